@@ -26,6 +26,8 @@
     [self registerRouters];
     
     [DarkModeManager.shared updateDarkMode:MyConfiguration.shared.appearance];
+
+    [EZBingTokenManager.shared startIfNeeded];
 }
 
 #pragma mark - NSApplicationDelegate
@@ -143,16 +143,31 @@ extension Defaults.Keys {
     static let replaceNewlineWithSpace = Key<Bool>(
         "EZConfiguration_kReplaceNewlineWithSpace", default: false
     )
+    static let enableLongTextChunkedTranslation = Key<Bool>(
+        "EZConfiguration_kEnableLongTextChunkedTranslation", default: false
+    )
 
     static let enableBetaFeature = Key<Bool>("EZBetaFeatureKey", default: false)
     static var disableTipsView = Key<Bool>("disableTipsViewKey", default: false)
     static var enableYoudaoOCR = Key<Bool>("enableYoudaoOCR", default: false)
+    static var enableHedgedRequests = Key<Bool>("enableHedgedRequests", default: false)
+    static var enableSpeculativePrefetch = Key<Bool>("enableSpeculativePrefetch", default: false)
+    static var enableQueryTracing = Key<Bool>("enableQueryTracing", default: false)
     static var enableCompatibilityReplace = Key<Bool>(
         "replaceWithTranslationInCompatibilityMode",
         default: false
     )
     static var enableHTTPServer = Key<Bool>("enableHTTPServer", default: false)
     static var httpPort = Key<String>("httpPort", default: "8080")
+    static var httpStreamFlushPolicy = Key<ServerSentEventFlushPolicy>(
+        "httpStreamFlushPolicy", default: .balanced
+    )
+    static var httpServerRouteConcurrencyLimit = Key<Int>("httpServerRouteConcurrencyLimit", default: 8)
+    static var httpServerServiceConcurrencyLimit = Key<Int>("httpServerServiceConcurrencyLimit", default: 2)
+    static var httpServerQueueLimit = Key<Int>("httpServerQueueLimit", default: 16)
+    static var httpServerMaxQueueWait = Key<Double>("httpServerMaxQueueWait", default: 30)
+    /// 0 uses NIO's shared event loop group.
+    static var httpServerEventLoopThreads = Key<Int>("httpServerEventLoopThreads", default: 0)
 
     static var enableAppleOfflineTranslation = Key<Bool>(
         "enableAppleOfflineTranslation", default: false
@@ -160,6 +175,10 @@ extension Defaults.Keys {
     static var enableOCRTextNormalization = Key<Bool>(
         "enableOCRTextNormalization", default: false
     )
+    /// Recognizes tall images in overlapping bands concurrently, see `OCRImageTiler`.
+    static var enableTiledOCR = Key<Bool>(
+        "enableTiledOCR", default: false
+    )
     static var showOCRMenuItems = Key<Bool>(
         "showOCRMenuItems", default: false
     )
@@ -192,6 +211,24 @@ extension Defaults.Keys {
         default: true
     )
 
+    /// Debug only: also write rendered Apple Dictionary HTML to `~/Library/Dictionaries/Dict HTML`.
+    static let enableDictionaryHTMLDebugDump = Key<Bool>(
+        "EZConfiguration_kEnableDictionaryHTMLDebugDump",
+        default: false
+    )
+
+    /// Keep pre-spawned Codex CLI workers so CLI startup is off the query path.
+    static let enableCodexCLIWorkerPool = Key<Bool>(
+        "EZConfiguration_kEnableCodexCLIWorkerPool",
+        default: false
+    )
+
+    /// Keep pre-spawned Claude Code workers so CLI startup is off the query path.
+    static let enableClaudeCodeWorkerPool = Key<Bool>(
+        "EZConfiguration_kEnableClaudeCodeWorkerPool",
+        default: false
+    )
+
     static let preferAppleScriptAPI = Key<Bool>(
         "EZConfiguration_kPreferAppleScriptAPI",
         default: true
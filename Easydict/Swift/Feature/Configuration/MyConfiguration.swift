@@ -108,6 +108,7 @@ class MyConfiguration: NSObject {
 
     @DefaultsWrapper(.enableAppleOfflineTranslation) var enableAppleOfflineTranslation: Bool
     @DefaultsWrapper(.enableOCRTextNormalization) var enableOCRTextNormalization: Bool
+    @DefaultsWrapper(.enableTiledOCR) var enableTiledOCR: Bool
     @DefaultsWrapper(.isScreenshotTipLayerHidden) var isScreenshotTipLayerHidden: Bool
     @DefaultsWrapper(.formerFixedScreenVisibleFrame) var formerFixedScreenVisibleFrame: CGRect
     @DefaultsWrapper(.formerMiniScreenVisibleFrame) var formerMiniScreenVisibleFrame: CGRect
@@ -49,6 +49,6 @@ extension QueryService {
             }
         }
 
-        return try await translate(text, from: sourceLanguage, to: to)
+        return try await coalescedTranslate(text, from: sourceLanguage, to: to)
     }
 }
@@ -0,0 +1,408 @@
+//
+//  HTTPAdmissionControl.swift
+//  Easydict
+//
+//  Created by tisfeng on 2026/10/19.
+//  Copyright © 2026 izual. All rights reserved.
+//
+
+import Defaults
+import Foundation
+import Vapor
+
+// MARK: - HTTPAdmissionControl
+
+/// Limits how many HTTP server requests run at once, per route and per service.
+///
+/// Each route, and each service behind `/translate` and `/streamTranslate`, has its own
+/// `AdmissionLimiter`. Requests over a limit wait in a bounded FIFO queue; when the queue
+/// is full or the wait exceeds `maxQueueWait`, the request is answered with 429 and a
+/// `Retry-After` estimate. This keeps a burst of automation requests from spawning dozens
+/// of CLI processes or exhausting a provider's quota.
+///
+/// The configuration is read from `Defaults` when the server starts.
+final class HTTPAdmissionControl: @unchecked Sendable {
+    // MARK: Lifecycle
+
+    init(configuration: Configuration = .current, registry: MetricsRegistry = .shared) {
+        self.configuration = configuration
+        self.registry = registry
+    }
+
+    // MARK: Internal
+
+    struct Configuration {
+        /// Requests of one route running at once.
+        var routeConcurrencyLimit: Int
+        /// Requests for one service running at once, across routes.
+        var serviceConcurrencyLimit: Int
+        /// Requests waiting per limiter before new ones are rejected.
+        var queueLimit: Int
+        /// Longest time a request waits for a slot.
+        var maxQueueWait: TimeInterval
+
+        static var current: Configuration {
+            Configuration(
+                routeConcurrencyLimit: Defaults[.httpServerRouteConcurrencyLimit],
+                serviceConcurrencyLimit: Defaults[.httpServerServiceConcurrencyLimit],
+                queueLimit: Defaults[.httpServerQueueLimit],
+                maxQueueWait: Defaults[.httpServerMaxQueueWait]
+            )
+        }
+    }
+
+    let configuration: Configuration
+
+    /// Waits for a slot of `service`, if given, and then of `route`.
+    ///
+    /// The service slot is taken first, so requests queued behind a slow service do not hold
+    /// route slots that requests for idle services could use. `service` must be a validated
+    /// service type, since every distinct value creates a limiter that lives with the server.
+    ///
+    /// The returned permit must be released once the request's work is done, which for
+    /// streaming responses is when the body has been written.
+    ///
+    /// - Throws: `AdmissionRejection` when a queue is full or the wait times out.
+    func admit(route: String, service: String? = nil) async throws -> AdmissionPermit {
+        guard let service else {
+            return try await limiter(for: "route:\(route)", limit: configuration.routeConcurrencyLimit).acquire()
+        }
+
+        let servicePermit = try await limiter(
+            for: "service:\(service)",
+            limit: configuration.serviceConcurrencyLimit
+        ).acquire()
+        do {
+            let routePermit = try await limiter(
+                for: "route:\(route)",
+                limit: configuration.routeConcurrencyLimit
+            ).acquire()
+            return AdmissionPermit(combining: [servicePermit, routePermit])
+        } catch {
+            servicePermit.release()
+            throw error
+        }
+    }
+
+    // MARK: Private
+
+    private let registry: MetricsRegistry
+    private let lock = NSLock()
+    private var limiters: [String: AdmissionLimiter] = [:]
+
+    private func limiter(for name: String, limit: Int) -> AdmissionLimiter {
+        lock.withLock {
+            if let limiter = limiters[name] {
+                return limiter
+            }
+            let limiter = AdmissionLimiter(
+                name: name,
+                maxConcurrent: limit,
+                maxQueued: configuration.queueLimit,
+                maxWait: configuration.maxQueueWait,
+                registry: registry
+            )
+            limiters[name] = limiter
+            return limiter
+        }
+    }
+}
+
+// MARK: - Application + HTTPAdmissionControl
+
+extension Application {
+    private struct AdmissionControlKey: StorageKey {
+        typealias Value = HTTPAdmissionControl
+    }
+
+    /// Admission control of this server, configured in `configure(_:)`.
+    var admissionControl: HTTPAdmissionControl {
+        get {
+            if let admissionControl = storage[AdmissionControlKey.self] {
+                return admissionControl
+            }
+            let admissionControl = HTTPAdmissionControl()
+            storage[AdmissionControlKey.self] = admissionControl
+            return admissionControl
+        }
+        set {
+            storage[AdmissionControlKey.self] = newValue
+        }
+    }
+}
+
+// MARK: - AdmissionRejection
+
+/// A request turned away by an `AdmissionLimiter`, answered with 429 and `Retry-After`.
+struct AdmissionRejection: AbortError {
+    enum Reason: String {
+        case queueFull = "queue_full"
+        case timeout
+    }
+
+    let limiter: String
+    let rejectionReason: Reason
+    /// Seconds after which a retry is likely to be admitted.
+    let retryAfter: Int
+
+    var status: HTTPResponseStatus {
+        .tooManyRequests
+    }
+
+    var reason: String {
+        switch rejectionReason {
+        case .queueFull: "Too many requests for \(limiter), the wait queue is full"
+        case .timeout: "Too many requests for \(limiter), timed out waiting for a slot"
+        }
+    }
+
+    var headers: HTTPHeaders {
+        ["Retry-After": String(retryAfter)]
+    }
+}
+
+// MARK: - AdmissionPermit
+
+/// A slot held in one or more limiters. Released explicitly, or when deallocated.
+final class AdmissionPermit: @unchecked Sendable {
+    // MARK: Lifecycle
+
+    fileprivate init(limiter: AdmissionLimiter, acquiredTime: TimeInterval) {
+        self.onRelease = { limiter.release(heldSince: acquiredTime) }
+    }
+
+    fileprivate init(combining permits: [AdmissionPermit]) {
+        self.onRelease = { permits.forEach { $0.release() } }
+    }
+
+    deinit {
+        release()
+    }
+
+    // MARK: Internal
+
+    func release() {
+        let onRelease = lock.withLock { () -> (() -> ())? in
+            defer { self.onRelease = nil }
+            return self.onRelease
+        }
+        onRelease?()
+    }
+
+    // MARK: Private
+
+    private let lock = NSLock()
+    private var onRelease: (() -> ())?
+}
+
+// MARK: - AdmissionLimiter
+
+/// FIFO concurrency limiter with a bounded wait queue.
+///
+/// A released slot is handed straight to the oldest waiter, so waiting requests are
+/// admitted in arrival order. `Retry-After` is estimated from the average time a slot is
+/// held and the number of requests ahead.
+final class AdmissionLimiter: @unchecked Sendable {
+    // MARK: Lifecycle
+
+    init(
+        name: String,
+        maxConcurrent: Int,
+        maxQueued: Int,
+        maxWait: TimeInterval,
+        registry: MetricsRegistry = .shared,
+        now: @escaping () -> TimeInterval = { ProcessInfo.processInfo.systemUptime }
+    ) {
+        self.name = name
+        self.maxConcurrent = max(maxConcurrent, 1)
+        self.maxQueued = max(maxQueued, 0)
+        self.maxWait = maxWait
+        self.registry = registry
+        self.now = now
+    }
+
+    // MARK: Internal
+
+    static let queueDepth = MetricDescriptor(
+        name: "easydict_http_queue_depth",
+        help: "HTTP server requests waiting for a slot, by limiter.",
+        kind: .gauge
+    )
+    static let inFlight = MetricDescriptor(
+        name: "easydict_http_in_flight_requests",
+        help: "HTTP server requests holding a slot, by limiter.",
+        kind: .gauge
+    )
+    static let queueWait = MetricDescriptor(
+        name: "easydict_http_queue_wait_seconds",
+        help: "Time admitted HTTP server requests waited for a slot, by limiter.",
+        kind: .summary
+    )
+    static let rejections = MetricDescriptor(
+        name: "easydict_http_rejections_total",
+        help: "HTTP server requests answered with 429, by limiter and reason (queue_full, timeout).",
+        kind: .counter
+    )
+
+    let name: String
+    let maxConcurrent: Int
+    let maxQueued: Int
+    let maxWait: TimeInterval
+
+    /// Waits for a slot, in arrival order.
+    ///
+    /// - Throws: `AdmissionRejection` when the queue is full or `maxWait` passes, or
+    ///   `CancellationError` when the task is cancelled while waiting.
+    func acquire() async throws -> AdmissionPermit {
+        let enqueueTime = now()
+        let waiterID: UInt64
+        do {
+            waiterID = try lock.withLock { () throws -> UInt64 in
+                if running < maxConcurrent {
+                    running += 1
+                    publishGauges()
+                    return 0
+                }
+                guard queuedCount < maxQueued else {
+                    throw makeRejection(.queueFull)
+                }
+                // Holds the queue place until `waitForSlot` appends the waiter.
+                pendingWaiterCount += 1
+                nextWaiterID += 1
+                return nextWaiterID
+            }
+        } catch {
+            registry.increment(Self.rejections, labels: ["limiter": name, "reason": AdmissionRejection.Reason.queueFull.rawValue])
+            throw error
+        }
+
+        if waiterID != 0 {
+            try await waitForSlot(id: waiterID)
+        }
+
+        let acquiredTime = now()
+        registry.observe(Self.queueWait, labels: ["limiter": name], value: acquiredTime - enqueueTime)
+        return AdmissionPermit(limiter: self, acquiredTime: acquiredTime)
+    }
+
+    // MARK: Fileprivate
+
+    fileprivate func release(heldSince acquiredTime: TimeInterval) {
+        let heldTime = now() - acquiredTime
+        let waiter = lock.withLock { () -> Waiter? in
+            averageHoldTime = averageHoldTime == 0 ? heldTime : averageHoldTime * 0.8 + heldTime * 0.2
+            guard !waiters.isEmpty else {
+                running -= 1
+                publishGauges()
+                return nil
+            }
+            // The slot passes to the oldest waiter, so `running` stays the same.
+            let waiter = waiters.removeFirst()
+            publishGauges()
+            return waiter
+        }
+        waiter?.timeoutTask?.cancel()
+        waiter?.continuation.resume()
+    }
+
+    // MARK: Private
+
+    private struct Waiter {
+        let id: UInt64
+        let continuation: CheckedContinuation<(), Error>
+        var timeoutTask: Task<(), Never>?
+    }
+
+    private let registry: MetricsRegistry
+    private let now: () -> TimeInterval
+    private let lock = NSLock()
+
+    private var running = 0
+    private var waiters: [Waiter] = []
+    /// Waiters that passed the queue check in `acquire` but are not appended yet.
+    private var pendingWaiterCount = 0
+    private var nextWaiterID: UInt64 = 0
+    /// Moving average of how long a slot is held, in seconds.
+    private var averageHoldTime: TimeInterval = 0
+
+    private func waitForSlot(id: UInt64) async throws {
+        try await withTaskCancellationHandler {
+            try await withCheckedThrowingContinuation { (continuation: CheckedContinuation<(), Error>) in
+                let isAdmitted = lock.withLock { () -> Bool in
+                    pendingWaiterCount -= 1
+                    // A slot released since `acquire` found none free had no waiter to pass to.
+                    if running < maxConcurrent {
+                        running += 1
+                        publishGauges()
+                        return true
+                    }
+                    waiters.append(Waiter(id: id, continuation: continuation))
+                    publishGauges()
+                    return false
+                }
+                if isAdmitted {
+                    continuation.resume()
+                    return
+                }
+
+                // Started after the waiter is queued, so it cannot miss it.
+                let maxWait = maxWait
+                let timeoutTask = Task { [weak self] in
+                    try? await Task.sleepThrowing(seconds: maxWait)
+                    guard !Task.isCancelled, let self else { return }
+                    let rejection = lock.withLock { makeRejection(.timeout) }
+                    if removeWaiter(id: id, resumingWith: rejection) {
+                        registry.increment(Self.rejections, labels: ["limiter": name, "reason": AdmissionRejection.Reason.timeout.rawValue])
+                    }
+                }
+                let isQueued = lock.withLock { () -> Bool in
+                    guard let index = waiters.firstIndex(where: { $0.id == id }) else { return false }
+                    waiters[index].timeoutTask = timeoutTask
+                    return true
+                }
+                if !isQueued {
+                    timeoutTask.cancel()
+                } else if Task.isCancelled {
+                    // The cancellation handler ran before the waiter was queued.
+                    removeWaiter(id: id, resumingWith: CancellationError())
+                }
+            }
+        } onCancel: {
+            removeWaiter(id: id, resumingWith: CancellationError())
+        }
+    }
+
+    /// Removes a waiter that has not been admitted yet and fails it with `error`.
+    @discardableResult
+    private func removeWaiter(id: UInt64, resumingWith error: Error) -> Bool {
+        let waiter = lock.withLock { () -> Waiter? in
+            guard let index = waiters.firstIndex(where: { $0.id == id }) else { return nil }
+            let waiter = waiters.remove(at: index)
+            publishGauges()
+            return waiter
+        }
+        guard let waiter else { return false }
+        waiter.timeoutTask?.cancel()
+        waiter.continuation.resume(throwing: error)
+        return true
+    }
+
+    /// Requests waiting for a slot, including those not appended yet. Read with the lock held.
+    private var queuedCount: Int {
+        waiters.count + pendingWaiterCount
+    }
+
+    /// Called with the lock held.
+    private func makeRejection(_ reason: AdmissionRejection.Reason) -> AdmissionRejection {
+        // Requests ahead drain `maxConcurrent` at a time, each batch taking about one hold time.
+        let batchesAhead = Double(queuedCount / maxConcurrent + 1)
+        let estimate = (batchesAhead * max(averageHoldTime, 1)).rounded(.up)
+        return AdmissionRejection(limiter: name, rejectionReason: reason, retryAfter: Int(min(estimate, 60)))
+    }
+
+    /// Called with the lock held.
+    private func publishGauges() {
+        registry.set(Self.queueDepth, labels: ["limiter": name], value: Double(queuedCount))
+        registry.set(Self.inFlight, labels: ["limiter": name], value: Double(running))
+    }
+}
@@ -0,0 +1,250 @@
+//
+//  OCRUpload.swift
+//  Easydict
+//
+//  Created by tisfeng on 2026/10/19.
+//  Copyright © 2026 izual. All rights reserved.
+//
+
+import MultipartKit
+import Vapor
+
+// MARK: - OCRUpload
+
+/// Images posted to `/ocr` or `/ocr/batch`, read from the streamed request body.
+///
+/// Three body types are accepted:
+/// - A raw `image/*` body holding one image, with `sourceLanguage` in the query string.
+/// - `multipart/form-data` with one part per image file and an optional `sourceLanguage`
+///   field. Parts are parsed while the body streams in, so only the image bytes are kept.
+/// - The JSON `OCRRequest`, or `OCRBatchRequest` for batches, with base64 image data.
+///
+/// Raw and multipart uploads skip base64 entirely, and a body larger than `maxSize` is
+/// rejected as soon as it crosses the limit instead of after being collected.
+struct OCRUpload {
+    // MARK: Internal
+
+    var images: [Data]
+    var sourceLanguage: String?
+
+    /// Reads the upload of `req`, which must be routed with `body: .stream`.
+    static func read(from req: Request, maxSize: Int) async throws -> OCRUpload {
+        guard let contentType = req.headers.contentType else {
+            throw Abort(.unsupportedMediaType, reason: "Missing Content-Type")
+        }
+        let contentLength = req.headers.first(name: .contentLength).flatMap(Int.init)
+        return try await read(
+            req.body,
+            contentType: contentType,
+            contentLength: contentLength,
+            sourceLanguage: req.query[String.self, at: "sourceLanguage"],
+            maxSize: maxSize,
+            allocator: req.byteBufferAllocator
+        )
+    }
+
+    /// Reads an upload from body `chunks` of the given `contentType`.
+    static func read<Body: AsyncSequence>(
+        _ chunks: Body,
+        contentType: HTTPMediaType,
+        contentLength: Int? = nil,
+        sourceLanguage: String? = nil,
+        maxSize: Int,
+        allocator: ByteBufferAllocator = ByteBufferAllocator()
+    ) async throws
+        -> OCRUpload where Body.Element == ByteBuffer {
+        if contentType.type == "image" {
+            let body = try await collect(chunks, contentLength: contentLength, maxSize: maxSize, allocator: allocator)
+            return OCRUpload(images: [Data(body.readableBytesView)], sourceLanguage: sourceLanguage)
+        }
+
+        if contentType.type == "multipart", contentType.subType == "form-data" {
+            guard let boundary = contentType.parameters["boundary"] else {
+                throw Abort(.badRequest, reason: "Missing multipart boundary")
+            }
+            var upload = try await readMultipart(chunks, boundary: boundary, maxSize: maxSize)
+            upload.sourceLanguage = upload.sourceLanguage ?? sourceLanguage
+            return upload
+        }
+
+        if contentType == .json {
+            let body = try await collect(chunks, contentLength: contentLength, maxSize: maxSize, allocator: allocator)
+            let request = try JSONDecoder().decode(JSONBody.self, from: Data(body.readableBytesView))
+            let images = request.images ?? request.imageData.map { [$0] } ?? []
+            return OCRUpload(images: images, sourceLanguage: request.sourceLanguage ?? sourceLanguage)
+        }
+
+        throw Abort(.unsupportedMediaType, reason: "Expected image/*, multipart/form-data or application/json")
+    }
+
+    // MARK: Private
+
+    /// `OCRRequest` and `OCRBatchRequest` share one decoding path.
+    private struct JSONBody: Decodable {
+        var imageData: Data?
+        var images: [Data]?
+        var sourceLanguage: String?
+    }
+
+    /// One multipart part, with only the headers OCR needs.
+    private struct Part {
+        var name: String?
+        var filename: String?
+        var contentType: String?
+        var body = ByteBuffer()
+    }
+
+    private static func collect<Body: AsyncSequence>(
+        _ chunks: Body,
+        contentLength: Int?,
+        maxSize: Int,
+        allocator: ByteBufferAllocator
+    ) async throws
+        -> ByteBuffer where Body.Element == ByteBuffer {
+        if let contentLength, contentLength > maxSize {
+            throw Abort(.payloadTooLarge)
+        }
+
+        var body = allocator.buffer(capacity: contentLength ?? 0)
+        for try await var chunk in chunks {
+            guard body.readableBytes + chunk.readableBytes <= maxSize else {
+                throw Abort(.payloadTooLarge)
+            }
+            body.writeBuffer(&chunk)
+        }
+        return body
+    }
+
+    private static func readMultipart<Body: AsyncSequence>(
+        _ chunks: Body,
+        boundary: String,
+        maxSize: Int
+    ) async throws
+        -> OCRUpload where Body.Element == ByteBuffer {
+        var parts: [Part] = []
+        var part = Part()
+
+        let parser = MultipartParser(boundary: boundary)
+        parser.onHeader = { field, value in
+            switch field.lowercased() {
+            case "content-disposition":
+                let disposition = HTTPHeaders([("Content-Disposition", value)]).contentDisposition
+                part.name = disposition?.name
+                part.filename = disposition?.filename
+            case "content-type":
+                part.contentType = value
+            default:
+                break
+            }
+        }
+        parser.onBody = { body in
+            part.body.writeBuffer(&body)
+        }
+        parser.onPartComplete = {
+            parts.append(part)
+            part = Part()
+        }
+
+        var receivedBytes = 0
+        for try await chunk in chunks {
+            receivedBytes += chunk.readableBytes
+            guard receivedBytes <= maxSize else {
+                throw Abort(.payloadTooLarge)
+            }
+            try parser.execute(chunk)
+        }
+
+        var upload = OCRUpload(images: [], sourceLanguage: nil)
+        for part in parts {
+            if part.name == "sourceLanguage" {
+                upload.sourceLanguage = String(buffer: part.body)
+            } else if part.filename != nil || part.contentType?.hasPrefix("image/") == true {
+                upload.images.append(Data(part.body.readableBytesView))
+            }
+        }
+        return upload
+    }
+}
+
+// MARK: - OCR Recognition
+
+extension OCRUpload {
+    /// Upper bound of images OCRed at the same time by `/ocr/batch`.
+    static let batchConcurrencyLimit = max(2, ProcessInfo.processInfo.activeProcessorCount / 2)
+
+    /// OCRs one image and reports how long it took.
+    static func recognize(_ imageData: Data, sourceLanguage: String?) async throws -> OCRResponse {
+        let startTime = ProcessInfo.processInfo.systemUptime
+
+        let queryModel = QueryModel()
+        queryModel.ocrImage = NSImage(data: imageData)
+
+        var from = Language.auto
+        if let sourceLanguage {
+            from = Language.language(fromCode: sourceLanguage)
+        }
+        queryModel.userSourceLanguage = from
+
+        let detectManager = DetectManager(model: queryModel)
+        let result = try await detectManager.ocr()
+
+        return OCRResponse(
+            ocrText: result.mergedText,
+            sourceLanguage: result.from.code,
+            durationMs: (ProcessInfo.processInfo.systemUptime - startTime) * 1000
+        )
+    }
+
+    /// OCRs every image, at most `concurrencyLimit` at a time, in upload order. A failed
+    /// image reports its error without failing the batch.
+    func recognizeAll(concurrencyLimit: Int = OCRUpload.batchConcurrencyLimit) async -> OCRBatchResponse {
+        let startTime = ProcessInfo.processInfo.systemUptime
+        let sourceLanguage = sourceLanguage
+
+        let results = await Self.boundedMap(images, concurrencyLimit: concurrencyLimit) { imageData in
+            let imageStartTime = ProcessInfo.processInfo.systemUptime
+            do {
+                return OCRBatchResponse.Item(result: try await Self.recognize(imageData, sourceLanguage: sourceLanguage))
+            } catch {
+                let durationMs = (ProcessInfo.processInfo.systemUptime - imageStartTime) * 1000
+                return OCRBatchResponse.Item(error: error, durationMs: durationMs)
+            }
+        }
+
+        return OCRBatchResponse(
+            results: results,
+            durationMs: (ProcessInfo.processInfo.systemUptime - startTime) * 1000
+        )
+    }
+
+    /// Maps `elements` concurrently, running at most `concurrencyLimit` transforms at a time,
+    /// and returns the results in the order of `elements`.
+    static func boundedMap<Element, Result>(
+        _ elements: [Element],
+        concurrencyLimit: Int,
+        transform: @escaping (Element) async -> Result
+    ) async
+        -> [Result] {
+        guard !elements.isEmpty else { return [] }
+        let concurrencyLimit = min(max(concurrencyLimit, 1), elements.count)
+
+        var results = [Result?](repeating: nil, count: elements.count)
+        await withTaskGroup(of: (Int, Result).self) { group in
+            var nextIndex = 0
+            while nextIndex < concurrencyLimit {
+                let index = nextIndex
+                group.addTask { await (index, transform(elements[index])) }
+                nextIndex += 1
+            }
+            for await (index, result) in group {
+                results[index] = result
+                if nextIndex < elements.count {
+                    let index = nextIndex
+                    group.addTask { await (index, transform(elements[index])) }
+                    nextIndex += 1
+                }
+            }
+        }
+        return results.map { $0! }
+    }
+}
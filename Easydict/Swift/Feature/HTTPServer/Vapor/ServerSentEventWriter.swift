@@ -0,0 +1,234 @@
+//
+//  ServerSentEventWriter.swift
+//  Easydict
+//
+//  Created by tisfeng on 2026/10/19.
+//  Copyright © 2026 izual. All rights reserved.
+//
+
+import Defaults
+import Foundation
+import SwiftUI
+import Vapor
+
+// MARK: - ServerSentEventFlushPolicy
+
+/// How long `ServerSentEventWriter` holds events back to coalesce them into one write.
+enum ServerSentEventFlushPolicy: String, CaseIterable, Defaults.Serializable {
+    /// Every event is written as soon as it is encoded.
+    case latency
+    /// Events produced within a few milliseconds share a write.
+    case balanced
+    /// Events are collected for longer, trading token latency for fewer writes.
+    case throughput
+
+    // MARK: Internal
+
+    /// Longest time an event waits in the buffer.
+    var coalescingDelay: TimeInterval {
+        switch self {
+        case .latency: 0
+        case .balanced: 0.008
+        case .throughput: 0.05
+        }
+    }
+
+    /// Buffered bytes that trigger a write before the delay has passed.
+    var maxBufferedBytes: Int {
+        switch self {
+        case .latency: 0
+        case .balanced: 4 * 1024
+        case .throughput: 32 * 1024
+        }
+    }
+}
+
+// MARK: EnumLocalizedStringConvertible
+
+extension ServerSentEventFlushPolicy: EnumLocalizedStringConvertible {
+    var title: LocalizedStringKey {
+        switch self {
+        case .latency:
+            "setting.advance.http_stream_flush_policy.latency"
+        case .balanced:
+            "setting.advance.http_stream_flush_policy.balanced"
+        case .throughput:
+            "setting.advance.http_stream_flush_policy.throughput"
+        }
+    }
+}
+
+// MARK: - ServerSentEventWriter
+
+/// Writes `text/event-stream` events to a streaming Vapor response body.
+///
+/// Events are encoded straight into a `ByteBuffer` with a JSON encoder reused for the whole
+/// stream. Events produced within the policy's coalescing delay go out in one write, and
+/// the first event is always written right away so time to first token does not pay the
+/// delay. Two buffers take turns: one collects events while the other is being written,
+/// and its storage is reused once the channel releases it.
+///
+/// While the stream is idle, a `: keep-alive` comment is written every `keepAliveInterval`
+/// so proxies do not close the connection during a slow first token.
+actor ServerSentEventWriter {
+    // MARK: Lifecycle
+
+    init(
+        writer: any AsyncBodyStreamWriter,
+        allocator: ByteBufferAllocator,
+        flushPolicy: ServerSentEventFlushPolicy = Defaults[.httpStreamFlushPolicy],
+        keepAliveInterval: TimeInterval? = 15,
+        initialCapacity: Int = 4 * 1024
+    ) {
+        self.writer = writer
+        self.allocator = allocator
+        self.flushPolicy = flushPolicy
+        self.keepAliveInterval = keepAliveInterval
+        self.initialCapacity = initialCapacity
+        self.buffer = allocator.buffer(capacity: initialCapacity)
+    }
+
+    deinit {
+        flushTask?.cancel()
+        keepAliveTask?.cancel()
+    }
+
+    // MARK: Internal
+
+    /// Sends `payload` JSON-encoded as one `data:` event. Payloads that fail to encode are skipped.
+    func send(_ payload: some Encodable) async throws {
+        guard let json = try? encoder.encode(payload) else { return }
+        try await append(json)
+    }
+
+    /// Sends an already encoded JSON string as one `data:` event.
+    func send(json: String) async throws {
+        try await append(Data(json.utf8))
+    }
+
+    /// Starts writing keep-alive comments while the stream is idle, typically before the
+    /// first token arrives.
+    func startKeepAlive() {
+        guard keepAliveTask == nil, let keepAliveInterval, keepAliveInterval > 0 else { return }
+        keepAliveTask = Task { [weak self] in
+            while !Task.isCancelled {
+                try? await Task.sleepThrowing(seconds: keepAliveInterval)
+                guard !Task.isCancelled, let self else { return }
+                await writeKeepAliveIfIdle()
+            }
+        }
+    }
+
+    /// Writes the pending events and ends the response body.
+    func finish() async throws {
+        flushTask?.cancel()
+        keepAliveTask?.cancel()
+        while isWriting {
+            await withCheckedContinuation { idleWaiters.append($0) }
+        }
+        if let deferredError {
+            throw deferredError
+        }
+        try await flush()
+        try await writer.write(.end)
+    }
+
+    // MARK: Private
+
+    private let writer: any AsyncBodyStreamWriter
+    private let allocator: ByteBufferAllocator
+    private let flushPolicy: ServerSentEventFlushPolicy
+    private let keepAliveInterval: TimeInterval?
+    private let initialCapacity: Int
+    private let encoder = JSONEncoder()
+
+    /// Collects events until the next write.
+    private var buffer: ByteBuffer
+    /// Storage of the previous write, cleared for reuse.
+    private var spareBuffer: ByteBuffer?
+    private var isWriting = false
+    /// Whether an event was appended; keep-alive comments do not count, so the first event
+    /// after a slow first token is still written right away.
+    private var hasSentEvent = false
+    private var lastWriteTime = ProcessInfo.processInfo.systemUptime
+    /// Failure of a write started by a timer, reported by the next `send`.
+    private var deferredError: Error?
+    /// Callers waiting for the write in progress to finish.
+    private var idleWaiters: [CheckedContinuation<(), Never>] = []
+
+    private var flushTask: Task<(), Never>?
+    private var keepAliveTask: Task<(), Never>?
+
+    private func append(_ json: Data) async throws {
+        if let deferredError {
+            throw deferredError
+        }
+
+        // SSE format https://developer.mozilla.org/en-US/docs/Web/API/Server-sent_events/Using-server-sent_events
+        buffer.writeStaticString("data: ")
+        buffer.writeBytes(json)
+        buffer.writeStaticString("\n\n")
+
+        let isFirstEvent = !hasSentEvent
+        hasSentEvent = true
+        if isFirstEvent || flushPolicy.coalescingDelay == 0 || buffer.readableBytes >= flushPolicy.maxBufferedBytes {
+            try await flush()
+        } else if flushTask == nil {
+            let delay = flushPolicy.coalescingDelay
+            flushTask = Task { [weak self] in
+                try? await Task.sleepThrowing(seconds: delay)
+                guard !Task.isCancelled else { return }
+                await self?.flushFromTimer()
+            }
+        }
+    }
+
+    private func flushFromTimer() async {
+        flushTask = nil
+        do {
+            try await flush()
+        } catch {
+            deferredError = error
+        }
+    }
+
+    /// Writes the buffered bytes. A write already in progress picks up bytes appended
+    /// while it waits, so writes never overlap.
+    private func flush() async throws {
+        flushTask?.cancel()
+        flushTask = nil
+        guard !isWriting else { return }
+        isWriting = true
+        defer {
+            isWriting = false
+            idleWaiters.forEach { $0.resume() }
+            idleWaiters.removeAll()
+        }
+
+        while buffer.readableBytes > 0 {
+            var pending = buffer
+            buffer = spareBuffer ?? allocator.buffer(capacity: initialCapacity)
+            spareBuffer = nil
+
+            try await writer.write(.buffer(pending))
+            lastWriteTime = ProcessInfo.processInfo.systemUptime
+
+            // Keeps the storage when the channel no longer references it.
+            pending.clear()
+            spareBuffer = pending
+        }
+    }
+
+    private func writeKeepAliveIfIdle() async {
+        guard let keepAliveInterval, !isWriting, buffer.readableBytes == 0,
+              ProcessInfo.processInfo.systemUptime - lastWriteTime >= keepAliveInterval
+        else { return }
+
+        buffer.writeStaticString(": keep-alive\n\n")
+        do {
+            try await flush()
+        } catch {
+            deferredError = error
+        }
+    }
+}
@@ -88,11 +88,51 @@ struct OCRRequest: Content {
     var sourceLanguage: String?
 }
 
+// MARK: - OCRBatchRequest
+
+struct OCRBatchRequest: Content {
+    var images: [Data]
+    var sourceLanguage: String?
+}
+
 // MARK: - OCRResponse
 
 struct OCRResponse: Content {
     var ocrText: String
     var sourceLanguage: String
+    var durationMs: Double? // Time spent on OCR of this image, in milliseconds.
+}
+
+// MARK: - OCRBatchResponse
+
+struct OCRBatchResponse: Content {
+    // MARK: Internal
+
+    /// Result of one image, in upload order. Either `ocrText` or `error` is set.
+    struct Item: Content {
+        // MARK: Lifecycle
+
+        init(result: OCRResponse) {
+            self.ocrText = result.ocrText
+            self.sourceLanguage = result.sourceLanguage
+            self.durationMs = result.durationMs ?? 0
+        }
+
+        init(error: Error, durationMs: Double) {
+            self.error = QueryError.queryError(from: error)?.localizedDescription ?? error.localizedDescription
+            self.durationMs = durationMs
+        }
+
+        // MARK: Internal
+
+        var ocrText: String?
+        var sourceLanguage: String?
+        var error: String?
+        var durationMs: Double
+    }
+
+    var results: [Item]
+    var durationMs: Double // Wall time of the whole batch, in milliseconds.
 }
 
 // MARK: - DetectRequest
@@ -48,6 +48,8 @@ class VaporServer {
 
     var app: Vapor.Application?
     var env: Environment?
+    /// Dedicated event loops when `httpServerEventLoopThreads` is set.
+    var eventLoopGroup: MultiThreadedEventLoopGroup?
 
     var httpPort: Int {
         Int(Defaults[.httpPort]) ?? 8080
@@ -84,7 +86,16 @@ class VaporServer {
             return
         }
 
-        let app = try await Application.make(env)
+        // 0 keeps NIO's shared event loop group, one thread per core.
+        let eventLoopThreadCount = Defaults[.httpServerEventLoopThreads]
+        let app: Application
+        if eventLoopThreadCount > 0 {
+            let eventLoopGroup = MultiThreadedEventLoopGroup(numberOfThreads: eventLoopThreadCount)
+            self.eventLoopGroup = eventLoopGroup
+            app = try await Application.make(env, .shared(eventLoopGroup))
+        } else {
+            app = try await Application.make(env)
+        }
         self.app = app
 
         app.http.server.configuration.port = httpPort
@@ -93,7 +104,7 @@ class VaporServer {
             try await configure(app)
         } catch {
             app.logger.report(error: error)
-            try? await app.asyncShutdown()
+            await stop()
             throw error
         }
 
@@ -102,6 +113,9 @@ class VaporServer {
 
     private func stop() async {
         try? await app?.asyncShutdown()
+        app = nil
+        try? await eventLoopGroup?.shutdownGracefully()
+        eventLoopGroup = nil
     }
 
     // Show alert when error
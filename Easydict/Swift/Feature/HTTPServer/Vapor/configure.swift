@@ -12,6 +12,8 @@ import Vapor
 public func configure(_ app: Application) async throws {
     // uncomment to serve files from /Public folder
 //     app.middleware.use(FileMiddleware(publicDirectory: app.directory.publicDirectory))
+    // limit concurrent requests per route and per service
+    app.admissionControl = HTTPAdmissionControl(configuration: .current)
     // register routes
     try routes(app)
 }
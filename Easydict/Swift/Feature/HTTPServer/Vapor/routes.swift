@@ -27,6 +27,10 @@ func routes(_ app: Application) throws {
             )
         }
 
+        // Admitted only after validation, so unknown service types cannot create limiters.
+        let permit = try await req.application.admissionControl.admit(route: "translate", service: request.serviceType)
+        defer { permit.release() }
+
         if let appleDictionary = service as? AppleDictionary, let appleDictionaryNames {
             appleDictionary.appleDictionaryNames = appleDictionaryNames
         }
@@ -41,7 +45,9 @@ func routes(_ app: Application) throws {
             throw QueryError(type: .api, message: message)
         }
 
-        let result = try await service.translate(request: request)
+        let result = try await QueryMetrics.measure(service: service.serviceTypeWithUniqueIdentifier()) {
+            try await service.translate(request: request)
+        }
 
         var response = TranslationResponse(
             translatedText: result.translatedText ?? "",
@@ -83,25 +89,36 @@ func routes(_ app: Application) throws {
             throw QueryError(type: .api, message: message)
         }
 
+        // Held until the response body has been written.
+        let permit = try await req.application.admissionControl.admit(
+            route: "streamTranslate",
+            service: request.serviceType
+        )
+
         let headers = HTTPHeaders([
             ("Content-Type", "text/event-stream"),
             ("Cache-Control", "no-cache"),
             ("Connection", "keep-alive"),
         ])
 
-        let chatStream = try await streamService.streamTranslate(request: request)
-        let jsonStream = chatStreamToJSONStream(
-            chatStream: chatStream,
-            fallbackModel: streamService.model
-        )
-
-        let asyncBodyStream: @Sendable (AsyncBodyStreamWriter) async throws -> () = { writer in
-            for await json in jsonStream {
-                // SSE format https://developer.mozilla.org/en-US/docs/Web/API/Server-sent_events/Using-server-sent_events
-                let data = "data: \(json)\n\n"
-                try await writer.write(.buffer(.init(string: data)))
+        let span = QueryMetricsSpan(service: streamService.serviceTypeWithUniqueIdentifier())
+        let chatStream: AsyncThrowingStream<ChatStreamResult, Error>
+        do {
+            chatStream = try await QueryMetrics.$current.withValue(span) {
+                try await streamService.streamTranslate(request: request)
             }
-            try await writer.write(.end)
+        } catch {
+            span.finish(error: error)
+            permit.release()
+            throw error
+        }
+        let allocator = req.byteBufferAllocator
+        let fallbackModel = streamService.model
+        let asyncBodyStream: @Sendable (AsyncBodyStreamWriter) async throws -> () = { writer in
+            defer { permit.release() }
+            let eventWriter = ServerSentEventWriter(writer: writer, allocator: allocator)
+            await eventWriter.startKeepAlive()
+            try await writeChatStream(chatStream, to: eventWriter, fallbackModel: fallbackModel, span: span)
         }
 
         return Response(
@@ -110,26 +127,31 @@ func routes(_ app: Application) throws {
         )
     }
 
-    /// OCR image data up to 10MB. https://docs.vapor.codes/basics/routing/
-    app.on(.POST, "ocr", body: .collect(maxSize: "10mb")) { req async throws -> OCRResponse in
-        let request = try req.content.decode(OCRRequest.self)
-
-        let queryModel = QueryModel()
-        queryModel.ocrImage = NSImage(data: request.imageData)
+    /// OCR one image up to 10MB, posted as a raw `image/*` body, a multipart file or
+    /// base64 JSON, see `OCRUpload`. https://docs.vapor.codes/basics/routing/
+    app.on(.POST, "ocr", body: .stream) { req async throws -> OCRResponse in
+        // Admitted before reading, so a waiting upload stays in the socket buffer.
+        let permit = try await req.application.admissionControl.admit(route: "ocr")
+        defer { permit.release() }
 
-        var from = Language.auto
-        if let sourceLanguage = request.sourceLanguage {
-            from = Language.language(fromCode: sourceLanguage)
+        let upload = try await OCRUpload.read(from: req, maxSize: 10 * 1024 * 1024)
+        guard let imageData = upload.images.first else {
+            throw QueryError(type: .parameter, message: "ocr image cannot be empty")
         }
-        queryModel.userSourceLanguage = from
+        return try await OCRUpload.recognize(imageData, sourceLanguage: upload.sourceLanguage)
+    }
 
-        let detectManager = DetectManager(model: queryModel)
-        let result = try await detectManager.ocr()
+    /// OCR up to 32 images, 50MB in total, concurrently. Results keep the upload order
+    /// and carry per-image timings.
+    app.on(.POST, "ocr", "batch", body: .stream) { req async throws -> OCRBatchResponse in
+        let permit = try await req.application.admissionControl.admit(route: "ocr/batch")
+        defer { permit.release() }
 
-        return OCRResponse(
-            ocrText: result.mergedText,
-            sourceLanguage: result.from.code
-        )
+        let upload = try await OCRUpload.read(from: req, maxSize: 50 * 1024 * 1024)
+        guard (1 ... 32).contains(upload.images.count) else {
+            throw QueryError(type: .parameter, message: "ocr batch needs 1 to 32 images, got \(upload.images.count)")
+        }
+        return await upload.recognizeAll()
     }
 
     /// Detect language
@@ -140,6 +162,30 @@ func routes(_ app: Application) throws {
         return DetectResponse(sourceLanguage: queryModel.detectedLanguage.code)
     }
 
+    /// Query metrics in the Prometheus text exposition format.
+    app.get("metrics") { _ async -> Response in
+        let headers = HTTPHeaders([
+            ("Content-Type", "text/plain; version=0.0.4; charset=utf-8"),
+        ])
+        return Response(
+            status: .ok,
+            headers: headers,
+            body: .init(string: MetricsRegistry.shared.prometheusText())
+        )
+    }
+
+    /// Recent query traces in the Chrome trace-event format, see `QueryTracer`.
+    app.get("traces") { _ async -> Response in
+        let headers = HTTPHeaders([
+            ("Content-Type", "application/json"),
+        ])
+        return Response(
+            status: .ok,
+            headers: headers,
+            body: .init(data: QueryTracer.shared.chromeTraceJSON())
+        )
+    }
+
     /// Get selected text
     app.get("selectedText") { _ async throws -> GetSelectedTextResponse in
         let selectedText = try await SelectedTextManager.shared.getSelectedText(strategy: .auto)
@@ -147,29 +193,27 @@ func routes(_ app: Application) throws {
     }
 }
 
-/// Convert chat stream to JSON messages, wrapping errors in a chunk-compatible
+/// Write chat stream results as SSE events, wrapping errors in a chunk-compatible
 /// JSON object so chunk-based stream clients can still decode the payload.
-private func chatStreamToJSONStream(
-    chatStream: AsyncThrowingStream<ChatStreamResult, Error>,
-    fallbackModel: String
-)
-    -> AsyncStream<String> {
-    AsyncStream<String> { continuation in
-        Task {
-            defer { continuation.finish() }
-            do {
-                for try await chatResult in chatStream {
-                    if let json = chatResult.jsonString {
-                        continuation.yield(json)
-                    }
-                }
-            } catch {
-                if let errorJson = makeJSONErrorMessage(error, fallbackModel: fallbackModel) {
-                    continuation.yield(errorJson)
-                }
-            }
+/// The query's metrics `span` is finished when the chat stream ends.
+private func writeChatStream(
+    _ chatStream: AsyncThrowingStream<ChatStreamResult, Error>,
+    to eventWriter: ServerSentEventWriter,
+    fallbackModel: String,
+    span: QueryMetricsSpan
+) async throws {
+    do {
+        for try await chatResult in chatStream {
+            try await eventWriter.send(chatResult)
+        }
+        span.finish(error: nil)
+    } catch {
+        span.finish(error: error)
+        if let errorJson = makeJSONErrorMessage(error, fallbackModel: fallbackModel) {
+            try await eventWriter.send(json: errorJson)
         }
     }
+    try await eventWriter.finish()
 }
 
 private func makeJSONErrorMessage(_ error: Error, fallbackModel: String) -> String? {
@@ -102,6 +102,8 @@ public class QueryError: NSError, LocalizedError, AbortError, @unchecked Sendabl
     public let type: ErrorType
     public var message: String?
     public var errorDataMessage: String?
+    /// HTTP status code of the failed response, nil when the error did not come from one.
+    public var statusCode: Int?
 
     public var errorDescription: String? {
         var errorString = ""
@@ -140,6 +142,18 @@ public class QueryError: NSError, LocalizedError, AbortError, @unchecked Sendabl
         .init(type: type, message: message, errorDataMessage: errorDataMessage)
     }
 
+    /// Error for a non-2xx HTTP response, keeping its `statusCode`.
+    public static func httpError(
+        statusCode: Int,
+        message: String? = nil,
+        errorDataMessage: String? = nil
+    )
+        -> QueryError {
+        let error = QueryError(type: .api, message: message, errorDataMessage: errorDataMessage)
+        error.statusCode = statusCode
+        return error
+    }
+
     public static func unsupportedLanguageError(service: QueryService) -> QueryError {
         let to = service.languageCode(forLanguage: service.queryModel.queryTargetLanguage)
         var unsupportLanguage = service.queryModel.queryFromLanguage
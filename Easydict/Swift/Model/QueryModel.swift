@@ -42,6 +42,7 @@ open class QueryModel: NSObject, NSCopying {
         model.specifiedTextLanguageDict = specifiedTextLanguageDict.mutableCopy() as? NSMutableDictionary
             ?? NSMutableDictionary()
         model.autoQuery = autoQuery
+        model.traceSpanID = traceSpanID
         return model
     }
 
@@ -80,6 +81,9 @@ open class QueryModel: NSObject, NSCopying {
     /// Whether to auto query after updating the model.
     var autoQuery: Bool = true
 
+    /// Root span of the current query's trace, 0 when tracing is off. See `QueryTracer`.
+    var traceSpanID: UInt64 = 0
+
     /// User selected source language.
     var userSourceLanguage: Language = .auto {
         didSet {
@@ -0,0 +1,64 @@
+//
+//  AgentCLIJSONEventDecoder.swift
+//  Easydict
+//
+//  Created by tisfeng on 2026/10/19.
+//  Copyright © 2026 izual. All rights reserved.
+//
+
+import Foundation
+
+// MARK: - AgentCLIJSONEventDecoder
+
+/// Decodes JSONL events straight from framed line bytes.
+///
+/// Lines are decoded from the `Data` handed out by `AgentCLILineFramer` instead of going
+/// through `String` and back to `Data`. A byte-level marker check lets callers skip JSON
+/// decoding entirely for events that cannot carry text, which are the majority of verbose
+/// stream output (system, rate limit, message start/stop, reasoning items).
+struct AgentCLIJSONEventDecoder {
+    // MARK: Internal
+
+    /// Decodes one event, returning `nil` for malformed or unrelated lines.
+    func decode<Event: Decodable>(_ type: Event.Type, from line: Data) -> Event? {
+        try? decoder.decode(type, from: line)
+    }
+
+    /// Decodes one event only when `line` contains `marker` verbatim.
+    ///
+    /// The marker must be a JSON string literal including its quotes, e.g. `"text_delta"`.
+    /// CLIs emit compact, unescaped ASCII for event types, so a missing marker means the
+    /// event cannot match and decoding is skipped.
+    func decode<Event: Decodable>(
+        _ type: Event.Type,
+        from line: Data,
+        requiringMarker marker: StaticString
+    )
+        -> Event? {
+        guard Self.line(line, contains: marker) else { return nil }
+        return decode(type, from: line)
+    }
+
+    /// Returns whether `line` contains the UTF-8 bytes of `marker`.
+    static func line(_ line: Data, contains marker: StaticString) -> Bool {
+        line.withUnsafeBytes { bytes in
+            guard let base = bytes.baseAddress, marker.utf8CodeUnitCount > 0 else { return false }
+            return memmem(base, bytes.count, marker.utf8Start, marker.utf8CodeUnitCount) != nil
+        }
+    }
+
+    /// Returns whether `line` starts with the UTF-8 bytes of `prefix`.
+    ///
+    /// Useful for classifying compact CLI events by their leading `{"type":"..."` key
+    /// without decoding them.
+    static func line(_ line: Data, hasPrefix prefix: StaticString) -> Bool {
+        guard prefix.utf8CodeUnitCount > 0, line.count >= prefix.utf8CodeUnitCount else { return false }
+        return line.withUnsafeBytes { bytes in
+            memcmp(bytes.baseAddress!, prefix.utf8Start, prefix.utf8CodeUnitCount) == 0
+        }
+    }
+
+    // MARK: Private
+
+    private let decoder = JSONDecoder()
+}
@@ -0,0 +1,209 @@
+//
+//  AgentCLILineFramer.swift
+//  Easydict
+//
+//  Created by tisfeng on 2026/10/19.
+//  Copyright © 2026 izual. All rights reserved.
+//
+
+import Foundation
+
+// MARK: - AgentCLILineFramer
+
+/// Splits agent CLI stdout into newline-delimited lines without copying the unconsumed tail.
+///
+/// Bytes are appended into one growable buffer with separate read, scan, and write offsets.
+/// Consumed bytes are reclaimed lazily: the pending tail is moved to the front only when
+/// the buffer runs out of room, so each byte is copied at most a constant number of times
+/// and the scan offset guarantees a long partial line is never rescanned for newlines.
+///
+/// Lines are handed out as `Data` views over the internal storage. A view is only valid
+/// inside the `drainLines` callback; copy it (e.g. into a `String`) to keep it.
+///
+/// Not thread-safe. Runners own one framer per run and touch it on their I/O queue only.
+final class AgentCLILineFramer {
+    // MARK: Lifecycle
+
+    init(initialCapacity: Int = 16 * 1024) {
+        self.capacity = max(initialCapacity, 64)
+        self.storage = .allocate(byteCount: capacity, alignment: 1)
+    }
+
+    deinit {
+        storage.deallocate()
+    }
+
+    // MARK: Internal
+
+    /// Number of buffered bytes that have not been handed out as a line yet.
+    var pendingByteCount: Int {
+        writeIndex - readIndex
+    }
+
+    /// Appends raw bytes read from the pipe.
+    func append(_ data: Data) {
+        guard !data.isEmpty else { return }
+        reserveCapacity(for: data.count)
+        data.withUnsafeBytes { bytes in
+            (storage + writeIndex).copyMemory(from: bytes.baseAddress!, byteCount: bytes.count)
+        }
+        writeIndex += data.count
+    }
+
+    /// Calls `body` for every complete, non-empty line, excluding the trailing newline.
+    ///
+    /// Splits on the 0x0A byte, which is safe because newline is a single byte in UTF-8;
+    /// multi-byte sequences never contain 0x0A.
+    ///
+    /// - Parameter includeRemainder: When `true`, bytes after the last newline are also
+    ///   delivered as a final line. Pass `true` only after all pipe data has been read.
+    func drainLines(includeRemainder: Bool = false, _ body: (Data) -> ()) {
+        while scanIndex < writeIndex {
+            let remaining = writeIndex - scanIndex
+            guard let newline = memchr(storage + scanIndex, 0x0A, remaining) else {
+                scanIndex = writeIndex
+                break
+            }
+            let newlineIndex = storage.distance(to: newline)
+            deliverLine(upTo: newlineIndex, body)
+            readIndex = newlineIndex + 1
+            scanIndex = readIndex
+        }
+
+        if includeRemainder, readIndex < writeIndex {
+            deliverLine(upTo: writeIndex, body)
+            readIndex = writeIndex
+            scanIndex = writeIndex
+        }
+
+        if readIndex == writeIndex {
+            readIndex = 0
+            scanIndex = 0
+            writeIndex = 0
+        }
+    }
+
+    // MARK: Private
+
+    private var storage: UnsafeMutableRawPointer
+    private var capacity: Int
+    /// Start of the first byte not yet handed out.
+    private var readIndex = 0
+    /// Bytes in `readIndex ..< scanIndex` are known to contain no newline.
+    private var scanIndex = 0
+    /// End of the buffered bytes.
+    private var writeIndex = 0
+
+    private func deliverLine(upTo endIndex: Int, _ body: (Data) -> ()) {
+        let count = endIndex - readIndex
+        guard count > 0 else { return }
+        let line = Data(bytesNoCopy: storage + readIndex, count: count, deallocator: .none)
+        body(line)
+    }
+
+    /// Makes room for `count` more bytes, compacting before growing.
+    private func reserveCapacity(for count: Int) {
+        guard writeIndex + count > capacity else { return }
+
+        let pendingCount = writeIndex - readIndex
+        if readIndex > 0 {
+            storage.copyMemory(from: storage + readIndex, byteCount: pendingCount)
+            scanIndex -= readIndex
+            readIndex = 0
+            writeIndex = pendingCount
+        }
+
+        let requiredCapacity = pendingCount + count
+        guard requiredCapacity > capacity else { return }
+
+        var newCapacity = capacity * 2
+        while newCapacity < requiredCapacity {
+            newCapacity *= 2
+        }
+        let newStorage = UnsafeMutableRawPointer.allocate(byteCount: newCapacity, alignment: 1)
+        newStorage.copyMemory(from: storage, byteCount: pendingCount)
+        storage.deallocate()
+        storage = newStorage
+        capacity = newCapacity
+    }
+}
+
+// MARK: - AgentCLITailBuffer
+
+/// Capped ring buffer that keeps the most recent bytes of a stream.
+///
+/// Used for CLI stderr, which is only decoded once after the process exits and is usually
+/// tiny. Storage grows with the bytes actually received until it reaches `capacity`;
+/// from then on older bytes are overwritten in place without reallocating or shifting,
+/// and `data` linearizes the ring a single time.
+final class AgentCLITailBuffer {
+    // MARK: Lifecycle
+
+    /// The default 1 MB cap prevents unbounded growth if the CLI emits large error payloads;
+    /// nothing is allocated up front.
+    init(capacity: Int = 1_048_576) {
+        self.capacity = max(capacity, 1)
+    }
+
+    // MARK: Internal
+
+    let capacity: Int
+
+    /// Number of retained bytes, at most `capacity`.
+    private(set) var count = 0
+
+    /// The retained bytes in arrival order.
+    var data: Data {
+        guard count > 0 else { return Data() }
+        let start = (writeIndex - count + capacity) % capacity
+        if start + count <= capacity {
+            return Data(storage[start ..< start + count])
+        }
+        var result = Data(capacity: count)
+        result.append(contentsOf: storage[start ..< capacity])
+        result.append(contentsOf: storage[0 ..< writeIndex])
+        return result
+    }
+
+    func append(_ data: Data) {
+        guard !data.isEmpty else { return }
+
+        // Only the last `capacity` bytes of an oversized chunk can survive.
+        var bytes = data.count > capacity ? data.suffix(capacity) : data[...]
+
+        // Grow until the cap is reached, then wrap around.
+        if storage.count < capacity {
+            let growCount = min(bytes.count, capacity - storage.count)
+            storage.append(contentsOf: bytes.prefix(growCount))
+            count = storage.count
+            writeIndex = storage.count % capacity
+            bytes = bytes.dropFirst(growCount)
+            guard !bytes.isEmpty else { return }
+        }
+        overwriteOldest(with: bytes)
+    }
+
+    // MARK: Private
+
+    private var storage: [UInt8] = []
+    private var writeIndex = 0
+
+    /// Writes `bytes` over the oldest ones, once `storage` holds `capacity` bytes.
+    private func overwriteOldest(with bytes: Data) {
+        storage.withUnsafeMutableBytes { ring in
+            bytes.withUnsafeBytes { source in
+                let firstCount = min(source.count, capacity - writeIndex)
+                ring.baseAddress!.advanced(by: writeIndex)
+                    .copyMemory(from: source.baseAddress!, byteCount: firstCount)
+                if firstCount < source.count {
+                    ring.baseAddress!.copyMemory(
+                        from: source.baseAddress!.advanced(by: firstCount),
+                        byteCount: source.count - firstCount
+                    )
+                }
+            }
+        }
+        writeIndex = (writeIndex + bytes.count) % capacity
+        count = min(count + bytes.count, capacity)
+    }
+}
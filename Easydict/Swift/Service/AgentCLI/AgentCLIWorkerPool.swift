@@ -0,0 +1,339 @@
+//
+//  AgentCLIWorkerPool.swift
+//  Easydict
+//
+//  Created by tisfeng on 2026/10/19.
+//  Copyright © 2026 izual. All rights reserved.
+//
+
+import AppKit
+import Combine
+import Defaults
+import Foundation
+
+// MARK: - AgentCLIWorkerConfiguration
+
+/// Identifies interchangeable CLI workers.
+///
+/// Two requests can share warm workers only when the executable, arguments, working
+/// directory, and environment are identical; the prompt itself is always sent on stdin.
+/// The environment is part of the key so a changed API key or proxy in the user's
+/// settings never reaches a worker launched with the old values.
+struct AgentCLIWorkerConfiguration: Hashable, Sendable {
+    let executablePath: String
+    let arguments: [String]
+    let workingDirectory: String
+    let environment: [String: String]
+}
+
+// MARK: - AgentCLIWorker
+
+/// One agent CLI subprocess together with its stdio pipes.
+///
+/// Warm workers are launched ahead of time and block on stdin until a prompt arrives,
+/// so the CLI's own startup (runtime boot, config loading, auth checks) happens off
+/// the query's critical path. Cold workers are created on demand and launched by the runner.
+///
+/// Both `codex exec` and `claude -p` exit after answering one prompt, so a worker is
+/// single-use: once checked out it belongs to exactly one runner.
+final class AgentCLIWorker: @unchecked Sendable {
+    // MARK: Lifecycle
+
+    init(configuration: AgentCLIWorkerConfiguration) {
+        self.configuration = configuration
+
+        process.executableURL = URL(fileURLWithPath: configuration.executablePath)
+        process.arguments = configuration.arguments
+        process.standardInput = stdinPipe
+        process.standardOutput = stdoutPipe
+        process.standardError = stderrPipe
+        process.currentDirectoryURL = URL(fileURLWithPath: configuration.workingDirectory)
+        process.environment = configuration.environment
+        process.terminationHandler = { [weak self] terminatedProcess in
+            self?.didTerminate(terminatedProcess)
+        }
+    }
+
+    // MARK: Internal
+
+    let configuration: AgentCLIWorkerConfiguration
+    let process = Process()
+    let stdinPipe = Pipe()
+    let stdoutPipe = Pipe()
+    let stderrPipe = Pipe()
+
+    /// Time the subprocess was launched, `nil` until `launchIfNeeded()` succeeds.
+    private(set) var launchDate: Date?
+
+    /// Whether the subprocess is launched and still waiting for its prompt.
+    var isAvailable: Bool {
+        stateLock.withLock { launchDate != nil && !isTerminated } && process.isRunning
+    }
+
+    /// Launches the subprocess unless it is already running.
+    func launchIfNeeded() throws {
+        guard stateLock.withLock({ launchDate == nil }) else { return }
+        try process.run()
+        stateLock.withLock { launchDate = Date() }
+    }
+
+    /// Registers the runner's termination handler.
+    ///
+    /// A warm worker may exit while idle (e.g. the CLI rejected its credentials), so the
+    /// handler is invoked immediately when the process has already terminated.
+    func setTerminationHandler(_ handler: @escaping @Sendable (Process) -> ()) {
+        let alreadyTerminated = stateLock.withLock { () -> Bool in
+            terminationHandler = handler
+            return isTerminated
+        }
+        if alreadyTerminated {
+            handler(process)
+        }
+    }
+
+    /// Terminates the subprocess if it is running.
+    func terminate() {
+        if process.isRunning {
+            process.terminate()
+        }
+    }
+
+    // MARK: Private
+
+    private let stateLock = NSLock()
+    private var isTerminated = false
+    private var terminationHandler: (@Sendable (Process) -> ())?
+
+    private func didTerminate(_ terminatedProcess: Process) {
+        let handler = stateLock.withLock { () -> (@Sendable (Process) -> ())? in
+            isTerminated = true
+            return terminationHandler
+        }
+        handler?(terminatedProcess)
+    }
+}
+
+// MARK: - AgentCLIWorkerPoolStatistics
+
+/// Counters used to compare latency with and without warm workers.
+struct AgentCLIWorkerPoolStatistics: Sendable {
+    var warmCheckouts = 0
+    var coldCheckouts = 0
+    var spawnedWorkers = 0
+    var recycledWorkers = 0
+}
+
+// MARK: - AgentCLIWorkerPool
+
+/// Keeps pre-spawned agent CLI workers per configuration.
+///
+/// `checkout(_:)` hands out a warm worker when one is available and refills the
+/// pool in the background. Workers are recycled when they sit idle longer than
+/// `idleTimeout`, when a request fails, or when `enabledKey` is turned off in settings.
+/// Only the most recently used `maxConfigurationCount` configurations are kept warm,
+/// because prompts that vary per language pair produce different CLI arguments.
+final class AgentCLIWorkerPool: @unchecked Sendable {
+    // MARK: Lifecycle
+
+    init(
+        name: String,
+        enabledKey: Defaults.Key<Bool>,
+        warmWorkerCount: Int = 1,
+        idleTimeout: TimeInterval = 300,
+        maxConfigurationCount: Int = 4
+    ) {
+        self.name = name
+        self.enabledKey = enabledKey
+        self.warmWorkerCount = warmWorkerCount
+        self.idleTimeout = idleTimeout
+        self.maxConfigurationCount = maxConfigurationCount
+        self.queue = DispatchQueue(label: "\(name)-worker-pool", qos: .utility)
+
+        enabledCancellable = Defaults.publisher(enabledKey, options: [])
+            .sink { [weak self] change in
+                if !change.newValue {
+                    self?.drain()
+                }
+            }
+
+        // Idle workers block on stdin; terminate them so they do not outlive the app.
+        terminationObserver = NotificationCenter.default.addObserver(
+            forName: NSApplication.willTerminateNotification,
+            object: nil,
+            queue: nil
+        ) { [weak self] _ in
+            self?.drain()
+        }
+    }
+
+    deinit {
+        if let terminationObserver {
+            NotificationCenter.default.removeObserver(terminationObserver)
+        }
+        drain()
+    }
+
+    // MARK: Internal
+
+    let name: String
+
+    /// Whether runners should check workers out of the pool instead of spawning directly.
+    var isEnabled: Bool {
+        Defaults[enabledKey]
+    }
+
+    var statistics: AgentCLIWorkerPoolStatistics {
+        lock.withLock { currentStatistics }
+    }
+
+    /// Returns a worker for the configuration, preferring an already launched one.
+    ///
+    /// The returned worker is either running and waiting on stdin (warm) or not yet
+    /// launched (cold); callers should always call `launchIfNeeded()`.
+    func checkout(_ configuration: AgentCLIWorkerConfiguration) -> AgentCLIWorker {
+        let warmWorker = lock.withLock { () -> AgentCLIWorker? in
+            touch(configuration)
+            var workers = idleWorkers[configuration] ?? []
+            var available: AgentCLIWorker?
+            while !workers.isEmpty {
+                let worker = workers.removeFirst()
+                if worker.isAvailable {
+                    available = worker
+                    break
+                }
+            }
+            idleWorkers[configuration] = workers
+
+            if available != nil {
+                currentStatistics.warmCheckouts += 1
+            } else {
+                currentStatistics.coldCheckouts += 1
+            }
+            return available
+        }
+
+        queue.async { [weak self] in
+            self?.refill(configuration)
+        }
+
+        if let warmWorker {
+            logInfo("\(name) checked out warm worker (pid \(warmWorker.process.processIdentifier))")
+            return warmWorker
+        }
+        return AgentCLIWorker(configuration: configuration)
+    }
+
+    /// Launches warm workers for a configuration without checking one out.
+    func prewarm(_ configuration: AgentCLIWorkerConfiguration) {
+        lock.withLock { touch(configuration) }
+        queue.async { [weak self] in
+            self?.refill(configuration)
+        }
+    }
+
+    /// Terminates idle workers of a configuration, e.g. after a request failed.
+    ///
+    /// The pool is refilled on the next checkout, so a persistent failure such as a
+    /// logged-out CLI does not keep respawning workers in the background.
+    func recycle(_ configuration: AgentCLIWorkerConfiguration) {
+        let workers = lock.withLock { () -> [AgentCLIWorker] in
+            let workers = idleWorkers.removeValue(forKey: configuration) ?? []
+            recentConfigurations.removeAll { $0 == configuration }
+            currentStatistics.recycledWorkers += workers.count
+            return workers
+        }
+        workers.forEach { $0.terminate() }
+    }
+
+    /// Terminates every idle worker.
+    func drain() {
+        let workers = lock.withLock { () -> [AgentCLIWorker] in
+            let workers = idleWorkers.values.flatMap { $0 }
+            idleWorkers.removeAll()
+            recentConfigurations.removeAll()
+            currentStatistics.recycledWorkers += workers.count
+            return workers
+        }
+        workers.forEach { $0.terminate() }
+    }
+
+    // MARK: Private
+
+    private let enabledKey: Defaults.Key<Bool>
+    private let warmWorkerCount: Int
+    private let idleTimeout: TimeInterval
+    private let maxConfigurationCount: Int
+    private let queue: DispatchQueue
+    private let lock = NSLock()
+
+    private var idleWorkers: [AgentCLIWorkerConfiguration: [AgentCLIWorker]] = [:]
+    /// Most recently used configuration last. Always access under `lock`.
+    private var recentConfigurations: [AgentCLIWorkerConfiguration] = []
+    private var currentStatistics = AgentCLIWorkerPoolStatistics()
+    private var enabledCancellable: AnyCancellable?
+    private var terminationObserver: NSObjectProtocol?
+
+    /// Marks a configuration as recently used and evicts the least recently used ones.
+    /// Must be called under `lock`.
+    private func touch(_ configuration: AgentCLIWorkerConfiguration) {
+        recentConfigurations.removeAll { $0 == configuration }
+        recentConfigurations.append(configuration)
+
+        while recentConfigurations.count > maxConfigurationCount {
+            let evicted = recentConfigurations.removeFirst()
+            let workers = idleWorkers.removeValue(forKey: evicted) ?? []
+            currentStatistics.recycledWorkers += workers.count
+            workers.forEach { $0.terminate() }
+        }
+    }
+
+    /// Launches workers until the configuration has `warmWorkerCount` idle workers.
+    private func refill(_ configuration: AgentCLIWorkerConfiguration) {
+        guard isEnabled else { return }
+
+        while true {
+            let missingCount = lock.withLock { () -> Int in
+                guard recentConfigurations.contains(configuration) else { return 0 }
+                let liveWorkers = (idleWorkers[configuration] ?? []).filter(\.isAvailable)
+                idleWorkers[configuration] = liveWorkers
+                return warmWorkerCount - liveWorkers.count
+            }
+            guard missingCount > 0 else { return }
+
+            let worker = AgentCLIWorker(configuration: configuration)
+            do {
+                try worker.launchIfNeeded()
+            } catch {
+                logError("\(name) failed to launch warm worker: \(error)")
+                return
+            }
+
+            lock.withLock {
+                idleWorkers[configuration, default: []].append(worker)
+                currentStatistics.spawnedWorkers += 1
+            }
+            scheduleIdleTimeout(for: worker)
+        }
+    }
+
+    private func scheduleIdleTimeout(for worker: AgentCLIWorker) {
+        queue.asyncAfter(deadline: .now() + idleTimeout) { [weak self, weak worker] in
+            guard let self, let worker else { return }
+            let isIdle = lock.withLock { () -> Bool in
+                guard var workers = idleWorkers[worker.configuration],
+                      let index = workers.firstIndex(where: { $0 === worker })
+                else {
+                    return false
+                }
+                workers.remove(at: index)
+                idleWorkers[worker.configuration] = workers
+                currentStatistics.recycledWorkers += 1
+                return true
+            }
+            if isIdle {
+                logInfo("\(name) recycled idle worker (pid \(worker.process.processIdentifier))")
+                worker.terminate()
+            }
+        }
+    }
+}
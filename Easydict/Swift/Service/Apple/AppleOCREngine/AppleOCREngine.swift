@@ -65,7 +65,8 @@ public class AppleOCREngine: NSObject {
         let startTime = CFAbsoluteTimeGetCurrent()
 
         // Perform Vision OCR using unified API
-        let observations = try await performVisionOCR(on: cgImage, language: language)
+        let tiler = MyConfiguration.shared.enableTiledOCR ? imageTiler : nil
+        let observations = try await recognizeObservations(in: cgImage, language: language, tiler: tiler)
 
         logInfo("Recognize observations count: \(observations.count) (\(language))")
         logInfo("Cost time: \(startTime.elapsedTimeString) seconds")
@@ -132,6 +133,42 @@ public class AppleOCREngine: NSObject {
         return mostConfidentResult
     }
 
+    /// Recognizes the text observations of `cgImage`, normalized to the whole image.
+    ///
+    /// With a `tiler`, an image taller than its `minTiledHeight` is split into overlapping
+    /// horizontal bands that are recognized concurrently, then merged back into one list,
+    /// so `OCRTextProcessor` receives the same kind of input as for a single pass.
+    /// Vision recognizes an image on one core, so tiling cuts the latency of full-screen captures.
+    func recognizeObservations(
+        in cgImage: CGImage,
+        language: Language = .auto,
+        tiler: OCRImageTiler? = nil
+    ) async throws
+        -> [EZRecognizedTextObservation] {
+        let tileRects = tiler?.tileRects(width: cgImage.width, height: cgImage.height) ?? []
+        guard let tiler, tileRects.count > 1 else {
+            return try await performVisionOCR(on: cgImage, language: language)
+        }
+
+        logInfo("Recognizing \(tileRects.count) tiles, image size: \(cgImage.width)x\(cgImage.height)")
+
+        var observations = try await recognizeTiles(of: cgImage, tileRects: tileRects, tiler: tiler, language: language)
+
+        // Tiles skip the Japanese retry, since a blank margin tile would trigger it;
+        // like a single pass, retry only when the whole image yields nothing.
+        if observations.isEmpty, language == .auto {
+            logInfo("No text recognized in any tile with auto language, retrying with Japanese.")
+            observations = try await recognizeTiles(
+                of: cgImage, tileRects: tileRects, tiler: tiler, language: .japanese
+            )
+        }
+
+        if observations.isEmpty {
+            throw QueryError.error(type: .noResult, message: String(localized: "ocr_result_is_empty"))
+        }
+        return observations
+    }
+
     func pasteboardOCR() {
         logInfo("Pasteboard OCR")
         if let image = NSPasteboard.general.image {
@@ -186,6 +223,50 @@ public class AppleOCREngine: NSObject {
     /// Language detector used for tie-breaking when confidences are equal.
     private let languageDetector = AppleLanguageDetector()
 
+    /// Splits tall images into bands when `enableTiledOCR` is on.
+    private let imageTiler = OCRImageTiler()
+
+    /// Recognizes `tileRects` of `cgImage` concurrently and merges their observations.
+    private func recognizeTiles(
+        of cgImage: CGImage,
+        tileRects: [CGRect],
+        tiler: OCRImageTiler,
+        language: Language
+    ) async throws
+        -> [EZRecognizedTextObservation] {
+        let tileObservations = try await withThrowingTaskGroup(
+            of: (Int, [EZRecognizedTextObservation]).self
+        ) { group in
+            for (index, tileRect) in tileRects.enumerated() {
+                guard let tileImage = cgImage.cropping(to: tileRect) else {
+                    throw QueryError.error(type: .parameter, message: "Failed to crop OCR tile: \(tileRect)")
+                }
+                group.addTask {
+                    try await (index, self.recognizeTile(tileImage, language: language))
+                }
+            }
+
+            var collected = [[EZRecognizedTextObservation]](repeating: [], count: tileRects.count)
+            for try await (index, observations) in group {
+                collected[index] = observations
+            }
+            return collected
+        }
+
+        return tiler.merge(tileObservations, tileRects: tileRects, imageHeight: cgImage.height)
+    }
+
+    /// Recognizes one tile of a tiled image, without the Japanese retry. A tile without text,
+    /// such as a blank margin, yields no observations instead of failing the whole image.
+    private func recognizeTile(_ tileImage: CGImage, language: Language) async throws
+        -> [EZRecognizedTextObservation] {
+        do {
+            return try await performVisionOCR(on: tileImage, language: language, retriesWithJapanese: false)
+        } catch let error as QueryError where error.type == .noResult {
+            return []
+        }
+    }
+
     /// The core async method that executes a `VNRecognizeTextRequest` on a given `CGImage`.
     ///
     /// This function configures the Vision request based on the specified language and accuracy level,
@@ -194,11 +275,15 @@ public class AppleOCREngine: NSObject {
     /// - Parameters:
     ///   - cgImage: The `CGImage` to perform OCR on.
     ///   - language: The preferred `Language` for recognition. If not a valid OCR language, defaults to automatic detection.
+    ///   - retriesWithJapanese: Whether an empty `.auto` result is retried with Japanese.
     /// - Returns: Array of `VNRecognizedTextObservation` objects containing recognition results.
     ///
     /// - Warning: Call this function on macOS 15.0+ will crash https://github.com/tisfeng/Easydict/issues/915
-    private func performLegacyVisionOCR(on cgImage: CGImage, language: Language = .auto)
-        async throws
+    private func performLegacyVisionOCR(
+        on cgImage: CGImage,
+        language: Language = .auto,
+        retriesWithJapanese: Bool = true
+    ) async throws
         -> [VNRecognizedTextObservation] {
         // Try primary OCR first
         let observations = try await performSingleLegacyVisionOCR(on: cgImage, language: language)
@@ -214,7 +299,7 @@ public class AppleOCREngine: NSObject {
          -----------------------------------------------------------
          */
 
-        if observations.isEmpty, language == .auto {
+        if observations.isEmpty, language == .auto, retriesWithJapanese {
             logInfo("No text recognized with auto language, retrying with Japanese.")
             return try await performSingleLegacyVisionOCR(on: cgImage, language: .japanese)
         }
@@ -417,7 +502,11 @@ public class AppleOCREngine: NSObject {
     ///   - cgImage: The `CGImage` to perform OCR on.
     ///   - language: The preferred `Language` for recognition. Defaults to `.auto`.
     /// - Returns: Array of `EZRecognizedTextObservation` objects containing unified recognition results.
-    private func performVisionOCR(on cgImage: CGImage, language: Language = .auto) async throws
+    private func performVisionOCR(
+        on cgImage: CGImage,
+        language: Language = .auto,
+        retriesWithJapanese: Bool = true
+    ) async throws
         -> [EZRecognizedTextObservation] {
         // `performModernVisionOCR` is supported on macOS 15.0+, but it seems not working in actual tests.
         // So we only use it on macOS 26.0+ for now.
@@ -425,13 +514,13 @@ public class AppleOCREngine: NSObject {
         if #available(macOS 26.0, *) {
             logInfo("Using modern RecognizeTextRequest API")
             let modernObservations = try await performModernVisionOCR(
-                on: cgImage, language: language
+                on: cgImage, language: language, retriesWithJapanese: retriesWithJapanese
             )
             return modernObservations.toEZRecognizedTextObservations()
         } else {
             logInfo("Using legacy VNRecognizeTextRequest API")
             let legacyObservations = try await performLegacyVisionOCR(
-                on: cgImage, language: language
+                on: cgImage, language: language, retriesWithJapanese: retriesWithJapanese
             )
             return legacyObservations.toEZRecognizedTextObservations()
         }
@@ -440,13 +529,16 @@ public class AppleOCREngine: NSObject {
     // MARK: - Modern API Implementation (macOS 15.0+)
 
     @available(macOS 15.0, *)
-    private func performModernVisionOCR(on cgImage: CGImage, language: Language = .auto)
-        async throws
+    private func performModernVisionOCR(
+        on cgImage: CGImage,
+        language: Language = .auto,
+        retriesWithJapanese: Bool = true
+    ) async throws
         -> [RecognizedTextObservation] {
         // Try primary OCR first
         let observations = try await performSingleModernVisionOCR(on: cgImage, language: language)
 
-        if observations.isEmpty, language == .auto {
+        if observations.isEmpty, language == .auto, retriesWithJapanese {
             logInfo("No text recognized with auto language, retrying with Japanese.")
             return try await performSingleModernVisionOCR(on: cgImage, language: .japanese)
         }
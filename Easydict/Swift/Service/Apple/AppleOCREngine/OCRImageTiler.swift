@@ -0,0 +1,133 @@
+//
+//  OCRImageTiler.swift
+//  Easydict
+//
+//  Created by tisfeng on 2026/10/19.
+//  Copyright © 2026 izual. All rights reserved.
+//
+
+import CoreGraphics
+import Foundation
+
+// MARK: - OCRImageTiler
+
+/// Splits tall images into overlapping horizontal tiles for concurrent OCR, and merges the
+/// observations of the tiles back into one list in image coordinates.
+///
+/// Vision recognizes one image on a single core, so a full-screen capture takes seconds.
+/// Tiles span the full image width and overlap by more than a text line, so every line lies
+/// completely inside at least one tile. Each tile owns the part of the image closer to its
+/// own center than to a neighbor's, up to the middle of the overlaps. An observation is kept
+/// only by the tile owning its vertical center, which drops both the duplicates and the lines
+/// cut at a tile edge.
+struct OCRImageTiler {
+    // MARK: Internal
+
+    /// Images up to this height, in pixels, are recognized in one piece.
+    var minTiledHeight = 1600
+    /// Height of a tile, in pixels, including its overlaps.
+    var tileHeight = 1000
+    /// Height shared by neighboring tiles, in pixels. Must exceed the tallest text line.
+    var overlap = 200
+
+    /// Returns the tile rects of an image, top to bottom, in pixel coordinates with a top-left
+    /// origin as used by `CGImage.cropping(to:)`. Returns one rect for images that are not tiled.
+    func tileRects(width: Int, height: Int) -> [CGRect] {
+        let fullRect = CGRect(x: 0, y: 0, width: width, height: height)
+        guard height > minTiledHeight, tileHeight > overlap else {
+            return [fullRect]
+        }
+
+        let stride = tileHeight - overlap
+        let tileCount = Int((Double(height - overlap) / Double(stride)).rounded(.up))
+        // Spreads the tiles evenly, so the last one is not a thin strip.
+        let evenStride = Double(height - overlap) / Double(tileCount)
+        let evenHeight = Int((evenStride + Double(overlap)).rounded(.up))
+
+        return (0 ..< tileCount).map { index in
+            let minY = Int((Double(index) * evenStride).rounded(.down))
+            return CGRect(x: 0, y: minY, width: width, height: min(evenHeight, height - minY))
+        }
+    }
+
+    /// Merges the observations of each tile, in `tileRects` order, into one list in the
+    /// normalized coordinates of the whole image.
+    ///
+    /// - Parameters:
+    ///   - tileObservations: Observations of each tile, normalized to the tile as Vision reports them.
+    ///   - tileRects: The rects returned by `tileRects(width:height:)`.
+    ///   - imageHeight: Height of the whole image, in pixels.
+    func merge(
+        _ tileObservations: [[EZRecognizedTextObservation]],
+        tileRects: [CGRect],
+        imageHeight: Int
+    )
+        -> [EZRecognizedTextObservation] {
+        guard tileRects.count > 1 else {
+            return tileObservations.first ?? []
+        }
+
+        let height = CGFloat(imageHeight)
+        var merged: [EZRecognizedTextObservation] = []
+
+        for (index, tileRect) in tileRects.enumerated() where index < tileObservations.count {
+            // Owned range, in pixels from the top, ends halfway through each overlap.
+            let ownedTop = index == 0 ? 0 : (tileRect.minY + tileRects[index - 1].maxY) / 2
+            let ownedBottom = index == tileRects.count - 1 ? height : (tileRect.maxY + tileRects[index + 1].minY) / 2
+
+            for observation in tileObservations[index] {
+                let mapped = observation.mapped(fromTile: tileRect, imageHeight: height)
+                let centerFromTop = (1 - mapped.boundingBox.midY) * height
+                guard centerFromTop >= ownedTop, centerFromTop < ownedBottom else { continue }
+
+                // Vision can split one line differently in two tiles; keep the first copy.
+                let isDuplicate = merged.contains { kept in
+                    kept.firstText == mapped.firstText
+                        && kept.boundingBox.intersectionOverUnion(with: mapped.boundingBox) > 0.5
+                }
+                if !isDuplicate {
+                    merged.append(mapped)
+                }
+            }
+        }
+        return merged
+    }
+}
+
+// MARK: - EZRecognizedTextObservation + Tile Mapping
+
+extension EZRecognizedTextObservation {
+    /// Converts an observation normalized to a tile into the normalized coordinates of the
+    /// whole image. Vision coordinates have a bottom-left origin; `tileRect` has a top-left one.
+    fileprivate func mapped(fromTile tileRect: CGRect, imageHeight: CGFloat) -> EZRecognizedTextObservation {
+        let tileMinY = (imageHeight - tileRect.maxY) / imageHeight
+        let tileScale = tileRect.height / imageHeight
+
+        func map(_ point: CGPoint) -> CGPoint {
+            CGPoint(x: point.x, y: tileMinY + point.y * tileScale)
+        }
+
+        return EZRecognizedTextObservation(
+            topLeft: map(topLeft),
+            topRight: map(topRight),
+            bottomRight: map(bottomRight),
+            bottomLeft: map(bottomLeft),
+            uuid: uuid,
+            confidence: confidence,
+            topCandidates: topCandidates
+        )
+    }
+}
+
+// MARK: - CGRect + Intersection Over Union
+
+extension CGRect {
+    /// Area of the intersection divided by the area of the union, 0 for disjoint rects.
+    fileprivate func intersectionOverUnion(with other: CGRect) -> CGFloat {
+        let overlapRect = intersection(other)
+        guard !overlapRect.isNull, overlapRect.width > 0, overlapRect.height > 0 else { return 0 }
+        let intersectionArea = overlapRect.width * overlapRect.height
+        let unionArea = width * height + other.width * other.height - intersectionArea
+        return unionArea > 0 ? intersectionArea / unionArea : 0
+    }
+}
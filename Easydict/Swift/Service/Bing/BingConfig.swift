@@ -69,27 +69,43 @@ class BingConfig: NSObject, Codable {
 
     // MARK: - Methods
 
-    func isBingTokenExpired() -> Bool {
-        guard let key else {
-            return true
-        }
+    /// When the token should be replaced, `nil` if there is no token.
+    ///
+    /// `key` is the token's creation time in milliseconds. expirationInterval is 3600000 ms,
+    /// 3600000/1000/60 = 60 mins. Default expiration is 60 mins, for better experience, we
+    /// get a new token after 30 min.
+    var tokenRefreshDate: Date? {
+        guard let key else { return nil }
 
         let tokenStart = Double(key) ?? 0
+        let expirationIntervalValue = Double(expirationInterval ?? "3600000") ?? 3600000
+        return Date(timeIntervalSince1970: (tokenStart + expirationIntervalValue / 2) / 1000)
+    }
 
-        // Convert to millisecond
-        let now = Date().timeIntervalSince1970 * 1000
+    func isBingTokenExpired() -> Bool {
+        guard let tokenRefreshDate else {
+            return true
+        }
 
-        /// expirationInterval is 3600000 ms, 3600000/1000/60 = 60 mins
-        /// Default expiration is 60 mins, for better experience, we get a new token after 30 min.
-        let tokenUsedTime = now - tokenStart
-        let expirationIntervalValue = Double(expirationInterval ?? "3600000") ?? 3600000
-        let isExpired = tokenUsedTime > expirationIntervalValue / 2
+        let isExpired = Date() > tokenRefreshDate
 
         logInfo("is Bing token expired: \(isExpired ? "YES" : "NO")")
 
         return isExpired
     }
 
+    /// Returns an independent copy, as handed out by `BingTokenManager.config`.
+    func snapshot() -> BingConfig {
+        let config = BingConfig()
+        config.IG = IG
+        config.IID = IID
+        config.key = key
+        config.token = token
+        config.expirationInterval = expirationInterval
+        config.host = host
+        return config
+    }
+
     func resetToken() {
         IID = nil
         IG = nil
@@ -26,15 +26,20 @@ typealias BingTranslateCompletion = (
 class BingRequest {
     // MARK: Lifecycle
 
-    init() {
-        self.bingConfig = BingConfig.loadFromUserDefaults()
+    /// `service` gates hedging through `QueryService.isRequestHedgingEnabled`.
+    init(service: QueryService) {
+        self.service = service
     }
 
     // MARK: Internal
 
     // MARK: - Public Properties
 
-    private(set) var bingConfig: BingConfig
+    /// A copy of the config shared by all Bing services, see `BingTokenManager`.
+    /// Host and token changes go through the manager.
+    var bingConfig: BingConfig {
+        tokenManager.config
+    }
 
     // MARK: - Public Methods
 
@@ -63,11 +68,13 @@ class BingRequest {
                     return
                 }
 
+                // One copy for the whole query, so its token and URLs match.
+                let config = bingConfig
                 let parameters: [String: Any] = [
                     "text": text,
                     "to": to,
-                    "token": bingConfig.token ?? "",
-                    "key": bingConfig.key ?? "",
+                    "token": config.token ?? "",
+                    "key": config.key ?? "",
                 ]
 
                 // Get translate data
@@ -75,10 +82,12 @@ class BingRequest {
                 translateParameters["fromLang"] = from
                 translateParameters["tryFetchingGenderDebiasedTranslations"] = "true"
 
-                let translateRequest = makeTranslateRequest(
-                    url: bingConfig.ttranslatev3URLString,
-                    parameters: translateParameters
-                )
+                let translateRequest = hedgedRequest {
+                    self.makeTranslateRequest(
+                        url: config.ttranslatev3URLString,
+                        parameters: translateParameters
+                    )
+                }
                 translateRequest.responseData { [weak self] response in
                     guard let self = self else { return }
                     untrackRequest(translateRequest)
@@ -122,10 +131,12 @@ class BingRequest {
                 var dictParameters = parameters
                 dictParameters["from"] = from
 
-                let lookupRequest = makeTranslateRequest(
-                    url: bingConfig.tlookupv3URLString,
-                    parameters: dictParameters
-                )
+                let lookupRequest = hedgedRequest {
+                    self.makeTranslateRequest(
+                        url: config.tlookupv3URLString,
+                        parameters: dictParameters
+                    )
+                }
                 lookupRequest.responseData { [weak self] response in
                     guard let self = self else { return }
                     untrackRequest(lookupRequest)
@@ -179,14 +190,15 @@ class BingRequest {
                 }
 
                 let ssml = generateSSML(text: text, language: from, accent: accent)
+                let config = bingConfig
                 let parameters: [String: Any] = [
                     "ssml": ssml,
-                    "token": bingConfig.token ?? "",
-                    "key": bingConfig.key ?? "",
+                    "token": config.token ?? "",
+                    "key": config.key ?? "",
                 ]
 
                 let request = makeTTSRequest(
-                    url: bingConfig.tfetttsURLString,
+                    url: config.tfetttsURLString,
                     parameters: parameters
                 )
                 request.responseData { [weak self] response in
@@ -212,10 +224,9 @@ class BingRequest {
                     }
 
                     // If host has changed, use new host to fetch again.
-                    if let host = response.response?.url?.host, bingConfig.host != host {
+                    if let host = response.response?.url?.host, config.host != host {
                         logInfo("bing host changed: \(host)")
-                        bingConfig.host = host
-                        bingConfig.saveToUserDefaults()
+                        tokenManager.updateHost(host)
 
                         fetchTextToAudio(text: text, fromLanguage: from, accent: accent, completion: completion)
                     } else {
@@ -276,7 +287,7 @@ class BingRequest {
 
     func reset() {
         cancelActiveRequests()
-        bingConfig.resetToken()
+        tokenManager.resetToken()
         resetData()
     }
 
@@ -306,6 +317,9 @@ class BingRequest {
     private var text: String = ""
     private var completion: BingTranslateCompletion?
 
+    private let tokenManager = BingTokenManager.shared
+    private weak var service: QueryService?
+
     private var canRetryFetchHost = true
     private let activeRequestLock = NSLock()
     private var activeRequests: [Request] = []
@@ -323,8 +337,7 @@ class BingRequest {
                lookupData != nil, lookupData?.isEmpty == true {
                 reset()
                 canRetryFetchHost = false
-                bingConfig.host = nil
-                bingConfig.saveToUserDefaults()
+                tokenManager.updateHost(nil)
                 translateText(text: text, from: from, to: to, completionHandler: completion ?? { _, _, _, _ in })
                 return
             }
@@ -338,123 +351,22 @@ class BingRequest {
     }
 
     private func fetchBingHost(callback: @escaping () -> (), failure: @escaping (Error) -> ()) {
-        if bingConfig.host != nil {
-            callback()
-            return
-        }
-
-        // For www.bing.com, sometimes it won't return redirect URL, so we use cn.bing.com
-        let webBingURLString = "http://\(BingConfig.chinaHost)"
-
-        let request = makeTranslateRequest(url: webBingURLString)
-        request.responseData { [weak self] response in
-            guard let self = self else {
-                failure(CancellationError())
-                return
-            }
-            untrackRequest(request)
-
-            if let error = response.error {
-                if isCancelledError(error) {
-                    failure(CancellationError())
-                    return
-                }
-
-                bingConfig.host = BingConfig.chinaHost
-                bingConfig.saveToUserDefaults()
+        tokenManager.fetchHostIfNeeded(isHedgingEnabled: isHedgingEnabled) { error in
+            if let error {
+                failure(error)
+            } else {
                 callback()
-                return
             }
-
-            let host = response.response?.url?.host ?? BingConfig.chinaHost
-            bingConfig.host = host
-            bingConfig.saveToUserDefaults()
-            logInfo("bing host: \(host)")
-            callback()
         }
     }
 
     private func fetchBingConfig(callback: @escaping () -> (), failure: @escaping (Error) -> ()) {
-        if !bingConfig.isBingTokenExpired() {
-            callback()
-            return
-        }
-
-        let url = bingConfig.translatorURLString
-        let request = makeHTMLRequest(url: url)
-        request.responseData { [weak self] response in
-            guard let self = self else {
-                failure(CancellationError())
-                return
-            }
-            untrackRequest(request)
-
-            if let error = response.error {
-                if isCancelledError(error) {
-                    failure(CancellationError())
-                    return
-                }
-                failure(error)
-                return
-            }
-
-            guard let data = response.data else {
-                let error = QueryError(type: .api, message: "bing htmlSession responseObject is not Data")
-                failure(error)
-                return
-            }
-
-            guard let responseString = String(data: data, encoding: .utf8) else {
-                let error = QueryError(type: .api, message: "bing html response string is nil")
-                failure(error)
-                return
-            }
-
-            guard let ig = getIGValue(from: responseString), !ig.isEmpty else {
-                let error = QueryError(type: .api, message: "bing IG is empty")
-                failure(error)
-                return
-            }
-            logInfo("bing IG: \(ig)")
-
-            guard let iid = getDataIidValue(from: responseString), !iid.isEmpty else {
-                let error = QueryError(type: .api, message: "bing IID is empty")
+        tokenManager.ensureToken(isHedgingEnabled: isHedgingEnabled) { error in
+            if let error {
                 failure(error)
-                return
-            }
-            logInfo("bing IID: \(iid)")
-
-            guard let arr = getParamsAbusePreventionHelperArray(from: responseString), arr.count == 3 else {
-                let error = QueryError(type: .api, message: "bing get key and token failed")
-                failure(error)
-                return
-            }
-
-            let key = arr[0]
-            guard !key.isEmpty else {
-                let error = QueryError(type: .api, message: "bing key is empty")
-                failure(error)
-                return
-            }
-
-            let token = arr[1]
-            guard !token.isEmpty else {
-                let error = QueryError(type: .api, message: "bing token is empty")
-                failure(error)
-                return
+            } else {
+                callback()
             }
-            logInfo("bing key: \(key)")
-            logInfo("bing token: \(token)")
-
-            let expirationInterval = arr[2]
-
-            bingConfig.IG = ig
-            bingConfig.IID = iid
-            bingConfig.key = key
-            bingConfig.token = token
-            bingConfig.expirationInterval = expirationInterval
-            bingConfig.saveToUserDefaults()
-            callback()
         }
     }
 
@@ -466,20 +378,6 @@ class BingRequest {
         responseCount = 0
     }
 
-    @discardableResult
-    private func makeHTMLRequest(
-        url: String,
-        parameters: Parameters? = nil
-    )
-        -> DataRequest {
-        makeRequest(
-            url: url,
-            method: .get,
-            parameters: parameters,
-            headers: requestHeaders()
-        )
-    }
-
     @discardableResult
     private func makeTranslateRequest(
         url: String,
@@ -552,8 +450,9 @@ class BingRequest {
             "User-Agent": EZUserAgent,
         ])
 
-        if includeCookie, !bingConfig.cookie.isEmpty {
-            headers.add(name: "Cookie", value: bingConfig.cookie)
+        let cookie = includeCookie ? bingConfig.cookie : ""
+        if !cookie.isEmpty {
+            headers.add(name: "Cookie", value: cookie)
         }
 
         return headers
@@ -569,36 +468,34 @@ class BingRequest {
         activeRequestLock.unlock()
     }
 
-    private func untrackRequest(_ request: Request) {
-        activeRequestLock.lock()
-        activeRequests.removeAll { trackedRequest in
-            trackedRequest.id == request.id
-        }
-        activeRequestLock.unlock()
+    private var isHedgingEnabled: Bool {
+        service?.isRequestHedgingEnabled ?? false
     }
 
-    // MARK: - Regex Helpers
-
-    private func getIGValue(from htmlString: String) -> String? {
-        // IG:"8E24D5A82C3240C8A68683C2484870E6",
-        let pattern = #"IG:\s*"([^"]+)""#
-        return htmlString.getStringValue(withPattern: pattern)
+    /// Wraps a request in a `HedgedDataRequest` when hedged requests are enabled.
+    private func hedgedRequest(
+        alternate: (() -> DataRequest)? = nil,
+        _ makeRequest: @escaping () -> DataRequest
+    )
+        -> HedgedDataRequest {
+        HedgedDataRequest(
+            label: ServiceType.bing.rawValue,
+            isHedgingEnabled: isHedgingEnabled,
+            makeRequest: makeRequest,
+            alternate: alternate
+        )
     }
 
-    private func getParamsAbusePreventionHelperArray(from htmlString: String) -> [String]? {
-        // var params_AbusePreventionHelper = [1693880687457,"0T_WDBmVBWjrlS5lBJPS6KYPLOboyyrf",3600000];
-        let pattern = #"params_AbusePreventionHelper\s*=\s*\[([^\]]+)\]"#
-        guard let arrayString = htmlString.getStringValue(withPattern: pattern) else {
-            return nil
-        }
-        let cleanedString = arrayString.replacingOccurrences(of: "\"", with: "")
-        return cleanedString.components(separatedBy: ",")
+    private func untrackRequest(_ request: HedgedDataRequest) {
+        request.requests.forEach { untrackRequest($0) }
     }
 
-    private func getDataIidValue(from htmlString: String) -> String? {
-        // data-iid="translator.5029"
-        let pattern = #"data-iid\s*=\s*"([^"]+)""#
-        return htmlString.getStringValue(withPattern: pattern)
+    private func untrackRequest(_ request: Request) {
+        activeRequestLock.lock()
+        activeRequests.removeAll { trackedRequest in
+            trackedRequest.id == request.id
+        }
+        activeRequestLock.unlock()
     }
 
     // MARK: - SSML Generation
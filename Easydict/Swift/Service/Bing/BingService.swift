@@ -30,7 +30,7 @@ class BingService: QueryService {
 
     // MARK: - Internal Properties (for extension)
 
-    lazy var bingRequest = BingRequest()
+    lazy var bingRequest = BingRequest(service: self)
     var canRetry = true
     var isDictQueryResult = false
 
@@ -48,6 +48,10 @@ class BingService: QueryService {
         .none
     }
 
+    override func supportsRequestHedging() -> Bool {
+        true
+    }
+
     // MARK: - Query Text Type
 
     override func intelligentQueryTextType() -> EZQueryTextType {
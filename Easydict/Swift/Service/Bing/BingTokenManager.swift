@@ -0,0 +1,392 @@
+//
+//  BingTokenManager.swift
+//  Easydict
+//
+//  Created by tisfeng on 2026/10/19.
+//  Copyright © 2026 izual. All rights reserved.
+//
+
+import Alamofire
+import Foundation
+
+// MARK: - BingTokenManager
+
+/// Owns the shared `BingConfig` and keeps its translator token fresh.
+///
+/// Every `BingRequest` uses the same config, so a host probe or token refresh runs at most
+/// once at a time; concurrent callers wait for the in-flight one instead of scraping the
+/// translator page again. Tokens persist in user defaults, and while Bing is in use the
+/// next refresh is scheduled shortly before the token reaches its refresh date, so queries
+/// rarely wait on the HTML download.
+///
+/// The config is only changed by this manager, under its lock. Callers read a copy through
+/// `config`, and change the host or token through `updateHost(_:)` and `resetToken()`.
+@objc(EZBingTokenManager)
+final class BingTokenManager: NSObject, @unchecked Sendable {
+    // MARK: Lifecycle
+
+    private override init() {
+        self.sharedConfig = BingConfig.loadFromUserDefaults()
+        super.init()
+    }
+
+    // MARK: Internal
+
+    typealias Completion = (Error?) -> ()
+
+    @objc static let shared = BingTokenManager()
+
+    /// A copy of the shared config, so its host, token and URLs are consistent with each other.
+    var config: BingConfig {
+        lock.withLock { sharedConfig.snapshot() }
+    }
+
+    /// Starts background refreshing once per launch, called when the app finishes launching.
+    ///
+    /// A persisted token means Bing has been used before, so a stale one is refreshed right
+    /// away and a fresh one gets its next refresh scheduled.
+    @objc
+    func startIfNeeded() {
+        let (shouldStart, hasToken, isExpired) = lock.withLock {
+            defer { isStarted = true }
+            return (!isStarted, sharedConfig.key != nil, sharedConfig.isBingTokenExpired())
+        }
+        guard shouldStart, hasToken else { return }
+
+        if isExpired {
+            refreshToken { error in
+                if let error {
+                    logError("bing launch token refresh failed: \(error)")
+                }
+            }
+        } else {
+            scheduleRefresh()
+        }
+    }
+
+    /// Resolves the Bing host if it is unknown; concurrent callers share one probe.
+    ///
+    /// `isHedgingEnabled` is the querying service's hedging gate, which the manager's own
+    /// requests follow as well.
+    func fetchHostIfNeeded(isHedgingEnabled: Bool, completion: @escaping Completion) {
+        lock.withLock {
+            self.isHedgingEnabled = isHedgingEnabled
+        }
+        probeHostIfNeeded(completion: completion)
+    }
+
+    /// Calls `completion` once the config holds an unexpired token, refreshing it first
+    /// when needed; concurrent callers share one refresh.
+    func ensureToken(isHedgingEnabled: Bool, completion: @escaping Completion) {
+        let isExpired = lock.withLock {
+            self.isHedgingEnabled = isHedgingEnabled
+            lastUsageDate = Date()
+            return sharedConfig.isBingTokenExpired()
+        }
+
+        guard isExpired else {
+            completion(nil)
+            return
+        }
+        refreshToken(completion: completion)
+    }
+
+    /// Replaces the host, `nil` to probe it again on the next query.
+    func updateHost(_ host: String?) {
+        lock.withLock {
+            sharedConfig.host = host
+            sharedConfig.saveToUserDefaults()
+        }
+    }
+
+    /// Drops the token, so the next query fetches a new one.
+    func resetToken() {
+        lock.withLock {
+            sharedConfig.resetToken()
+        }
+    }
+
+    // MARK: Private
+
+    /// Refresh this long before the token's refresh date.
+    private static let refreshLeadTime: TimeInterval = 60
+    /// Proactive refreshes stop when Bing has not been queried for this long.
+    private static let activeUsageWindow: TimeInterval = 3600
+
+    private let lock = NSLock()
+    /// Guarded by `lock`.
+    private let sharedConfig: BingConfig
+    private var isStarted = false
+    private var hostWaiters: [Completion]?
+    private var tokenWaiters: [Completion]?
+    private var lastUsageDate: Date?
+    /// Hedging gate of the latest query; launch and proactive refreshes reuse it.
+    private var isHedgingEnabled = false
+    private var refreshWorkItem: DispatchWorkItem?
+
+    private func refreshToken(completion: @escaping Completion) {
+        guard enqueue(completion, into: \.tokenWaiters) else { return }
+
+        probeHostIfNeeded { [weak self] error in
+            guard let self else { return }
+            if let error {
+                drain(\.tokenWaiters, error: error)
+                return
+            }
+
+            fetchTranslatorConfig { [weak self] error in
+                guard let self else { return }
+                if error == nil {
+                    scheduleRefresh()
+                }
+                drain(\.tokenWaiters, error: error)
+            }
+        }
+    }
+
+    /// Probes the host if it is unknown, with the hedging gate of the latest query.
+    private func probeHostIfNeeded(completion: @escaping Completion) {
+        let hasHost = lock.withLock {
+            sharedConfig.host != nil
+        }
+        if hasHost {
+            completion(nil)
+            return
+        }
+
+        guard enqueue(completion, into: \.hostWaiters) else { return }
+        probeHost { [weak self] error in
+            self?.drain(\.hostWaiters, error: error)
+        }
+    }
+
+    /// Adds a waiter, returning `true` when the caller should start the work.
+    private func enqueue(
+        _ completion: @escaping Completion,
+        into waiters: ReferenceWritableKeyPath<BingTokenManager, [Completion]?>
+    )
+        -> Bool {
+        lock.withLock {
+            if self[keyPath: waiters] != nil {
+                self[keyPath: waiters]?.append(completion)
+                return false
+            }
+            self[keyPath: waiters] = [completion]
+            return true
+        }
+    }
+
+    private func drain(
+        _ waiters: ReferenceWritableKeyPath<BingTokenManager, [Completion]?>,
+        error: Error?
+    ) {
+        let completions = lock.withLock {
+            defer { self[keyPath: waiters] = nil }
+            return self[keyPath: waiters] ?? []
+        }
+        completions.forEach { $0(error) }
+    }
+
+    private func scheduleRefresh() {
+        guard let refreshDate = lock.withLock({ sharedConfig.tokenRefreshDate }) else { return }
+
+        let delay = max(refreshDate.timeIntervalSinceNow - Self.refreshLeadTime, 0)
+        let workItem = DispatchWorkItem { [weak self] in
+            self?.proactiveRefresh()
+        }
+        let previousWorkItem = lock.withLock {
+            defer { refreshWorkItem = workItem }
+            return refreshWorkItem
+        }
+        previousWorkItem?.cancel()
+        DispatchQueue.main.asyncAfter(deadline: .now() + delay, execute: workItem)
+        logInfo("bing token refresh scheduled in \(Int(delay))s")
+    }
+
+    private func proactiveRefresh() {
+        let isInUse = lock.withLock {
+            guard let lastUsageDate else { return false }
+            return Date().timeIntervalSince(lastUsageDate) < Self.activeUsageWindow
+        }
+        // When idle, let the next query refresh lazily instead of polling Bing.
+        guard isInUse else { return }
+
+        // The current token stays valid meanwhile, so queries do not wait on this refresh.
+        refreshToken { error in
+            if let error {
+                logError("bing proactive token refresh failed: \(error)")
+            }
+        }
+    }
+
+    // MARK: - Network
+
+    private func probeHost(completion: @escaping Completion) {
+        // For www.bing.com, sometimes it won't return redirect URL, so we use cn.bing.com
+        let webBingURLString = "http://\(BingConfig.chinaHost)"
+
+        // If cn.bing.com stalls, www.bing.com is tried as the hedged alternate.
+        let request = hedgedRequest(
+            alternate: { self.makeRequest(url: "https://\(BingConfig.defaultHost)", includeCookie: true) },
+            { self.makeRequest(url: webBingURLString, includeCookie: true) }
+        )
+        request.responseData { [weak self] response in
+            guard let self else {
+                completion(CancellationError())
+                return
+            }
+
+            if let error = response.error {
+                if isCancelledError(error) {
+                    completion(CancellationError())
+                    return
+                }
+
+                updateHost(BingConfig.chinaHost)
+                completion(nil)
+                return
+            }
+
+            let host = response.response?.url?.host ?? BingConfig.chinaHost
+            updateHost(host)
+            logInfo("bing host: \(host)")
+            completion(nil)
+        }
+    }
+
+    private func fetchTranslatorConfig(completion: @escaping Completion) {
+        let url = config.translatorURLString
+        let request = hedgedRequest { self.makeRequest(url: url, includeCookie: false) }
+        request.responseData { [weak self] response in
+            guard let self else {
+                completion(CancellationError())
+                return
+            }
+
+            if let error = response.error {
+                if isCancelledError(error) {
+                    completion(CancellationError())
+                    return
+                }
+                completion(error)
+                return
+            }
+
+            guard let data = response.data else {
+                completion(QueryError(type: .api, message: "bing htmlSession responseObject is not Data"))
+                return
+            }
+
+            guard let responseString = String(data: data, encoding: .utf8) else {
+                completion(QueryError(type: .api, message: "bing html response string is nil"))
+                return
+            }
+
+            guard let ig = getIGValue(from: responseString), !ig.isEmpty else {
+                completion(QueryError(type: .api, message: "bing IG is empty"))
+                return
+            }
+            logInfo("bing IG: \(ig)")
+
+            guard let iid = getDataIidValue(from: responseString), !iid.isEmpty else {
+                completion(QueryError(type: .api, message: "bing IID is empty"))
+                return
+            }
+            logInfo("bing IID: \(iid)")
+
+            guard let arr = getParamsAbusePreventionHelperArray(from: responseString), arr.count == 3 else {
+                completion(QueryError(type: .api, message: "bing get key and token failed"))
+                return
+            }
+
+            let key = arr[0]
+            guard !key.isEmpty else {
+                completion(QueryError(type: .api, message: "bing key is empty"))
+                return
+            }
+
+            let token = arr[1]
+            guard !token.isEmpty else {
+                completion(QueryError(type: .api, message: "bing token is empty"))
+                return
+            }
+            logInfo("bing key: \(key)")
+            logInfo("bing token: \(token)")
+
+            let expirationInterval = arr[2]
+
+            lock.withLock {
+                sharedConfig.IG = ig
+                sharedConfig.IID = iid
+                sharedConfig.key = key
+                sharedConfig.token = token
+                sharedConfig.expirationInterval = expirationInterval
+                sharedConfig.saveToUserDefaults()
+            }
+            completion(nil)
+        }
+    }
+
+    /// Token requests are not tracked by `BingRequest`, so a new query cancelling its own
+    /// requests cannot abort a refresh that other queries are waiting on.
+    private func makeRequest(url: String, includeCookie: Bool) -> DataRequest {
+        var headers = HTTPHeaders([
+            "User-Agent": EZUserAgent,
+        ])
+        let cookie = includeCookie ? config.cookie : ""
+        if !cookie.isEmpty {
+            headers.add(name: "Cookie", value: cookie)
+        }
+
+        return AF.request(
+            url,
+            method: .get,
+            headers: headers,
+            requestModifier: { request in
+                request.timeoutInterval = EZNetWorkTimeoutInterval
+            }
+        )
+        .validate(statusCode: 200 ..< 300)
+    }
+
+    private func hedgedRequest(
+        alternate: (() -> DataRequest)? = nil,
+        _ makeRequest: @escaping () -> DataRequest
+    )
+        -> HedgedDataRequest {
+        HedgedDataRequest(
+            label: ServiceType.bing.rawValue,
+            isHedgingEnabled: lock.withLock { isHedgingEnabled },
+            makeRequest: makeRequest,
+            alternate: alternate
+        )
+    }
+
+    private func isCancelledError(_ error: Error) -> Bool {
+        (error as NSError).code == NSURLErrorCancelled
+    }
+
+    // MARK: - Regex Helpers
+
+    private func getIGValue(from htmlString: String) -> String? {
+        // IG:"8E24D5A82C3240C8A68683C2484870E6",
+        let pattern = #"IG:\s*"([^"]+)""#
+        return htmlString.getStringValue(withPattern: pattern)
+    }
+
+    private func getParamsAbusePreventionHelperArray(from htmlString: String) -> [String]? {
+        // var params_AbusePreventionHelper = [1693880687457,"0T_WDBmVBWjrlS5lBJPS6KYPLOboyyrf",3600000];
+        let pattern = #"params_AbusePreventionHelper\s*=\s*\[([^\]]+)\]"#
+        guard let arrayString = htmlString.getStringValue(withPattern: pattern) else {
+            return nil
+        }
+        let cleanedString = arrayString.replacingOccurrences(of: "\"", with: "")
+        return cleanedString.components(separatedBy: ",")
+    }
+
+    private func getDataIidValue(from htmlString: String) -> String? {
+        // data-iid="translator.5029"
+        let pattern = #"data-iid\s*=\s*"([^"]+)""#
+        return htmlString.getStringValue(withPattern: pattern)
+    }
+}
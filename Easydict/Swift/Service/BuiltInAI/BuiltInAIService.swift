@@ -77,4 +77,9 @@ class BuiltInAIService: BaseOpenAIService {
     override var observeKeys: [Defaults.Key<String>] {
         [supportedModelsKey]
     }
+
+    /// The built-in service shares a free quota, so long-text chunks are sent one by one.
+    override var longTextConcurrencyLimit: Int {
+        1
+    }
 }
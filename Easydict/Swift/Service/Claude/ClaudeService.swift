@@ -62,10 +62,15 @@ public final class ClaudeService: StreamService {
         true
     }
 
+    override var usesLLMTransport: Bool {
+        true
+    }
+
     override func contentStreamTranslate(
         _ text: String,
         from: Language,
-        to: Language
+        to: Language,
+        queryType: EZQueryTextType
     )
         -> AsyncThrowingStream<String, Error> {
         AsyncThrowingStream { continuation in
@@ -73,8 +78,6 @@ public final class ClaudeService: StreamService {
                 currentTask.cancel()
             }
 
-            let queryType = queryType(text: text, from: from, to: to)
-
             let task = Task {
                 do {
                     guard !apiKey.isEmpty else {
@@ -90,17 +93,17 @@ public final class ClaudeService: StreamService {
                     )
 
                     let messages = chatMessageDicts(chatQueryParam)
-                    let (systemPrompt, userMessages) = separateSystemMessages(messages)
+                    let (systemMessage, userMessages) = separateSystemMessages(messages)
                     let requestBody = buildRequestBody(
-                        systemPrompt: systemPrompt,
+                        systemMessage: systemMessage,
                         messages: userMessages
                     )
                     let urlRequest = try createURLRequest(body: requestBody)
 
-                    let (asyncBytes, response) = try await URLSession.shared.bytes(for: urlRequest)
-                    try await validateHTTPResponse(response, asyncBytes: asyncBytes)
+                    let (chunks, response) = try await LLMTransport.shared.dataChunks(for: urlRequest)
+                    try await validateHTTPResponse(response, chunks: chunks)
 
-                    try await processStreamBytes(asyncBytes, continuation: continuation)
+                    try await ClaudeSSEParser().yieldContent(of: chunks, to: continuation)
                     continuation.finish()
                 } catch is CancellationError {
                     logInfo("Claude task was cancelled.")
@@ -166,33 +169,44 @@ public final class ClaudeService: StreamService {
     /// Separates system messages from user/assistant messages.
     ///
     /// Anthropic requires system prompts as a top-level parameter, not in the messages array.
-    /// This method extracts system-role messages and returns them separately.
+    /// This method joins system-role messages into one and returns it separately. When the
+    /// cacheable prefix ends on a system message, the joined message keeps its cache breakpoint.
     ///
     /// - Parameter messages: The full chat message list from `chatMessageDicts()`.
-    /// - Returns: A tuple of (system prompt string, remaining user/assistant messages).
+    /// - Returns: A tuple of (joined system message, nil if there is none, remaining user/assistant messages).
     private func separateSystemMessages(
         _ messages: [ChatMessage]
     )
-        -> (String, [ChatMessage]) {
+        -> (ChatMessage?, [ChatMessage]) {
         var systemParts: [String] = []
+        var isSystemCacheBreakpoint = false
         var otherMessages: [ChatMessage] = []
 
         for message in messages {
             if message.role == .system {
                 systemParts.append(message.content)
+                isSystemCacheBreakpoint = isSystemCacheBreakpoint || message.isCacheBreakpoint
             } else {
                 otherMessages.append(message)
             }
         }
 
-        return (systemParts.joined(separator: "\n\n"), otherMessages)
+        let systemPrompt = systemParts.joined(separator: "\n\n")
+        guard !systemPrompt.isEmpty else { return (nil, otherMessages) }
+
+        let systemMessage = ChatMessage(
+            role: .system,
+            content: systemPrompt,
+            isCacheBreakpoint: isSystemCacheBreakpoint
+        )
+        return (systemMessage, otherMessages)
     }
 
     // MARK: - HTTP Request
 
     /// Builds the JSON request body for the Anthropic Messages API.
     private func buildRequestBody(
-        systemPrompt: String,
+        systemMessage: ChatMessage?,
         messages: [ChatMessage]
     )
         -> [String: Any] {
@@ -201,16 +215,52 @@ public final class ClaudeService: StreamService {
             "max_tokens": maxTokens,
             "temperature": min(max(temperature, 0), 1),
             "stream": true,
-            "messages": messages.map { ["role": $0.role.rawValue, "content": $0.content] },
+            "messages": messages.map(messageObject),
         ]
 
-        if !systemPrompt.isEmpty {
-            body["system"] = systemPrompt
+        if let systemMessage {
+            body["system"] = systemObject(systemMessage)
         }
 
         return body
     }
 
+    /// Converts a chat message to an Anthropic message object.
+    ///
+    /// The message that ends the built-in prompt prefix carries an ephemeral `cache_control`
+    /// block, so the system prompt and few-shot turns before it are served from the prompt
+    /// cache on later queries.
+    private func messageObject(_ message: ChatMessage) -> [String: Any] {
+        guard message.isCacheBreakpoint else {
+            return ["role": message.role.rawValue, "content": message.content]
+        }
+        return [
+            "role": message.role.rawValue,
+            "content": [
+                [
+                    "type": "text",
+                    "text": message.content,
+                    "cache_control": ["type": "ephemeral"],
+                ],
+            ],
+        ]
+    }
+
+    /// Converts the joined system message to the top-level `system` parameter, a list of
+    /// text blocks whose last block carries the `cache_control` breakpoint when needed.
+    private func systemObject(_ message: ChatMessage) -> Any {
+        guard message.isCacheBreakpoint else {
+            return message.content
+        }
+        return [
+            [
+                "type": "text",
+                "text": message.content,
+                "cache_control": ["type": "ephemeral"],
+            ],
+        ]
+    }
+
     /// Creates and configures a URLRequest for the Anthropic Messages API.
     ///
     /// Uses the user-configured endpoint (defaults to `https://api.anthropic.com/v1/messages`).
@@ -241,7 +291,7 @@ public final class ClaudeService: StreamService {
     /// the actual error message from Anthropic's JSON error response.
     private func validateHTTPResponse(
         _ response: URLResponse,
-        asyncBytes: URLSession.AsyncBytes
+        chunks: AsyncThrowingStream<Data, Error>
     ) async throws {
         guard let httpResponse = response as? HTTPURLResponse else {
             throw QueryError(type: .api, message: "Invalid HTTP response from Claude API.")
@@ -252,7 +302,13 @@ public final class ClaudeService: StreamService {
         }
 
         // Read the error response body (up to 4KB) to get the actual error message.
-        let errorData = try await asyncBytes.prefix(4096).reduce(into: Data()) { $0.append($1) }
+        var errorData = Data()
+        for try await chunk in chunks {
+            errorData.append(chunk.prefix(4096 - errorData.count))
+            if errorData.count >= 4096 {
+                break
+            }
+        }
 
         var errorMessage = "Claude API error: HTTP \(httpResponse.statusCode)"
         if let errorBody = try? JSONDecoder().decode(ClaudeStreamError.self, from: errorData) {
@@ -264,57 +320,6 @@ public final class ClaudeService: StreamService {
         throw QueryError(type: .api, errorDataMessage: errorMessage)
     }
 
-    // MARK: - SSE Stream Parsing
-
-    /// Processes SSE byte stream and yields translated text chunks.
-    private func processStreamBytes(
-        _ asyncBytes: URLSession.AsyncBytes,
-        continuation: AsyncThrowingStream<String, Error>.Continuation
-    ) async throws {
-        var dataBuffer = Data()
-        var textBuffer = ""
-        let bufferThreshold = 1024
-
-        for try await byte in asyncBytes {
-            try Task.checkCancellation()
-
-            dataBuffer.append(byte)
-
-            guard dataBuffer.count >= bufferThreshold || byte == 0x0A else {
-                continue
-            }
-
-            if let text = String(data: dataBuffer, encoding: .utf8) {
-                textBuffer.append(text)
-                dataBuffer.removeAll()
-                try processCompleteEvents(from: &textBuffer, continuation: continuation)
-            }
-        }
-
-        if !dataBuffer.isEmpty, let text = String(data: dataBuffer, encoding: .utf8) {
-            textBuffer.append(text)
-        }
-        try processCompleteEvents(from: &textBuffer, continuation: continuation)
-    }
-
-    /// Splits the text buffer on double-newlines and processes complete SSE events.
-    /// Normalizes CRLF to LF before splitting to handle proxies that use CRLF framing.
-    private func processCompleteEvents(
-        from textBuffer: inout String,
-        continuation: AsyncThrowingStream<String, Error>.Continuation
-    ) throws {
-        // A trailing standalone `\r` may still pair with the next chunk's leading `\n`,
-        // so only normalize completed line endings before splitting SSE events.
-        let extractedEvents = ClaudeSSEParser.extractCompleteEvents(from: textBuffer)
-        textBuffer = extractedEvents.remainingBuffer
-
-        for event in extractedEvents.events {
-            if let content = try ClaudeSSEParser.parseEvent(event) {
-                continuation.yield(content)
-            }
-        }
-    }
-
     private func remoteModelsURL(afterID: String?) throws -> URL {
         let queryItems = [
             URLQueryItem(name: "limit", value: "1000"),
@@ -75,97 +75,133 @@ private func stdoutErrorMessage(from line: CLIStreamJSONLine) -> String? {
     return nil
 }
 
-/// Parses a `ClaudeCodeError` by inspecting stdout JSON events first, then falling back to stderr.
-///
-/// The Claude Code CLI reports quota / rate-limit failures via a `rate_limit_event` JSON line
-/// written to **stdout**, accompanied by a `result` line whose `result` field contains the
-/// human-readable message (e.g. "You've hit your limit · resets 3am"). The stderr at that
-/// point contains only macOS system noise, so checking stderr alone produces an empty message.
-func parseError(fromStdout stdout: String, stderr: String) -> ClaudeCodeError {
-    // 1. Scan stdout for a rate_limit_event — this is the authoritative quota signal.
-    //    Also capture auth and generic error messages emitted in stdout events.
-    var hasRateLimitEvent = false
-    var stdoutAuthMessage: String?
-    var stdoutQuotaMessage: String?
-    var stdoutGenericMessage: String?
-    let decoder = JSONDecoder()
-
-    for line in stdout.components(separatedBy: "\n") where !line.isEmpty {
-        guard let data = line.data(using: .utf8) else { continue }
-        if let event = try? decoder.decode(CLIStreamJSONLine.self, from: data) {
-            if event.type == "rate_limit_event" {
-                hasRateLimitEvent = true
-            }
+// MARK: - ClaudeCodeEventParser
 
-            if let message = stdoutErrorMessage(from: event) {
-                if stdoutGenericMessage == nil {
-                    stdoutGenericMessage = message
-                }
-                if stdoutAuthMessage == nil, isClaudeAuthenticationMessage(message) {
-                    stdoutAuthMessage = message
-                }
-                if stdoutQuotaMessage == nil, isClaudeQuotaMessage(message) {
-                    stdoutQuotaMessage = message
-                }
-            }
+/// Incremental consumer for `--output-format stream-json` stdout.
+///
+/// The runner feeds every line as it arrives. Text deltas are returned immediately, while
+/// error signals and token usage are folded into a few fields, so producing the final
+/// `tokenUsage` or `error(stderr:)` after exit does not re-scan or re-decode any stdout.
+///
+/// Not thread-safe. The runner owns one parser per run and uses it on its I/O queue only.
+final class ClaudeCodeEventParser {
+    // MARK: Internal
+
+    /// Token usage from the first `result` event, `nil` until one arrives or when that
+    /// event carried no token fields (e.g. the run was rate-limited).
+    private(set) var tokenUsage: CLITokenUsage?
+
+    /// Consumes one stdout line and returns its text delta, if any.
+    @discardableResult
+    func consume(_ line: Data) -> String? {
+        // Partial-message stream events dominate verbose output. Only text deltas matter
+        // among them, since the wrapper never carries result, usage, or error fields.
+        if AgentCLIJSONEventDecoder.line(line, hasPrefix: Self.streamEventPrefix) {
+            return extractTextDelta(from: line, decoder: decoder)
+        }
 
-            if let errorValue = event.error {
-                if stdoutAuthMessage == nil, isClaudeAuthenticationMessage(errorValue) {
-                    stdoutAuthMessage = stdoutErrorMessage(from: event) ?? errorValue
-                }
-                if stdoutQuotaMessage == nil, isClaudeQuotaMessage(errorValue) {
-                    stdoutQuotaMessage = stdoutErrorMessage(from: event) ?? errorValue
-                }
-            }
+        guard let event = decoder.decode(CLIStreamJSONLine.self, from: line) else { return nil }
+        if let delta = textDelta(in: event) {
+            return delta
         }
+        update(with: event)
+        return nil
     }
 
-    if hasRateLimitEvent {
-        return .quotaExceeded(message: stdoutQuotaMessage ?? stdoutGenericMessage)
+    /// Consumes one stdout line given as a `String`.
+    @discardableResult
+    func consume(_ line: String) -> String? {
+        guard !line.isEmpty else { return nil }
+        return consume(Data(line.utf8))
     }
 
-    if stdoutAuthMessage != nil {
-        return .notLoggedIn
-    }
+    /// Classifies the run failure from the consumed stdout events, falling back to stderr.
+    ///
+    /// The Claude Code CLI reports quota / rate-limit failures via a `rate_limit_event` JSON line
+    /// written to **stdout**, accompanied by a `result` line whose `result` field contains the
+    /// human-readable message (e.g. "You've hit your limit · resets 3am"). The stderr at that
+    /// point contains only macOS system noise, so checking stderr alone produces an empty message.
+    func error(stderr: String) -> ClaudeCodeError {
+        if hasRateLimitEvent {
+            return .quotaExceeded(message: stdoutQuotaMessage ?? stdoutGenericMessage)
+        }
 
-    if let stdoutQuotaMessage {
-        return .quotaExceeded(message: stdoutQuotaMessage)
-    }
+        if stdoutAuthMessage != nil {
+            return .notLoggedIn
+        }
+
+        if let stdoutQuotaMessage {
+            return .quotaExceeded(message: stdoutQuotaMessage)
+        }
 
-    // 2. Fall back to stderr inspection (authentication errors, unknown CLI failures).
-    let cleaned = stderr
-        .components(separatedBy: "\n")
-        .filter { !$0.contains("MallocStackLogging") }
-        .joined(separator: "\n")
-        .trimmingCharacters(in: .whitespacesAndNewlines)
+        // Fall back to stderr inspection (authentication errors, unknown CLI failures).
+        let cleaned = stderr
+            .components(separatedBy: "\n")
+            .filter { !$0.contains("MallocStackLogging") }
+            .joined(separator: "\n")
+            .trimmingCharacters(in: .whitespacesAndNewlines)
 
-    if isClaudeAuthenticationMessage(cleaned) {
-        return .notLoggedIn
-    }
-    if isClaudeQuotaMessage(cleaned) {
-        return .quotaExceeded(message: nil)
-    }
-    if let stdoutGenericMessage, !stdoutGenericMessage.isEmpty {
-        return .cliError(message: stdoutGenericMessage)
+        if isClaudeAuthenticationMessage(cleaned) {
+            return .notLoggedIn
+        }
+        if isClaudeQuotaMessage(cleaned) {
+            return .quotaExceeded(message: nil)
+        }
+        if let stdoutGenericMessage, !stdoutGenericMessage.isEmpty {
+            return .cliError(message: stdoutGenericMessage)
+        }
+        // Use the cleaned stderr text if available; fall back to a localized generic message so
+        // the caller never receives an empty string that gives the user no actionable information.
+        let message = cleaned.isEmpty ? String(localized: "service.claude_code.cli_error.unknown") : cleaned
+        return .cliError(message: message)
     }
-    // Use the cleaned stderr text if available; fall back to a localized generic message so
-    // the caller never receives an empty string that gives the user no actionable information.
-    let message = cleaned.isEmpty ? String(localized: "service.claude_code.cli_error.unknown") : cleaned
-    return .cliError(message: message)
-}
 
-/// Scans stdout for the `result` event and extracts token usage.
-///
-/// Returns `nil` if no `result` event is found or the usage fields are missing
-/// (e.g. the run was rate-limited before any tokens were consumed).
-func parseTokenUsage(from stdout: String) -> CLITokenUsage? {
-    for line in stdout.components(separatedBy: "\n") where !line.isEmpty {
-        guard let data = line.data(using: .utf8),
-              let event = try? JSONDecoder().decode(CLIStreamJSONLine.self, from: data),
-              event.type == "result",
-              let usage = event.usage
-        else { continue }
+    // MARK: Private
+
+    private static let streamEventPrefix: StaticString = #"{"type":"stream_event""#
 
+    private let decoder = AgentCLIJSONEventDecoder()
+
+    private var hasRateLimitEvent = false
+    private var stdoutAuthMessage: String?
+    private var stdoutQuotaMessage: String?
+    private var stdoutGenericMessage: String?
+    /// Only the first `result` event decides the usage, matching the CLI's single result line.
+    private var hasResultUsage = false
+
+    private func update(with event: CLIStreamJSONLine) {
+        if event.type == "rate_limit_event" {
+            hasRateLimitEvent = true
+        }
+
+        if let message = stdoutErrorMessage(from: event) {
+            if stdoutGenericMessage == nil {
+                stdoutGenericMessage = message
+            }
+            if stdoutAuthMessage == nil, isClaudeAuthenticationMessage(message) {
+                stdoutAuthMessage = message
+            }
+            if stdoutQuotaMessage == nil, isClaudeQuotaMessage(message) {
+                stdoutQuotaMessage = message
+            }
+        }
+
+        if let errorValue = event.error {
+            if stdoutAuthMessage == nil, isClaudeAuthenticationMessage(errorValue) {
+                stdoutAuthMessage = stdoutErrorMessage(from: event) ?? errorValue
+            }
+            if stdoutQuotaMessage == nil, isClaudeQuotaMessage(errorValue) {
+                stdoutQuotaMessage = stdoutErrorMessage(from: event) ?? errorValue
+            }
+        }
+
+        if !hasResultUsage, event.type == "result", let usage = event.usage {
+            hasResultUsage = true
+            tokenUsage = makeTokenUsage(from: usage, in: event)
+        }
+    }
+
+    private func makeTokenUsage(from usage: CLIRawUsage, in event: CLIStreamJSONLine) -> CLITokenUsage? {
         let hasAnyTokenField = usage.inputTokens != nil
             || usage.cacheCreationInputTokens != nil
             || usage.cacheReadInputTokens != nil
@@ -181,7 +217,32 @@ func parseTokenUsage(from stdout: String) -> CLITokenUsage? {
             durationMs: event.durationMs ?? 0
         )
     }
-    return nil
+}
+
+// MARK: - Whole-output helpers
+
+/// Parses a `ClaudeCodeError` from complete stdout and stderr buffers.
+///
+/// Convenience wrapper over `ClaudeCodeEventParser` for callers that only have the
+/// accumulated output; the runner consumes lines incrementally instead.
+func parseError(fromStdout stdout: String, stderr: String) -> ClaudeCodeError {
+    let parser = ClaudeCodeEventParser()
+    for line in stdout.split(separator: "\n") {
+        parser.consume(String(line))
+    }
+    return parser.error(stderr: stderr)
+}
+
+/// Scans complete stdout for the `result` event and extracts token usage.
+///
+/// Returns `nil` if no `result` event is found or the usage fields are missing
+/// (e.g. the run was rate-limited before any tokens were consumed).
+func parseTokenUsage(from stdout: String) -> CLITokenUsage? {
+    let parser = ClaudeCodeEventParser()
+    for line in stdout.split(separator: "\n") {
+        parser.consume(String(line))
+    }
+    return parser.tokenUsage
 }
 
 /// Parses one newline-delimited JSON line from `--output-format stream-json` output and
@@ -189,11 +250,65 @@ func parseTokenUsage(from stdout: String) -> CLITokenUsage? {
 ///
 /// All other event types (system, rate_limit, result, etc.) return `nil` and are skipped.
 ///
-/// - Parameter decoder: Caller-supplied decoder to avoid per-call allocation on the hot path.
-func extractTextDelta(from line: String, decoder: JSONDecoder = JSONDecoder()) -> String? {
+/// This is the full `Codable` path; the runner uses the byte-level variant below.
+///
+/// - Parameter decoder: Defaults to a shared decoder, so callers never allocate one per line.
+func extractTextDelta(from line: String, decoder: JSONDecoder = cliStreamJSONDecoder) -> String? {
     guard let data = line.data(using: .utf8),
-          let wrapper = try? decoder.decode(CLIStreamJSONLine.self, from: data),
-          wrapper.type == "stream_event",
+          let wrapper = try? decoder.decode(CLIStreamJSONLine.self, from: data)
+    else { return nil }
+    return textDelta(in: wrapper)
+}
+
+/// Decoder shared by `extractTextDelta(from:decoder:)` callers; decoding keeps no state in it.
+let cliStreamJSONDecoder = JSONDecoder()
+
+/// Byte-level variant of `extractTextDelta(from:decoder:)` used on the runner hot path.
+///
+/// Skips lines that do not mention `"text_delta"`, then reads the delta with
+/// `cliTextDeltaExtractor`. Only lines the extractor cannot vouch for are decoded with
+/// `Codable`, straight from the framed line bytes.
+func extractTextDelta(from line: Data, decoder: AgentCLIJSONEventDecoder) -> String? {
+    guard AgentCLIJSONEventDecoder.line(line, contains: "\"text_delta\"") else { return nil }
+    if case let .delta(text) = cliTextDeltaExtractor.extract(from: line) {
+        return text
+    }
+
+    guard let wrapper = decoder.decode(CLIStreamJSONLine.self, from: line) else { return nil }
+    return textDelta(in: wrapper)
+}
+
+/// Schema of `CLIStreamJSONLine`, with the type checks of `textDelta(in:)` as discriminators.
+let cliTextDeltaExtractor = JSONDeltaExtractor([
+    .init("type", .discriminator("stream_event"), required: true),
+    .init("event", .object([
+        .init("type", .discriminator("content_block_delta"), required: true),
+        .init("delta", .object([
+            .init("type", .discriminator("text_delta"), required: true),
+            .init("text", .delta),
+        ])),
+    ])),
+    .init("result", .string),
+    .init("is_error", .boolean),
+    .init("message", .object([
+        .init("content", .array(of: .object([
+            .init("type", .string, required: true),
+            .init("text", .string),
+        ]))),
+    ])),
+    .init("error", .string),
+    .init("usage", .object([
+        .init("input_tokens", .integer),
+        .init("cache_creation_input_tokens", .integer),
+        .init("cache_read_input_tokens", .integer),
+        .init("output_tokens", .integer),
+    ])),
+    .init("total_cost_usd", .number),
+    .init("duration_ms", .integer),
+])
+
+private func textDelta(in wrapper: CLIStreamJSONLine) -> String? {
+    guard wrapper.type == "stream_event",
           let inner = wrapper.event,
           inner.type == "content_block_delta",
           let delta = inner.delta,
@@ -86,6 +86,40 @@ final class ClaudeCodeRunner: @unchecked Sendable {
         return arguments
     }
 
+    /// Builds the argument list for a pooled invocation that reads its prompt from stdin.
+    ///
+    /// Same flags as `buildArguments(prompt:systemPrompt:)`, but the prompt is sent as a
+    /// single `stream-json` user message on stdin, so the subprocess can be launched
+    /// before the prompt is known.
+    static func buildStreamInputArguments(systemPrompt: String?) -> [String] {
+        var arguments = [
+            "-p",
+            "--print",
+            "--verbose",
+            "--input-format", "stream-json",
+            "--output-format", "stream-json",
+            "--include-partial-messages",
+            "--no-session-persistence",
+            "--tools", "",
+            "--strict-mcp-config",
+            "--setting-sources", "",
+        ]
+        if let systemPrompt, !systemPrompt.isEmpty {
+            arguments += ["--system-prompt", systemPrompt]
+        }
+        return arguments
+    }
+
+    /// Encodes a prompt as one `stream-json` user message line for stdin.
+    static func streamInputMessage(prompt: String) -> Data {
+        let message = ClaudeStreamInputMessage(
+            message: .init(role: "user", content: prompt)
+        )
+        var data = (try? JSONEncoder().encode(message)) ?? Data()
+        data.append(0x0A)
+        return data
+    }
+
     /// Loads string env vars from the user's Claude settings file.
     ///
     /// Returns an empty dictionary if the file is missing, unreadable, malformed,
@@ -170,40 +204,44 @@ final class ClaudeCodeRunner: @unchecked Sendable {
             // so a plain Task { } would run on the main actor and block the UI when
             // detectClaudeBinary() spawns a login shell on the first invocation.
             Task.detached(priority: .userInitiated) { [weak self] in
-                // One decoder per invocation, shared across all readabilityHandler calls.
-                // Avoids the per-line JSONDecoder allocation on the hot streaming path.
-                let decoder = JSONDecoder()
+                // One parser per invocation, shared across all readabilityHandler calls.
+                // Tracks usage and error signals as lines arrive, so nothing is re-parsed on exit.
+                let eventParser = ClaudeCodeEventParser()
                 do {
                     let binaryPath = try Self.detectClaudeBinary()
                     #if AGENT_CLI_DEBUG
                     self?.logger = ClaudeCodeLogger(command: "\(binaryPath) -p <prompt>", prompt: prompt)
                     #endif
 
-                    let process = Process()
-                    let stdoutPipe = Pipe()
-                    let stderrPipe = Pipe()
-
-                    process.executableURL = URL(fileURLWithPath: binaryPath)
-                    process.arguments = Self.buildArguments(prompt: prompt, systemPrompt: systemPrompt)
-                    process.standardOutput = stdoutPipe
-                    process.standardError = stderrPipe
-                    // Use a neutral working directory so claude does not scan user folders.
-                    process.currentDirectoryURL = FileManager.default.temporaryDirectory
-                    // Keep Claude settings sources disabled, but explicitly inject
-                    // user-configured env vars such as auth and proxy settings.
-                    process.environment = Self.buildProcessEnvironment()
+                    // With the worker pool enabled, the prompt goes through stdin so an
+                    // already launched `claude -p` can be reused.
+                    let usesWorkerPool = Self.workerPool.isEnabled
+                    let workerConfiguration = AgentCLIWorkerConfiguration(
+                        executablePath: binaryPath,
+                        arguments: usesWorkerPool
+                            ? Self.buildStreamInputArguments(systemPrompt: systemPrompt)
+                            : Self.buildArguments(prompt: prompt, systemPrompt: systemPrompt),
+                        // Use a neutral working directory so claude does not scan user folders.
+                        workingDirectory: FileManager.default.temporaryDirectory.path,
+                        // Keep Claude settings sources disabled, but explicitly inject
+                        // user-configured env vars such as auth and proxy settings.
+                        environment: Self.buildProcessEnvironment()
+                    )
+                    let worker = usesWorkerPool
+                        ? Self.workerPool.checkout(workerConfiguration)
+                        : AgentCLIWorker(configuration: workerConfiguration)
+                    let process = worker.process
+                    let stdoutPipe = worker.stdoutPipe
+                    let stderrPipe = worker.stderrPipe
 
                     let startTime = Date()
                     // Raw stderr bytes; decoded to String once in the termination handler
                     // after all data has arrived, so multi-byte UTF-8 sequences are never split.
-                    var stderrDataBuffer = Data()
-                    // Accumulates non-delta stdout lines for post-exit error/usage detection.
-                    // Stored as an array to avoid O(N²) string concatenation on repeated appends.
-                    var stdoutControlLines: [String] = []
+                    let stderrTailBuffer = AgentCLITailBuffer()
                     // Incomplete stdout bytes carried over between readabilityHandler calls.
-                    // Buffered at the Data level so multi-byte UTF-8 chars split across reads
+                    // Buffered at the byte level so multi-byte UTF-8 chars split across reads
                     // are not dropped when converting to String.
-                    var stdoutDataBuffer = Data()
+                    let stdoutFramer = AgentCLILineFramer()
 
                     // Read stderr asynchronously into a raw-byte buffer (capped at 1 MB).
                     // Decoding is deferred to the termination handler so that multi-byte UTF-8
@@ -212,29 +250,28 @@ final class ClaudeCodeRunner: @unchecked Sendable {
                         let data = handle.availableData
                         guard !data.isEmpty else { return }
                         Self.ioQueue.async {
-                            Self.appendCapped(data, to: &stderrDataBuffer)
+                            stderrTailBuffer.append(data)
                         }
                     }
 
                     // Read stdout line by line, parse each JSON event, and yield text deltas.
-                    // Only non-delta lines are kept in stdoutControlLines for error/usage parsing.
+                    // Non-delta events update the parser's usage and error state.
                     stdoutPipe.fileHandleForReading.readabilityHandler = { [weak self] handle in
                         let data = handle.availableData
                         guard !data.isEmpty else { return }
                         let capturedLogger = self?.logger
                         Self.ioQueue.async {
                             capturedLogger?.appendStdout(String(data: data, encoding: .utf8) ?? "")
-                            stdoutDataBuffer.append(data)
+                            stdoutFramer.append(data)
                             Self.flushLines(
-                                from: &stdoutDataBuffer,
-                                into: &stdoutControlLines,
-                                decoder: decoder,
+                                from: stdoutFramer,
+                                parser: eventParser,
                                 continuation: continuation
                             )
                         }
                     }
 
-                    process.terminationHandler = { [weak self] terminatedProcess in
+                    worker.setTerminationHandler { [weak self] terminatedProcess in
                         stdoutPipe.fileHandleForReading.readabilityHandler = nil
                         stderrPipe.fileHandleForReading.readabilityHandler = nil
 
@@ -246,7 +283,7 @@ final class ClaudeCodeRunner: @unchecked Sendable {
                         // then calls ioQueue.async. If that ioQueue.async happens AFTER we
                         // enqueue the termination finish block, the handler's data is processed
                         // after finish() — yielded text is silently dropped, and the result/
-                        // usage line may miss parseTokenUsage / parseError.
+                        // usage line may never reach the event parser.
                         //
                         // Mitigation: sync-wait on ioQueue to flush any blocks already queued,
                         // then read remaining pipe bytes (a syscall). Any readabilityHandler
@@ -274,27 +311,24 @@ final class ClaudeCodeRunner: @unchecked Sendable {
                             if !remainingStdoutData.isEmpty {
                                 capturedLogger?
                                     .appendStdout(String(data: remainingStdoutData, encoding: .utf8) ?? "")
-                                stdoutDataBuffer.append(remainingStdoutData)
+                                stdoutFramer.append(remainingStdoutData)
                             }
                             Self.flushLines(
-                                from: &stdoutDataBuffer,
-                                into: &stdoutControlLines,
+                                from: stdoutFramer,
+                                parser: eventParser,
                                 includeRemainder: true,
-                                decoder: decoder,
                                 continuation: continuation
                             )
 
                             if !remainingStderrData.isEmpty {
-                                Self.appendCapped(remainingStderrData, to: &stderrDataBuffer)
+                                stderrTailBuffer.append(remainingStderrData)
                             }
-                            let stderrBuffer = String(data: stderrDataBuffer, encoding: .utf8) ?? ""
+                            let stderrBuffer = String(data: stderrTailBuffer.data, encoding: .utf8) ?? ""
 
                             let duration = Date().timeIntervalSince(startTime)
                             capturedLogger?.finish(stderr: stderrBuffer, exitCode: exitCode, duration: duration)
 
-                            // Join control lines once here; used by both parseTokenUsage and parseError.
-                            let controlBuffer = stdoutControlLines.joined(separator: "\n")
-                            self?.tokenUsage = parseTokenUsage(from: controlBuffer)
+                            self?.tokenUsage = eventParser.tokenUsage
 
                             #if AGENT_CLI_DEBUG
                             ClaudeCodeDebugLogger.shared.post(
@@ -303,7 +337,10 @@ final class ClaudeCodeRunner: @unchecked Sendable {
                             #endif
 
                             if exitCode != 0, !wasCancelled {
-                                let error = parseError(fromStdout: controlBuffer, stderr: stderrBuffer)
+                                // Warm workers share this configuration's auth state; do not
+                                // hand them out after a failure.
+                                Self.workerPool.recycle(workerConfiguration)
+                                let error = eventParser.error(stderr: stderrBuffer)
                                 continuation.finish(throwing: error)
                             } else {
                                 // Either success or user-initiated cancellation — finish cleanly.
@@ -317,15 +354,22 @@ final class ClaudeCodeRunner: @unchecked Sendable {
                     // Returns false (== nil) if the runner was already cancelled.
                     guard self?.setProcessIfNotCancelled(process) == true else {
                         // Clear readability handlers so they release captured resources
-                        // (continuation, decoder, buffer vars) without waiting for the
+                        // (continuation, parser, buffers) without waiting for the
                         // pipes to be connected to a process that will never launch.
                         stdoutPipe.fileHandleForReading.readabilityHandler = nil
                         stderrPipe.fileHandleForReading.readabilityHandler = nil
+                        worker.terminate()
                         continuation.finish()
                         return
                     }
-                    try process.run()
+                    try worker.launchIfNeeded()
                     self?.logger?.start()
+                    let stdinHandle = worker.stdinPipe.fileHandleForWriting
+                    if usesWorkerPool {
+                        try? stdinHandle.write(contentsOf: Self.streamInputMessage(prompt: prompt))
+                    }
+                    // Close stdin in both modes; `claude -p` otherwise waits for piped input.
+                    try? stdinHandle.close()
                     // Post-launch cancellation guard: cancel() checks isRunning before calling
                     // terminate(), so if cancel() ran between setProcessIfNotCancelled and run()
                     // it would have skipped terminate() (isRunning was false at that point).
@@ -364,11 +408,28 @@ final class ClaudeCodeRunner: @unchecked Sendable {
         let env: [String: String]?
     }
 
+    /// A `--input-format stream-json` user message.
+    private struct ClaudeStreamInputMessage: Encodable {
+        struct Message: Encodable {
+            let role: String
+            let content: String
+        }
+
+        var type = "user"
+        let message: Message
+    }
+
     /// Cached path from the first successful `detectClaudeBinary()` call.
     /// Avoids spawning a login shell on every translation request.
     private static var cachedBinaryPath: String?
     private static let cacheLock = NSLock()
 
+    /// Pre-spawned `claude -p --input-format stream-json` workers.
+    private static let workerPool = AgentCLIWorkerPool(
+        name: "claude-code",
+        enabledKey: .enableClaudeCodeWorkerPool
+    )
+
     /// Shared serial queue for all I/O handler dispatches across invocations.
     /// Reusing one queue avoids the overhead of creating a new DispatchQueue per translation.
     private static let ioQueue = DispatchQueue(
@@ -385,60 +446,24 @@ final class ClaudeCodeRunner: @unchecked Sendable {
     /// `cancel()` (caller thread) and `Task.detached` (concurrency thread pool).
     private let stateLock = NSLock()
 
-    /// Drains all newline-terminated lines from `buffer`, yielding text deltas to
-    /// `continuation` and appending non-delta lines to `controlLines`.
+    /// Drains all newline-terminated lines from `framer` into `parser`, yielding text
+    /// deltas to `continuation`.
     ///
-    /// Splits on the 0x0A byte, which is safe because newline is a single byte in UTF-8;
-    /// multi-byte sequences never contain 0x0A. Uses a read-head offset to avoid creating
-    /// an intermediate `Data` copy per newline, keeping the hot streaming path at O(N).
+    /// Lines arrive as byte views, so events are decoded without an intermediate `String`.
     ///
     /// - Parameter includeRemainder: When `true`, any bytes remaining after the last newline
     ///   are also decoded and dispatched. Pass `true` only in the termination handler after
     ///   all pipe data has been read, so a final line without a trailing newline is not lost.
     private static func flushLines(
-        from buffer: inout Data,
-        into controlLines: inout [String],
+        from framer: AgentCLILineFramer,
+        parser: ClaudeCodeEventParser,
         includeRemainder: Bool = false,
-        decoder: JSONDecoder,
         continuation: AsyncThrowingStream<String, Error>.Continuation
     ) {
-        var readHead = buffer.startIndex
-        while let newlineIdx = buffer[readHead...].firstIndex(of: 0x0A) {
-            let lineData = buffer[readHead ..< newlineIdx]
-            if let line = String(data: lineData, encoding: .utf8), !line.isEmpty {
-                if let delta = extractTextDelta(from: line, decoder: decoder) {
-                    continuation.yield(delta)
-                } else {
-                    // Retain control events (result, rate_limit_event, system) for
-                    // post-exit error detection and token-usage parsing.
-                    controlLines.append(line)
-                }
-            }
-            readHead = buffer.index(after: newlineIdx)
-        }
-        // Advance past all consumed bytes in a single slice (one allocation, not per-line).
-        buffer = readHead < buffer.endIndex ? Data(buffer[readHead...]) : Data()
-
-        if includeRemainder, !buffer.isEmpty,
-           let line = String(data: buffer, encoding: .utf8), !line.isEmpty {
-            if let delta = extractTextDelta(from: line, decoder: decoder) {
+        framer.drainLines(includeRemainder: includeRemainder) { line in
+            if let delta = parser.consume(line) {
                 continuation.yield(delta)
-            } else {
-                controlLines.append(line)
             }
-            buffer = Data()
-        }
-    }
-
-    /// Appends `data` to `buffer`, capping the total at 1 MB by retaining only the
-    /// most-recent suffix when the limit would be exceeded.
-    ///
-    /// The 1 MB cap prevents unbounded stderr growth if the CLI emits large error payloads.
-    private static func appendCapped(_ data: Data, to buffer: inout Data) {
-        let maxSize = 1_048_576 // 1 MB
-        buffer.append(data)
-        if buffer.count > maxSize {
-            buffer = Data(buffer.suffix(maxSize))
         }
     }
 
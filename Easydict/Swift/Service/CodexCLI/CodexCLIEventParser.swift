@@ -204,8 +204,27 @@ func parseCodexTokenUsage(from stdout: String, durationMs: Int = 0) -> CodexToke
 /// - Parameter decoder: Caller-supplied decoder to avoid per-call allocation on the hot path.
 func extractCodexText(from line: String, decoder: JSONDecoder = JSONDecoder()) -> String? {
     guard let data = line.data(using: .utf8),
-          let event = try? decoder.decode(CodexCLIStreamLine.self, from: data),
-          event.type == "item.completed",
+          let event = try? decoder.decode(CodexCLIStreamLine.self, from: data)
+    else { return nil }
+    return agentMessageText(in: event)
+}
+
+/// Byte-level variant of `extractCodexText(from:decoder:)` used on the runner hot path.
+///
+/// Decodes straight from the framed line bytes and skips JSON decoding for lines that
+/// do not mention `"agent_message"`.
+func extractCodexText(from line: Data, decoder: AgentCLIJSONEventDecoder) -> String? {
+    guard let event = decoder.decode(
+        CodexCLIStreamLine.self,
+        from: line,
+        requiringMarker: "\"agent_message\""
+    )
+    else { return nil }
+    return agentMessageText(in: event)
+}
+
+private func agentMessageText(in event: CodexCLIStreamLine) -> String? {
+    guard event.type == "item.completed",
           event.item?.type == "agent_message",
           let text = event.item?.text,
           !text.isEmpty
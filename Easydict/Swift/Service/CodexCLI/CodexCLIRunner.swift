@@ -238,6 +238,9 @@ final class CodexCLIRunner: @unchecked Sendable {
     ///   for `AGENTS.md` or other repo-local instructions.
     /// - `-- -` — tells codex to read the prompt from stdin instead of argv.
     ///
+    /// When the worker pool is enabled in settings, the subprocess is taken from
+    /// `workerPool`, so an already launched `codex exec` only waits for its stdin prompt.
+    ///
     /// - Parameters:
     ///   - prompt: The full prompt sent to the CLI. The caller is responsible for
     ///     embedding any system instructions. It is written to stdin so long OCR
@@ -274,24 +277,23 @@ final class CodexCLIRunner: @unchecked Sendable {
                     self?.logger = CodexCLILogger(command: "\(binaryPath) exec --json", prompt: prompt)
                     #endif
 
-                    let context = CodexRunContext()
-                    let workingDirectory = FileManager.default.temporaryDirectory.path
-                    let process = Self.configuredProcess(
-                        for: CodexProcessConfiguration(
-                            binaryPath: binaryPath,
-                            model: model,
-                            reasoningEffort: reasoningEffort,
-                            workingDirectory: workingDirectory,
-                            context: context
-                        )
+                    let workerConfiguration = Self.workerConfiguration(
+                        binaryPath: binaryPath,
+                        model: model,
+                        reasoningEffort: reasoningEffort,
+                        workingDirectory: FileManager.default.temporaryDirectory.path
                     )
+                    let worker = Self.workerPool.isEnabled
+                        ? Self.workerPool.checkout(workerConfiguration)
+                        : AgentCLIWorker(configuration: workerConfiguration)
+                    let context = CodexRunContext(worker: worker)
                     Self.installReadabilityHandlers(
                         context: context,
                         logger: self?.logger,
                         continuation: continuation
                     )
 
-                    process.terminationHandler = { [weak self] terminatedProcess in
+                    worker.setTerminationHandler { [weak self] terminatedProcess in
                         context.stdoutPipe.fileHandleForReading.readabilityHandler = nil
                         context.stderrPipe.fileHandleForReading.readabilityHandler = nil
 
@@ -313,21 +315,15 @@ final class CodexCLIRunner: @unchecked Sendable {
                                 capturedLogger?.appendStdout(
                                     String(data: remainingStdoutData, encoding: .utf8) ?? ""
                                 )
-                                context.stdoutDataBuffer.append(remainingStdoutData)
+                                context.stdoutFramer.append(remainingStdoutData)
                             }
-                            Self.flushLines(
-                                from: &context.stdoutDataBuffer,
-                                into: &context.stdoutControlLines,
-                                latestAgentMessage: &context.latestAgentMessage,
-                                includeRemainder: true,
-                                decoder: context.decoder
-                            )
+                            Self.flushLines(context: context, includeRemainder: true)
 
                             if !remainingStderrData.isEmpty {
-                                Self.appendCapped(remainingStderrData, to: &context.stderrDataBuffer)
+                                context.stderrTailBuffer.append(remainingStderrData)
                             }
                             let stderrBuffer = String(
-                                data: context.stderrDataBuffer,
+                                data: context.stderrTailBuffer.data,
                                 encoding: .utf8
                             ) ?? ""
 
@@ -356,6 +352,11 @@ final class CodexCLIRunner: @unchecked Sendable {
                                 stdoutControlBuffer: controlBuffer,
                                 stderrBuffer: stderrBuffer
                             )
+                            if terminalError != nil, !wasCancelled {
+                                // Warm workers share this configuration's auth state; do not
+                                // hand them out after a failure.
+                                Self.workerPool.recycle(workerConfiguration)
+                            }
 
                             if let message = Self.terminalAgentMessage(
                                 latestAgentMessage: context.latestAgentMessage,
@@ -372,13 +373,15 @@ final class CodexCLIRunner: @unchecked Sendable {
                         }
                     }
 
+                    let process = worker.process
                     guard self?.setProcessIfNotCancelled(process) == true else {
                         context.stdoutPipe.fileHandleForReading.readabilityHandler = nil
                         context.stderrPipe.fileHandleForReading.readabilityHandler = nil
+                        worker.terminate()
                         continuation.finish()
                         return
                     }
-                    try process.run()
+                    try worker.launchIfNeeded()
                     self?.logger?.start()
                     Self.writePromptToStandardInput(prompt, pipe: context.stdinPipe)
                     if self?.checkIsCancelled() == true, process.isRunning {
@@ -409,24 +412,27 @@ final class CodexCLIRunner: @unchecked Sendable {
     /// Stores per-run pipes and buffers shared by subprocess I/O callbacks.
     /// Mutations happen on `ioQueue` after the handlers are installed.
     private final class CodexRunContext: @unchecked Sendable {
-        let stdinPipe = Pipe()
-        let stdoutPipe = Pipe()
-        let stderrPipe = Pipe()
-        let decoder = JSONDecoder()
+        // MARK: Lifecycle
+
+        init(worker: AgentCLIWorker) {
+            self.stdinPipe = worker.stdinPipe
+            self.stdoutPipe = worker.stdoutPipe
+            self.stderrPipe = worker.stderrPipe
+        }
+
+        // MARK: Internal
+
+        let stdinPipe: Pipe
+        let stdoutPipe: Pipe
+        let stderrPipe: Pipe
+        let eventDecoder = AgentCLIJSONEventDecoder()
         let startTime = Date()
-        var stderrDataBuffer = Data()
+        /// Raw stderr bytes, capped at 1 MB and decoded once after exit.
+        let stderrTailBuffer = AgentCLITailBuffer()
+        /// Incomplete stdout bytes carried over between reads.
+        let stdoutFramer = AgentCLILineFramer()
         var latestAgentMessage: String?
         var stdoutControlLines: [String] = []
-        var stdoutDataBuffer = Data()
-    }
-
-    /// Captures immutable values needed to configure one Codex subprocess.
-    private struct CodexProcessConfiguration {
-        let binaryPath: String
-        let model: String?
-        let reasoningEffort: String?
-        let workingDirectory: String
-        let context: CodexRunContext
     }
 
     /// Codex feature flags disabled for translation-only subprocess runs.
@@ -476,6 +482,13 @@ final class CodexCLIRunner: @unchecked Sendable {
 
     private static let cacheLock = NSLock()
 
+    /// Pre-spawned `codex exec` workers. The prompt is read from stdin (`-- -`), so a
+    /// worker can finish CLI startup before the prompt is known.
+    private static let workerPool = AgentCLIWorkerPool(
+        name: "codex-cli",
+        enabledKey: .enableCodexCLIWorkerPool
+    )
+
     /// Shared serial queue for all I/O handler dispatches across invocations.
     private static let ioQueue = DispatchQueue(
         label: "com.easydict.codex-cli-runner-io",
@@ -500,21 +513,23 @@ final class CodexCLIRunner: @unchecked Sendable {
         }
     }
 
-    private static func configuredProcess(for configuration: CodexProcessConfiguration)
-        -> Process {
-        let process = Process()
-        process.executableURL = URL(fileURLWithPath: configuration.binaryPath)
-        process.arguments = buildArguments(
-            workingDirectory: configuration.workingDirectory,
-            model: configuration.model,
-            reasoningEffort: configuration.reasoningEffort
+    private static func workerConfiguration(
+        binaryPath: String,
+        model: String?,
+        reasoningEffort: String?,
+        workingDirectory: String
+    )
+        -> AgentCLIWorkerConfiguration {
+        AgentCLIWorkerConfiguration(
+            executablePath: binaryPath,
+            arguments: buildArguments(
+                workingDirectory: workingDirectory,
+                model: model,
+                reasoningEffort: reasoningEffort
+            ),
+            workingDirectory: workingDirectory,
+            environment: buildProcessEnvironment()
         )
-        process.standardInput = configuration.context.stdinPipe
-        process.standardOutput = configuration.context.stdoutPipe
-        process.standardError = configuration.context.stderrPipe
-        process.currentDirectoryURL = URL(fileURLWithPath: configuration.workingDirectory)
-        process.environment = buildProcessEnvironment()
-        return process
     }
 
     private static func installReadabilityHandlers(
@@ -526,7 +541,7 @@ final class CodexCLIRunner: @unchecked Sendable {
             let data = handle.availableData
             guard !data.isEmpty else { return }
             ioQueue.async {
-                appendCapped(data, to: &context.stderrDataBuffer)
+                context.stderrTailBuffer.append(data)
             }
         }
 
@@ -535,59 +550,21 @@ final class CodexCLIRunner: @unchecked Sendable {
             guard !data.isEmpty else { return }
             ioQueue.async {
                 logger?.appendStdout(String(data: data, encoding: .utf8) ?? "")
-                context.stdoutDataBuffer.append(data)
-                flushLines(
-                    from: &context.stdoutDataBuffer,
-                    into: &context.stdoutControlLines,
-                    latestAgentMessage: &context.latestAgentMessage,
-                    decoder: context.decoder
-                )
+                context.stdoutFramer.append(data)
+                flushLines(context: context)
             }
         }
     }
 
     /// Drains newline-terminated lines, caching agent text and retaining control events.
-    private static func flushLines(
-        from buffer: inout Data,
-        into controlLines: inout [String],
-        latestAgentMessage: inout String?,
-        includeRemainder: Bool = false,
-        decoder: JSONDecoder
-    ) {
-        var readHead = buffer.startIndex
-        while let newlineIdx = buffer[readHead...].firstIndex(of: 0x0A) {
-            let lineData = buffer[readHead ..< newlineIdx]
-            if let line = String(data: lineData, encoding: .utf8), !line.isEmpty {
-                processCodexStdoutLine(
-                    line,
-                    decoder: decoder,
-                    latestAgentMessage: &latestAgentMessage,
-                    controlLines: &controlLines
-                )
-            }
-            readHead = buffer.index(after: newlineIdx)
-        }
-        buffer = readHead < buffer.endIndex ? Data(buffer[readHead...]) : Data()
-
-        if includeRemainder, !buffer.isEmpty,
-           let line = String(data: buffer, encoding: .utf8), !line.isEmpty {
+    private static func flushLines(context: CodexRunContext, includeRemainder: Bool = false) {
+        context.stdoutFramer.drainLines(includeRemainder: includeRemainder) { line in
             processCodexStdoutLine(
                 line,
-                decoder: decoder,
-                latestAgentMessage: &latestAgentMessage,
-                controlLines: &controlLines
+                decoder: context.eventDecoder,
+                latestAgentMessage: &context.latestAgentMessage,
+                controlLines: &context.stdoutControlLines
             )
-            buffer = Data()
-        }
-    }
-
-    /// Appends `data` to `buffer`, capping the total at 1 MB by retaining only the
-    /// most-recent suffix when the limit would be exceeded.
-    private static func appendCapped(_ data: Data, to buffer: inout Data) {
-        let maxSize = 1_048_576 // 1 MB
-        buffer.append(data)
-        if buffer.count > maxSize {
-            buffer = Data(buffer.suffix(maxSize))
         }
     }
 
@@ -720,6 +697,21 @@ extension CodexCLIRunner {
         try? handle.write(contentsOf: Data(prompt.utf8))
     }
 
+    /// Updates stdout parsing state for one framed JSONL line without decoding it to `String`
+    /// unless it has to be retained as a control event.
+    static func processCodexStdoutLine(
+        _ line: Data,
+        decoder: AgentCLIJSONEventDecoder,
+        latestAgentMessage: inout String?,
+        controlLines: inout [String]
+    ) {
+        if let message = extractCodexText(from: line, decoder: decoder) {
+            latestAgentMessage = message
+        } else if let controlLine = String(data: line, encoding: .utf8), !controlLine.isEmpty {
+            controlLines.append(controlLine)
+        }
+    }
+
     /// Updates stdout parsing state for one complete JSONL line.
     static func processCodexStdoutLine(
         _ line: String,
@@ -62,10 +62,10 @@ final class CodexCLIService: StreamService {
     public override func contentStreamTranslate(
         _ text: String,
         from: Language,
-        to: Language
+        to: Language,
+        queryType: EZQueryTextType
     )
         -> AsyncThrowingStream<String, Error> {
-        let queryType = queryType(text: text, from: from, to: to)
         let chatQueryParam = ChatQueryParam(
             text: text,
             sourceLanguage: from,
@@ -66,6 +66,11 @@ class DeepSeekService: OpenAIService {
         false
     }
 
+    /// `contentStreamTranslate` cancels the previous request, so chunks cannot overlap.
+    override var longTextConcurrencyLimit: Int {
+        0
+    }
+
     /// Per-service reasoning effort. Defaults to off because Easydict's
     /// translation workflows prioritize lower latency; users can still choose
     /// high or max when quality needs outweigh response speed.
@@ -80,7 +85,8 @@ class DeepSeekService: OpenAIService {
     override func contentStreamTranslate(
         _ text: String,
         from: Language,
-        to: Language
+        to: Language,
+        queryType: EZQueryTextType
     )
         -> AsyncThrowingStream<String, Error> {
         AsyncThrowingStream { continuation in
@@ -107,7 +113,6 @@ class DeepSeekService: OpenAIService {
 
             let task = Task {
                 do {
-                    let queryType = queryType(text: text, from: from, to: to)
                     let chatQueryParam = ChatQueryParam(
                         text: text,
                         sourceLanguage: from,
@@ -120,9 +125,9 @@ class DeepSeekService: OpenAIService {
                         messages: chatMessageDicts(chatQueryParam)
                     )
 
-                    let (asyncBytes, response) = try await URLSession.shared.bytes(for: request)
+                    let (chunks, response) = try await LLMTransport.shared.dataChunks(for: request)
                     try validateHTTPResponse(response)
-                    try await processStreamBytes(asyncBytes, continuation: continuation)
+                    try await DeepSeekSSEParser().yieldContent(of: chunks, to: continuation)
                     continuation.finish()
                 } catch is CancellationError {
                     logInfo("DeepSeek task was cancelled.")
@@ -168,79 +173,55 @@ class DeepSeekService: OpenAIService {
         }
 
         guard (200 ... 299).contains(httpResponse.statusCode) else {
-            throw QueryError(type: .api, message: "HTTP \(httpResponse.statusCode)")
+            throw QueryError.httpError(
+                statusCode: httpResponse.statusCode,
+                message: "HTTP \(httpResponse.statusCode)"
+            )
         }
     }
+}
 
-    private func processStreamBytes(
-        _ asyncBytes: URLSession.AsyncBytes,
-        continuation: AsyncThrowingStream<String, Error>.Continuation
-    ) async throws {
-        var dataBuffer = Data()
-        var textBuffer = ""
-
-        for try await byte in asyncBytes {
-            try Task.checkCancellation()
-            dataBuffer.append(byte)
-
-            guard byte == 0x0A else {
-                continue
-            }
+// MARK: - DeepSeekSSEParser
 
-            if let text = String(data: dataBuffer, encoding: .utf8) {
-                textBuffer.append(text)
-                dataBuffer.removeAll()
-                processCompleteEvents(from: &textBuffer, continuation: continuation)
-            }
-        }
+/// Extracts content deltas from DeepSeek's OpenAI-compatible server-sent events.
+struct DeepSeekSSEParser: ServerSentEventContentDecoder {
+    // MARK: Internal
 
-        if !dataBuffer.isEmpty, let text = String(data: dataBuffer, encoding: .utf8) {
-            textBuffer.append(text)
+    func content(of event: ServerSentEvent) -> String? {
+        guard !event.data.isEmpty, event.data != doneFlag else {
+            return nil
         }
-        processCompleteEvents(from: &textBuffer, continuation: continuation)
-    }
 
-    private func processCompleteEvents(
-        from textBuffer: inout String,
-        continuation: AsyncThrowingStream<String, Error>.Continuation
-    ) {
-        textBuffer = textBuffer.replacingOccurrences(of: "\r\n", with: "\n")
-        let eventSeparator = "\n\n"
-        guard textBuffer.contains(eventSeparator) else { return }
-
-        let parts = textBuffer.split(separator: eventSeparator, omittingEmptySubsequences: false)
-        textBuffer = String(parts.last ?? "")
-
-        for event in parts.dropLast() where !event.isEmpty {
-            guard let content = parseSSEEvent(String(event)) else { continue }
-            continuation.yield(content)
+        if case let .delta(content) = Self.deltaExtractor.extract(from: event.data) {
+            return content
         }
+        return decodeContent(from: event.data)
     }
 
-    private func parseSSEEvent(_ event: String) -> String? {
-        let dataPrefix = "data:"
-        let doneFlag = "[DONE]"
-        var dataString = ""
-
-        for line in event.split(separator: "\n") where line.starts(with: dataPrefix) {
-            let payload = line.dropFirst(dataPrefix.count).trimmingCharacters(in: .whitespaces)
-            guard payload != doneFlag else { return nil }
-            dataString += payload
-        }
-
-        guard !dataString.isEmpty,
-              let data = dataString.data(using: .utf8)
-        else {
-            return nil
-        }
-
-        guard let chunk = try? JSONDecoder().decode(DeepSeekStreamChunk.self, from: data) else {
-            logError("Failed to decode DeepSeek SSE data: \(dataString)")
+    /// Decodes a chunk with `Codable`, for chunks the fast path does not handle, such as
+    /// the final usage chunk or error payloads.
+    func decodeContent(from data: Data) -> String? {
+        guard let chunk = try? decoder.decode(DeepSeekStreamChunk.self, from: data) else {
+            logError("Failed to decode DeepSeek SSE data: \(String(decoding: data, as: UTF8.self))")
             return nil
         }
 
         return chunk.choices.first?.delta.content
     }
+
+    /// Schema of `DeepSeekStreamChunk`.
+    static let deltaExtractor = JSONDeltaExtractor([
+        .init("choices", .array(of: .object([
+            .init("delta", .object([
+                .init("content", .delta),
+            ]), required: true),
+        ])), required: true),
+    ])
+
+    // MARK: Private
+
+    private let doneFlag = Data("[DONE]".utf8)
+    private let decoder = JSONDecoder()
 }
 
 // MARK: - DeepSeekModel
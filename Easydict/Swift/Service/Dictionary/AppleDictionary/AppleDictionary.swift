@@ -7,6 +7,7 @@
 //
 
 import AppKit
+import Defaults
 import Foundation
 
 // MARK: - Constants
@@ -41,14 +42,15 @@ class AppleDictionary: QueryService, @unchecked Sendable {
 
     // MARK: - Public Properties
 
-    var htmlFilePath: String = ""
+    /// In-memory URL of the latest rendered HTML, served by `DictionaryURLSchemeHandler`.
+    var htmlURL: URL?
 
     var appleDictionaryNames: [String] {
         get {
             appleDictionaries.map { $0.name }
         }
         set {
-            appleDictionaries = newValue.map { TTTDictionary(named: $0) }
+            appleDictionaries = AppleDictionaryHandleCache.shared.dictionaries(named: newValue)
         }
     }
 
@@ -66,6 +68,21 @@ class AppleDictionary: QueryService, @unchecked Sendable {
         [.dictionary, .sentence]
     }
 
+    override func supportsSpeculativePrefetch() -> Bool {
+        true
+    }
+
+    /// Local lookups put no load on a provider, and the selected dictionaries are per instance.
+    override func coalescingKey(text: String, from: Language, to: Language) -> String? {
+        nil
+    }
+
+    override func adoptSpeculativeResult(_ prefetched: QueryResult, from probe: QueryService) -> QueryResult {
+        // The rendered document was registered by the probe's lookup.
+        htmlURL = (probe as? AppleDictionary)?.htmlURL
+        return super.adoptSpeculativeResult(prefetched, from: probe)
+    }
+
     override func intelligentQueryTextType() -> EZQueryTextType {
         [.dictionary, .sentence]
     }
@@ -183,21 +200,39 @@ class AppleDictionary: QueryService, @unchecked Sendable {
             return false
         }
 
-        let entries = queryEntryHTMLs(
+        let entryLookup = queryEntryHTMLs(
             ofWord: text,
             inDictionaryName: dictName,
             language: language
         )
-        return !entries.isEmpty
+        return !entryLookup.htmls.isEmpty
     }
 
     // MARK: Private
 
     // MARK: - Private Properties
 
+    private static let htmlDumpQueue = DispatchQueue(label: "apple-dictionary-html-dump", qos: .utility)
+
     private var appleDictionaries: [TTTDictionary] = []
 }
 
+// MARK: - AppleDictionaryEntryLookup
+
+/// Valid entries found in one dictionary.
+private struct AppleDictionaryEntryLookup {
+    let htmls: [String]
+    let texts: [String]
+}
+
+// MARK: - AppleDictionaryLookup
+
+/// Per-dictionary lookup output, collected concurrently and reassembled in dictionary order.
+private struct AppleDictionaryLookup {
+    let entryLookup: AppleDictionaryEntryLookup
+    var section: DictionaryHTMLSection?
+}
+
 // MARK: - HTML Query Methods
 
 extension AppleDictionary {
@@ -209,19 +244,15 @@ extension AppleDictionary {
         inDictionaryNames dictNames: [String]
     )
         -> String? {
-        var dicts: [TTTDictionary] = []
-        for name in dictNames {
-            let dict = TTTDictionary(named: name)
-            if !dicts.contains(dict) {
-                dicts.append(dict)
-            }
-        }
+        let dicts = AppleDictionaryHandleCache.shared.dictionaries(named: dictNames)
         return queryAllIframeHTMLResult(
             ofWord: word, fromToLanguages: languages, inDictionaries: dicts
         )
     }
 
-    /// Get All iframe HTML of word from dictionaries, cost ~0.2s
+    /// Get All iframe HTML of word from dictionaries.
+    ///
+    /// Each dictionary is searched concurrently, results are reassembled in the given dictionary order.
     func queryAllIframeHTMLResult(
         ofWord word: String,
         fromToLanguages languages: [Language]?,
@@ -237,33 +268,44 @@ extension AppleDictionary {
             bodyMargin: 10,
             extraCSS: ".\(customIframeContainerClass){margin-top:0;margin-bottom:0;width:100%;}"
         )
-        var sections: [DictionaryHTMLSection] = []
 
-        for dictionary in dictionaries {
-            var wordHtmlString = ""
+        var lookups = [AppleDictionaryLookup?](repeating: nil, count: dictionaries.count)
+        let lookupsLock = NSLock()
+
+        DispatchQueue.concurrentPerform(iterations: dictionaries.count) { index in
+            let dictionary = dictionaries[index]
 
             // ~/Library/Dictionaries/Apple.dictionary/Contents/
             let contentsURL = dictionary.dictionaryURL.appendingPathComponent("Contents")
 
-            let entryHTMLs = queryEntryHTMLs(
+            let entryLookup = queryEntryHTMLs(
                 ofWord: word, inDictionary: dictionary, language: fromLanguage
             )
-            result?.htmlStrings = entryHTMLs
 
-            for html in entryHTMLs {
+            var wordHtmlString = ""
+            for html in entryLookup.htmls {
                 let absolutePathHTML = replacedAudioPath(
                     ofHTML: html, withBasePath: contentsURL.path
                 )
                 wordHtmlString += absolutePathHTML
             }
 
+            var lookup = AppleDictionaryLookup(entryLookup: entryLookup)
             if !wordHtmlString.isEmpty {
                 let dictHTML = "\(entryStyle)\n\n\(wordHtmlString)"
-                sections.append(DictionaryHTMLSection(title: dictionary.shortName, html: dictHTML))
-                saveDictHTML(dictHTML, dictName: dictionary.shortName)
+                lookup.section = DictionaryHTMLSection(title: dictionary.shortName, html: dictHTML)
+            }
+
+            lookupsLock.withLock {
+                lookups[index] = lookup
             }
         }
 
+        let orderedLookups = lookups.compactMap { $0 }
+        result?.htmlStrings = orderedLookups.flatMap { $0.entryLookup.htmls }
+        result?.innerTexts = orderedLookups.flatMap { $0.entryLookup.texts }
+        let sections = orderedLookups.compactMap { $0.section }
+
         let endTime = CFAbsoluteTimeGetCurrent()
         logInfo("Query all dicts cost: \(String(format: "%.1f", (endTime - startTime) * 1000)) ms")
 
@@ -271,7 +313,15 @@ extension AppleDictionary {
             return nil
         }
 
-        saveAllDictHTML(renderResult.htmlString)
+        htmlURL = DictionaryURLSchemeHandler.shared.registerDocument(
+            html: renderResult.htmlString,
+            resourceRoots: dictionaries.map { $0.dictionaryURL }
+        )
+
+        if Defaults[.enableDictionaryHTMLDebugDump] {
+            dumpDictHTML(renderResult)
+        }
+
         return renderResult.htmlString
     }
 
@@ -282,17 +332,20 @@ extension AppleDictionary {
         inDictionaryName name: String,
         language: Language?
     )
-        -> [String] {
-        let dictionary = TTTDictionary(named: name)
+        -> AppleDictionaryEntryLookup {
+        let dictionary = AppleDictionaryHandleCache.shared.dictionaries(named: [name])[0]
         return queryEntryHTMLs(ofWord: word, inDictionary: dictionary, language: language)
     }
 
+    /// Query valid entry HTMLs and their plain texts of word in a dictionary.
+    ///
+    /// This method does not touch `result`, so it is safe to call concurrently for different dictionaries.
     private func queryEntryHTMLs(
         ofWord word: String,
         inDictionary dictionary: TTTDictionary,
         language: Language?
     )
-        -> [String] {
+        -> AppleDictionaryEntryLookup {
         var entryHTMLs: [String] = []
         var texts: [String] = []
 
@@ -310,37 +363,32 @@ extension AppleDictionary {
             }
         }
 
-        // `detectText` may call this method without setting `result` beforehand.
-        // Avoid crashing when `result` is nil.
-        result?.innerTexts = texts
-
-        return entryHTMLs
+        return AppleDictionaryEntryLookup(htmls: entryHTMLs, texts: texts)
     }
 
-    private func saveDictHTML(_ dictHTML: String, dictName: String) {
-        let dictionaryURL = TTTDictionary.userDictionaryDirectoryURL()
-        let htmlDirectory = dictionaryURL.appendingPathComponent(kHTMLDirectory).path
+    /// Write rendered HTML to `~/Library/Dictionaries/Dict HTML` for debugging, off the query thread.
+    private func dumpDictHTML(_ renderResult: DictionaryHTMLRenderResult) {
+        Self.htmlDumpQueue.async { [self] in
+            let dictionaryURL = TTTDictionary.userDictionaryDirectoryURL()
+            let htmlDirectory = dictionaryURL.appendingPathComponent(kHTMLDirectory).path
+            createHTMLDirectoryIfNeeded(htmlDirectory)
 
-        createHTMLDirectoryIfNeeded(htmlDirectory)
+            for section in renderResult.sections {
+                let filePath = "\(htmlDirectory)/\(section.title).html"
+                writeHTML(section.html, toFile: filePath)
+            }
+            writeHTML(renderResult.htmlString, toFile: "\(htmlDirectory)/\(kHTMLDictFilePath)")
+        }
+    }
 
-        let htmlFilePath = "\(htmlDirectory)/\(dictName).html"
+    private func writeHTML(_ html: String, toFile filePath: String) {
         do {
-            try dictHTML.write(toFile: htmlFilePath, atomically: true, encoding: .utf8)
+            try html.write(toFile: filePath, atomically: true, encoding: .utf8)
         } catch {
             logError("writeToFile error: \(error)")
         }
     }
 
-    private func saveAllDictHTML(_ htmlString: String) {
-        let dictionaryURL = TTTDictionary.userDictionaryDirectoryURL()
-        let htmlDirectory = dictionaryURL.appendingPathComponent(kHTMLDirectory).path
-        createHTMLDirectoryIfNeeded(htmlDirectory)
-
-        let filePath = "\(htmlDirectory)/\(kHTMLDictFilePath)"
-        htmlFilePath = filePath
-        try? htmlString.write(toFile: filePath, atomically: true, encoding: .utf8)
-    }
-
     private func createHTMLDirectoryIfNeeded(_ htmlDirectory: String) {
         let fileManager = FileManager.default
         guard !fileManager.fileExists(atPath: htmlDirectory) else { return }
@@ -359,15 +407,18 @@ extension AppleDictionary {
 // MARK: - Path Replacement Methods
 
 extension AppleDictionary {
-    // MARK: Private
+    // MARK: Internal
 
-    /// Replace HTML all audio relative path with absolute path
+    /// Replace HTML all audio relative path with an absolute `easydict-dict://resource/` URL
     ///
     /// &quot; is " in HTML
     ///
     /// javascript:new Audio(&quot;uk/apple__gb_1.mp3&quot;) -->
-    /// javascript:new Audio('/Users/tisfeng/Library/Contents/uk/apple__gb_1.mp3')
-    private func replacedAudioPath(ofHTML html: String, withBasePath basePath: String) -> String {
+    /// javascript:new Audio('easydict-dict://resource/Users/tisfeng/Library/Contents/uk/apple__gb_1.mp3')
+    ///
+    /// The HTML is shown in a `srcdoc` iframe of an `easydict-dict://document/` page, so a bare
+    /// file path would resolve against the document host instead of the resource host.
+    func replacedAudioPath(ofHTML html: String, withBasePath basePath: String) -> String {
         let pattern = "new Audio\\((.*?)\\)"
         guard let regex = try? NSRegularExpression(pattern: pattern) else {
             return html
@@ -398,7 +449,8 @@ extension AppleDictionary {
             }
 
             let absolutePath = (fileBasePath as NSString).appendingPathComponent(relativePath)
-            let replacement = "new Audio('\(absolutePath)')"
+            let audioURL = DictionaryURLSchemeHandler.shared.resourceURL(forFilePath: absolutePath)
+            let replacement = "new Audio('\(audioURL.absoluteString)')"
 
             if let fullMatchRange = Range(match.range, in: mutableHTML) {
                 mutableHTML.replaceSubrange(fullMatchRange, with: replacement)
@@ -408,6 +460,8 @@ extension AppleDictionary {
         return mutableHTML
     }
 
+    // MARK: Private
+
     /// Find file path in directory.
     private func findFilePath(
         inDirectory directoryPath: String,
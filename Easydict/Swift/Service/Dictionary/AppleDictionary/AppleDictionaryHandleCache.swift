@@ -0,0 +1,84 @@
+//
+//  AppleDictionaryHandleCache.swift
+//  Easydict
+//
+//  Created by tisfeng on 2026/10/19.
+//  Copyright © 2026 izual. All rights reserved.
+//
+
+import Foundation
+
+// MARK: - AppleDictionaryHandleCache
+
+/// Caches opened `TTTDictionary` handles for the dictionary name lists used by lookups.
+///
+/// Resolving names and de-duplicating handles happens once per distinct name list
+/// instead of on every query. When Dictionary.app reports that the active dictionary
+/// set changed, `TTTDictionary` re-reads the installed dictionaries and the cache is
+/// dropped, so newly added or enabled dictionaries are picked up.
+final class AppleDictionaryHandleCache: @unchecked Sendable {
+    // MARK: Lifecycle
+
+    private init() {
+        observer = DistributedNotificationCenter.default().addObserver(
+            forName: Self.activeDictionariesChangedNotification,
+            object: nil,
+            queue: nil
+        ) { [weak self] _ in
+            logInfo("Active dictionaries changed, invalidate dictionary handle cache")
+            self?.invalidate()
+        }
+    }
+
+    deinit {
+        if let observer {
+            DistributedNotificationCenter.default().removeObserver(observer)
+        }
+    }
+
+    // MARK: Internal
+
+    static let shared = AppleDictionaryHandleCache()
+
+    /// Returns unique dictionary handles for names, preserving the given order.
+    func dictionaries(named names: [String]) -> [TTTDictionary] {
+        let cacheKey = names.joined(separator: "\n")
+        if let cached = lock.withLock({ dictionariesByNames[cacheKey] }) {
+            QueryMetrics.recordCacheLookup("apple_dictionary_handles", hit: true)
+            return cached
+        }
+        QueryMetrics.recordCacheLookup("apple_dictionary_handles", hit: false)
+
+        var dictionaries: [TTTDictionary] = []
+        for name in names {
+            let dictionary = TTTDictionary(named: name)
+            if !dictionaries.contains(dictionary) {
+                dictionaries.append(dictionary)
+            }
+        }
+
+        lock.withLock {
+            dictionariesByNames[cacheKey] = dictionaries
+        }
+        return dictionaries
+    }
+
+    /// Reloads the installed dictionaries and drops all cached handles,
+    /// the next lookup resolves names again.
+    func invalidate() {
+        lock.withLock {
+            TTTDictionary.reloadAvailableDictionaries()
+            dictionariesByNames.removeAll()
+        }
+    }
+
+    // MARK: Private
+
+    private static let activeDictionariesChangedNotification = Notification.Name(
+        "kDCSActiveDictionariesChangedDistributedNotification"
+    )
+
+    private let lock = NSLock()
+    private var dictionariesByNames: [String: [TTTDictionary]] = [:]
+    private var observer: NSObjectProtocol?
+}
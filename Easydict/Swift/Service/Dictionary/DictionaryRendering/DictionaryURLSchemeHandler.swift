@@ -0,0 +1,143 @@
+//
+//  DictionaryURLSchemeHandler.swift
+//  Easydict
+//
+//  Created by tisfeng on 2026/10/19.
+//  Copyright © 2026 izual. All rights reserved.
+//
+
+import Foundation
+import UniformTypeIdentifiers
+import WebKit
+
+// MARK: - DictionaryURLSchemeHandler
+
+/// Serves rendered dictionary HTML to the result WebView from memory.
+///
+/// Rendered documents are registered under a `easydict-dict://document/<id>.html` URL,
+/// so lookups never need to write HTML to disk before loading it. Resources such as
+/// pronunciation audio use `easydict-dict://resource/<absolute file path>` URLs, see
+/// `resourceURL(forFilePath:)`, and are served only when they live inside a resource
+/// root registered with a document, e.g. a dictionary bundle's `Contents` folder.
+///
+/// Documents are loaded into `srcdoc` iframes, so a relative or host-less resource path
+/// resolves against the document URL. Any path under `document` that is not an
+/// `<id>.html` document is therefore served as a resource too.
+@objc(EZDictionaryURLSchemeHandler)
+@objcMembers
+final class DictionaryURLSchemeHandler: NSObject, WKURLSchemeHandler, @unchecked Sendable {
+    // MARK: Internal
+
+    static let shared = DictionaryURLSchemeHandler()
+
+    static let scheme = "easydict-dict"
+
+    /// Registers a rendered HTML document and returns the URL the WebView should load.
+    ///
+    /// - Parameters:
+    ///   - html: The complete rendered HTML.
+    ///   - resourceRoots: Directories whose files may be requested by the document.
+    /// - Returns: A `easydict-dict://document/<id>.html` URL.
+    @nonobjc
+    func registerDocument(html: String, resourceRoots: [URL]) -> URL {
+        let identifier = UUID().uuidString
+        lock.withLock {
+            documents[identifier] = Data(html.utf8)
+            documentOrder.append(identifier)
+            while documentOrder.count > maxDocumentCount {
+                let evicted = documentOrder.removeFirst()
+                documents.removeValue(forKey: evicted)
+            }
+            for root in resourceRoots {
+                allowedResourceRoots.insert(root.standardizedFileURL.path)
+            }
+        }
+
+        return URL(string: "\(Self.scheme)://\(documentHost)/\(identifier).html")!
+    }
+
+    /// Returns the `easydict-dict://resource/...` URL that serves the file at `filePath`.
+    ///
+    /// The path is percent-encoded, including `'`, so the URL can be embedded in a
+    /// single-quoted JavaScript string such as `new Audio('...')`.
+    @nonobjc
+    func resourceURL(forFilePath filePath: String) -> URL {
+        var allowedCharacters = CharacterSet.urlPathAllowed
+        allowedCharacters.remove(charactersIn: "'")
+        let encodedPath = filePath.addingPercentEncoding(withAllowedCharacters: allowedCharacters) ?? filePath
+        let separator = encodedPath.hasPrefix("/") ? "" : "/"
+        return URL(string: "\(Self.scheme)://\(resourceHost)\(separator)\(encodedPath)")!
+    }
+
+    // MARK: - WKURLSchemeHandler
+
+    func webView(_ webView: WKWebView, start urlSchemeTask: any WKURLSchemeTask) {
+        guard let url = urlSchemeTask.request.url else {
+            urlSchemeTask.didFailWithError(URLError(.badURL))
+            return
+        }
+
+        let responseData: Data?
+        let mimeType: String
+        if let identifier = documentIdentifier(of: url) {
+            responseData = lock.withLock { documents[identifier] }
+            mimeType = "text/html"
+        } else {
+            let filePath = url.path.removingPercentEncoding ?? url.path
+            responseData = resourceData(atPath: filePath)
+            mimeType = UTType(filenameExtension: (filePath as NSString).pathExtension)?
+                .preferredMIMEType ?? "application/octet-stream"
+        }
+
+        guard let responseData else {
+            logError("Dictionary resource not found: \(url)")
+            urlSchemeTask.didFailWithError(URLError(.fileDoesNotExist))
+            return
+        }
+
+        let response = URLResponse(
+            url: url,
+            mimeType: mimeType,
+            expectedContentLength: responseData.count,
+            textEncodingName: mimeType == "text/html" ? "utf-8" : nil
+        )
+        urlSchemeTask.didReceive(response)
+        urlSchemeTask.didReceive(responseData)
+        urlSchemeTask.didFinish()
+    }
+
+    func webView(_ webView: WKWebView, stop urlSchemeTask: any WKURLSchemeTask) {
+        // Responses are delivered synchronously in `start`, nothing to cancel.
+    }
+
+    // MARK: Private
+
+    private let documentHost = "document"
+    private let resourceHost = "resource"
+
+    /// Keep a few documents alive so several query windows can load their results.
+    private let maxDocumentCount = 8
+
+    private let lock = NSLock()
+    private var documents: [String: Data] = [:]
+    private var documentOrder: [String] = []
+    private var allowedResourceRoots: Set<String> = []
+
+    /// Returns the document identifier of a `document/<id>.html` URL, or `nil` for resources.
+    private func documentIdentifier(of url: URL) -> String? {
+        guard url.host == documentHost, url.pathExtension == "html",
+              url.pathComponents.count == 2
+        else { return nil }
+        return url.deletingPathExtension().lastPathComponent
+    }
+
+    private func resourceData(atPath path: String) -> Data? {
+        let standardizedPath = URL(fileURLWithPath: path).standardizedFileURL.path
+        let isAllowed = lock.withLock {
+            allowedResourceRoots.contains { standardizedPath.hasPrefix($0 + "/") }
+        }
+        guard isAllowed else { return nil }
+
+        return try? Data(contentsOf: URL(fileURLWithPath: standardizedPath), options: .mappedIfSafe)
+    }
+}
@@ -38,6 +38,15 @@ class MDictService: QueryService, @unchecked Sendable {
         [.dictionary, .sentence]
     }
 
+    override func supportsSpeculativePrefetch() -> Bool {
+        true
+    }
+
+    /// Local lookups put no load on a provider, so there is nothing to share.
+    override func coalescingKey(text: String, from: Language, to: Language) -> String? {
+        nil
+    }
+
     override func intelligentQueryTextType() -> EZQueryTextType {
         [.dictionary, .sentence]
     }
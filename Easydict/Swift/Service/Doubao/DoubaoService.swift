@@ -83,10 +83,15 @@ public final class DoubaoService: StreamService {
         Self.defaultModelIdentifier
     }
 
+    override var usesLLMTransport: Bool {
+        true
+    }
+
     override func contentStreamTranslate(
         _ text: String,
         from: Language,
-        to: Language
+        to: Language,
+        queryType: EZQueryTextType
     )
         -> AsyncThrowingStream<String, Error> {
         AsyncThrowingStream { continuation in
@@ -107,10 +112,10 @@ public final class DoubaoService: StreamService {
                     let requestBody = buildRequestBody(text: text, transType: transType)
                     let urlRequest = try createURLRequest(body: requestBody)
 
-                    let (asyncBytes, response) = try await URLSession.shared.bytes(for: urlRequest)
+                    let (chunks, response) = try await LLMTransport.shared.dataChunks(for: urlRequest)
                     try validateHTTPResponse(response)
 
-                    try await processStreamBytes(asyncBytes, continuation: continuation)
+                    try await DoubaoSSEParser().yieldContent(of: chunks, to: continuation)
                     continuation.finish()
                 } catch is CancellationError {
                     logInfo("Doubao task was cancelled.")
@@ -126,9 +131,6 @@ public final class DoubaoService: StreamService {
 
     private var currentTask: Task<(), Never>?
 
-    /// SSE event type for translation delta updates
-    private let deltaEventType = "response.output_text.delta"
-
     /// Validates the API key, returns a QueryError if missing
     private func validateAPIKey() -> QueryError? {
         guard !apiKey.isEmpty else {
@@ -183,7 +185,7 @@ public final class DoubaoService: StreamService {
 
     /// Creates and configures URLRequest for Doubao API
     ///
-    /// Note: We use URLSession.shared.bytes instead of ChatQuery/Gemini-style requests because:
+    /// Note: We use pooled `LLMTransport` byte streams instead of ChatQuery/Gemini-style requests because:
     /// 1. Doubao provides a specialized translation API, not a general chat/LLM API
     /// 2. The API uses a unique format with "translation_options" parameter, which is incompatible with
     ///    standard chat message formats (system/user/assistant roles)
@@ -232,114 +234,51 @@ public final class DoubaoService: StreamService {
             throw QueryError(type: .api, message: errorMessage)
         }
     }
+}
 
-    /// Processes stream bytes and yields translation content
-    /// - Parameters:
-    ///   - asyncBytes: The async byte stream from URLSession
-    ///   - continuation: The continuation to yield translated content chunks
-    /// - Throws: CancellationError if task is cancelled, or other errors during processing
-    private func processStreamBytes(
-        _ asyncBytes: URLSession.AsyncBytes,
-        continuation: AsyncThrowingStream<String, Error>.Continuation
-    ) async throws {
-        var dataBuffer = Data()
-        var textBuffer = ""
-        let bufferThreshold = 1024 // Process in 1KB chunks for better performance
-
-        for try await byte in asyncBytes {
-            // Check for cancellation
-            try Task.checkCancellation()
-
-            dataBuffer.append(byte)
-
-            // Process bytes in larger chunks to improve performance
-            // Only attempt decoding when we have enough bytes or detect event boundary
-            guard dataBuffer.count >= bufferThreshold || byte == 0x0A else { // 0x0A is '\n'
-                continue
-            }
+// MARK: - DoubaoSSEParser
 
-            // Try to decode accumulated bytes as UTF-8
-            if let text = String(data: dataBuffer, encoding: .utf8) {
-                textBuffer.append(text)
-                dataBuffer.removeAll()
+/// Extracts translation deltas from Doubao server-sent events.
+///
+/// Doubao API returns SSE events in the format:
+/// ```
+/// event: response.output_text.delta
+/// data: {"type":"response.output_text.delta","delta":"text"}
+/// ```
+struct DoubaoSSEParser: ServerSentEventContentDecoder {
+    // MARK: Internal
 
-                // Process complete SSE events
-                processCompleteEvents(from: &textBuffer, continuation: continuation)
-            }
-            // If decoding fails, continue accumulating bytes (incomplete UTF-8 sequence)
+    /// Returns the delta text if the event is a valid translation delta, nil otherwise.
+    func content(of event: ServerSentEvent) -> String? {
+        guard event.type == deltaEventType, event.data != doneFlag else {
+            return nil
         }
 
-        // Process any remaining data in the buffer
-        if !dataBuffer.isEmpty, let text = String(data: dataBuffer, encoding: .utf8) {
-            textBuffer.append(text)
+        if case let .delta(delta) = Self.deltaExtractor.extract(from: event.data) {
+            return delta
         }
-
-        // Process any remaining complete events
-        processCompleteEvents(from: &textBuffer, continuation: continuation)
+        return decodeDelta(from: event.data)
     }
 
-    /// Processes complete SSE events from the accumulated text buffer.
-    ///
-    /// - Parameters:
-    ///   - textBuffer: The text buffer containing SSE events. It will be updated in place to keep any incomplete event data.
-    ///   - continuation: The async stream continuation used to yield parsed translation content.
-    private func processCompleteEvents(
-        from textBuffer: inout String,
-        continuation: AsyncThrowingStream<String, Error>.Continuation
-    ) {
-        let eventSeparator = "\n\n"
-        guard textBuffer.contains(eventSeparator) else { return }
-
-        // Split into complete events and retain remaining incomplete data
-        let parts = textBuffer.split(separator: eventSeparator, omittingEmptySubsequences: false)
-        textBuffer = String(parts.last ?? "")
-
-        for event in parts.dropLast() where !event.isEmpty {
-            guard let content = parseSSEEvent(String(event)) else { continue }
-            continuation.yield(content)
-        }
-    }
-
-    /// Parse SSE event and extract delta content
-    ///
-    /// Doubao API returns SSE events in the format:
-    /// ```
-    /// event: response.output_text.delta
-    /// data: {"type":"response.output_text.delta","delta":"text"}
-    /// ```
-    /// - Parameter event: The SSE event string to parse
-    /// - Returns: The delta text content if the event is a valid translation delta, nil otherwise
-    private func parseSSEEvent(_ event: String) -> String? {
-        let eventPrefix = "event:"
-        let dataPrefix = "data:"
-        let doneFlag = "[DONE]"
-
-        var eventType: String?
-        var jsonDataString: String?
-
-        for line in event.split(separator: "\n") {
-            if line.starts(with: eventPrefix) {
-                eventType = line.dropFirst(eventPrefix.count).trimmingCharacters(in: .whitespaces)
-            } else if line.starts(with: dataPrefix) {
-                jsonDataString = line.dropFirst(dataPrefix.count).trimmingCharacters(
-                    in: .whitespaces
-                )
-            }
-        }
-
-        guard eventType == deltaEventType,
-              let dataString = jsonDataString,
-              dataString != doneFlag,
-              let data = dataString.data(using: .utf8)
-        else {
-            return nil
-        }
-
-        guard let streamEvent = try? JSONDecoder().decode(DoubaoStreamEvent.self, from: data) else {
-            logError("Failed to decode Doubao SSE data: \(jsonDataString ?? "")")
+    /// Decodes a delta payload with `Codable`, for payloads the fast path does not handle.
+    func decodeDelta(from data: Data) -> String? {
+        guard let streamEvent = try? decoder.decode(DoubaoStreamEvent.self, from: data) else {
+            logError("Failed to decode Doubao SSE data: \(String(decoding: data, as: UTF8.self))")
             return nil
         }
 
         return streamEvent.delta
     }
+
+    /// Schema of `DoubaoStreamEvent`.
+    static let deltaExtractor = JSONDeltaExtractor([
+        .init("delta", .delta),
+    ])
+
+    // MARK: Private
+
+    /// SSE event type for translation delta updates
+    private let deltaEventType = "response.output_text.delta"
+    private let doneFlag = Data("[DONE]".utf8)
+    private let decoder = JSONDecoder()
 }
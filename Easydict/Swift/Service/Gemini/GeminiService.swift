@@ -79,7 +79,8 @@ public final class GeminiService: StreamService {
     override func contentStreamTranslate(
         _ text: String,
         from: Language,
-        to: Language
+        to: Language,
+        queryType: EZQueryTextType
     )
         -> AsyncThrowingStream<String, Error> {
         AsyncThrowingStream { continuation in
@@ -87,8 +88,6 @@ public final class GeminiService: StreamService {
                 currentTask.cancel()
             }
 
-            let queryType = queryType(text: text, from: from, to: to)
-
             currentTask = Task {
                 do {
                     let systemPrompt =
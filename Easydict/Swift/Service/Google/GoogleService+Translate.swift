@@ -194,8 +194,7 @@ extension GoogleService {
                                 components: normalResults,
                                 separatedBy: "\n"
                             ) ?? ""
-                        let signTo =
-                            signFunction.call(withArguments: [mergeString])?.toString() ?? ""
+                        let signTo = webAppSign(mergeString)
                         result.toSpeakURL = getAudioURL(
                             withText: mergeString,
                             language: languageCode(for: googleTo) ?? "",
@@ -222,7 +221,7 @@ extension GoogleService {
         to: Language,
         completion: @escaping (Any?, String?, NSMutableDictionary?, Error?) -> ()
     ) {
-        let sign = signFunction.call(withArguments: [text])?.toString() ?? ""
+        let sign = webAppSign(text)
 
         var url = "\(kGoogleTranslateURL)/translate_a/single"
         url += "?dt=at&dt=bd&dt=ex&dt=ld&dt=md&dt=qca&dt=rw&dt=rm&dt=ss&dt=t"
@@ -243,7 +242,7 @@ extension GoogleService {
             "q": text,
         ]
 
-        let request = googleJSONRequest(url: url, parameters: params)
+        let request = hedgedDataRequest { self.googleJSONRequest(url: url, parameters: params) }
         queryModel.setStop(
             {
                 request.cancel()
@@ -285,15 +284,15 @@ extension GoogleService {
 
     // MARK: - TKK Management
 
+    /// Computes the web app `tk` parameter for `text` with the cached TKK.
+    func webAppSign(_ text: String) -> String {
+        GoogleTranslateToken.sign(text, tkk: GoogleTKKCache.shared.tkk)
+    }
+
     func sendGetWebAppTKKRequest(completion: @escaping (String?, Error?) -> ()) {
         let url = kGoogleTranslateURL
 
-        googleHTMLRequest(url: url).responseData { [weak self] response in
-            guard let self = self else {
-                completion(nil, CancellationError())
-                return
-            }
-
+        hedgedDataRequest { self.googleHTMLRequest(url: url) }.responseData { response in
             if let error = response.error {
                 if (error as NSError).code == NSURLErrorCancelled {
                     completion(nil, CancellationError())
@@ -303,66 +302,54 @@ extension GoogleService {
                 return
             }
 
-            var tkkResult: String?
-            if let data = response.data,
-               let string = String(data: data, encoding: .utf8) {
-                // tkk:'437961.2280157552'
-                let pattern = "tkk:'\\d+\\.\\d+',"
-                let regex = try? NSRegularExpression(
-                    pattern: pattern, options: .caseInsensitive
-                )
-                let matches =
-                    regex?.matches(
-                        in: string,
-                        options: .reportCompletion,
-                        range: NSRange(location: 0, length: string.count)
-                    ) ?? []
-
-                for match in matches {
-                    let tkk = (string as NSString).substring(with: match.range)
-                    if tkk.count > 7 {
-                        tkkResult = (tkk as NSString).substring(
-                            with: NSRange(location: 5, length: tkk.count - 7)
-                        )
-                        break
-                    }
-                }
-            }
+            let tkk = response.data
+                .flatMap { String(data: $0, encoding: .utf8) }
+                .flatMap(self.scrapeTKK(from:))
+            completion(tkk, nil)
+        }
+    }
 
-            if let tkk = tkkResult, !tkk.isEmpty {
-                completion(tkk, nil)
-            } else if let tkk = windowObject.objectForKeyedSubscript("TKK").toString(),
-                      !tkk.isEmpty {
-                completion(tkk, nil)
-            } else {
-                completion(nil, QueryError(type: .api, message: "谷歌翻译获取 tkk 失败"))
+    /// Finds `tkk:'437961.2280157552'` in the web app page.
+    func scrapeTKK(from html: String) -> String? {
+        let marker = "tkk:'"
+        var searchRange = html.startIndex ..< html.endIndex
+        while let markerRange = html.range(of: marker, options: .caseInsensitive, range: searchRange) {
+            let valueStart = markerRange.upperBound
+            searchRange = valueStart ..< html.endIndex
+            guard let quote = html[valueStart...].firstIndex(of: "'") else { return nil }
+
+            let value = html[valueStart ..< quote]
+            let parts = value.split(separator: ".", omittingEmptySubsequences: false)
+            let isNumeric = parts.allSatisfy { part in
+                !part.isEmpty && part.allSatisfy { ("0" ... "9").contains($0) }
+            }
+            if parts.count == 2, isNumeric {
+                return String(value)
             }
         }
+        return nil
     }
 
+    /// Refreshes the cached TKK when it is older than `GoogleTKKCache.refreshInterval`.
+    ///
+    /// A page without a TKK keeps the current value, so only network errors fail here.
     func updateWebAppTKK(completion: @escaping (Error?) -> ()) {
-        let now = Int64(Date().timeIntervalSince1970) / 3600
-        if let tkk = windowObject.objectForKeyedSubscript("TKK").toString(),
-           let firstComponent = tkk.components(separatedBy: ".").first,
-           let tkkTime = Int64(firstComponent),
-           tkkTime == now {
+        let cache = GoogleTKKCache.shared
+        guard cache.needsRefresh else {
             completion(nil)
             return
         }
 
-        sendGetWebAppTKKRequest { [weak self] tkk, error in
-            guard let self = self else {
-                completion(CancellationError())
+        sendGetWebAppTKKRequest { tkk, error in
+            if let error {
+                completion(error)
                 return
             }
-            if let tkk = tkk {
-                windowObject.setObject(
-                    tkk, forKeyedSubscript: "TKK" as NSCopying & NSObjectProtocol
-                )
-                completion(nil)
-            } else {
-                completion(error)
+            cache.update(tkk)
+            if let tkk {
+                logInfo("google tkk: \(tkk)")
             }
+            completion(nil)
         }
     }
 
@@ -388,7 +375,7 @@ extension GoogleService {
         to: Language,
         completion: @escaping (Any?, String?, NSMutableDictionary?, Error?) -> ()
     ) {
-        let sign = signFunction.call(withArguments: [text])?.toString() ?? ""
+        let sign = webAppSign(text)
         let url = "\(kGoogleTranslateURL)/translate_a/single"
 
         let fromLanguage = languageCode(for: from) ?? ""
@@ -404,7 +391,7 @@ extension GoogleService {
             "client": "gtx",
         ]
 
-        let request = googleJSONRequest(url: url, parameters: params)
+        let request = hedgedDataRequest { self.googleJSONRequest(url: url, parameters: params) }
         queryModel.setStop(
             {
                 request.cancel()
@@ -492,8 +479,7 @@ extension GoogleService {
                     let translatedText = translationArray.joined()
                     result.translatedResults = translatedText.toParagraphs()
 
-                    let signTo =
-                        signFunction.call(withArguments: [translatedText])?.toString() ?? ""
+                    let signTo = webAppSign(translatedText)
                     result.toSpeakURL = getAudioURL(
                         withText: translatedText,
                         language: languageCode(for: googleTo) ?? "",
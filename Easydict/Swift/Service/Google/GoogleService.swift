@@ -7,7 +7,6 @@
 //
 
 import Foundation
-import JavaScriptCore
 
 private let kGoogleTranslateURL = "https://translate.google.com"
 
@@ -15,25 +14,6 @@ private let kGoogleTranslateURL = "https://translate.google.com"
 
 @objc(EZGoogleService)
 class GoogleService: QueryService {
-    // MARK: - JavaScript Context
-
-    lazy var jsContext: JSContext = {
-        let context = JSContext()
-        if let jsPath = Bundle.main.path(forResource: "google-translate-sign", ofType: "js"),
-           let jsString = try? String(contentsOfFile: jsPath, encoding: .utf8) {
-            context?.evaluateScript(jsString)
-        }
-        return context!
-    }()
-
-    lazy var signFunction: JSValue = {
-        jsContext.objectForKeyedSubscript("sign")
-    }()
-
-    lazy var windowObject: JSValue = {
-        jsContext.objectForKeyedSubscript("window")
-    }()
-
     // MARK: - QueryService Override
 
     /// Translate text using Google web or GTX APIs.
@@ -80,6 +60,10 @@ class GoogleService: QueryService {
         .none
     }
 
+    override func supportsRequestHedging() -> Bool {
+        true
+    }
+
     override func supportedQueryType() -> EZQueryTextType {
         [.dictionary, .sentence, .translation]
     }
@@ -228,7 +212,7 @@ class GoogleService: QueryService {
 
         if fromLanguage == .auto {
             let lang = try await detectText(text)
-            let sign = signFunction.call(withArguments: [text])?.toString() ?? ""
+            let sign = webAppSign(text)
             let url = getAudioURL(
                 withText: text,
                 language: getTTSLanguageCode(lang, accent: accent),
@@ -238,7 +222,7 @@ class GoogleService: QueryService {
         }
 
         try await updateWebAppTKK()
-        let sign = signFunction.call(withArguments: [text])?.toString() ?? ""
+        let sign = webAppSign(text)
         let url = getAudioURL(
             withText: text,
             language: getTTSLanguageCode(fromLanguage, accent: accent),
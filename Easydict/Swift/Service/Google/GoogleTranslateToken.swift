@@ -0,0 +1,126 @@
+//
+//  GoogleTranslateToken.swift
+//  Easydict
+//
+//  Created by tisfeng on 2026/10/19.
+//  Copyright © 2026 izual. All rights reserved.
+//
+
+import Foundation
+
+// MARK: - GoogleTranslateToken
+
+/// Native port of the Google translate web `tk` sign function (`sM` in the web app).
+///
+/// The arithmetic mirrors JavaScript number semantics exactly: values are integral
+/// doubles, bitwise operators work on their 32-bit two's complement form, `>>>` is an
+/// unsigned shift and `(a + d) & 4294967295` yields a signed 32-bit value. Intermediate
+/// values are kept in `Int64`, which holds every value the JS version can produce.
+enum GoogleTranslateToken {
+    /// TKK embedded in the web app script, used until a fresher one is fetched.
+    static let defaultTKK = "444000.1270171236"
+
+    /// Returns the `tk` parameter for `text`, e.g. `"95794.511634"`.
+    static func sign(_ text: String, tkk: String = defaultTKK) -> String {
+        let components = tkk.components(separatedBy: ".")
+        let base = jsNumber(components[0])
+        let key = components.count > 1 ? jsNumber(components[1]) : 0
+
+        // Swift strings are always valid Unicode, so their UTF-8 view matches the
+        // surrogate-pair aware encoding loop of the JS version byte for byte.
+        var a = base
+        for byte in text.utf8 {
+            a += Int64(byte)
+            a = transform(a, "+-a^+6")
+        }
+        a = transform(a, "+-3^+b+-f")
+        a = Int64(toInt32(a) ^ toInt32(key))
+        if a < 0 {
+            a = Int64(toInt32(a) & 2147483647) + 2147483648
+        }
+        a %= 1_000_000
+        return "\(a).\(toInt32(a) ^ toInt32(base))"
+    }
+
+    // MARK: Private
+
+    /// The `xr` helper: applies shift/add/xor steps encoded as three-character groups.
+    private static func transform(_ value: Int64, _ steps: StaticString) -> Int64 {
+        var a = value
+        let bytes = steps.withUTF8Buffer { Array($0) }
+        var index = 0
+        while index < bytes.count - 2 {
+            let amountChar = bytes[index + 2]
+            let amount = amountChar >= UInt8(ascii: "a")
+                ? Int64(amountChar) - 87
+                : Int64(amountChar - UInt8(ascii: "0"))
+
+            let d: Int64 = bytes[index + 1] == UInt8(ascii: "+")
+                ? Int64(toUInt32(a) >> UInt32(amount))
+                : Int64(toInt32(a) << Int32(amount))
+
+            a = bytes[index] == UInt8(ascii: "+")
+                ? Int64(toInt32(a + d))
+                : Int64(toInt32(a) ^ toInt32(d))
+            index += 3
+        }
+        return a
+    }
+
+    /// `Number(string) || 0` for the integral TKK components.
+    private static func jsNumber(_ string: String) -> Int64 {
+        let trimmed = string.trimmingCharacters(in: .whitespacesAndNewlines)
+        guard let value = Double(trimmed), value.isFinite else { return 0 }
+        return Int64(value.truncatingRemainder(dividingBy: 4294967296))
+    }
+
+    private static func toInt32(_ value: Int64) -> Int32 {
+        Int32(truncatingIfNeeded: value)
+    }
+
+    private static func toUInt32(_ value: Int64) -> UInt32 {
+        UInt32(truncatingIfNeeded: value)
+    }
+}
+
+// MARK: - GoogleTKKCache
+
+/// Process-wide TKK, refreshed from the web app at most once per `refreshInterval`.
+///
+/// The web app rotates TKK hourly, and its first component is the hour it was issued.
+/// A fetch that finds no TKK in the page keeps the current value but still counts as a
+/// refresh, so an unreachable or changed page does not trigger a download per query.
+final class GoogleTKKCache: @unchecked Sendable {
+    // MARK: Internal
+
+    static let shared = GoogleTKKCache()
+
+    static let refreshInterval: TimeInterval = 3600
+
+    var tkk: String {
+        lock.withLock { value }
+    }
+
+    var needsRefresh: Bool {
+        lock.withLock {
+            guard let refreshDate else { return true }
+            return Date().timeIntervalSince(refreshDate) >= Self.refreshInterval
+        }
+    }
+
+    /// Stores a freshly fetched TKK, or only marks the refresh when `tkk` is nil.
+    func update(_ tkk: String?, at date: Date = Date()) {
+        lock.withLock {
+            if let tkk, !tkk.isEmpty {
+                value = tkk
+            }
+            refreshDate = date
+        }
+    }
+
+    // MARK: Private
+
+    private let lock = NSLock()
+    private var value = GoogleTranslateToken.defaultTKK
+    private var refreshDate: Date?
+}
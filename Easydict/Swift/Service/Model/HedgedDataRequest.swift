@@ -0,0 +1,213 @@
+//
+//  HedgedDataRequest.swift
+//  Easydict
+//
+//  Created by tisfeng on 2026/10/19.
+//  Copyright © 2026 izual. All rights reserved.
+//
+
+import Alamofire
+import Defaults
+import Foundation
+
+// MARK: - HedgedDataRequest
+
+/// An Alamofire data request that is re-issued when it outlives the service's usual latency.
+///
+/// The primary request starts immediately. When hedging is enabled and no response has
+/// arrived after the endpoint's p95 latency (see `RequestLatencyRecorder.hedgeDelay(for:)`),
+/// a duplicate, or the `alternate` request if given, is sent as well. The first successful
+/// response wins and the other request is cancelled. Transport errors and non-2xx status
+/// codes count as losses, so a fast error page cannot beat a slower valid response; a
+/// failure is only reported once no request is left in flight. Latency of every successful
+/// request is recorded per service and endpoint (host and path of the primary request),
+/// because one service's endpoints can differ widely in latency.
+final class HedgedDataRequest: @unchecked Sendable {
+    // MARK: Lifecycle
+
+    init(
+        label: String,
+        isHedgingEnabled: Bool,
+        makeRequest: @escaping () -> DataRequest,
+        alternate: (() -> DataRequest)? = nil
+    ) {
+        self.label = label
+        self.isHedgingEnabled = isHedgingEnabled
+        self.makeRequest = makeRequest
+        self.alternate = alternate
+    }
+
+    // MARK: Internal
+
+    /// Requests issued so far, primary first.
+    var requests: [DataRequest] {
+        lock.withLock { issuedRequests }
+    }
+
+    /// Starts the request; `completion` is called once, on the main queue.
+    func responseData(completion: @escaping (AFDataResponse<Data>) -> ()) {
+        lock.withLock {
+            self.completion = completion
+            startTime = .now()
+        }
+
+        let primary = launch(makeRequest, isHedge: false)
+        let latencyLabel = Self.latencyLabel(label, of: primary)
+        lock.withLock {
+            self.latencyLabel = latencyLabel
+        }
+
+        guard isHedgingEnabled else { return }
+
+        let delay = RequestLatencyRecorder.shared.hedgeDelay(for: latencyLabel)
+        let workItem = DispatchWorkItem { [weak self] in
+            self?.launchHedge(after: delay)
+        }
+        lock.withLock {
+            hedgeWorkItem = workItem
+        }
+        DispatchQueue.main.asyncAfter(deadline: .now() + delay, execute: workItem)
+    }
+
+    /// Starts the request and returns its data, cancelling it when the task is cancelled.
+    func data() async throws -> Data {
+        try await withTaskCancellationHandler {
+            try await withCheckedThrowingContinuation { continuation in
+                responseData { response in
+                    continuation.resume(with: response.result)
+                }
+            }
+        } onCancel: {
+            cancel()
+        }
+    }
+
+    func cancel() {
+        let (requests, workItem) = lock.withLock {
+            isCancelled = true
+            return (issuedRequests, hedgeWorkItem)
+        }
+        workItem?.cancel()
+        requests.forEach { $0.cancel() }
+    }
+
+    // MARK: Private
+
+    private let label: String
+    private let isHedgingEnabled: Bool
+    private let makeRequest: () -> DataRequest
+    private let alternate: (() -> DataRequest)?
+
+    private let lock = NSLock()
+    private var completion: ((AFDataResponse<Data>) -> ())?
+    private var startTime = DispatchTime.now()
+    private var latencyLabel: String?
+    private var issuedRequests: [DataRequest] = []
+    private var inFlightCount = 0
+    private var hedgeWorkItem: DispatchWorkItem?
+    private var didHedge = false
+    private var isFinished = false
+    private var isCancelled = false
+
+    /// Histogram label of a request: the service label followed by the request's host and path.
+    private static func latencyLabel(_ label: String, of request: DataRequest) -> String {
+        guard let url = try? request.convertible.asURLRequest().url, let host = url.host else {
+            return label
+        }
+        return "\(label) \(host)\(url.path)"
+    }
+
+    @discardableResult
+    private func launch(_ factory: () -> DataRequest, isHedge: Bool) -> DataRequest {
+        let request = factory()
+        let isCancelled = lock.withLock {
+            issuedRequests.append(request)
+            inFlightCount += 1
+            return self.isCancelled
+        }
+
+        // The hedged request keeps itself alive until one of its requests finishes it.
+        request.responseData { response in
+            self.handle(response, from: request, isHedge: isHedge)
+        }
+
+        if isCancelled {
+            request.cancel()
+        }
+        return request
+    }
+
+    private func launchHedge(after delay: TimeInterval) {
+        let shouldHedge = lock.withLock {
+            guard !isFinished, !isCancelled else { return false }
+            didHedge = true
+            return true
+        }
+        guard shouldHedge else { return }
+
+        logInfo("\(label) request exceeded \(Int(delay * 1000))ms, sending hedged request")
+        launch(alternate ?? makeRequest, isHedge: true)
+    }
+
+    private func handle(_ response: AFDataResponse<Data>, from request: DataRequest, isHedge: Bool) {
+        let statusCode = response.response?.statusCode ?? 0
+        let succeeded = response.error == nil && (200 ..< 300).contains(statusCode)
+
+        typealias Outcome = (
+            completion: ((AFDataResponse<Data>) -> ())?,
+            losers: [DataRequest],
+            didHedge: Bool,
+            latencyLabel: String
+        )
+        let outcome = lock.withLock { () -> Outcome? in
+            guard !isFinished else { return nil }
+            inFlightCount -= 1
+            guard succeeded || inFlightCount == 0 else { return nil }
+
+            isFinished = true
+            hedgeWorkItem?.cancel()
+            hedgeWorkItem = nil
+            let completion = completion
+            self.completion = nil
+            let losers = issuedRequests.filter { $0.id != request.id }
+            return (completion, losers, didHedge, latencyLabel ?? label)
+        }
+        guard let outcome else { return }
+
+        if succeeded {
+            outcome.losers.forEach { $0.cancel() }
+            let elapsed = Double(DispatchTime.now().uptimeNanoseconds - startTime.uptimeNanoseconds) / 1_000_000
+            RequestLatencyRecorder.shared.record(
+                outcome.latencyLabel,
+                milliseconds: elapsed,
+                hedged: outcome.didHedge,
+                hedgeWon: isHedge
+            )
+        }
+        outcome.completion?(response)
+    }
+}
+
+// MARK: - QueryService + Hedging
+
+extension QueryService {
+    /// Whether this service's web requests are hedged, i.e. the service opts in and the
+    /// user enabled hedged requests.
+    var isRequestHedgingEnabled: Bool {
+        supportsRequestHedging() && Defaults[.enableHedgedRequests]
+    }
+
+    /// Wraps a data request of this service in a `HedgedDataRequest`.
+    func hedgedDataRequest(
+        alternate: (() -> DataRequest)? = nil,
+        _ makeRequest: @escaping () -> DataRequest
+    )
+        -> HedgedDataRequest {
+        HedgedDataRequest(
+            label: serviceType().rawValue,
+            isHedgingEnabled: isRequestHedgingEnabled,
+            makeRequest: makeRequest,
+            alternate: alternate
+        )
+    }
+}
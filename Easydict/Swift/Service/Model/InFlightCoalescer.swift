@@ -0,0 +1,249 @@
+//
+//  InFlightCoalescer.swift
+//  Easydict
+//
+//  Created by tisfeng on 2026/10/19.
+//  Copyright © 2026 izual. All rights reserved.
+//
+
+import Foundation
+
+// MARK: - InFlightCoalescer
+
+/// Single-flight layer that lets concurrent identical queries share one upstream call.
+///
+/// The mini window, the fixed window and HTTP clients each create their own service
+/// instances, so the same text queried from several places at once would otherwise hit the
+/// provider once per caller. Requests are keyed by `QueryService.coalescingKey(text:from:to:)`:
+/// - `value(for:operation:)` runs one operation and hands its result to every waiter.
+/// - `stream(for:owner:makeStream:)` runs one upstream stream and fans it out; a late
+///   subscriber first receives every element yielded so far.
+///
+/// An upstream call is cancelled once all of its callers are gone, and a key is released as
+/// soon as its call finishes, so results are never cached beyond the call itself.
+final class InFlightCoalescer: @unchecked Sendable {
+    // MARK: Internal
+
+    static let shared = InFlightCoalescer()
+
+    /// Number of calls currently shared or running, for diagnostics and tests.
+    var inFlightCount: Int {
+        lock.withLock { valueFlights.count + streamFlights.count }
+    }
+
+    /// Returns the result of `operation`, joining an identical call already in flight.
+    func value<T>(
+        for key: String,
+        operation: @escaping @Sendable () async throws -> T
+    ) async throws
+        -> T {
+        let (flight, isLeader) = lock.withLock { () -> (ValueFlight<T>, Bool) in
+            if let flight = valueFlights[key] as? ValueFlight<T> {
+                flight.waiterCount += 1
+                return (flight, false)
+            }
+            let flight = ValueFlight(task: Task { try await operation() })
+            valueFlights[key] = flight
+            return (flight, true)
+        }
+        QueryMetrics.recordCacheLookup("in_flight_request", hit: !isLeader)
+        if !isLeader {
+            logInfo("coalesced in-flight request: \(key.prefix(80))")
+        }
+
+        defer {
+            lock.withLock {
+                if valueFlights[key] === flight {
+                    valueFlights[key] = nil
+                }
+            }
+        }
+
+        return try await withTaskCancellationHandler {
+            try await flight.task.value
+        } onCancel: {
+            leave(flight, key: key)
+        }
+    }
+
+    /// Returns a subscription to the upstream stream for `key`, starting `makeStream` when
+    /// no identical stream is in flight.
+    ///
+    /// - Parameter owner: Subscriptions can be cancelled per owner with
+    ///   `cancelSubscriptions(of:)`, e.g. when its query window stops.
+    func stream<Element>(
+        for key: String,
+        owner: AnyObject,
+        makeStream: @escaping () -> AsyncThrowingStream<Element, Error>
+    )
+        -> AsyncThrowingStream<Element, Error> {
+        AsyncThrowingStream { continuation in
+            let subscriberID = UUID()
+            let flight = lock.withLock { () -> StreamFlight<Element>? in
+                if let flight = streamFlights[key] as? StreamFlight<Element> {
+                    logInfo("coalesced in-flight stream: \(key.prefix(80))")
+                    // Replay under the lock, so no element is missed or delivered twice.
+                    flight.buffer.forEach { continuation.yield($0) }
+                    flight.subscribers[subscriberID] = Subscriber(owner: ObjectIdentifier(owner), continuation: continuation)
+                    return nil
+                }
+                let flight = StreamFlight<Element>()
+                flight.subscribers[subscriberID] = Subscriber(owner: ObjectIdentifier(owner), continuation: continuation)
+                streamFlights[key] = flight
+                return flight
+            }
+
+            continuation.onTermination = { [weak self] _ in
+                self?.unsubscribe(subscriberID, key: key)
+            }
+
+            // Only the first subscriber starts the upstream stream.
+            QueryMetrics.recordCacheLookup("in_flight_stream", hit: flight == nil)
+            guard let flight else { return }
+            let task = Task { [weak self] in
+                do {
+                    for try await element in makeStream() {
+                        self?.broadcast(element, from: flight)
+                    }
+                    self?.finish(flight, key: key, error: nil)
+                } catch {
+                    self?.finish(flight, key: key, error: error)
+                }
+            }
+            lock.withLock {
+                flight.task = task
+            }
+        }
+    }
+
+    /// Ends every stream subscription of `owner` with a `CancellationError`.
+    func cancelSubscriptions(of owner: AnyObject) {
+        let ownerID = ObjectIdentifier(owner)
+        let continuations = lock.withLock {
+            streamFlights.values.flatMap { $0.removeSubscribers(of: ownerID) }
+        }
+        // Finishing triggers `onTermination`, which takes the lock again.
+        continuations.forEach { $0() }
+    }
+
+    // MARK: Private
+
+    private final class ValueFlight<T>: AnyValueFlight {
+        // MARK: Lifecycle
+
+        init(task: Task<T, Error>) {
+            self.task = task
+        }
+
+        // MARK: Internal
+
+        let task: Task<T, Error>
+        var waiterCount = 1
+
+        func cancel() {
+            task.cancel()
+        }
+    }
+
+    private struct Subscriber<Element> {
+        let owner: ObjectIdentifier
+        let continuation: AsyncThrowingStream<Element, Error>.Continuation
+    }
+
+    private final class StreamFlight<Element>: AnyStreamFlight {
+        var buffer: [Element] = []
+        var subscribers: [UUID: Subscriber<Element>] = [:]
+        var task: Task<(), Never>?
+
+        var isIdle: Bool {
+            subscribers.isEmpty
+        }
+
+        func removeSubscriber(_ id: UUID) {
+            subscribers[id] = nil
+        }
+
+        func removeSubscribers(of owner: ObjectIdentifier) -> [() -> ()] {
+            let owned = subscribers.filter { $0.value.owner == owner }
+            owned.keys.forEach { subscribers[$0] = nil }
+            return owned.values.map { subscriber in
+                { subscriber.continuation.finish(throwing: CancellationError()) }
+            }
+        }
+
+        func cancel() {
+            task?.cancel()
+        }
+    }
+
+    private let lock = NSLock()
+    private var valueFlights: [String: AnyValueFlight] = [:]
+    private var streamFlights: [String: AnyStreamFlight] = [:]
+
+    private func leave<T>(_ flight: ValueFlight<T>, key: String) {
+        let shouldCancel = lock.withLock {
+            flight.waiterCount -= 1
+            guard flight.waiterCount == 0 else { return false }
+            if valueFlights[key] === flight {
+                valueFlights[key] = nil
+            }
+            return true
+        }
+        if shouldCancel {
+            flight.cancel()
+        }
+    }
+
+    private func broadcast<Element>(_ element: Element, from flight: StreamFlight<Element>) {
+        let continuations = lock.withLock {
+            flight.buffer.append(element)
+            return flight.subscribers.values.map(\.continuation)
+        }
+        continuations.forEach { $0.yield(element) }
+    }
+
+    private func finish<Element>(_ flight: StreamFlight<Element>, key: String, error: Error?) {
+        let continuations = lock.withLock {
+            if streamFlights[key] === flight {
+                streamFlights[key] = nil
+            }
+            defer { flight.subscribers.removeAll() }
+            return flight.subscribers.values.map(\.continuation)
+        }
+        for continuation in continuations {
+            if let error {
+                continuation.finish(throwing: error)
+            } else {
+                continuation.finish()
+            }
+        }
+    }
+
+    private func unsubscribe(_ subscriberID: UUID, key: String) {
+        let idleFlight = lock.withLock { () -> AnyStreamFlight? in
+            guard let flight = streamFlights[key] else { return nil }
+            flight.removeSubscriber(subscriberID)
+            guard flight.isIdle else { return nil }
+            streamFlights[key] = nil
+            return flight
+        }
+        // The last subscriber left, nobody needs the upstream stream anymore.
+        idleFlight?.cancel()
+    }
+}
+
+// MARK: - AnyValueFlight
+
+private protocol AnyValueFlight: AnyObject {
+    func cancel()
+}
+
+// MARK: - AnyStreamFlight
+
+private protocol AnyStreamFlight: AnyObject {
+    var isIdle: Bool { get }
+
+    func removeSubscriber(_ id: UUID)
+    func removeSubscribers(of owner: ObjectIdentifier) -> [() -> ()]
+    func cancel()
+}
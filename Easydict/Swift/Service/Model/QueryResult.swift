@@ -299,6 +299,30 @@ public class QueryResult: NSObject {
         showReplaceButton = false
     }
 
+    /// Copies the output fields of `other`, e.g. a result shared by a coalesced request.
+    /// View state such as `isShowing` and the query model are left untouched.
+    func copyOutput(from other: QueryResult) {
+        queryText = other.queryText
+        from = other.from
+        to = other.to
+        translatedResults = other.translatedResults
+        wordResult = other.wordResult
+        error = other.error
+        validationMessage = other.validationMessage
+        fromSpeakURL = other.fromSpeakURL
+        toSpeakURL = other.toSpeakURL
+        raw = other.raw
+        promptTitle = other.promptTitle
+        promptURL = other.promptURL
+        showBigWord = other.showBigWord
+        translateResultsTopInset = other.translateResultsTopInset
+        isStreamFinished = other.isStreamFinished
+        htmlString = other.htmlString
+        htmlStrings = other.htmlStrings
+        innerTexts = other.innerTexts
+        storedCopiedText = other.storedCopiedText
+    }
+
     /// Converts translated results to Traditional Chinese.
     func convertToTraditionalChineseResult() {
         translatedResults = translatedResults?.toTraditionalChineseTexts()
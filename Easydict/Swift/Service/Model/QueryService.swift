@@ -229,7 +229,7 @@ open class QueryService: NSObject {
             return prehandleResult
         }
 
-        return try await translate(queryText, from: fromLanguage, to: targetLanguage)
+        return try await coalescedTranslate(queryText, from: fromLanguage, to: targetLanguage)
     }
 
     /// Starts a query and reports incremental results on the main thread.
@@ -272,62 +272,102 @@ open class QueryService: NSObject {
         queryModel.setStop({ [weak self] in
             task.cancel()
             self?.cancelStream()
+            if let self {
+                InFlightCoalescer.shared.cancelSubscriptions(of: self)
+            }
         }, serviceType: serviceType)
     }
 
     /// Starts a query using async stream and yields incremental results.
+    ///
+    /// The query is measured by a `QueryMetricsSpan` and traced in a child span of
+    /// `queryModel.traceSpanID`, both bound to every task the query starts.
     open func startQueryStream(_ queryModel: QueryModel)
         -> AsyncThrowingStream<QueryResult, Error> {
-        AsyncThrowingStream { [weak self] continuation in
-            Task {
-                guard let self else {
-                    continuation.finish()
-                    return
-                }
-
-                self.queryModel = queryModel
+        let serviceID = serviceTypeWithUniqueIdentifier()
+        let span = QueryMetricsSpan(service: serviceID)
+        let traceSpanID = QueryTracer.shared.beginSpan(serviceID, parent: queryModel.traceSpanID, lane: serviceID)
+        let finishSpans = { (error: Error?) in
+            span.finish(error: error)
+            QueryTracer.shared.endSpan(traceSpanID)
+        }
 
-                let queryText = queryModel.queryText
-                let fromLanguage = queryModel.queryFromLanguage
-                let targetLanguage = queryModel.queryTargetLanguage
+        return AsyncThrowingStream { [weak self] continuation in
+            QueryMetrics.$current.withValue(span) {
+                QueryTracer.$currentSpanID.withValue(traceSpanID) {
+                    Task {
+                        guard let self else {
+                            finishSpans(CancellationError())
+                            continuation.finish()
+                            return
+                        }
 
-                var didYieldError = false
+                        self.queryModel = queryModel
 
-                do {
-                    let (handled, prehandleResult) = try await self.prehandleQueryText(
-                        queryText,
-                        from: fromLanguage,
-                        to: targetLanguage
-                    )
-                    if handled {
-                        continuation.yield(prehandleResult)
-                        continuation.finish()
-                        return
-                    }
+                        let queryText = queryModel.queryText
+                        let fromLanguage = queryModel.queryFromLanguage
+                        let targetLanguage = queryModel.queryTargetLanguage
 
-                    for try await result in self.translateStream(
-                        queryText,
-                        from: fromLanguage,
-                        to: targetLanguage
-                    ) {
-                        if result.error != nil {
-                            didYieldError = true
+                        var yieldedError: Error?
+                        let yield = { (result: QueryResult) in
+                            if let error = result.error {
+                                yieldedError = error
+                            } else if result.hasTranslatedResult {
+                                span.markFirstToken()
+                            }
+                            continuation.yield(result)
                         }
-                        continuation.yield(result)
-                    }
 
-                    continuation.finish()
-                } catch is CancellationError {
-                    continuation.finish()
-                } catch {
-                    if !didYieldError {
-                        let errorResult = self.ensureResult()
-                        if errorResult.error == nil {
-                            errorResult.error = QueryError.queryError(from: error)
+                        do {
+                            let (handled, prehandleResult) = try await self.prehandleQueryText(
+                                queryText,
+                                from: fromLanguage,
+                                to: targetLanguage
+                            )
+                            if handled {
+                                yield(prehandleResult)
+                                finishSpans(yieldedError)
+                                continuation.finish()
+                                return
+                            }
+
+                            if let lookup = SelectionPrefetcher.shared.takeLookup(
+                                for: self,
+                                text: queryText,
+                                from: fromLanguage,
+                                to: targetLanguage
+                            ) {
+                                yield(try self.adoptSpeculativeLookup(lookup))
+                                finishSpans(yieldedError)
+                                continuation.finish()
+                                return
+                            }
+
+                            for try await result in self.translateStream(
+                                queryText,
+                                from: fromLanguage,
+                                to: targetLanguage
+                            ) {
+                                yield(result)
+                            }
+
+                            finishSpans(yieldedError)
+                            continuation.finish()
+                        } catch is CancellationError {
+                            finishSpans(CancellationError())
+                            continuation.finish()
+                        } catch {
+                            finishSpans(error)
+                            if yieldedError == nil {
+                                let errorResult = self.ensureResult()
+                                if errorResult.error == nil {
+                                    errorResult.error = QueryError.queryError(from: error)
+                                }
+                                continuation.yield(errorResult)
+                            }
+                            continuation.finish(throwing: error)
                         }
-                        continuation.yield(errorResult)
                     }
-                    continuation.finish(throwing: error)
                 }
             }
         }
@@ -399,7 +439,7 @@ open class QueryService: NSObject {
                 }
 
                 do {
-                    let result = try await self.translate(text, from: from, to: to)
+                    let result = try await self.coalescedTranslate(text, from: from, to: to)
                     continuation.yield(result)
                     continuation.finish()
                 } catch is CancellationError {
@@ -454,6 +494,78 @@ open class QueryService: NSObject {
         false
     }
 
+    /// Whether web requests may be hedged with a duplicate when they run slow, see
+    /// `HedgedDataRequest`. Only idempotent, keyless web endpoints should opt in.
+    open func supportsRequestHedging() -> Bool {
+        false
+    }
+
+    /// Identifies queries that would send the same upstream request, so concurrent ones can
+    /// share it through `InFlightCoalescer`; nil opts out.
+    ///
+    /// Services are configured per type and unique identifier, so by default that plus the
+    /// query type, languages and text is enough. Override to add per-instance settings.
+    open func coalescingKey(text: String, from: Language, to: Language) -> String? {
+        [
+            serviceTypeWithUniqueIdentifier(),
+            "\(queryType.rawValue)",
+            from.rawValue,
+            to.rawValue,
+            text,
+        ].joined(separator: "\u{1F}")
+    }
+
+    /// Runs `translate(_:from:to:)`, sharing one upstream call with concurrent identical queries.
+    ///
+    /// The shared call runs on a separate instance of this service, so stopping one caller
+    /// never aborts the others; its output is then copied into this service's result.
+    @nonobjc
+    open func coalescedTranslate(
+        _ text: String,
+        from: Language,
+        to: Language
+    ) async throws
+        -> QueryResult {
+        guard let key = coalescingKey(text: text, from: from, to: to) else {
+            return try await translate(text, from: from, to: to)
+        }
+
+        let sharedResult = try await InFlightCoalescer.shared.value(for: key) { [self] in
+            try await makeCoalescingUpstream().translate(text, from: from, to: to)
+        }
+        let result = ensureResult()
+        result.copyOutput(from: sharedResult)
+        return result
+    }
+
+    /// Returns a fresh instance with this service's configuration, for coalesced calls.
+    func makeCoalescingUpstream() -> Self {
+        let upstream = Self()
+        upstream.uuid = uuid
+        upstream.windowType = windowType
+        upstream.queryType = queryType
+        upstream.queryModel = queryModel
+        upstream.result = QueryResult()
+        return upstream
+    }
+
+    /// Whether `SelectionPrefetcher` may run this service on a selection before the user
+    /// asks for it. Only cheap, local lookups without quotas should opt in.
+    open func supportsSpeculativePrefetch() -> Bool {
+        false
+    }
+
+    /// Copies the output of a speculative lookup by `probe`, another instance of this
+    /// service, into the current result. Override to carry service-specific state.
+    open func adoptSpeculativeResult(_ prefetched: QueryResult, from probe: QueryService) -> QueryResult {
+        let result = ensureResult()
+        result.htmlString = prefetched.htmlString
+        result.htmlStrings = prefetched.htmlStrings
+        result.innerTexts = prefetched.innerTexts
+        result.translatedResults = prefetched.translatedResults
+        return result
+    }
+
     open func isDeletable(_ windowType: EZWindowType) -> Bool {
         true
     }
@@ -645,6 +757,12 @@ open class QueryService: NSObject {
         return (false, currentResult, nil)
     }
 
+    /// Returns the adopted result of a prefetched lookup, rethrowing its error.
+    private func adoptSpeculativeLookup(_ lookup: SelectionPrefetcher.Lookup) throws -> QueryResult {
+        let prefetched = try lookup.outcome.get()
+        return adoptSpeculativeResult(prefetched, from: lookup.probe)
+    }
+
     /// Ensure that `result` is non-nil and return it.
     private func ensureResult() -> QueryResult {
         if let result {
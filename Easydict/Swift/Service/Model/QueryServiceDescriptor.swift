@@ -0,0 +1,81 @@
+//
+//  QueryServiceDescriptor.swift
+//  Easydict
+//
+//  Created by tisfeng on 2026/10/19.
+//  Copyright © 2026 izual. All rights reserved.
+//
+
+import Foundation
+
+/// A lightweight description of a service in a window, read from the stored configuration
+/// without creating the service.
+///
+/// Building the service list of a window only needs the type, order and enabled state of
+/// each service. The `QueryService` instance, whose init may set up subscribers, is created
+/// the first time `service` is accessed, so disabled services are never instantiated.
+///
+/// Descriptors are not cached: `LocalStorage` builds new ones on every call, so each window
+/// setup still gets fresh service instances, and the selection prefetcher's probes never
+/// share state with a window's services.
+@objc(EZQueryServiceDescriptor)
+@objcMembers
+final class QueryServiceDescriptor: NSObject {
+    // MARK: Lifecycle
+
+    init(
+        serviceTypeId: String,
+        serviceType: ServiceType,
+        uuid: String,
+        windowType: EZWindowType,
+        enabled: Bool,
+        enabledQuery: Bool
+    ) {
+        self.serviceTypeId = serviceTypeId
+        self.serviceType = serviceType
+        self.uuid = uuid
+        self.windowType = windowType
+        self.enabled = enabled
+        self.enabledQuery = enabledQuery
+        super.init()
+    }
+
+    // MARK: Internal
+
+    /// Service type identifier, with the `#uuid` suffix of a duplicated service.
+    let serviceTypeId: String
+    /// Base service type.
+    let serviceType: ServiceType
+    let uuid: String
+    let windowType: EZWindowType
+    /// Whether the service is shown in the window.
+    let enabled: Bool
+    /// Whether the service queries automatically.
+    let enabledQuery: Bool
+
+    /// Whether `service` has been created.
+    var isInstantiated: Bool {
+        instance != nil
+    }
+
+    /// The service with the stored state applied, created on first access.
+    var service: QueryService {
+        if let instance {
+            return instance
+        }
+
+        guard let service = QueryServiceFactory.shared.service(withTypeId: serviceTypeId) else {
+            fatalError("Unsupported service type: \(serviceTypeId)")
+        }
+        service.enabled = enabled
+        service.enabledQuery = enabledQuery
+        service.windowType = windowType
+        service.uuid = uuid
+        instance = service
+        return service
+    }
+
+    // MARK: Private
+
+    private var instance: QueryService?
+}
@@ -49,6 +49,12 @@ final class QueryServiceFactory: NSObject {
         return service
     }
 
+    /// Whether a service type identifier, optionally with a `#uuid` suffix, is supported.
+    func supportsService(withTypeId typeIdIfHave: String) -> Bool {
+        let serviceTypeString = typeIdIfHave.split(separator: "#", maxSplits: 1).first.map(String.init) ?? typeIdIfHave
+        return serviceDictionary.object(forKey: serviceTypeString) != nil
+    }
+
     /// Creates `QueryService` instances from a list of service type identifiers.
     ///
     /// - Parameter types: An array of service type identifiers.
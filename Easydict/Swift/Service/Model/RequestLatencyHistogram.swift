@@ -0,0 +1,130 @@
+//
+//  RequestLatencyHistogram.swift
+//  Easydict
+//
+//  Created by tisfeng on 2026/10/19.
+//  Copyright © 2026 izual. All rights reserved.
+//
+
+import Foundation
+
+// MARK: - RequestLatencyHistogram
+
+/// Bucketed latency distribution of successful web requests to one service endpoint.
+struct RequestLatencyHistogram: CustomStringConvertible {
+    // MARK: Internal
+
+    /// Upper bounds of the buckets in milliseconds; a final overflow bucket holds the rest.
+    static let bucketBounds: [Double] = [
+        50, 100, 200, 300, 500, 750, 1000, 1500, 2000, 3000, 5000, 8000, 12000,
+    ]
+
+    private(set) var bucketCounts = Array(repeating: 0, count: bucketBounds.count + 1)
+    private(set) var sampleCount = 0
+    private(set) var maxMilliseconds = 0.0
+    /// Requests that issued a hedged duplicate.
+    private(set) var hedgedCount = 0
+    /// Requests won by the hedged duplicate rather than the primary.
+    private(set) var hedgeWinCount = 0
+
+    var description: String {
+        guard sampleCount > 0 else { return "no samples" }
+        return "n=\(sampleCount), p50=\(format(percentile(0.5))), p95=\(format(percentile(0.95))), "
+            + "p99=\(format(percentile(0.99))), max=\(format(maxMilliseconds)), "
+            + "hedged=\(hedgedCount), hedge wins=\(hedgeWinCount)"
+    }
+
+    mutating func record(milliseconds: Double, hedged: Bool = false, hedgeWon: Bool = false) {
+        let index = Self.bucketBounds.firstIndex { milliseconds <= $0 } ?? Self.bucketBounds.count
+        bucketCounts[index] += 1
+        sampleCount += 1
+        maxMilliseconds = max(maxMilliseconds, milliseconds)
+        if hedged {
+            hedgedCount += 1
+        }
+        if hedgeWon {
+            hedgeWinCount += 1
+        }
+    }
+
+    /// Estimated latency at `quantile` (0...1), interpolated linearly inside its bucket.
+    func percentile(_ quantile: Double) -> Double {
+        guard sampleCount > 0 else { return 0 }
+
+        let target = quantile * Double(sampleCount)
+        var cumulative = 0.0
+        for (index, count) in bucketCounts.enumerated() where count > 0 {
+            let next = cumulative + Double(count)
+            if next >= target {
+                guard index < Self.bucketBounds.count else { return maxMilliseconds }
+                let lower = index == 0 ? 0 : Self.bucketBounds[index - 1]
+                let upper = min(Self.bucketBounds[index], maxMilliseconds)
+                let fraction = (target - cumulative) / Double(count)
+                return lower + max(upper - lower, 0) * fraction
+            }
+            cumulative = next
+        }
+        return maxMilliseconds
+    }
+
+    // MARK: Private
+
+    private func format(_ milliseconds: Double) -> String {
+        String(format: "%.0fms", milliseconds)
+    }
+}
+
+// MARK: - RequestLatencyRecorder
+
+/// Collects per-endpoint latency histograms and derives hedging delays from them.
+final class RequestLatencyRecorder: @unchecked Sendable {
+    // MARK: Internal
+
+    static let shared = RequestLatencyRecorder()
+
+    func record(
+        _ label: String,
+        milliseconds: Double,
+        hedged: Bool = false,
+        hedgeWon: Bool = false
+    ) {
+        let histogram = lock.withLock {
+            histograms[label, default: RequestLatencyHistogram()]
+                .record(milliseconds: milliseconds, hedged: hedged, hedgeWon: hedgeWon)
+            return histograms[label]!
+        }
+
+        if histogram.sampleCount % Self.logInterval == 0 {
+            logInfo("\(label) request latency: \(histogram)")
+        }
+    }
+
+    func histogram(for label: String) -> RequestLatencyHistogram {
+        lock.withLock { histograms[label] ?? RequestLatencyHistogram() }
+    }
+
+    func allHistograms() -> [String: RequestLatencyHistogram] {
+        lock.withLock { histograms }
+    }
+
+    /// Delay after which a request to `label` is hedged: its p95 latency once enough
+    /// samples exist, clamped so a fast history cannot double every request.
+    func hedgeDelay(for label: String) -> TimeInterval {
+        let histogram = histogram(for: label)
+        guard histogram.sampleCount >= Self.minimumSamples else { return Self.defaultHedgeDelay }
+
+        let p95 = histogram.percentile(0.95) / 1000
+        return min(max(p95, Self.minimumHedgeDelay), Self.maximumHedgeDelay)
+    }
+
+    // MARK: Private
+
+    private static let logInterval = 20
+    private static let minimumSamples = 20
+    private static let defaultHedgeDelay: TimeInterval = 1.0
+    private static let minimumHedgeDelay: TimeInterval = 0.3
+    private static let maximumHedgeDelay: TimeInterval = 3.0
+
+    private let lock = NSLock()
+    private var histograms: [String: RequestLatencyHistogram] = [:]
+}
@@ -46,15 +46,15 @@ final class LocalStorage: NSObject {
     /// Total query character count.
 
     var queryCharacterCount: Int {
-        get { userDefaults.integer(forKey: Constants.queryCharacterCountKey) }
-        set { userDefaults.set(newValue, forKey: Constants.queryCharacterCountKey) }
+        get { usageCounters.totalUsage.queryCharacterCount }
+        set { usageCounters.totalUsage.queryCharacterCount = newValue }
     }
 
     /// Total query count.
 
     var queryCount: Int {
-        get { userDefaults.integer(forKey: Constants.queryCountKey) }
-        set { userDefaults.set(newValue, forKey: Constants.queryCountKey) }
+        get { usageCounters.totalUsage.queryCount }
+        set { usageCounters.totalUsage.queryCount = newValue }
     }
 
     // MARK: Singleton
@@ -71,8 +71,12 @@ final class LocalStorage: NSObject {
     }
 
     /// Destroys the shared storage instance (used for testing or hard resets).
+    ///
+    /// Pending service info and usage writes are dropped, so they cannot undo a reset.
     @objc(destroySharedInstance)
     static func destroySharedInstance() {
+        sharedInstance?.serviceConfigurations.discardPendingWrites()
+        sharedInstance?.usageCounters.discardPendingWrites()
         sharedInstance = nil
     }
 
@@ -89,10 +93,11 @@ final class LocalStorage: NSObject {
             return allServiceTypes
         }
 
-        for type in allServiceTypes where !storedTypes.contains(type) {
-            storedTypes.append(type)
+        let newTypes = allServiceTypes.filter { !storedTypes.contains($0) }
+        if !newTypes.isEmpty {
+            storedTypes.append(contentsOf: newTypes)
+            userDefaults.set(storedTypes, forKey: allServiceTypesKey)
         }
-        userDefaults.set(storedTypes, forKey: allServiceTypesKey)
         return storedTypes
     }
 
@@ -116,6 +121,42 @@ final class LocalStorage: NSObject {
         return services
     }
 
+    /// Returns descriptors of the services for the given window without creating them.
+    ///
+    /// Prefer this over `allServices(_:)` when only some services are used, such as the
+    /// enabled ones of a query window.
+    /// - Parameter windowType: Target window type.
+    /// - Returns: Service descriptors in the persisted order.
+    @objc(allServiceDescriptors:)
+    func allServiceDescriptors(_ windowType: EZWindowType) -> [QueryServiceDescriptor] {
+        allServiceTypes(windowType).compactMap { serviceTypeId in
+            guard QueryServiceFactory.shared.supportsService(withTypeId: serviceTypeId) else {
+                return nil
+            }
+
+            let (serviceType, uuid) = serviceTypeComponents(of: serviceTypeId)
+            let info = serviceInfo(withType: serviceType, serviceId: uuid, windowType: windowType)
+            return QueryServiceDescriptor(
+                serviceTypeId: serviceTypeId,
+                serviceType: serviceType,
+                uuid: info?.uuid ?? uuid,
+                windowType: windowType,
+                enabled: info?.enabled ?? true,
+                enabledQuery: info?.enabledQuery ?? true
+            )
+        }
+    }
+
+    /// Returns the enabled services for the given window, creating only those.
+    ///
+    /// Like `allServices(_:)`, every call returns new instances.
+    /// - Parameter windowType: Target window type.
+    /// - Returns: Enabled service instances with persisted state applied.
+    @objc(enabledServices:)
+    func enabledServices(_ windowType: EZWindowType) -> [QueryService] {
+        allServiceDescriptors(windowType).filter(\.enabled).map(\.service)
+    }
+
     /// Returns a service instance with persisted flags applied.
     /// - Parameters:
     ///   - serviceTypeId: Service type identifier, possibly containing a UUID suffix.
@@ -131,6 +172,8 @@ final class LocalStorage: NSObject {
     }
 
     /// Fetches persisted service info for a service type and id.
+    ///
+    /// Served from the in-memory snapshot; the stored data is decoded once per key.
     /// - Parameters:
     ///   - type: Service type identifier.
     ///   - serviceId: Unique service identifier.
@@ -143,27 +186,17 @@ final class LocalStorage: NSObject {
         windowType: EZWindowType
     )
         -> QueryServiceConfiguration? {
-        guard let data = storedServiceInfoData(type: type, serviceId: serviceId, windowType: windowType) else {
-            return nil
-        }
-
-        if let info = try? decoder.decode(QueryServiceConfiguration.self, from: data) {
-            return normalized(info, fallbackType: type, serviceId: serviceId, windowType: windowType)
+        let serviceInfoKey = key(forServiceType: type, serviceId: serviceId, windowType: windowType)
+        let entry = serviceConfigurations.entry(forKey: serviceInfoKey) { data in
+            decodeServiceInfo(from: data, fallbackType: type, serviceId: serviceId, windowType: windowType)
+                .map(ServiceConfigurationStore.Entry.init)
         }
-
-        if let legacyInfo = decodeLegacyServiceInfo(
-            from: data,
-            fallbackType: type,
-            serviceId: serviceId,
-            windowType: windowType
-        ) {
-            return legacyInfo
-        }
-
-        return nil
+        return entry?.configuration
     }
 
     /// Persists a service info record.
+    ///
+    /// The snapshot is updated immediately; the write to UserDefaults is coalesced.
     /// - Parameters:
     ///   - serviceInfo: Service info to persist.
     ///   - windowType: Target window type.
@@ -176,16 +209,12 @@ final class LocalStorage: NSObject {
             windowType: windowType
         )
 
-        guard let data = try? encoder.encode(normalizedInfo) else {
-            return
-        }
-
         let serviceInfoKey = key(
             forServiceType: normalizedInfo.type,
             serviceId: normalizedInfo.uuid,
             windowType: windowType
         )
-        userDefaults.set(data, forKey: serviceInfoKey)
+        serviceConfigurations.set(ServiceConfigurationStore.Entry(normalizedInfo), forKey: serviceInfoKey)
     }
 
     /// Persists a service's current state.
@@ -223,9 +252,8 @@ final class LocalStorage: NSObject {
     /// - Parameter queryText: Text used for the query.
     @objc(increaseQueryCount:)
     func increaseQueryCount(_ queryText: String) {
-        let currentCount = queryCount
+        let (currentCount, newCount) = usageCounters.recordQuery(characterCount: queryText.count)
         let currentLevel = queryLevel(for: currentCount)
-        let newCount = currentCount + 1
         let newLevel = queryLevel(for: newCount)
 
         if currentCount == 0 || newLevel != currentLevel {
@@ -239,21 +267,13 @@ final class LocalStorage: NSObject {
             ]
             AnalyticsService.logEvent(withName: "query_count", parameters: dict)
         }
-
-        queryCount = newCount
-        queryCharacterCount += queryText.count
     }
 
     /// Updates per-service query statistics.
     /// - Parameter service: Service being queried.
     @objc(increaseQueryService:)
     func increaseQueryService(_ service: QueryService) {
-        let serviceType = service.serviceType()
-        let record = record(with: serviceType)
-        let queryLength = service.queryModel.queryText.count
-        record.queryCount += 1
-        record.queryCharacterCount += queryLength
-        setQueryServiceRecord(record, serviceType: serviceType)
+        usageCounters.recordQuery(of: service.serviceType(), characterCount: service.queryModel.queryText.count)
 
         AnalyticsService.logQueryService(service)
     }
@@ -263,10 +283,10 @@ final class LocalStorage: NSObject {
     /// - Returns: `true` when the free quota is not exceeded.
     @objc(hasFreeQuotaLeft:)
     func hasFreeQuotaLeft(_ service: QueryService) -> Bool {
-        let record = record(with: service.serviceType())
+        let usage = usageCounters.usage(of: service.serviceType())
         let totalFreeCharacters = Double(service.totalFreeQueryCharacterCount()) * 0.9 /
             Double(Constants.totalUserCount)
-        return Double(record.queryCharacterCount) < totalFreeCharacters
+        return Double(usage.queryCharacterCount) < totalFreeCharacters
     }
 
     /// Whether the user is considered new.
@@ -280,18 +300,9 @@ final class LocalStorage: NSObject {
     private static var sharedInstance: LocalStorage?
 
     private let userDefaults = UserDefaults.standard
-    private let encoder = JSONEncoder()
     private let decoder = JSONDecoder()
-
-    /// Raw dictionary backing service query statistics.
-    private var queryServiceRecordDict: [String: [String: Any]] {
-        get {
-            userDefaults.dictionary(forKey: Constants.queryServiceRecordKey) as? [String: [String: Any]] ?? [:]
-        }
-        set {
-            userDefaults.set(newValue, forKey: Constants.queryServiceRecordKey)
-        }
-    }
+    private let serviceConfigurations = ServiceConfigurationStore()
+    private let usageCounters = QueryUsageStore()
 
     /// Ensures all known services have stored defaults for each window type.
     private func setup() {
@@ -301,10 +312,7 @@ final class LocalStorage: NSObject {
             let serviceTypeIds = allServiceTypes(windowType)
 
             for serviceTypeId in serviceTypeIds {
-                let components = serviceTypeId.split(separator: "#", maxSplits: 1, omittingEmptySubsequences: false)
-                let rawType = String(components.first ?? Substring(serviceTypeId))
-                let uuid = components.count > 1 ? String(components[1]) : ""
-                let baseType = ServiceType(rawValue: rawType)
+                let (baseType, uuid) = serviceTypeComponents(of: serviceTypeId)
 
                 if serviceInfo(withType: baseType, serviceId: uuid, windowType: windowType) == nil {
                     let serviceInfo = QueryServiceConfiguration(
@@ -321,7 +329,7 @@ final class LocalStorage: NSObject {
                         .builtInAI,
                     ]
 
-                    serviceInfo.enabled = defaultEnabledServices.contains { $0.rawValue == rawType }
+                    serviceInfo.enabled = defaultEnabledServices.contains(baseType)
                     setServiceInfo(serviceInfo, windowType: windowType)
                 }
             }
@@ -340,6 +348,16 @@ final class LocalStorage: NSObject {
         service.uuid = info?.uuid ?? service.uuid
     }
 
+    /// Splits a service type identifier into its base type and `#uuid` suffix.
+    /// - Parameter serviceTypeId: Service type identifier, possibly containing a UUID suffix.
+    /// - Returns: Base service type and UUID, empty when there is no suffix.
+    private func serviceTypeComponents(of serviceTypeId: String) -> (serviceType: ServiceType, uuid: String) {
+        let components = serviceTypeId.split(separator: "#", maxSplits: 1, omittingEmptySubsequences: false)
+        let rawType = String(components.first ?? Substring(serviceTypeId))
+        let uuid = components.count > 1 ? String(components[1]) : ""
+        return (ServiceType(rawValue: rawType), uuid)
+    }
+
     /// Builds the UserDefaults key for a service instance.
     /// - Parameters:
     ///   - serviceType: Base service type.
@@ -361,41 +379,6 @@ final class LocalStorage: NSObject {
         "\(Constants.allServiceTypesKey)-\(windowType.rawValue)"
     }
 
-    /// Reads or creates a per-service query usage record.
-    /// - Parameter serviceType: Service type to query.
-    /// - Returns: Usage record with counts.
-    private func record(with serviceType: ServiceType) -> QueryServiceRecord {
-        let dict = queryServiceRecordDict
-        if let recordDict = dict[serviceType.rawValue],
-           let queryCount = (recordDict["queryCount"] as? NSNumber)?.intValue ?? recordDict["queryCount"] as? Int,
-           let queryCharacterCount = (recordDict["queryCharacterCount"] as? NSNumber)?
-           .intValue ?? recordDict["queryCharacterCount"] as? Int {
-            return QueryServiceRecord(
-                serviceType: serviceType,
-                queryCount: queryCount,
-                queryCharacterCount: queryCharacterCount
-            )
-        }
-
-        let record = QueryServiceRecord(serviceType: serviceType, queryCount: 0, queryCharacterCount: 0)
-        setQueryServiceRecord(record, serviceType: serviceType)
-        return record
-    }
-
-    /// Persists a per-service query usage record.
-    /// - Parameters:
-    ///   - record: Usage record to store.
-    ///   - serviceType: Associated service type.
-    private func setQueryServiceRecord(_ record: QueryServiceRecord, serviceType: ServiceType) {
-        var dict = queryServiceRecordDict
-        dict[serviceType.rawValue] = [
-            "serviceType": record.serviceType.rawValue,
-            "queryCount": record.queryCount,
-            "queryCharacterCount": record.queryCharacterCount,
-        ]
-        queryServiceRecordDict = dict
-    }
-
     /// Calculates a query level bucket for a count.
     /// - Parameter count: Total query count.
     /// - Returns: Level index.
@@ -438,25 +421,30 @@ final class LocalStorage: NSObject {
         return chineseFlag ? titles[clampedLevel - 1] : enTitles[clampedLevel - 1]
     }
 
-    /// Retrieves persisted service info data with backward-compatible keys.
+    /// Decodes stored service info, falling back to the legacy format.
     /// - Parameters:
-    ///   - type: Service type identifier.
+    ///   - data: Stored JSON data.
+    ///   - fallbackType: Service type to use when missing.
     ///   - serviceId: Service UUID.
     ///   - windowType: Window scope.
-    /// - Returns: Stored data when available.
-    private func storedServiceInfoData(type: ServiceType, serviceId: String, windowType: EZWindowType) -> Data? {
-        let baseKey = key(forServiceType: type, serviceId: serviceId, windowType: windowType)
-        if let data = userDefaults.data(forKey: baseKey) {
-            return data
-        }
-
-        guard !serviceId.isEmpty else {
-            return nil
+    /// - Returns: Normalized service info when decoding succeeds.
+    private func decodeServiceInfo(
+        from data: Data,
+        fallbackType: ServiceType,
+        serviceId: String,
+        windowType: EZWindowType
+    )
+        -> QueryServiceConfiguration? {
+        if let info = try? decoder.decode(QueryServiceConfiguration.self, from: data) {
+            return normalized(info, fallbackType: fallbackType, serviceId: serviceId, windowType: windowType)
         }
 
-        let uniqueType = ServiceType(rawValue: "\(type.rawValue)#\(serviceId)")
-        let uniqueKey = key(forServiceType: uniqueType, serviceId: serviceId, windowType: windowType)
-        return userDefaults.data(forKey: uniqueKey)
+        return decodeLegacyServiceInfo(
+            from: data,
+            fallbackType: fallbackType,
+            serviceId: serviceId,
+            windowType: windowType
+        )
     }
 
     /// Attempts to decode legacy JSON payloads saved by MJExtension.
@@ -539,9 +527,6 @@ final class LocalStorage: NSObject {
 private enum Constants {
     static let serviceInfoStorageKey = "kServiceInfoStorageKey"
     static let allServiceTypesKey = "kAllServiceTypesKey"
-    static let queryCountKey = "kQueryCountKey"
-    static let queryCharacterCountKey = "kQueryCharacterCountKey"
     static let appModelTriggerListKey = "kAppModelTriggerListKey"
-    static let queryServiceRecordKey = "kQueryServiceRecordKey"
     static let totalUserCount = 1000
 }
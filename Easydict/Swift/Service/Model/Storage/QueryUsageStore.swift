@@ -0,0 +1,176 @@
+//
+//  QueryUsageStore.swift
+//  Easydict
+//
+//  Created by tisfeng on 2026/10/19.
+//  Copyright © 2026 izual. All rights reserved.
+//
+
+import AppKit
+import Foundation
+
+// MARK: - QueryUsageStore
+
+/// In-memory query usage counters, written to `UserDefaults` behind the query path.
+///
+/// Counters are loaded once and updated in memory, so a query no longer writes the total
+/// counts and one record per service synchronously. Changes are flushed together at most
+/// once per `flushInterval`, and when the app terminates.
+final class QueryUsageStore: @unchecked Sendable {
+    // MARK: Lifecycle
+
+    init(userDefaults: UserDefaults = .standard, flushInterval: TimeInterval = 5) {
+        self.userDefaults = userDefaults
+        self.flushInterval = flushInterval
+        self.total = Usage(
+            queryCount: userDefaults.integer(forKey: Constants.queryCountKey),
+            queryCharacterCount: userDefaults.integer(forKey: Constants.queryCharacterCountKey)
+        )
+        self.serviceUsages = Self.loadServiceUsages(from: userDefaults)
+
+        self.terminationObserver = NotificationCenter.default.addObserver(
+            forName: NSApplication.willTerminateNotification,
+            object: nil,
+            queue: nil
+        ) { [weak self] _ in
+            self?.flush()
+        }
+    }
+
+    deinit {
+        terminationObserver.map(NotificationCenter.default.removeObserver)
+    }
+
+    // MARK: Internal
+
+    struct Usage: Equatable {
+        var queryCount = 0
+        var queryCharacterCount = 0
+    }
+
+    let flushInterval: TimeInterval
+
+    /// Usage across all services.
+    var totalUsage: Usage {
+        get { lock.withLock { total } }
+        set { update { $0.total = newValue } }
+    }
+
+    /// Usage of one service type.
+    func usage(of serviceType: ServiceType) -> Usage {
+        lock.withLock { serviceUsages[serviceType.rawValue] ?? Usage() }
+    }
+
+    /// Counts one query of `characterCount` characters in the totals.
+    /// - Returns: The total query count before and after the query.
+    @discardableResult
+    func recordQuery(characterCount: Int) -> (previousCount: Int, newCount: Int) {
+        var counts = (previousCount: 0, newCount: 0)
+        update { store in
+            counts.previousCount = store.total.queryCount
+            store.total.queryCount += 1
+            store.total.queryCharacterCount += characterCount
+            counts.newCount = store.total.queryCount
+        }
+        return counts
+    }
+
+    /// Counts one query of `characterCount` characters for `serviceType`.
+    func recordQuery(of serviceType: ServiceType, characterCount: Int) {
+        update { store in
+            store.serviceUsages[serviceType.rawValue, default: Usage()].queryCount += 1
+            store.serviceUsages[serviceType.rawValue, default: Usage()].queryCharacterCount += characterCount
+        }
+    }
+
+    /// Writes changed counters to `UserDefaults` now.
+    func flush() {
+        flushQueue.sync {
+            flushChanges()
+        }
+    }
+
+    /// Drops unwritten changes and reloads the counters, e.g. after `UserDefaults` has been reset.
+    func discardPendingWrites() {
+        lock.withLock {
+            isDirty = false
+            total = Usage(
+                queryCount: userDefaults.integer(forKey: Constants.queryCountKey),
+                queryCharacterCount: userDefaults.integer(forKey: Constants.queryCharacterCountKey)
+            )
+            serviceUsages = Self.loadServiceUsages(from: userDefaults)
+        }
+    }
+
+    // MARK: Private
+
+    private let userDefaults: UserDefaults
+    private let flushQueue = DispatchQueue(label: "com.izual.Easydict.QueryUsageStore")
+    private let lock = NSLock()
+    private var terminationObserver: NSObjectProtocol?
+
+    private var total: Usage
+    /// Usage by service type raw value.
+    private var serviceUsages: [String: Usage]
+    private var isDirty = false
+    private var isFlushScheduled = false
+
+    /// Reads the per-service records in the format written by earlier versions.
+    private static func loadServiceUsages(from userDefaults: UserDefaults) -> [String: Usage] {
+        let dict = userDefaults.dictionary(forKey: Constants.queryServiceRecordKey) as? [String: [String: Any]] ?? [:]
+        return dict.compactMapValues { recordDict in
+            guard let queryCount = (recordDict["queryCount"] as? NSNumber)?.intValue,
+                  let queryCharacterCount = (recordDict["queryCharacterCount"] as? NSNumber)?.intValue
+            else {
+                return nil
+            }
+            return Usage(queryCount: queryCount, queryCharacterCount: queryCharacterCount)
+        }
+    }
+
+    /// Applies `change` in memory and schedules a flush.
+    private func update(_ change: (QueryUsageStore) -> ()) {
+        let needsSchedule = lock.withLock { () -> Bool in
+            change(self)
+            isDirty = true
+            defer { isFlushScheduled = true }
+            return !isFlushScheduled
+        }
+        guard needsSchedule else { return }
+
+        flushQueue.asyncAfter(deadline: .now() + flushInterval) { [weak self] in
+            self?.flushChanges()
+        }
+    }
+
+    /// Runs on `flushQueue`.
+    private func flushChanges() {
+        let snapshot = lock.withLock { () -> (total: Usage, serviceUsages: [String: Usage])? in
+            isFlushScheduled = false
+            guard isDirty else { return nil }
+            isDirty = false
+            return (total, serviceUsages)
+        }
+        guard let snapshot else { return }
+
+        let serviceRecordDict = snapshot.serviceUsages.reduce(into: [String: [String: Any]]()) { dict, element in
+            dict[element.key] = [
+                "serviceType": element.key,
+                "queryCount": element.value.queryCount,
+                "queryCharacterCount": element.value.queryCharacterCount,
+            ]
+        }
+
+        userDefaults.set(snapshot.total.queryCount, forKey: Constants.queryCountKey)
+        userDefaults.set(snapshot.total.queryCharacterCount, forKey: Constants.queryCharacterCountKey)
+        userDefaults.set(serviceRecordDict, forKey: Constants.queryServiceRecordKey)
+    }
+}
+
+// MARK: - Constants
+
+private enum Constants {
+    static let queryCountKey = "kQueryCountKey"
+    static let queryCharacterCountKey = "kQueryCharacterCountKey"
+    static let queryServiceRecordKey = "kQueryServiceRecordKey"
+}
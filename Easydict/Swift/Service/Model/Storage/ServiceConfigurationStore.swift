@@ -0,0 +1,201 @@
+//
+//  ServiceConfigurationStore.swift
+//  Easydict
+//
+//  Created by tisfeng on 2026/10/19.
+//  Copyright © 2026 izual. All rights reserved.
+//
+
+import AppKit
+import Foundation
+
+// MARK: - ServiceConfigurationStore
+
+/// In-memory snapshot of the service configurations persisted in `UserDefaults`.
+///
+/// Each record is decoded the first time it is read, then served from a copy-on-write
+/// dictionary, so building a window's service list does not touch the plist or JSON
+/// decoder. Writes update the snapshot right away and reach `UserDefaults` in one coalesced
+/// batch `flushDelay` later, or when the app terminates.
+///
+/// `UserDefaults.didChangeNotification` marks the snapshot stale. The next read compares
+/// the cached records with the stored data and only decodes the ones that changed.
+final class ServiceConfigurationStore: @unchecked Sendable {
+    // MARK: Lifecycle
+
+    init(userDefaults: UserDefaults = .standard, flushDelay: TimeInterval = 0.5) {
+        self.userDefaults = userDefaults
+        self.flushDelay = flushDelay
+
+        let notificationCenter = NotificationCenter.default
+        self.observers = [
+            notificationCenter.addObserver(
+                forName: UserDefaults.didChangeNotification,
+                object: userDefaults,
+                queue: nil
+            ) { [weak self] _ in
+                self?.markNeedsRevalidation()
+            },
+            notificationCenter.addObserver(
+                forName: NSApplication.willTerminateNotification,
+                object: nil,
+                queue: nil
+            ) { [weak self] _ in
+                self?.flush()
+            },
+        ]
+    }
+
+    deinit {
+        observers.forEach(NotificationCenter.default.removeObserver)
+    }
+
+    // MARK: Internal
+
+    /// Value copy of a `QueryServiceConfiguration`, safe to share between readers.
+    struct Entry: Equatable {
+        // MARK: Lifecycle
+
+        init(_ configuration: QueryServiceConfiguration) {
+            self.uuid = configuration.uuid
+            self.type = configuration.type
+            self.enabled = configuration.enabled
+            self.enabledQuery = configuration.enabledQuery
+            self.windowType = configuration.windowType
+        }
+
+        // MARK: Internal
+
+        var uuid: String
+        var type: ServiceType
+        var enabled: Bool
+        var enabledQuery: Bool
+        var windowType: EZWindowType
+
+        /// A new mutable configuration with the values of this entry.
+        var configuration: QueryServiceConfiguration {
+            QueryServiceConfiguration(
+                uuid: uuid,
+                type: type,
+                enabled: enabled,
+                enabledQuery: enabledQuery,
+                windowType: windowType
+            )
+        }
+    }
+
+    let flushDelay: TimeInterval
+
+    /// Returns the entry stored under `key`, decoding the stored data with `decode` only
+    /// when the key has not been read yet or changed since.
+    func entry(forKey key: String, decode: (Data) -> Entry?) -> Entry? {
+        let cachedRecord = lock.withLock { () -> Record? in
+            revalidateIfNeeded()
+            return records[key]
+        }
+        if let cachedRecord {
+            return cachedRecord.entry
+        }
+
+        let data = userDefaults.data(forKey: key)
+        let record = Record(entry: data.flatMap(decode), data: data)
+        return lock.withLock {
+            // A write that landed meanwhile wins over what was just read.
+            if let newerRecord = records[key] {
+                return newerRecord.entry
+            }
+            records[key] = record
+            return record.entry
+        }
+    }
+
+    /// Stores `entry` under `key` and schedules the write to `UserDefaults`.
+    func set(_ entry: Entry, forKey key: String) {
+        let needsSchedule = lock.withLock { () -> Bool in
+            // The stored data stays as it is until the flush.
+            records[key] = Record(entry: entry, data: records[key]?.data)
+            pendingWrites[key] = entry
+            defer { isFlushScheduled = true }
+            return !isFlushScheduled
+        }
+        guard needsSchedule else { return }
+
+        flushQueue.asyncAfter(deadline: .now() + flushDelay) { [weak self] in
+            self?.flushPendingWrites()
+        }
+    }
+
+    /// Writes pending entries to `UserDefaults` now.
+    func flush() {
+        flushQueue.sync {
+            flushPendingWrites()
+        }
+    }
+
+    /// Drops pending writes and cached records, e.g. after `UserDefaults` has been reset.
+    func discardPendingWrites() {
+        lock.withLock {
+            pendingWrites.removeAll()
+            records.removeAll()
+        }
+    }
+
+    // MARK: Private
+
+    /// A cached record and the stored data it was read from, `nil` when nothing is stored.
+    private struct Record {
+        let entry: Entry?
+        let data: Data?
+    }
+
+    private let userDefaults: UserDefaults
+    private let encoder = JSONEncoder()
+    private let flushQueue = DispatchQueue(label: "com.izual.Easydict.ServiceConfigurationStore")
+    private let lock = NSLock()
+    private var observers: [NSObjectProtocol] = []
+
+    private var records: [String: Record] = [:]
+    private var pendingWrites: [String: Entry] = [:]
+    private var isFlushScheduled = false
+    private var needsRevalidation = false
+
+    private func markNeedsRevalidation() {
+        lock.withLock {
+            needsRevalidation = true
+        }
+    }
+
+    /// Evicts cached records whose stored data changed. Called with the lock held.
+    private func revalidateIfNeeded() {
+        guard needsRevalidation else { return }
+        needsRevalidation = false
+
+        for (key, record) in records where pendingWrites[key] == nil {
+            if userDefaults.data(forKey: key) != record.data {
+                records[key] = nil
+            }
+        }
+    }
+
+    /// Runs on `flushQueue`.
+    private func flushPendingWrites() {
+        let writes = lock.withLock { () -> [String: Entry] in
+            isFlushScheduled = false
+            return pendingWrites
+        }
+
+        for (key, entry) in writes {
+            guard let data = try? encoder.encode(entry.configuration) else {
+                continue
+            }
+            userDefaults.set(data, forKey: key)
+
+            lock.withLock {
+                // Entries set again during the write stay pending for the next flush.
+                guard pendingWrites[key] == entry else { return }
+                pendingWrites[key] = nil
+                records[key] = Record(entry: entry, data: data)
+            }
+        }
+    }
+}
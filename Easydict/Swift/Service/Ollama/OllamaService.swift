@@ -50,6 +50,11 @@ class OllamaService: BaseOpenAIService {
         [supportedModelsKey]
     }
 
+    /// Local models usually serve one request at a time, so chunks run sequentially.
+    override var longTextConcurrencyLimit: Int {
+        1
+    }
+
     override func apiKeyRequirement() -> ServiceAPIKeyRequirement {
         .none
     }
@@ -23,9 +23,11 @@ public class BaseOpenAIService: StreamService {
     open var supportsStreamingToggle: Bool { false }
 
     open override func cancelStream() {
-        control.cancel()
-        nonStreamingTask?.cancel()
-        nonStreamingTask = nil
+        let tasks = inFlightTasksLock.withLock {
+            defer { inFlightTasks.removeAll() }
+            return Array(inFlightTasks.values)
+        }
+        tasks.forEach { $0.cancel() }
     }
 
     // MARK: Internal
@@ -44,12 +46,19 @@ public class BaseOpenAIService: StreamService {
         true
     }
 
-    let control = StreamControl()
+    override var usesLLMTransport: Bool {
+        true
+    }
+
+    override var longTextConcurrencyLimit: Int {
+        3
+    }
 
     override func contentStreamTranslate(
         _ text: String,
         from: Language,
-        to: Language
+        to: Language,
+        queryType: EZQueryTextType
     )
         -> AsyncThrowingStream<String, any Error> {
         let url = URL(string: endpoint)
@@ -74,7 +83,6 @@ public class BaseOpenAIService: StreamService {
 
         result.isStreamFinished = false
 
-        let queryType = queryType(text: text, from: from, to: to)
         let chatQueryParam = ChatQueryParam(
             text: text,
             sourceLanguage: from,
@@ -96,16 +104,7 @@ public class BaseOpenAIService: StreamService {
         let query = ChatQuery(messages: chatHistory, model: model, temperature: temperature)
 
         if usesStreamingTransport {
-            let openAI = OpenAI(apiToken: apiKey)
-
-            // FIXME: It seems that `control` will cause a memory leak, but it is not clear how to solve it.
-            unowned let unownedControl = control
-
-            let chatStream: AsyncThrowingStream<ChatStreamResult, Error> = openAI.chatsStream(
-                query: query,
-                url: url,
-                control: unownedControl
-            )
+            let chatStream = streamingChatResults(query: query, url: url)
             return chatStreamToContentStream(chatStream)
         } else {
             return nonStreamingTranslate(query: query, url: url)
@@ -220,8 +219,28 @@ public class BaseOpenAIService: StreamService {
     /// Temporary override for streaming during validate retry. `nil` means use the persisted value.
     private var streamingOverride: Bool?
 
-    /// Reference to the in-flight non-streaming task so `cancelStream()` can cancel it.
-    private var nonStreamingTask: Task<(), Never>?
+    /// In-flight request tasks so `cancelStream()` can cancel them. Long-text mode runs
+    /// several chunk requests at once, so this cannot be a single task reference.
+    private var inFlightTasks: [UUID: Task<(), Never>] = [:]
+    private let inFlightTasksLock = NSLock()
+
+    /// Tracks `task` until the stream it feeds terminates.
+    private func trackInFlightTask<Element>(
+        _ task: Task<(), Never>,
+        continuation: AsyncThrowingStream<Element, Error>.Continuation
+    ) {
+        let taskID = UUID()
+        inFlightTasksLock.withLock {
+            inFlightTasks[taskID] = task
+        }
+        continuation.onTermination = { @Sendable [weak self] _ in
+            task.cancel()
+            guard let self else { return }
+            inFlightTasksLock.withLock {
+                _ = inFlightTasks.removeValue(forKey: taskID)
+            }
+        }
+    }
 
     /// Whether the retry error should replace the original streaming mismatch diagnostics.
     private func shouldPreferRetryError(_ retryError: QueryError) -> Bool {
@@ -251,29 +270,19 @@ public class BaseOpenAIService: StreamService {
             }
 
             let task = Task {
-                defer { self.nonStreamingTask = nil }
-
                 do {
-                    let request = try self.makeNonStreamingChatRequest(
+                    let request = try self.makeChatRequest(
                         query: query,
                         url: url,
-                        apiKey: apiKey
+                        apiKey: apiKey,
+                        stream: false
                     )
-                    let (data, response) = try await URLSession.shared.data(for: request)
+                    let (data, response) = try await LLMTransport.shared.data(for: request)
                     try Task.checkCancellation()
 
                     if let http = response as? HTTPURLResponse,
                        !(200 ... 299).contains(http.statusCode) {
-                        if let apiError = try? JSONDecoder().decode(
-                            APIErrorResponse.self, from: data
-                        ) {
-                            throw apiError
-                        }
-                        throw QueryError(
-                            type: .api,
-                            message: "HTTP \(http.statusCode)",
-                            errorDataMessage: String(data: data, encoding: .utf8)
-                        )
+                        throw Self.httpError(statusCode: http.statusCode, data: data)
                     }
 
                     let chatResult = try JSONDecoder().decode(ChatResult.self, from: data)
@@ -297,36 +306,142 @@ public class BaseOpenAIService: StreamService {
                 }
             }
 
-            nonStreamingTask = task
-            continuation.onTermination = { @Sendable _ in
-                task.cancel()
+            trackInFlightTask(task, continuation: continuation)
+        }
+    }
+
+    /// Performs a streaming chat completion over the pooled `LLMTransport`.
+    ///
+    /// Frames the `text/event-stream` response with `ServerSentEventFramer` and decodes each
+    /// event's data as a `ChatStreamResult`. A non-SSE `Content-Type` is reported as
+    /// "Incorrect content-type" so validation can fall back to non-streaming mode.
+    private func streamingChatResults(
+        query: ChatQuery,
+        url: URL
+    )
+        -> AsyncThrowingStream<ChatStreamResult, Error> {
+        let apiKey = apiKey
+
+        return AsyncThrowingStream(ChatStreamResult.self) { [weak self] continuation in
+            guard let self else {
+                continuation.finish(throwing: CancellationError())
+                return
             }
+
+            let task = Task {
+                do {
+                    let request = try self.makeChatRequest(
+                        query: query,
+                        url: url,
+                        apiKey: apiKey,
+                        stream: true
+                    )
+
+                    let (chunks, response) = try await LLMTransport.shared.dataChunks(for: request)
+                    try await self.validateStreamingResponse(response, chunks: chunks)
+
+                    let decoder = JSONDecoder()
+                    let framer = ServerSentEventFramer()
+                    var isDone = false
+                    for try await chunk in chunks {
+                        try Task.checkCancellation()
+                        framer.append(chunk)
+                        try framer.drainEvents { event in
+                            guard !isDone else { return }
+                            if event.data == Self.doneEventData {
+                                isDone = true
+                            } else if let chatStreamResult = try? decoder.decode(ChatStreamResult.self, from: event.data) {
+                                continuation.yield(chatStreamResult)
+                            } else if let apiError = try? decoder.decode(APIErrorResponse.self, from: event.data) {
+                                throw apiError
+                            }
+                        }
+                        if isDone {
+                            break
+                        }
+                    }
+                    continuation.finish()
+                } catch let urlError as URLError where urlError.code == .cancelled {
+                    continuation.finish(throwing: CancellationError())
+                } catch is CancellationError {
+                    continuation.finish(throwing: CancellationError())
+                } catch {
+                    continuation.finish(throwing: error)
+                }
+            }
+
+            trackInFlightTask(task, continuation: continuation)
+        }
+    }
+
+    /// Data of the event that ends an OpenAI stream.
+    private static let doneEventData = Data("[DONE]".utf8)
+
+    /// Error for a non-2xx response, with the provider's message when the body is an API error.
+    private static func httpError(statusCode: Int, data: Data) -> QueryError {
+        if let apiError = try? JSONDecoder().decode(APIErrorResponse.self, from: data) {
+            return .httpError(statusCode: statusCode, message: apiError.localizedDescription)
+        }
+        return .httpError(
+            statusCode: statusCode,
+            message: "HTTP \(statusCode)",
+            errorDataMessage: String(data: data, encoding: .utf8)
+        )
+    }
+
+    /// Throws the provider error for non-2xx responses and rejects non-SSE content types.
+    private func validateStreamingResponse(
+        _ response: URLResponse,
+        chunks: AsyncThrowingStream<Data, Error>
+    ) async throws {
+        guard let http = response as? HTTPURLResponse else { return }
+
+        if !(200 ... 299).contains(http.statusCode) {
+            var data = Data()
+            for try await chunk in chunks {
+                data.append(chunk)
+            }
+            throw Self.httpError(statusCode: http.statusCode, data: data)
+        }
+
+        let contentType = http.value(forHTTPHeaderField: "Content-Type") ?? ""
+        if !contentType.lowercased().contains("text/event-stream") {
+            throw QueryError(type: .api, message: "Incorrect content-type: \(contentType)")
         }
     }
 
-    /// Builds the HTTP request for a non-streaming OpenAI-compatible chat completion.
+    /// Builds the HTTP request for an OpenAI-compatible chat completion.
     /// - Parameters:
     ///   - query: The chat completion query to encode.
     ///   - url: The provider endpoint URL.
     ///   - apiKey: The API token used by OpenAI-compatible providers.
-    /// - Returns: A configured `URLRequest` ready for `URLSession`.
-    private func makeNonStreamingChatRequest(
+    ///   - stream: Whether to request a `text/event-stream` response.
+    /// - Returns: A configured `URLRequest` ready for `LLMTransport`.
+    private func makeChatRequest(
         query: ChatQuery,
         url: URL,
-        apiKey: String
+        apiKey: String,
+        stream: Bool
     ) throws
         -> URLRequest {
         var query = query
-        query.stream = false
+        query.stream = stream
 
         var request = URLRequest(url: url, timeoutInterval: EZNetWorkTimeoutInterval)
         request.httpMethod = "POST"
         request.setValue("application/json", forHTTPHeaderField: "Content-Type")
+        if stream {
+            request.setValue("text/event-stream", forHTTPHeaderField: "Accept")
+        }
         if !apiKey.isEmpty {
             request.setValue("Bearer \(apiKey)", forHTTPHeaderField: "Authorization")
             request.setValue(apiKey, forHTTPHeaderField: "api-key")
         }
-        request.httpBody = try JSONEncoder().encode(query)
+        // Sorted keys keep the request body byte-stable, so the shared prompt prefix
+        // serializes identically for providers with automatic prefix caching.
+        let encoder = JSONEncoder()
+        encoder.outputFormatting = .sortedKeys
+        request.httpBody = try encoder.encode(query)
         return request
     }
 
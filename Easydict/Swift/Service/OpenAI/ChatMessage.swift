@@ -26,7 +26,7 @@ func chatMessagePair(userContent: String, assistantContent: String) -> [ChatMess
 
 // MARK: - ChatMessage
 
-struct ChatMessage {
+struct ChatMessage: Equatable {
     // MARK: - ChatRole
 
     enum ChatRole: String, Codable, Equatable, CaseIterable {
@@ -39,6 +39,8 @@ struct ChatMessage {
 
     let role: ChatRole
     let content: String
+    /// Whether this message ends the stable prompt prefix that providers may cache.
+    var isCacheBreakpoint = false
 }
 
 // MARK: - AIToolType
@@ -61,3 +63,49 @@ struct ChatQueryParam {
         (text, sourceLanguage, targetLanguage, queryType, enableSystemPrompt)
     }
 }
+
+// MARK: - PromptPrefixKey
+
+/// Everything the built-in prompt prefix depends on.
+struct PromptPrefixKey: Hashable {
+    let queryType: EZQueryTextType
+    let sourceLanguage: Language
+    let targetLanguage: Language
+    let answerLanguage: Language
+    let enableSystemPrompt: Bool
+}
+
+// MARK: - PromptPrefixCache
+
+/// Memoizes rendered prompt prefixes, so the system prompt and few-shot turns are built once
+/// per key instead of on every query.
+final class PromptPrefixCache: @unchecked Sendable {
+    // MARK: Internal
+
+    static let shared = PromptPrefixCache()
+
+    func messages(for key: PromptPrefixKey, render: () -> [ChatMessage]) -> [ChatMessage] {
+        if let messages = lock.withLock({ cache[key] }) {
+            QueryMetrics.recordCacheLookup("prompt_prefix", hit: true)
+            return messages
+        }
+        QueryMetrics.recordCacheLookup("prompt_prefix", hit: false)
+
+        let messages = render()
+        lock.withLock {
+            if cache.count >= Self.capacity {
+                cache.removeAll()
+            }
+            cache[key] = messages
+        }
+        return messages
+    }
+
+    // MARK: Private
+
+    /// Language pairs in daily use are few; this only bounds pathological growth.
+    private static let capacity = 64
+
+    private let lock = NSLock()
+    private var cache: [PromptPrefixKey: [ChatMessage]] = [:]
+}
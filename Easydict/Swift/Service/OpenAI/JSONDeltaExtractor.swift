@@ -0,0 +1,479 @@
+//
+//  JSONDeltaExtractor.swift
+//  Easydict
+//
+//  Created by tisfeng on 2026/10/19.
+//  Copyright © 2026 izual. All rights reserved.
+//
+
+import Foundation
+
+// MARK: - JSONDeltaExtractor
+
+/// Pulls the text delta out of a streaming chunk without `Codable`.
+///
+/// Streams emit hundreds of tiny events per response, and decoding each into a model type
+/// just to read one string dominates parse time. An extractor is built once from the
+/// schema of a provider's chunk type, then walks each payload in a single pass: fields the
+/// schema does not mention are skipped without allocating, and only the delta string is
+/// materialized.
+///
+/// The walk is strict so that it never accepts a payload the `Codable` model would reject:
+/// the whole document is validated, required fields must be present and non-null, and
+/// anything the scanner is unsure about (escaped keys, duplicate schema keys, exponents,
+/// lone surrogates, invalid UTF-8 in the delta) yields `.unsupported`, so callers fall back
+/// to full decoding. Error and usage events take that path as well when their shape
+/// differs from the delta schema.
+struct JSONDeltaExtractor {
+    // MARK: Lifecycle
+
+    /// - Parameter fields: Fields of the top-level object, mirroring the `Codable` model.
+    init(_ fields: [Field]) {
+        self.fields = fields
+    }
+
+    // MARK: Internal
+
+    /// Expected JSON type of a schema field.
+    indirect enum Shape {
+        case string
+        /// A string that must equal the given value for the event to carry a delta, like a
+        /// `type` checked after decoding. A different value on the delta's path yields
+        /// `.delta(nil)`.
+        case discriminator(StaticString)
+        /// A number `Int` can decode: no fraction or exponent, at most 18 digits.
+        case integer
+        /// A number `Double` can decode, without an exponent.
+        case number
+        case boolean
+        case object([Field])
+        /// An array whose elements all have the given shape. Only the first element can
+        /// provide the delta, like `choices.first`.
+        case array(of: Shape)
+        /// The optional string the extractor returns.
+        case delta
+    }
+
+    /// One field of a schema object.
+    struct Field {
+        // MARK: Lifecycle
+
+        init(_ key: StaticString, _ shape: Shape, required: Bool = false) {
+            self.key = key
+            self.shape = shape
+            self.isRequired = required
+        }
+
+        // MARK: Internal
+
+        let key: StaticString
+        let shape: Shape
+        /// Non-optional in the model: the field must be present and not `null`.
+        let isRequired: Bool
+    }
+
+    enum Outcome: Equatable {
+        /// The payload matches the schema; `nil` when it carries no delta.
+        case delta(String?)
+        /// The payload needs full decoding.
+        case unsupported
+    }
+
+    func extract(from data: Data) -> Outcome {
+        data.withUnsafeBytes { bytes in
+            var scanner = DeltaScanner(bytes: bytes)
+            do {
+                scanner.skipWhitespace()
+                try scanner.parseObject(fields, capturesDelta: true)
+                scanner.skipWhitespace()
+                guard scanner.isAtEnd else { return .unsupported }
+                return .delta(scanner.isMismatched ? nil : scanner.delta)
+            } catch {
+                return .unsupported
+            }
+        }
+    }
+
+    // MARK: Private
+
+    private let fields: [Field]
+}
+
+// MARK: - DeltaScanner
+
+private struct Unsupported: Error {}
+
+/// Single-pass, validating JSON walker over the payload bytes.
+private struct DeltaScanner {
+    // MARK: Lifecycle
+
+    init(bytes: UnsafeRawBufferPointer) {
+        self.bytes = bytes
+    }
+
+    // MARK: Internal
+
+    private(set) var delta: String?
+    /// A discriminator did not match, so the payload carries no delta.
+    private(set) var isMismatched = false
+
+    var isAtEnd: Bool {
+        index == bytes.count
+    }
+
+    mutating func skipWhitespace() {
+        while index < bytes.count {
+            switch bytes[index] {
+            case 0x20, 0x09, 0x0A, 0x0D: index += 1
+            default: return
+            }
+        }
+    }
+
+    mutating func parseObject(_ fields: [JSONDeltaExtractor.Field], capturesDelta: Bool) throws {
+        try expect(UInt8(ascii: "{"))
+        // Schemas are small; one bit per field tracks presence and duplicates.
+        guard fields.count <= 64 else { throw Unsupported() }
+        var seenFields: UInt64 = 0
+
+        skipWhitespace()
+        if !consume(UInt8(ascii: "}")) {
+            repeat {
+                skipWhitespace()
+                let key = try scanString()
+                // An escaped key could spell a schema key in a way the byte compare misses.
+                guard !key.hasEscapes else { throw Unsupported() }
+                skipWhitespace()
+                try expect(UInt8(ascii: ":"))
+                skipWhitespace()
+
+                if let fieldIndex = fields.firstIndex(where: { matches(key.range, $0.key) }) {
+                    let bit: UInt64 = 1 << fieldIndex
+                    guard seenFields & bit == 0 else { throw Unsupported() }
+                    seenFields |= bit
+                    let field = fields[fieldIndex]
+                    try parseValue(field.shape, isRequired: field.isRequired, capturesDelta: capturesDelta)
+                } else {
+                    try skipValue(depth: 0)
+                }
+                skipWhitespace()
+            } while consume(UInt8(ascii: ","))
+            try expect(UInt8(ascii: "}"))
+        }
+
+        for (fieldIndex, field) in fields.enumerated() where field.isRequired {
+            guard seenFields & (1 << fieldIndex) != 0 else { throw Unsupported() }
+        }
+    }
+
+    // MARK: Private
+
+    private static let maxDepth = 64
+
+    private let bytes: UnsafeRawBufferPointer
+    private var index = 0
+
+    private mutating func parseValue(
+        _ shape: JSONDeltaExtractor.Shape,
+        isRequired: Bool,
+        capturesDelta: Bool
+    ) throws {
+        if peek() == UInt8(ascii: "n") {
+            guard !isRequired else { throw Unsupported() }
+            try expectLiteral("null")
+            return
+        }
+
+        switch shape {
+        case .string:
+            _ = try scanString()
+
+        case let .discriminator(expected):
+            let value = try scanString()
+            guard !value.hasEscapes else { throw Unsupported() }
+            if capturesDelta, !matches(value.range, expected) {
+                isMismatched = true
+            }
+
+        case .integer:
+            let number = try scanNumber()
+            guard number.isInteger, number.digitCount <= 18 else { throw Unsupported() }
+
+        case .number:
+            let number = try scanNumber()
+            guard !number.hasExponent else { throw Unsupported() }
+
+        case .boolean:
+            if peek() == UInt8(ascii: "t") {
+                try expectLiteral("true")
+            } else {
+                try expectLiteral("false")
+            }
+
+        case let .object(fields):
+            try parseObject(fields, capturesDelta: capturesDelta)
+
+        case let .array(elementShape):
+            try expect(UInt8(ascii: "["))
+            skipWhitespace()
+            guard !consume(UInt8(ascii: "]")) else { return }
+            var isFirstElement = true
+            repeat {
+                skipWhitespace()
+                try parseValue(elementShape, isRequired: true, capturesDelta: capturesDelta && isFirstElement)
+                isFirstElement = false
+                skipWhitespace()
+            } while consume(UInt8(ascii: ","))
+            try expect(UInt8(ascii: "]"))
+
+        case .delta:
+            let value = try scanString()
+            if capturesDelta {
+                delta = try decodeString(value)
+            }
+        }
+    }
+
+    private func peek() -> UInt8? {
+        index < bytes.count ? bytes[index] : nil
+    }
+
+    private mutating func consume(_ byte: UInt8) -> Bool {
+        guard peek() == byte else { return false }
+        index += 1
+        return true
+    }
+
+    private mutating func expect(_ byte: UInt8) throws {
+        guard consume(byte) else { throw Unsupported() }
+    }
+
+    private mutating func expectLiteral(_ literal: StaticString) throws {
+        let count = literal.utf8CodeUnitCount
+        guard bytes.count - index >= count,
+              memcmp(bytes.baseAddress! + index, literal.utf8Start, count) == 0
+        else { throw Unsupported() }
+        index += count
+    }
+
+    private func matches(_ range: Range<Int>, _ key: StaticString) -> Bool {
+        range.count == key.utf8CodeUnitCount
+            && memcmp(bytes.baseAddress! + range.lowerBound, key.utf8Start, range.count) == 0
+    }
+
+    /// Validates a string and returns the range of its contents, without the quotes.
+    private mutating func scanString() throws -> (range: Range<Int>, hasEscapes: Bool) {
+        try expect(UInt8(ascii: "\""))
+        let start = index
+        var hasEscapes = false
+
+        while index < bytes.count {
+            let byte = bytes[index]
+            switch byte {
+            case UInt8(ascii: "\""):
+                index += 1
+                return (start ..< index - 1, hasEscapes)
+
+            case UInt8(ascii: "\\"):
+                hasEscapes = true
+                index += 1
+                guard let escaped = peek() else { throw Unsupported() }
+                switch escaped {
+                case UInt8(ascii: "\""), UInt8(ascii: "\\"), UInt8(ascii: "/"), UInt8(ascii: "b"),
+                     UInt8(ascii: "f"), UInt8(ascii: "n"), UInt8(ascii: "r"), UInt8(ascii: "t"):
+                    index += 1
+                case UInt8(ascii: "u"):
+                    index += 1
+                    let codeUnit = try scanHexQuad()
+                    if (0xD800 ..< 0xDC00).contains(codeUnit) {
+                        // A high surrogate must be followed by an escaped low surrogate.
+                        try expectLiteral("\\u")
+                        guard (0xDC00 ..< 0xE000).contains(try scanHexQuad()) else { throw Unsupported() }
+                    } else if (0xDC00 ..< 0xE000).contains(codeUnit) {
+                        throw Unsupported()
+                    }
+                default:
+                    throw Unsupported()
+                }
+
+            case 0x00 ..< 0x20:
+                // Control characters must be escaped.
+                throw Unsupported()
+
+            default:
+                index += 1
+            }
+        }
+        throw Unsupported()
+    }
+
+    private mutating func scanHexQuad() throws -> UInt16 {
+        guard bytes.count - index >= 4 else { throw Unsupported() }
+        var value: UInt16 = 0
+        for _ in 0 ..< 4 {
+            let byte = bytes[index]
+            let digit: UInt8 = switch byte {
+            case UInt8(ascii: "0") ... UInt8(ascii: "9"): byte - UInt8(ascii: "0")
+            case UInt8(ascii: "a") ... UInt8(ascii: "f"): byte - UInt8(ascii: "a") + 10
+            case UInt8(ascii: "A") ... UInt8(ascii: "F"): byte - UInt8(ascii: "A") + 10
+            default: throw Unsupported()
+            }
+            value = value << 4 | UInt16(digit)
+            index += 1
+        }
+        return value
+    }
+
+    /// Decodes a scanned string. Strings without escapes are copied in one go.
+    private func decodeString(_ value: (range: Range<Int>, hasEscapes: Bool)) throws -> String {
+        let raw = UnsafeRawBufferPointer(rebasing: bytes[value.range])
+        guard value.hasEscapes else {
+            return try decodeUTF8(raw)
+        }
+
+        var decoded: [UInt8] = []
+        decoded.reserveCapacity(raw.count)
+        var position = 0
+        while position < raw.count {
+            let byte = raw[position]
+            position += 1
+            guard byte == UInt8(ascii: "\\") else {
+                decoded.append(byte)
+                continue
+            }
+
+            let escaped = raw[position]
+            position += 1
+            switch escaped {
+            case UInt8(ascii: "b"): decoded.append(0x08)
+            case UInt8(ascii: "f"): decoded.append(0x0C)
+            case UInt8(ascii: "n"): decoded.append(0x0A)
+            case UInt8(ascii: "r"): decoded.append(0x0D)
+            case UInt8(ascii: "t"): decoded.append(0x09)
+            case UInt8(ascii: "u"):
+                var scalarValue = UInt32(hexQuad(in: raw, at: position))
+                position += 4
+                if (0xD800 ..< 0xDC00).contains(scalarValue) {
+                    // `scanString()` checked that an escaped low surrogate follows.
+                    let low = UInt32(hexQuad(in: raw, at: position + 2))
+                    scalarValue = 0x10000 + (scalarValue - 0xD800) << 10 + (low - 0xDC00)
+                    position += 6
+                }
+                guard let scalar = Unicode.Scalar(scalarValue) else { throw Unsupported() }
+                decoded.append(contentsOf: String(scalar).utf8)
+            default:
+                // `"`, `\` and `/` stand for themselves.
+                decoded.append(escaped)
+            }
+        }
+        return try decoded.withUnsafeBytes { try decodeUTF8($0) }
+    }
+
+    /// Hex value of four digits already validated by `scanHexQuad()`.
+    private func hexQuad(in raw: UnsafeRawBufferPointer, at position: Int) -> UInt16 {
+        var value: UInt16 = 0
+        for byte in raw[position ..< position + 4] {
+            let digit: UInt8 = switch byte {
+            case UInt8(ascii: "0") ... UInt8(ascii: "9"): byte - UInt8(ascii: "0")
+            case UInt8(ascii: "a") ... UInt8(ascii: "f"): byte - UInt8(ascii: "a") + 10
+            default: byte - UInt8(ascii: "A") + 10
+            }
+            value = value << 4 | UInt16(digit)
+        }
+        return value
+    }
+
+    /// Decodes UTF-8 and rejects invalid sequences, which `String(decoding:as:)` would repair.
+    private func decodeUTF8(_ raw: UnsafeRawBufferPointer) throws -> String {
+        if !raw.contains(where: { $0 >= 0x80 }) {
+            return String(decoding: raw, as: UTF8.self)
+        }
+        guard let string = String(bytes: raw, encoding: .utf8) else { throw Unsupported() }
+        return string
+    }
+
+    /// Validates a number per RFC 8259.
+    private mutating func scanNumber() throws -> (isInteger: Bool, hasExponent: Bool, digitCount: Int) {
+        _ = consume(UInt8(ascii: "-"))
+        let integerStart = index
+        if consume(UInt8(ascii: "0")) {
+            // No leading zeros.
+        } else {
+            guard skipDigits() > 0 else { throw Unsupported() }
+        }
+        let digitCount = index - integerStart
+
+        var isInteger = true
+        if consume(UInt8(ascii: ".")) {
+            isInteger = false
+            guard skipDigits() > 0 else { throw Unsupported() }
+        }
+
+        var hasExponent = false
+        if consume(UInt8(ascii: "e")) || consume(UInt8(ascii: "E")) {
+            hasExponent = true
+            isInteger = false
+            if !consume(UInt8(ascii: "+")) {
+                _ = consume(UInt8(ascii: "-"))
+            }
+            guard skipDigits() > 0 else { throw Unsupported() }
+        }
+        return (isInteger, hasExponent, digitCount)
+    }
+
+    private mutating func skipDigits() -> Int {
+        let start = index
+        while let byte = peek(), byte >= UInt8(ascii: "0"), byte <= UInt8(ascii: "9") {
+            index += 1
+        }
+        return index - start
+    }
+
+    /// Skips and validates a value the schema does not mention.
+    private mutating func skipValue(depth: Int) throws {
+        guard depth < Self.maxDepth, let byte = peek() else { throw Unsupported() }
+
+        switch byte {
+        case UInt8(ascii: "\""):
+            _ = try scanString()
+
+        case UInt8(ascii: "{"):
+            index += 1
+            skipWhitespace()
+            guard !consume(UInt8(ascii: "}")) else { return }
+            repeat {
+                skipWhitespace()
+                _ = try scanString()
+                skipWhitespace()
+                try expect(UInt8(ascii: ":"))
+                skipWhitespace()
+                try skipValue(depth: depth + 1)
+                skipWhitespace()
+            } while consume(UInt8(ascii: ","))
+            try expect(UInt8(ascii: "}"))
+
+        case UInt8(ascii: "["):
+            index += 1
+            skipWhitespace()
+            guard !consume(UInt8(ascii: "]")) else { return }
+            repeat {
+                skipWhitespace()
+                try skipValue(depth: depth + 1)
+                skipWhitespace()
+            } while consume(UInt8(ascii: ","))
+            try expect(UInt8(ascii: "]"))
+
+        case UInt8(ascii: "t"):
+            try expectLiteral("true")
+
+        case UInt8(ascii: "f"):
+            try expectLiteral("false")
+
+        case UInt8(ascii: "n"):
+            try expectLiteral("null")
+
+        default:
+            _ = try scanNumber()
+        }
+    }
+}
@@ -0,0 +1,312 @@
+//
+//  LLMTransport.swift
+//  Easydict
+//
+//  Created by tisfeng on 2026/10/19.
+//  Copyright © 2026 izual. All rights reserved.
+//
+
+import Foundation
+
+// MARK: - LLMTransportStatistics
+
+/// Connection counters for one endpoint host, collected from `URLSessionTaskMetrics`.
+struct LLMTransportStatistics: Sendable, CustomStringConvertible {
+    /// Completed requests, including pre-connect probes.
+    var requestCount = 0
+    /// Requests that ran on an already established connection.
+    var reusedConnectionCount = 0
+    /// Requests that had to open a new connection (DNS, TCP, TLS).
+    var newConnectionCount = 0
+    /// Total time spent establishing new connections, in milliseconds.
+    var totalConnectMilliseconds = 0.0
+    /// Pre-connect probes issued for this host.
+    var preconnectCount = 0
+
+    /// Share of requests that reused a pooled connection.
+    var reuseRatio: Double {
+        let total = reusedConnectionCount + newConnectionCount
+        return total == 0 ? 0 : Double(reusedConnectionCount) / Double(total)
+    }
+
+    /// Average connection setup time of new connections, in milliseconds.
+    var averageConnectMilliseconds: Double {
+        newConnectionCount == 0 ? 0 : totalConnectMilliseconds / Double(newConnectionCount)
+    }
+
+    var description: String {
+        "requests=\(requestCount), reused=\(reusedConnectionCount), new=\(newConnectionCount), "
+            + "reuse=\(String(format: "%.0f%%", reuseRatio * 100)), "
+            + "connect=\(String(format: "%.0f", averageConnectMilliseconds))ms, "
+            + "preconnects=\(preconnectCount)"
+    }
+}
+
+// MARK: - LLMTransport
+
+/// Shared HTTP transport for LLM services, with one pooled `URLSession` per endpoint host.
+///
+/// Requests to the same host (DeepSeek, Groq, Zhipu, GitHub Models, custom endpoints, …)
+/// share keep-alive HTTP/1.1 and HTTP/2 connections, so only the first query pays for
+/// DNS, TCP and TLS setup. `preconnect(to:)` lets a window warm the connection before the
+/// user submits a query, and `statistics(for:)` reports how often connections are reused.
+@objc(EZLLMTransport)
+final class LLMTransport: NSObject, @unchecked Sendable {
+    // MARK: Lifecycle
+
+    private override init() {
+        super.init()
+    }
+
+    // MARK: Internal
+
+    @objc static let shared = LLMTransport()
+
+    /// Returns the pooled session for the endpoint's host.
+    func session(for url: URL) -> URLSession {
+        let key = Self.hostKey(for: url)
+        return lock.withLock {
+            if let session = sessions[key] {
+                return session
+            }
+            let session = URLSession(
+                configuration: Self.makeConfiguration(),
+                delegate: self,
+                delegateQueue: delegateQueue
+            )
+            session.sessionDescription = key
+            sessions[key] = session
+            return session
+        }
+    }
+
+    /// Performs a request on the host's pooled session.
+    func data(for request: URLRequest) async throws -> (Data, URLResponse) {
+        guard let url = request.url else { throw URLError(.badURL) }
+        markActivity(for: url)
+        return try await session(for: url).data(for: request)
+    }
+
+    /// Starts a streaming request on the host's pooled session and delivers the body in the
+    /// chunks the network produced.
+    ///
+    /// Consumers handle one `Data` per read instead of awaiting every byte, which matters on
+    /// fast token streams. Returns once the response headers arrived, which marks the first
+    /// byte of the current `QueryMetrics` span and trace; ending the iteration of the chunk
+    /// stream cancels the request.
+    func dataChunks(for request: URLRequest) async throws -> (AsyncThrowingStream<Data, Error>, URLResponse) {
+        guard let url = request.url else { throw URLError(.badURL) }
+        markActivity(for: url)
+
+        let task = session(for: url).dataTask(with: request)
+        let receiver = DataChunkReceiver()
+        task.delegate = receiver
+        receiver.chunkContinuation.onTermination = { _ in
+            task.cancel()
+        }
+
+        let response = try await withTaskCancellationHandler {
+            try await withCheckedThrowingContinuation { continuation in
+                receiver.responseContinuation = continuation
+                task.resume()
+            }
+        } onCancel: {
+            task.cancel()
+        }
+        QueryMetrics.current?.markFirstByte()
+        QueryTracer.shared.mark("response headers")
+        return (receiver.chunks, response)
+    }
+
+    /// Opens a connection to the endpoint's host ahead of the first query.
+    ///
+    /// Sends a lightweight `HEAD` request to the host root and ignores the response; only
+    /// the resulting pooled connection matters. Hosts with recent activity are skipped,
+    /// since their connection is most likely still alive.
+    func preconnect(to url: URL) {
+        guard let scheme = url.scheme, scheme.hasPrefix("http"), url.host != nil else { return }
+
+        let key = Self.hostKey(for: url)
+        let now = Date()
+        let shouldConnect = lock.withLock { () -> Bool in
+            if let lastActivity = lastActivityDates[key],
+               now.timeIntervalSince(lastActivity) < Self.preconnectInterval {
+                return false
+            }
+            lastActivityDates[key] = now
+            hostStatistics[key, default: LLMTransportStatistics()].preconnectCount += 1
+            return true
+        }
+        guard shouldConnect,
+              var components = URLComponents(url: url, resolvingAgainstBaseURL: false)
+        else { return }
+
+        components.path = "/"
+        components.query = nil
+        guard let probeURL = components.url else { return }
+
+        var request = URLRequest(url: probeURL, timeoutInterval: Self.preconnectTimeout)
+        request.httpMethod = "HEAD"
+        session(for: url).dataTask(with: request).resume()
+    }
+
+    /// Pre-connects the endpoints of all enabled LLM services shown in a window.
+    @objc(preconnectServices:)
+    func preconnect(services: [QueryService]) {
+        for service in services where service.enabled {
+            guard let streamService = service as? StreamService,
+                  streamService.usesLLMTransport,
+                  let url = URL(string: streamService.endpoint.trim())
+            else { continue }
+            preconnect(to: url)
+        }
+    }
+
+    /// Connection statistics for the endpoint's host.
+    func statistics(for url: URL) -> LLMTransportStatistics {
+        let key = Self.hostKey(for: url)
+        return lock.withLock { hostStatistics[key] ?? LLMTransportStatistics() }
+    }
+
+    /// Connection statistics of every host used so far, keyed by `scheme://host:port`.
+    func allStatistics() -> [String: LLMTransportStatistics] {
+        lock.withLock { hostStatistics }
+    }
+
+    // MARK: Private
+
+    /// Skip pre-connects while a connection to the host was used this recently.
+    private static let preconnectInterval: TimeInterval = 30
+    private static let preconnectTimeout: TimeInterval = 5
+
+    private let lock = NSLock()
+    private var sessions: [String: URLSession] = [:]
+    private var lastActivityDates: [String: Date] = [:]
+    private var hostStatistics: [String: LLMTransportStatistics] = [:]
+
+    private lazy var delegateQueue: OperationQueue = {
+        let queue = OperationQueue()
+        queue.name = "com.easydict.llm-transport"
+        queue.maxConcurrentOperationCount = 1
+        return queue
+    }()
+
+    private static func hostKey(for url: URL) -> String {
+        let scheme = url.scheme?.lowercased() ?? "https"
+        let host = url.host?.lowercased() ?? ""
+        let port = url.port ?? (scheme == "http" ? 80 : 443)
+        return "\(scheme)://\(host):\(port)"
+    }
+
+    private static func makeConfiguration() -> URLSessionConfiguration {
+        let configuration = URLSessionConfiguration.default
+        // LLM responses are never cacheable, and cookies are not part of any provider's auth.
+        configuration.urlCache = nil
+        configuration.httpCookieStorage = nil
+        configuration.httpShouldSetCookies = false
+        configuration.httpMaximumConnectionsPerHost = 6
+        configuration.waitsForConnectivity = false
+        return configuration
+    }
+
+    private func markActivity(for url: URL) {
+        let key = Self.hostKey(for: url)
+        lock.withLock {
+            lastActivityDates[key] = Date()
+        }
+    }
+}
+
+// MARK: URLSessionTaskDelegate
+
+extension LLMTransport: URLSessionTaskDelegate {
+    func urlSession(
+        _ session: URLSession,
+        task: URLSessionTask,
+        didFinishCollecting metrics: URLSessionTaskMetrics
+    ) {
+        guard let key = session.sessionDescription,
+              let transaction = metrics.transactionMetrics.last(where: { $0.resourceFetchType == .networkLoad })
+        else { return }
+
+        var connectMilliseconds = 0.0
+        if let connectStart = transaction.connectStartDate, let connectEnd = transaction.connectEndDate {
+            connectMilliseconds = connectEnd.timeIntervalSince(connectStart) * 1000
+        }
+
+        let statistics = lock.withLock { () -> LLMTransportStatistics in
+            var statistics = hostStatistics[key] ?? LLMTransportStatistics()
+            statistics.requestCount += 1
+            if transaction.isReusedConnection {
+                statistics.reusedConnectionCount += 1
+            } else {
+                statistics.newConnectionCount += 1
+                statistics.totalConnectMilliseconds += connectMilliseconds
+            }
+            hostStatistics[key] = statistics
+            return statistics
+        }
+
+        logInfo("LLM transport \(key): \(statistics)")
+    }
+}
+
+// MARK: - DataChunkReceiver
+
+/// Task delegate of `LLMTransport.dataChunks(for:)`.
+///
+/// Callbacks arrive on the transport's serial delegate queue. Metrics are not handled here,
+/// so they still reach the session delegate.
+private final class DataChunkReceiver: NSObject, URLSessionDataDelegate, @unchecked Sendable {
+    // MARK: Lifecycle
+
+    override init() {
+        var chunkContinuation: AsyncThrowingStream<Data, Error>.Continuation!
+        self.chunks = AsyncThrowingStream { chunkContinuation = $0 }
+        self.chunkContinuation = chunkContinuation
+        super.init()
+    }
+
+    // MARK: Internal
+
+    let chunks: AsyncThrowingStream<Data, Error>
+    let chunkContinuation: AsyncThrowingStream<Data, Error>.Continuation
+
+    var responseContinuation: CheckedContinuation<URLResponse, Error>? {
+        get { lock.withLock { _responseContinuation } }
+        set { lock.withLock { _responseContinuation = newValue } }
+    }
+
+    func urlSession(
+        _ session: URLSession,
+        dataTask: URLSessionDataTask,
+        didReceive response: URLResponse,
+        completionHandler: @escaping (URLSession.ResponseDisposition) -> ()
+    ) {
+        resumeResponse(with: .success(response))
+        completionHandler(.allow)
+    }
+
+    func urlSession(_ session: URLSession, dataTask: URLSessionDataTask, didReceive data: Data) {
+        chunkContinuation.yield(data)
+    }
+
+    func urlSession(_ session: URLSession, task: URLSessionTask, didCompleteWithError error: Error?) {
+        resumeResponse(with: .failure(error ?? URLError(.badServerResponse)))
+        chunkContinuation.finish(throwing: error)
+    }
+
+    // MARK: Private
+
+    private let lock = NSLock()
+    private var _responseContinuation: CheckedContinuation<URLResponse, Error>?
+
+    /// Resumes the waiting caller once; later results are ignored.
+    private func resumeResponse(with result: Result<URLResponse, Error>) {
+        let continuation = lock.withLock { () -> CheckedContinuation<URLResponse, Error>? in
+            defer { _responseContinuation = nil }
+            return _responseContinuation
+        }
+        continuation?.resume(with: result)
+    }
+}
@@ -0,0 +1,217 @@
+//
+//  ServerSentEventFramer.swift
+//  Easydict
+//
+//  Created by tisfeng on 2026/10/19.
+//  Copyright © 2026 izual. All rights reserved.
+//
+
+import Foundation
+
+// MARK: - ServerSentEvent
+
+/// One dispatched `text/event-stream` event.
+struct ServerSentEvent: Equatable {
+    /// Value of the `event:` field, `nil` when the event has none.
+    var type: String?
+    /// The event's `data:` lines joined by `\n`, as raw UTF-8 bytes.
+    var data: Data
+}
+
+// MARK: - ServerSentEventContentDecoder
+
+/// Extracts the text deltas of one provider's stream from its server-sent events.
+///
+/// Conforming types are created once per stream and reused for every event, so they can
+/// keep a `JSONDecoder` instead of allocating one per event.
+protocol ServerSentEventContentDecoder {
+    /// Returns the text delta carried by `event`, or `nil` for events without content.
+    ///
+    /// - Throws: `QueryError` when the event reports a provider error.
+    func content(of event: ServerSentEvent) throws -> String?
+}
+
+extension ServerSentEventContentDecoder {
+    /// Frames the response `chunks` into events and yields their content to `continuation`.
+    func yieldContent(
+        of chunks: AsyncThrowingStream<Data, Error>,
+        to continuation: AsyncThrowingStream<String, Error>.Continuation
+    ) async throws {
+        let framer = ServerSentEventFramer()
+        for try await chunk in chunks {
+            try Task.checkCancellation()
+            framer.append(chunk)
+            try framer.drainEvents { event in
+                if let content = try content(of: event) {
+                    continuation.yield(content)
+                }
+            }
+        }
+    }
+}
+
+// MARK: - ServerSentEventFramer
+
+/// Splits a `text/event-stream` response body into events, one network chunk at a time.
+///
+/// Line endings are normalized to LF while a chunk is appended: `memchr` finds each CR, so
+/// chunks without any (the common case) are copied in one go. A CR that ends a chunk is
+/// turned into LF right away and a LF that starts the next chunk is skipped, which keeps a
+/// CRLF split across chunks a single line break.
+///
+/// Lines are then found with `memchr` for LF from a scan offset, so a long partial line is
+/// never rescanned. Splitting on single-byte LF never cuts a multi-byte UTF-8 sequence, and
+/// payloads stay bytes until a decoder reads them.
+///
+/// Events follow the WHATWG parsing rules: comments are skipped, one space after the colon
+/// is dropped, and events without `data:` lines or without a terminating blank line are
+/// not dispatched.
+///
+/// Not thread-safe. Services own one framer per stream.
+final class ServerSentEventFramer {
+    // MARK: Lifecycle
+
+    init(initialCapacity: Int = 16 * 1024) {
+        buffer.reserveCapacity(initialCapacity)
+    }
+
+    // MARK: Internal
+
+    /// Number of buffered bytes that are not part of a complete line yet.
+    var pendingByteCount: Int {
+        buffer.count - readIndex
+    }
+
+    /// Appends one chunk of the response body.
+    func append(_ data: Data) {
+        guard !data.isEmpty else { return }
+        compact()
+
+        data.withUnsafeBytes { bytes in
+            guard let base = bytes.baseAddress else { return }
+            var runStart = 0
+            if skipsLeadingLineFeed {
+                skipsLeadingLineFeed = false
+                if bytes[0] == Self.lineFeed {
+                    runStart = 1
+                }
+            }
+
+            while runStart < bytes.count,
+                  let carriageReturn = memchr(base + runStart, Int32(Self.carriageReturn), bytes.count - runStart) {
+                let carriageReturnIndex = base.distance(to: UnsafeRawPointer(carriageReturn))
+                buffer.append(contentsOf: UnsafeRawBufferPointer(rebasing: bytes[runStart ..< carriageReturnIndex]))
+                buffer.append(Self.lineFeed)
+
+                runStart = carriageReturnIndex + 1
+                if runStart == bytes.count {
+                    skipsLeadingLineFeed = true
+                } else if bytes[runStart] == Self.lineFeed {
+                    runStart += 1
+                }
+            }
+
+            if runStart < bytes.count {
+                buffer.append(contentsOf: UnsafeRawBufferPointer(rebasing: bytes[runStart...]))
+            }
+        }
+    }
+
+    /// Calls `body` for every event completed by the appended chunks.
+    func drainEvents(_ body: (ServerSentEvent) throws -> ()) rethrows {
+        try buffer.withUnsafeBytes { bytes in
+            guard let base = bytes.baseAddress else { return }
+            while scanIndex < bytes.count {
+                guard let lineFeed = memchr(base + scanIndex, Int32(Self.lineFeed), bytes.count - scanIndex) else {
+                    scanIndex = bytes.count
+                    break
+                }
+                let lineFeedIndex = base.distance(to: UnsafeRawPointer(lineFeed))
+                let line = UnsafeRawBufferPointer(start: base + readIndex, count: lineFeedIndex - readIndex)
+                readIndex = lineFeedIndex + 1
+                scanIndex = readIndex
+                try processLine(line, body)
+            }
+        }
+    }
+
+    // MARK: Private
+
+    private static let lineFeed: UInt8 = 0x0A
+    private static let carriageReturn: UInt8 = 0x0D
+    private static let colon: UInt8 = 0x3A
+    private static let space: UInt8 = 0x20
+
+    private var buffer: [UInt8] = []
+    /// Start of the first line not yet processed.
+    private var readIndex = 0
+    /// Bytes in `readIndex ..< scanIndex` are known to contain no LF.
+    private var scanIndex = 0
+    /// The last chunk ended with CR, so a LF at the start of the next chunk belongs to it.
+    private var skipsLeadingLineFeed = false
+
+    /// Fields of the event being assembled.
+    private var eventType: String?
+    private var eventData = Data()
+    private var hasEventData = false
+
+    private static func field(_ field: UnsafeRawBufferPointer, is name: StaticString) -> Bool {
+        field.count == name.utf8CodeUnitCount
+            && memcmp(field.baseAddress!, name.utf8Start, field.count) == 0
+    }
+
+    private func processLine(_ line: UnsafeRawBufferPointer, _ body: (ServerSentEvent) throws -> ()) rethrows {
+        guard let base = line.baseAddress, !line.isEmpty else {
+            try dispatchEvent(body)
+            return
+        }
+        // Comment lines, often used as keep-alives.
+        guard line[0] != Self.colon else { return }
+
+        var fieldCount = line.count
+        var valueStart = line.count
+        if let colon = memchr(base, Int32(Self.colon), line.count) {
+            fieldCount = base.distance(to: UnsafeRawPointer(colon))
+            valueStart = fieldCount + 1
+            if valueStart < line.count, line[valueStart] == Self.space {
+                valueStart += 1
+            }
+        }
+        let field = UnsafeRawBufferPointer(rebasing: line[0 ..< fieldCount])
+        let value = UnsafeRawBufferPointer(rebasing: line[valueStart...])
+
+        if Self.field(field, is: "data") {
+            eventData.append(contentsOf: value)
+            eventData.append(Self.lineFeed)
+            hasEventData = true
+        } else if Self.field(field, is: "event") {
+            eventType = String(decoding: value, as: UTF8.self)
+        }
+    }
+
+    private func dispatchEvent(_ body: (ServerSentEvent) throws -> ()) rethrows {
+        defer {
+            eventType = nil
+            eventData = Data()
+            hasEventData = false
+        }
+        guard hasEventData else { return }
+
+        eventData.removeLast()
+        try body(ServerSentEvent(type: eventType, data: eventData))
+    }
+
+    /// Drops processed lines, moving the pending tail to the front once it is cheap enough.
+    private func compact() {
+        guard readIndex > 0 else { return }
+        if readIndex == buffer.count {
+            buffer.removeAll(keepingCapacity: true)
+        } else if readIndex >= buffer.count / 2 {
+            buffer.removeSubrange(0 ..< readIndex)
+        } else {
+            return
+        }
+        scanIndex -= readIndex
+        readIndex = 0
+    }
+}
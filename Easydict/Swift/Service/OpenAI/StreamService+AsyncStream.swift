@@ -18,18 +18,21 @@ extension StreamService {
         to: Language
     )
         -> AsyncThrowingStream<ChatStreamResult, Error> {
-        let contentStream = contentStreamTranslate(text, from: from, to: to)
+        let contentStream = coalescedContentStream(text, from: from, to: to)
         return contentStreamToChatStream(contentStream)
     }
 
     /// Stream translate text, return EZQueryResult stream.
+    /// - Parameter traceSpanID: The query span result updates are traced under, captured by
+    ///   the caller because the stream's tasks do not inherit its task-local context.
     /// - Note: This func does not throttle result.
     func streamTranslate(
         text: String,
         from: Language,
         to: Language,
         targetResult: QueryResult,
-        targetGeneration: UInt
+        targetGeneration: UInt,
+        traceSpanID: UInt64
     )
         -> AsyncThrowingStream<QueryResult, Error> {
         AsyncThrowingStream { continuation in
@@ -53,17 +56,18 @@ extension StreamService {
                 let queryType = queryType(text: text, from: from, to: to)
 
                 do {
-                    let contentStream = contentStreamTranslate(text, from: from, to: to)
-                    for try await content in contentStream {
+                    let textStream = translatedTextStream(text, from: from, to: to, queryType: queryType)
+                    for try await translatedText in textStream {
                         try Task.checkCancellation()
 
-                        resultText += content
+                        resultText = translatedText
                         updateResultText(
                             resultText,
                             queryType: queryType,
                             error: nil,
                             targetResult: targetResult,
-                            targetGeneration: targetGeneration
+                            targetGeneration: targetGeneration,
+                            traceSpanID: traceSpanID
                         ) { result in
                             continuation.yield(result)
                         }
@@ -80,7 +84,8 @@ extension StreamService {
                         error: nil,
                         markStreamFinished: true,
                         targetResult: targetResult,
-                        targetGeneration: targetGeneration
+                        targetGeneration: targetGeneration,
+                        traceSpanID: traceSpanID
                     ) { result in
                         continuation.yield(result)
                     }
@@ -106,7 +111,8 @@ extension StreamService {
                             queryType: queryType,
                             error: nil,
                             targetResult: targetResult,
-                            targetGeneration: targetGeneration
+                            targetGeneration: targetGeneration,
+                            traceSpanID: traceSpanID
                         ) { result in
                             continuation.yield(result)
                         }
@@ -126,7 +132,8 @@ extension StreamService {
                         queryType: queryType,
                         error: error,
                         targetResult: targetResult,
-                        targetGeneration: targetGeneration
+                        targetGeneration: targetGeneration,
+                        traceSpanID: traceSpanID
                     ) { result in
                         continuation.yield(result)
                     }
@@ -169,6 +176,7 @@ extension StreamService {
             Task {
                 do {
                     for try await content in contentStream {
+                        QueryMetrics.current?.markToken()
                         let chatStreamResult = ChatStreamResult.create(content: content, model: model)
                         continuation.yield(chatStreamResult)
                     }
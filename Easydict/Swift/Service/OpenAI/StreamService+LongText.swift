@@ -0,0 +1,378 @@
+//
+//  StreamService+LongText.swift
+//  Easydict
+//
+//  Created by tisfeng on 2026/10/19.
+//  Copyright © 2026 izual. All rights reserved.
+//
+
+import Defaults
+import Foundation
+import NaturalLanguage
+
+// MARK: - LongTextChunk
+
+/// One source segment translated by its own request in long-text mode.
+struct LongTextChunk: Equatable {
+    /// Source text sent to the service.
+    let text: String
+    /// Text placed before this chunk's translation when reassembling, e.g. `"\n"` at a
+    /// paragraph boundary or `" "` when a long paragraph was split between sentences.
+    let separator: String
+}
+
+// MARK: - LongTextSegmenter
+
+/// Splits long documents at paragraph boundaries, and overlong paragraphs at sentence
+/// boundaries, into chunks of roughly `maxChunkLength` characters.
+struct LongTextSegmenter {
+    /// Target upper bound of a chunk, a single sentence longer than this stays whole.
+    var maxChunkLength = 1500
+    /// A chunk shorter than this, such as a heading before a long paragraph, is merged
+    /// into a neighbouring chunk, so no request is sent for a lone fragment.
+    var minChunkLength = 200
+
+    func chunks(for text: String) -> [LongTextChunk] {
+        var chunks: [LongTextChunk] = []
+        var currentText = ""
+        var currentSeparator = ""
+        var pendingSeparator = ""
+
+        func flush() {
+            guard !currentText.isEmpty else { return }
+            chunks.append(LongTextChunk(text: currentText, separator: currentSeparator))
+            currentText = ""
+        }
+
+        for (paragraphIndex, paragraph) in text.toParagraphs().enumerated() {
+            if paragraphIndex > 0 {
+                pendingSeparator += "\n"
+            }
+            // Blank lines only contribute to the separator of the next piece.
+            guard !paragraph.trim().isEmpty else { continue }
+
+            for (pieceIndex, piece) in pieces(of: paragraph).enumerated() {
+                let separator = pieceIndex == 0 ? pendingSeparator : " "
+                pendingSeparator = ""
+
+                if currentText.isEmpty {
+                    currentSeparator = chunks.isEmpty ? "" : separator
+                    currentText = piece
+                } else if currentText.count + separator.count + piece.count <= maxChunkLength {
+                    currentText += separator + piece
+                } else {
+                    flush()
+                    currentSeparator = separator
+                    currentText = piece
+                }
+            }
+        }
+        flush()
+
+        return mergingShortChunks(chunks)
+    }
+
+    /// Appends each chunk to the previous one when either of them is shorter than
+    /// `minChunkLength`, so a short chunk joins the chunk after it or, at the end, before it.
+    private func mergingShortChunks(_ chunks: [LongTextChunk]) -> [LongTextChunk] {
+        var merged: [LongTextChunk] = []
+        for chunk in chunks {
+            guard let previous = merged.last,
+                  previous.text.count < minChunkLength || chunk.text.count < minChunkLength
+            else {
+                merged.append(chunk)
+                continue
+            }
+            merged[merged.count - 1] = LongTextChunk(
+                text: previous.text + chunk.separator + chunk.text,
+                separator: previous.separator
+            )
+        }
+        return merged
+    }
+
+    /// Returns the paragraph itself, or trimmed sentence groups when it is longer than a chunk.
+    private func pieces(of paragraph: String) -> [String] {
+        guard paragraph.count > maxChunkLength else { return [paragraph] }
+
+        let tokenizer = NLTokenizer(unit: .sentence)
+        tokenizer.string = paragraph
+        var pieces: [String] = []
+        var current = ""
+        tokenizer.enumerateTokens(in: paragraph.startIndex ..< paragraph.endIndex) { range, _ in
+            let sentence = String(paragraph[range])
+            if !current.isEmpty, current.count + sentence.count > maxChunkLength {
+                pieces.append(current)
+                current = ""
+            }
+            current += sentence
+            return true
+        }
+        if !current.isEmpty {
+            pieces.append(current)
+        }
+        return pieces.map { $0.trimmingCharacters(in: .whitespaces) }
+    }
+}
+
+// MARK: - LongTextAssembler
+
+/// Reassembles concurrently translated chunks in source order.
+///
+/// The visible text is every finished chunk of the leading prefix followed by the partial
+/// output of the first unfinished chunk; later chunks stay buffered until the prefix
+/// reaches them.
+struct LongTextAssembler {
+    // MARK: Lifecycle
+
+    init(chunks: [LongTextChunk]) {
+        self.separators = chunks.map(\.separator)
+        self.outputs = Array(repeating: "", count: chunks.count)
+        self.finished = Array(repeating: false, count: chunks.count)
+    }
+
+    // MARK: Internal
+
+    /// Translated text of the finished prefix.
+    private(set) var committedText = ""
+
+    var isComplete: Bool {
+        headIndex == outputs.count
+    }
+
+    /// Text to show: the finished prefix plus the head chunk's partial output, trimmed
+    /// like committed output so the text does not shift when the chunk finishes.
+    var visibleText: String {
+        guard headIndex < outputs.count else { return committedText }
+        let partialOutput = Self.trimmed(outputs[headIndex])
+        guard !partialOutput.isEmpty else { return committedText }
+        return committedText + (committedText.isEmpty ? "" : separators[headIndex]) + partialOutput
+    }
+
+    mutating func append(_ delta: String, toChunk index: Int) {
+        outputs[index] += delta
+    }
+
+    /// Drops partial output before a chunk is retried.
+    mutating func resetChunk(_ index: Int) {
+        outputs[index] = ""
+    }
+
+    mutating func finishChunk(_ index: Int) {
+        finished[index] = true
+        while headIndex < outputs.count, finished[headIndex] {
+            committedText += (committedText.isEmpty ? "" : separators[headIndex]) + Self.trimmed(outputs[headIndex])
+            outputs[headIndex] = ""
+            headIndex += 1
+        }
+    }
+
+    // MARK: Private
+
+    private let separators: [String]
+    private var outputs: [String]
+    private var finished: [Bool]
+    private var headIndex = 0
+
+    private static func trimmed(_ output: String) -> String {
+        output.trimmingCharacters(in: .whitespacesAndNewlines)
+    }
+}
+
+// MARK: - StreamService + LongText
+
+extension StreamService {
+    /// Streams the assembled translation text, translating long documents chunk by chunk.
+    ///
+    /// Each element is the full text so far, not a delta, because a retried chunk may
+    /// replace output that was already shown.
+    func translatedTextStream(
+        _ text: String,
+        from: Language,
+        to: Language,
+        queryType: EZQueryTextType
+    )
+        -> AsyncThrowingStream<String, Error> {
+        let chunks = longTextChunks(for: text, queryType: queryType)
+        guard chunks.count > 1 else {
+            return accumulatedTextStream(coalescedContentStream(text, from: from, to: to, queryType: queryType))
+        }
+
+        logInfo("\(serviceType().rawValue) long-text mode: \(chunks.count) chunks, \(text.count) characters")
+        return chunkedTranslationStream(chunks, from: from, to: to)
+    }
+
+    /// Returns the chunks for long-text mode, or an empty array when the text should be
+    /// translated in one request.
+    func longTextChunks(for text: String, queryType: EZQueryTextType) -> [LongTextChunk] {
+        guard Defaults[.enableLongTextChunkedTranslation],
+              longTextConcurrencyLimit > 0,
+              queryType == .translation,
+              // Custom prompts substitute the whole query text, so they cannot be split.
+              !enableCustomPrompt,
+              text.count > Self.longTextThreshold
+        else { return [] }
+
+        return LongTextSegmenter().chunks(for: text)
+    }
+
+    /// Whether a failed chunk is worth another attempt: transport errors, timeouts,
+    /// rate limiting (429) and server errors (5xx). Anything else, such as a rejected
+    /// API key or an unsupported model, fails the same way on every attempt.
+    static func isRetryableChunkError(_ error: Error) -> Bool {
+        switch error {
+        case let queryError as QueryError:
+            if queryError.type == .timeout {
+                return true
+            }
+            guard let statusCode = queryError.statusCode else { return false }
+            return statusCode == 429 || (500 ... 599).contains(statusCode)
+        case let urlError as URLError:
+            return urlError.code != .cancelled
+        default:
+            return false
+        }
+    }
+
+    // MARK: Private
+
+    /// Character count above which long-text mode splits the document.
+    private static var longTextThreshold: Int { 3000 }
+
+    /// Attempts per chunk, including the first one.
+    private static var maxChunkAttempts: Int { 3 }
+
+    private enum LongTextChunkEvent {
+        case delta(index: Int, text: String)
+        case restarted(index: Int)
+        case finished(index: Int)
+        case failed(index: Int, error: Error)
+    }
+
+    private func accumulatedTextStream(
+        _ contentStream: AsyncThrowingStream<String, Error>
+    )
+        -> AsyncThrowingStream<String, Error> {
+        AsyncThrowingStream { continuation in
+            let task = Task {
+                var text = ""
+                do {
+                    for try await content in contentStream {
+                        QueryMetrics.current?.markToken()
+                        text += content
+                        continuation.yield(text)
+                    }
+                    continuation.finish()
+                } catch {
+                    continuation.finish(throwing: error)
+                }
+            }
+            continuation.onTermination = { _ in
+                task.cancel()
+            }
+        }
+    }
+
+    private func chunkedTranslationStream(
+        _ chunks: [LongTextChunk],
+        from: Language,
+        to: Language
+    )
+        -> AsyncThrowingStream<String, Error> {
+        let concurrencyLimit = min(longTextConcurrencyLimit, chunks.count)
+
+        return AsyncThrowingStream { continuation in
+            let (events, eventContinuation) = AsyncStream.makeStream(of: LongTextChunkEvent.self)
+
+            let worker = Task {
+                await withTaskGroup(of: Void.self) { group in
+                    var nextIndex = 0
+                    while nextIndex < concurrencyLimit {
+                        let index = nextIndex
+                        group.addTask {
+                            await self.translateChunk(chunks[index], at: index, from: from, to: to, events: eventContinuation)
+                        }
+                        nextIndex += 1
+                    }
+                    for await _ in group where nextIndex < chunks.count {
+                        let index = nextIndex
+                        group.addTask {
+                            await self.translateChunk(chunks[index], at: index, from: from, to: to, events: eventContinuation)
+                        }
+                        nextIndex += 1
+                    }
+                }
+                eventContinuation.finish()
+            }
+
+            let assembly = Task {
+                var assembler = LongTextAssembler(chunks: chunks)
+                for await event in events {
+                    switch event {
+                    case let .delta(index, text):
+                        assembler.append(text, toChunk: index)
+                    case let .restarted(index):
+                        assembler.resetChunk(index)
+                    case let .finished(index):
+                        assembler.finishChunk(index)
+                    case let .failed(index, error):
+                        logError("Long-text chunk \(index) failed after retries: \(error)")
+                        worker.cancel()
+                        continuation.finish(throwing: error)
+                        return
+                    }
+                    continuation.yield(assembler.visibleText)
+                }
+
+                if Task.isCancelled || !assembler.isComplete {
+                    continuation.finish(throwing: CancellationError())
+                } else {
+                    continuation.finish()
+                }
+            }
+
+            continuation.onTermination = { _ in
+                worker.cancel()
+                assembly.cancel()
+            }
+        }
+    }
+
+    /// Translates one chunk, retrying it alone with a short backoff when it fails with a
+    /// transient error (see `isRetryableChunkError(_:)`).
+    private func translateChunk(
+        _ chunk: LongTextChunk,
+        at index: Int,
+        from: Language,
+        to: Language,
+        events: AsyncStream<LongTextChunkEvent>.Continuation
+    ) async {
+        var lastError: Error = QueryError(type: .noResult)
+        for attempt in 0 ..< Self.maxChunkAttempts {
+            if attempt > 0 {
+                events.yield(.restarted(index: index))
+                try? await Task.sleep(for: .milliseconds(500 * attempt))
+            }
+            guard !Task.isCancelled else { return }
+
+            do {
+                // Sent as `.translation` like the whole document, whatever the chunk looks like.
+                let contentStream = coalescedContentStream(chunk.text, from: from, to: to, queryType: .translation)
+                for try await content in contentStream {
+                    QueryMetrics.current?.markToken()
+                    events.yield(.delta(index: index, text: content))
+                }
+                try Task.checkCancellation()
+                events.yield(.finished(index: index))
+                return
+            } catch is CancellationError {
+                return
+            } catch {
+                logInfo("Long-text chunk \(index) attempt \(attempt + 1) failed: \(error)")
+                lastError = error
+                guard Self.isRetryableChunkError(error) else { break }
+            }
+        }
+        events.yield(.failed(index: index, error: lastError))
+    }
+}
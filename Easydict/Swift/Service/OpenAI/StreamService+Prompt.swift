@@ -29,13 +29,23 @@ extension StreamService {
     }
 
     func translationMessages(_ chatQuery: ChatQueryParam) -> [ChatMessage] {
-        let (text, sourceLanguage, targetLanguage, _, enableSystemPrompt) = chatQuery.unpack()
+        let (text, sourceLanguage, targetLanguage, _, _) = chatQuery.unpack()
 
         // Use """ %@ """ to wrap user input, Ref: https://help.openai.com/en/articles/6654000-best-practices-for-prompt-engineering-with-openai-api#h_21d4f4dc3d
         //        let prompt = "Translate the following \(from.rawValue) text into \(to.rawValue) text: \"\"\"\(text)\"\"\""
 
         let prompt = translationPrompt(text: text, from: sourceLanguage, to: targetLanguage)
 
+        return promptPrefixMessages(for: chatQuery) + [.init(role: .user, content: prompt)]
+    }
+
+    /// System prompt and few-shot turns shared by every translation query of a language pair.
+    private func translationPrefixMessages(
+        from sourceLanguage: Language,
+        to targetLanguage: Language,
+        enableSystemPrompt: Bool
+    )
+        -> [ChatMessage] {
         let chineseFewShot = [
             // en --> zh
             chatMessagePair(
@@ -161,14 +171,11 @@ extension StreamService {
             messages.append(contentsOf: toClassicalChineseFewShot)
         }
 
-        let userMessages: [ChatMessage] = [.init(role: .user, content: prompt)]
-        messages.append(contentsOf: userMessages)
-
         return messages
     }
 
     func sentenceMessages(_ chatQuery: ChatQueryParam) -> [ChatMessage] {
-        let (sentence, sourceLanguage, targetLanguage, _, enableSystemPrompt) = chatQuery.unpack()
+        let (sentence, sourceLanguage, targetLanguage, _, _) = chatQuery.unpack()
 
         let answerLanguage = MyConfiguration.shared.firstLanguage
 
@@ -218,6 +225,16 @@ extension StreamService {
             "Total word count should not exceed 1000. Do not include additional information or notes."
         prompt += disableNotePrompt
 
+        let userMessage: ChatMessage = .init(role: .user, content: prompt)
+        return promptPrefixMessages(for: chatQuery) + [userMessage]
+    }
+
+    /// System prompt and few-shot turns shared by every sentence query of an answer language.
+    private func sentencePrefixMessages(
+        answerLanguage: Language,
+        enableSystemPrompt: Bool
+    )
+        -> [ChatMessage] {
         // Add few-shot examples or other messages as needed
         let chineseFewShot = [
             chatMessagePair(
@@ -355,14 +372,11 @@ extension StreamService {
             messages += englishFewShot
         }
 
-        let userMessage: ChatMessage = .init(role: .user, content: prompt)
-        messages.append(userMessage)
-
         return messages
     }
 
     func dictMessages(_ chatQuery: ChatQueryParam) -> [ChatMessage] {
-        let (word, sourceLanguage, targetLanguage, _, enableSystemPrompt) = chatQuery.unpack()
+        let (word, sourceLanguage, targetLanguage, _, _) = chatQuery.unpack()
 
         var prompt = ""
 
@@ -508,6 +522,16 @@ extension StreamService {
         let disableNotePrompt = "Do not display additional information or notes."
         prompt.append(disableNotePrompt)
 
+        let userMessage: ChatMessage = .init(role: .user, content: prompt)
+        return promptPrefixMessages(for: chatQuery) + [userMessage]
+    }
+
+    /// System prompt and few-shot turns shared by every dictionary query of an answer language.
+    private func dictPrefixMessages(
+        answerLanguage: Language,
+        enableSystemPrompt: Bool
+    )
+        -> [ChatMessage] {
         let chineseFewShot: [ChatMessage] = [
             chatMessagePair(
                 userContent: """
@@ -685,9 +709,6 @@ extension StreamService {
             messages += englishFewShot
         }
 
-        let userMessage: ChatMessage = .init(role: .user, content: prompt)
-        messages.append(userMessage)
-
         return messages
     }
 }
@@ -705,6 +726,51 @@ extension StreamService {
         }
     }
 
+    /// Returns the system prompt and few-shot turns that precede the query's user message.
+    ///
+    /// The prefix only depends on the query type, language pair, answer language and system
+    /// prompt flag, so it is rendered once per combination and stays byte-identical across
+    /// queries, which is what provider prompt caches match on. Its last message is marked as
+    /// a cache breakpoint for APIs that need explicit markers, such as Claude.
+    func promptPrefixMessages(for chatQuery: ChatQueryParam) -> [ChatMessage] {
+        let answerLanguage = MyConfiguration.shared.firstLanguage
+        let key = PromptPrefixKey(
+            queryType: chatQuery.queryType,
+            sourceLanguage: chatQuery.sourceLanguage,
+            targetLanguage: chatQuery.targetLanguage,
+            answerLanguage: answerLanguage,
+            enableSystemPrompt: chatQuery.enableSystemPrompt
+        )
+
+        return PromptPrefixCache.shared.messages(for: key) {
+            var messages =
+                switch chatQuery.queryType {
+                case .dictionary:
+                    dictPrefixMessages(
+                        answerLanguage: answerLanguage,
+                        enableSystemPrompt: chatQuery.enableSystemPrompt
+                    )
+                case .sentence:
+                    sentencePrefixMessages(
+                        answerLanguage: answerLanguage,
+                        enableSystemPrompt: chatQuery.enableSystemPrompt
+                    )
+                default:
+                    translationPrefixMessages(
+                        from: chatQuery.sourceLanguage,
+                        to: chatQuery.targetLanguage,
+                        enableSystemPrompt: chatQuery.enableSystemPrompt
+                    )
+                }
+
+            if var lastMessage = messages.popLast() {
+                lastMessage.isCacheBreakpoint = true
+                messages.append(lastMessage)
+            }
+            return messages
+        }
+    }
+
     /**
      Convert custom prompt $xxx to variable.
 
@@ -33,6 +33,7 @@ extension StreamService {
         error: Error?,
         targetResult: QueryResult? = nil,
         targetGeneration: UInt? = nil,
+        traceSpanID: UInt64,
         interval: TimeInterval = 0.3,
         completion: @escaping (QueryResult) -> ()
     ) async throws {
@@ -43,6 +44,7 @@ extension StreamService {
                 error: error,
                 targetResult: targetResult,
                 targetGeneration: targetGeneration,
+                traceSpanID: traceSpanID,
                 completion: completion
             )
         }
@@ -54,6 +56,8 @@ extension StreamService {
     ///   the lock before updating `translatedResults`. This prevents a race where a throttled
     ///   delivery of an earlier accumulated snapshot overwrites the final value after
     ///   `isStreamFinished` has been set outside the lock.
+    /// - Parameter traceSpanID: The query span to trace this update under. It is passed in
+    ///   because throttled and streamed updates run outside the query's task-local context.
     func updateResultText(
         _ resultText: String?,
         queryType: EZQueryTextType,
@@ -61,8 +65,12 @@ extension StreamService {
         markStreamFinished: Bool = false,
         targetResult: QueryResult? = nil,
         targetGeneration: UInt? = nil,
+        traceSpanID: UInt64,
         completion: @escaping (QueryResult) -> ()
     ) {
+        let updateSpanID = QueryTracer.shared.beginSpan("updateResultText", parent: traceSpanID, lane: nil)
+        defer { QueryTracer.shared.endSpan(updateSpanID) }
+
         // Acquire the lock before accessing/modifying the shared 'result' state
         updateResultLock.lock()
         defer { updateResultLock.unlock() }
@@ -127,12 +127,15 @@ public class StreamService: QueryService {
         // Capture the current result generation with the result object. Later
         // chunks are ignored if a reset starts a newer query on this service.
         let activeGeneration = resultGeneration
+        // Read the query span here, where the query's task-local context is still bound.
+        let traceSpanID = QueryTracer.currentSpanID
         let queryResultStream = streamTranslate(
             text: text,
             from: from,
             to: to,
             targetResult: activeResult,
-            targetGeneration: activeGeneration
+            targetGeneration: activeGeneration,
+            traceSpanID: traceSpanID
         )
         let textStream = queryResultStreamToTextStream(queryResultStream)
 
@@ -151,7 +154,8 @@ public class StreamService: QueryService {
                         queryType: self.supportedQueryType(),
                         error: nil,
                         targetResult: activeResult,
-                        targetGeneration: activeGeneration
+                        targetGeneration: activeGeneration,
+                        traceSpanID: traceSpanID
                     ) { result in
                         if result.error != nil {
                             didYieldError = true
@@ -185,6 +189,40 @@ public class StreamService: QueryService {
         }
     }
 
+    /// Adds the model and prompt settings that shape the request.
+    public override func coalescingKey(text: String, from: Language, to: Language) -> String? {
+        coalescingKey(text: text, from: from, to: to, queryType: queryType(text: text, from: from, to: to))
+    }
+
+    /// The coalescing key of a request sent as `queryType`; nil opts out.
+    func coalescingKey(text: String, from: Language, to: Language, queryType: EZQueryTextType) -> String? {
+        guard let baseKey = super.coalescingKey(text: text, from: from, to: to) else { return nil }
+
+        var components = [
+            baseKey,
+            endpoint,
+            model,
+            "\(temperature)",
+            "\(queryType.rawValue)",
+        ]
+        if enableCustomPrompt {
+            components += [systemPrompt, userPrompt, queryModel.queryText]
+        }
+        return components.joined(separator: "\u{1F}")
+    }
+
+    /// Stream services share the upstream content stream instead, see `coalescedContentStream`,
+    /// so every caller still builds its own throttled result.
+    @nonobjc
+    public override func coalescedTranslate(
+        _ text: String,
+        from: Language,
+        to: Language
+    ) async throws
+        -> QueryResult {
+        try await translate(text, from: from, to: to)
+    }
+
     public override func apiKeyRequirement() -> ServiceAPIKeyRequirement {
         .userProvided
     }
@@ -216,6 +254,20 @@ public class StreamService: QueryService {
         false
     }
 
+    /// Whether network requests go through the pooled `LLMTransport`, which lets query
+    /// windows pre-connect to `endpoint` before the first query.
+    var usesLLMTransport: Bool {
+        false
+    }
+
+    /// Maximum concurrent chunk requests in long-text mode, 0 disables chunking.
+    ///
+    /// Only services whose `contentStreamTranslate` can run several requests at once
+    /// should return a positive value.
+    var longTextConcurrencyLimit: Int {
+        0
+    }
+
     var remoteModelsEndpoint: String? {
         nil
     }
@@ -422,20 +474,18 @@ public class StreamService: QueryService {
     }
 
     func fetchRemoteModelData(url: URL, headers: HTTPHeaders = []) async throws -> Data {
-        let response = await AF.request(
-            url,
-            method: .get,
-            headers: headers,
-            requestModifier: { $0.timeoutInterval = EZNetWorkTimeoutInterval }
-        )
-        .serializingData(automaticallyCancelling: true)
-        .response
+        var request = URLRequest(url: url, timeoutInterval: EZNetWorkTimeoutInterval)
+        for header in headers {
+            request.setValue(header.value, forHTTPHeaderField: header.name)
+        }
 
-        if let statusCode = response.response?.statusCode,
+        // Same pooled connection as the chat requests that usually follow.
+        let (data, response) = try await LLMTransport.shared.data(for: request)
+        if let statusCode = (response as? HTTPURLResponse)?.statusCode,
            !(200 ... 299).contains(statusCode) {
-            throw remoteModelError(statusCode: statusCode, data: response.data)
+            throw remoteModelError(statusCode: statusCode, data: data)
         }
-        return try response.result.get()
+        return data
     }
 
     /// Base on chat query, convert prompt dict to LLM service prompt model.
@@ -500,12 +550,41 @@ public class StreamService: QueryService {
         return .translation
     }
 
+    /// `contentStreamTranslate`, shared with concurrent identical requests.
+    ///
+    /// The upstream stream runs on a separate instance of this service, so one caller's
+    /// `cancelStream()` cannot abort the others; a caller leaves through
+    /// `InFlightCoalescer.cancelSubscriptions(of:)` instead.
+    ///
+    /// - Parameter queryType: How the text is sent, inferred from `text` when nil. Chunks of a
+    ///   long document pass `.translation`, since a short chunk looks like a dictionary query.
+    func coalescedContentStream(
+        _ text: String,
+        from: Language,
+        to: Language,
+        queryType: EZQueryTextType? = nil
+    )
+        -> AsyncThrowingStream<String, Error> {
+        let queryType = queryType ?? self.queryType(text: text, from: from, to: to)
+        guard let key = coalescingKey(text: text, from: from, to: to, queryType: queryType) else {
+            return contentStreamTranslate(text, from: from, to: to, queryType: queryType)
+        }
+
+        return InFlightCoalescer.shared.stream(for: key, owner: self) { [self] in
+            makeCoalescingUpstream().contentStreamTranslate(text, from: from, to: to, queryType: queryType)
+        }
+    }
+
     /// Content stream translate.
     /// Content is the original delta text.
+    ///
+    /// - Parameter queryType: How the text is sent, resolved by the caller with
+    ///   `queryType(text:from:to:)` unless it is fixed, as for long-text chunks.
     func contentStreamTranslate(
         _ text: String,
         from: Language,
-        to: Language
+        to: Language,
+        queryType: EZQueryTextType
     )
         -> AsyncThrowingStream<String, Error> {
         AsyncThrowingStream { continuation in
@@ -48,13 +48,14 @@ extension YoudaoService {
 
         do {
             // Get the raw data
-            let responseData = try await AF.request(
-                url,
-                method: .post,
-                parameters: parameters
-            )
-            .serializingData()
-            .value
+            let responseData = try await hedgedDataRequest {
+                AF.request(
+                    url,
+                    method: .post,
+                    parameters: parameters
+                )
+            }
+            .data()
 
             // Decode the data
             let response = try JSONDecoder().decode(YoudaoDictResponseV4.self, from: responseData)
@@ -128,13 +129,14 @@ extension YoudaoService {
 
         do {
             // Get the raw data
-            let responseData = try await AF.request(
-                url,
-                method: .get,
-                parameters: parameters
-            )
-            .serializingData()
-            .value
+            let responseData = try await hedgedDataRequest {
+                AF.request(
+                    url,
+                    method: .get,
+                    parameters: parameters
+                )
+            }
+            .data()
 
             // Decode the data
             let response = try JSONDecoder().decode(YoudaoDictResponse.self, from: responseData)
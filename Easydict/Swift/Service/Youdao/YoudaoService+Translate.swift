@@ -80,14 +80,15 @@ extension YoudaoService {
             ], uniquingKeysWith: { _, new in new }
         )
 
-        let data = try await AF.request(
-            "\(kYoudaoDictURL)/webtranslate",
-            method: .post,
-            parameters: parameters,
-            headers: headers
-        )
-        .serializingData()
-        .value
+        let data = try await hedgedDataRequest {
+            AF.request(
+                "\(kYoudaoDictURL)/webtranslate",
+                method: .post,
+                parameters: parameters,
+                headers: self.headers
+            )
+        }
+        .data()
 
         do {
             let translateResponse = try parseTranslationResult(data, aesKey: aesKey, aesIv: aesIv)
@@ -121,14 +122,16 @@ extension YoudaoService {
             ], uniquingKeysWith: { _, new in new }
         )
 
-        return try await AF.request(
-            "\(kYoudaoDictURL)/webtranslate/key",
-            method: .get,
-            parameters: parameters,
-            headers: headers
-        )
-        .serializingDecodable(YoudaoKey.self)
-        .value
+        let data = try await hedgedDataRequest {
+            AF.request(
+                "\(kYoudaoDictURL)/webtranslate/key",
+                method: .get,
+                parameters: parameters,
+                headers: self.headers
+            )
+        }
+        .data()
+        return try JSONDecoder().decode(YoudaoKey.self, from: data)
     }
 
     private func generateSign(
@@ -52,6 +52,10 @@ class YoudaoService: QueryService {
         .none
     }
 
+    override func supportsRequestHedging() -> Bool {
+        true
+    }
+
     override func link() -> String {
         kYoudaoTranslateURL
     }
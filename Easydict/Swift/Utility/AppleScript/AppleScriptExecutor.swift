@@ -13,21 +13,37 @@ import Foundation
 /// facade type. It centralizes timeout control, background execution, and `QueryError` mapping so
 /// browser automation, system integrations, and Apple Translation fallback all share one runtime
 /// behavior. This is the preferred AppleScript backend for production Easydict features.
+///
+/// With a `compiledScriptCache`, scripts are compiled once and then checked out of the cache for
+/// each run. Scripts whose source changes on every run, such as text insertion, should use an
+/// executor without a cache, which compiles each script on a concurrent background queue.
 struct AppleScriptExecutor {
+    // MARK: Lifecycle
+
+    init(compiledScriptCache: CompiledAppleScriptCache? = nil) {
+        self.compiledScriptCache = compiledScriptCache
+    }
+
     // MARK: Internal
 
+    let compiledScriptCache: CompiledAppleScriptCache?
+
     /// Runs an AppleScript string through the `NSAppleScript` backend.
     ///
     /// - Parameters:
     ///   - appleScript: The AppleScript source string to execute.
     ///   - timeout: Maximum execution time in seconds.
+    ///   - bundleID: Bundle ID of the application the script targets, part of the cache key.
     /// - Returns: The script's optional string result.
     /// - Throws: `QueryError` when script creation, execution, or timeout handling fails.
     @discardableResult
-    func run(_ appleScript: String, timeout: TimeInterval = 10) async throws -> String? {
+    func run(_ appleScript: String, timeout: TimeInterval = 10, bundleID: String? = nil) async throws -> String? {
         do {
             return try await Task.withTimeout(seconds: timeout) {
-                try await executeOnBackgroundQueue(appleScript)
+                if let compiledScriptCache {
+                    return try await executeCompiled(appleScript, bundleID: bundleID, cache: compiledScriptCache)
+                }
+                return try await executeOnBackgroundQueue(appleScript)
             }
         } catch is TaskTimeoutError {
             throw makeAppleScriptError(
@@ -62,23 +78,62 @@ struct AppleScriptExecutor {
                     return
                 }
 
-                var errorInfo: NSDictionary?
-                let output = script.executeAndReturnError(&errorInfo)
-
-                if let errorInfo {
-                    let errorMessage =
-                        errorInfo[NSAppleScript.errorMessage] as? String ?? "Run AppleScript error"
-                    continuation.resume(
-                        throwing: makeAppleScriptError(errorMessage, appleScript: appleScript)
-                    )
-                    return
-                }
+                continuation.resume(with: Result { try execute(script, appleScript: appleScript) })
+            }
+        }
+    }
 
-                continuation.resume(returning: output.stringValue)
+    /// Executes `appleScript` compiled from `cache`, on a concurrent background queue.
+    ///
+    /// The script is checked out of the cache while it runs, so a hung Apple Event only holds
+    /// its own script and later runs, for this or other browsers, are not queued behind it.
+    ///
+    /// - Parameters:
+    ///   - appleScript: The AppleScript source string to execute.
+    ///   - bundleID: Bundle ID of the application the script targets.
+    ///   - cache: Cache holding the compiled script.
+    /// - Returns: The script's optional string result.
+    /// - Throws: `QueryError` when compiling or execution fails.
+    private func executeCompiled(
+        _ appleScript: String,
+        bundleID: String?,
+        cache: CompiledAppleScriptCache
+    ) async throws
+        -> String? {
+        try await withCheckedThrowingContinuation { continuation in
+            DispatchQueue.global().async {
+                continuation.resume(with: Result {
+                    let script = try cache.checkOut(appleScript, bundleID: bundleID)
+                    let startTime = CFAbsoluteTimeGetCurrent()
+                    defer {
+                        cache.recordExecution(bundleID: bundleID, duration: CFAbsoluteTimeGetCurrent() - startTime)
+                        cache.checkIn(script, source: appleScript, bundleID: bundleID)
+                    }
+                    return try execute(script, appleScript: appleScript)
+                })
             }
         }
     }
 
+    /// Executes `script` on the current thread and maps its error dictionary.
+    ///
+    /// - Parameters:
+    ///   - script: The script to execute, compiled or not.
+    ///   - appleScript: The AppleScript source string, attached to errors.
+    /// - Returns: The script's optional string result.
+    /// - Throws: `QueryError` when execution fails.
+    private func execute(_ script: NSAppleScript, appleScript: String) throws -> String? {
+        var errorInfo: NSDictionary?
+        let output = script.executeAndReturnError(&errorInfo)
+
+        if let errorInfo {
+            let errorMessage = errorInfo[NSAppleScript.errorMessage] as? String ?? "Run AppleScript error"
+            throw makeAppleScriptError(errorMessage, appleScript: appleScript)
+        }
+
+        return output.stringValue
+    }
+
     /// Creates a standardized AppleScript query error with the script content attached.
     ///
     /// - Parameters:
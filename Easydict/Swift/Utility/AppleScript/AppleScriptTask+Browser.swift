@@ -6,6 +6,8 @@
 //  Copyright © 2024 izual. All rights reserved.
 //
 
+import AppKit
+
 extension AppleScriptTask {
     // MARK: Internal
 
@@ -58,26 +60,65 @@ extension AppleScriptTask {
         }
     }
 
+    /// Compiles the read-only scripts of a browser whenever it becomes the frontmost app,
+    /// so the first selection in it does not pay for compiling. Safe to call more than once.
+    class func startPrewarmingBrowserScripts() {
+        _ = browserActivationObserver
+        if let bundleID = NSWorkspace.shared.frontmostApplication?.bundleIdentifier {
+            prewarmBrowserScripts(bundleID)
+        }
+    }
+
+    /// Compiles the scripts run on every selection in `bundleID` into the shared cache.
+    class func prewarmBrowserScripts(_ bundleID: String) {
+        guard isBrowserSupportingAppleScript(bundleID) else { return }
+
+        let actions: [BrowserAction] = [.getSelectedText, .getCurrentTabURL, .getTextFieldText]
+        let scripts = actions.compactMap { browserScript(for: $0, bundleID: bundleID)?.script }
+        CompiledAppleScriptCache.shared.prewarm(scripts, bundleID: bundleID)
+    }
+
     // MARK: Private
 
+    private static let browserActivationObserver = NSWorkspace.shared.notificationCenter.addObserver(
+        forName: NSWorkspace.didActivateApplicationNotification,
+        object: nil,
+        queue: nil
+    ) { notification in
+        let application = notification.userInfo?[NSWorkspace.applicationUserInfoKey] as? NSRunningApplication
+        if let bundleID = application?.bundleIdentifier {
+            AppleScriptTask.prewarmBrowserScripts(bundleID)
+        }
+    }
+
+    /// Returns the script of `action` for a Safari or Chrome kernel browser.
+    private class func browserScript(for action: BrowserAction, bundleID: String) -> (
+        script: String, timeout: TimeInterval?, logMessage: String
+    )? {
+        if isSafari(bundleID) {
+            return safariScriptFor(action: action, bundleID: bundleID)
+        }
+        if isChromeKernelBrowser(bundleID) {
+            return chromeScriptFor(action: action, bundleID: bundleID)
+        }
+        return nil
+    }
+
     /// Generic browser action executor that handles Safari and Chrome differences
     private class func executeBrowserAction(_ action: BrowserAction, bundleID: String) async throws
         -> String? {
-        guard isBrowserSupportingAppleScript(bundleID) else { return nil }
-
-        let script: String
-        let timeout: TimeInterval?
-        let logMessage: String
-
-        if isSafari(bundleID) {
-            (script, timeout, logMessage) = safariScriptFor(action: action, bundleID: bundleID)
-        } else if isChromeKernelBrowser(bundleID) {
-            (script, timeout, logMessage) = chromeScriptFor(action: action, bundleID: bundleID)
+        guard isBrowserSupportingAppleScript(bundleID),
+              let browserScript = browserScript(for: action, bundleID: bundleID)
+        else { return nil }
+        let (script, timeout, logMessage) = browserScript
+
+        let result: String?
+        if case .insertText = action {
+            // The script embeds the inserted text, so compiling it once would not be reused.
+            result = try await runAppleScript(script, timeout: timeout ?? 5.0)
         } else {
-            return nil
+            result = try await runCompiledAppleScript(script, bundleID: bundleID, timeout: timeout ?? 5.0)
         }
-
-        let result = try await runAppleScript(script, timeout: timeout ?? 5.0)
         logInfo("\(logMessage): \(result ?? "")")
         return result
     }
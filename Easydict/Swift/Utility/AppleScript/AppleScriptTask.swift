@@ -45,6 +45,28 @@ class AppleScriptTask: NSObject {
         -> String? {
         try await AppleScriptExecutor().run(appleScript, timeout: timeout)
     }
+
+    /// Runs AppleScript whose source repeats across runs, reusing its compiled form.
+    ///
+    /// - Parameters:
+    ///   - appleScript: The AppleScript to execute, compiled on its first run
+    ///   - bundleID: Bundle ID of the application the script targets
+    ///   - timeout: Maximum execution time in seconds, defaults to 10
+    /// - Returns: Optional string result from the AppleScript execution
+    /// - Throws: QueryError if execution fails or times out
+    /// - Note: Only compiling is serialized, on the queue of `CompiledAppleScriptCache.shared`;
+    ///   scripts run concurrently on a background queue, each with its own compiled instance.
+    ///   Use it for short scripts on latency-sensitive paths such as reading the selected text.
+    @discardableResult
+    static func runCompiledAppleScript(
+        _ appleScript: String,
+        bundleID: String?,
+        timeout: TimeInterval = 10
+    ) async throws
+        -> String? {
+        try await AppleScriptExecutor(compiledScriptCache: .shared)
+            .run(appleScript, timeout: timeout, bundleID: bundleID)
+    }
 }
 
 /// Builds the `Shortcuts Events` AppleScript used to run a shortcut with plain-text input.
@@ -0,0 +1,149 @@
+//
+//  CompiledAppleScriptCache.swift
+//  Easydict
+//
+//  Created by tisfeng on 2026/10/19.
+//  Copyright © 2026 izual. All rights reserved.
+//
+
+import Foundation
+
+// MARK: - CompiledAppleScriptCache
+
+/// Caches compiled `NSAppleScript` objects by script source and target bundle ID.
+///
+/// Compiling a script from source costs tens of milliseconds, which the browser selected-text
+/// scripts used to pay on every selection. Compiled scripts are kept here, at most `capacity`
+/// of them, evicting the least recently used.
+///
+/// `NSAppleScript` is not thread-safe, so a script is checked out of the cache for the
+/// duration of a run and checked back in afterwards; one instance never runs on two threads.
+/// Only compiling and cache bookkeeping are serialized on a private queue. Runs happen on the
+/// caller's thread, so a browser whose Apple Event hangs does not hold up scripts for other
+/// browsers. A script that never returns is simply never checked back in, and the next run
+/// compiles a new instance.
+final class CompiledAppleScriptCache: @unchecked Sendable {
+    // MARK: Lifecycle
+
+    init(capacity: Int = 32, registry: MetricsRegistry = .shared) {
+        self.capacity = max(capacity, 1)
+        self.registry = registry
+    }
+
+    // MARK: Internal
+
+    static let shared = CompiledAppleScriptCache()
+
+    static let compileDuration = MetricDescriptor(
+        name: "easydict_applescript_compile_seconds",
+        help: "Time to compile an AppleScript from source, by target bundle ID.",
+        kind: .summary
+    )
+    static let executeDuration = MetricDescriptor(
+        name: "easydict_applescript_execute_seconds",
+        help: "Time to execute a compiled AppleScript, by target bundle ID.",
+        kind: .summary
+    )
+
+    let capacity: Int
+
+    /// Number of cached scripts.
+    var count: Int {
+        queue.sync { scripts.count }
+    }
+
+    /// Removes the compiled script for `source` from the cache for exclusive use, compiling
+    /// a new one on a miss. Pass it to `checkIn(_:source:bundleID:)` after running it.
+    ///
+    /// - Throws: `QueryError` when compiling fails.
+    func checkOut(_ source: String, bundleID: String?) throws -> NSAppleScript {
+        try queue.sync {
+            let key = Key(source: source, bundleID: bundleID)
+            if let index = scripts.firstIndex(where: { $0.key == key }) {
+                QueryMetrics.recordCacheLookup("applescript", hit: true)
+                return scripts.remove(at: index).script
+            }
+            QueryMetrics.recordCacheLookup("applescript", hit: false)
+            return try compile(source, bundleID: bundleID)
+        }
+    }
+
+    /// Returns a script taken with `checkOut(_:source:bundleID:)` to the cache, as the most
+    /// recently used one. It is dropped when another run already checked in the same script.
+    func checkIn(_ script: NSAppleScript, source: String, bundleID: String?) {
+        queue.sync {
+            insert(script, for: Key(source: source, bundleID: bundleID))
+        }
+    }
+
+    /// Compiles `sources` in the background so their first run skips compiling.
+    func prewarm(_ sources: [String], bundleID: String?) {
+        queue.async { [self] in
+            for source in sources {
+                let key = Key(source: source, bundleID: bundleID)
+                guard !scripts.contains(where: { $0.key == key }),
+                      let script = try? compile(source, bundleID: bundleID)
+                else { continue }
+                insert(script, for: key)
+            }
+        }
+    }
+
+    /// Records how long running a cached script took.
+    func recordExecution(bundleID: String?, duration: TimeInterval) {
+        registry.observe(Self.executeDuration, labels: Self.labels(bundleID: bundleID), value: duration)
+    }
+
+    // MARK: Private
+
+    private struct Key: Hashable {
+        let source: String
+        let bundleID: String?
+    }
+
+    private let registry: MetricsRegistry
+
+    /// Serializes compiling and access to `scripts`, never running a script.
+    private let queue = DispatchQueue(label: "com.izual.Easydict.CompiledAppleScriptCache", qos: .userInitiated)
+
+    /// Least recently used first, excluding checked out scripts. Only accessed on `queue`.
+    private var scripts: [(key: Key, script: NSAppleScript)] = []
+
+    private static func labels(bundleID: String?) -> MetricsRegistry.Labels {
+        ["bundle_id": bundleID ?? "none"]
+    }
+
+    /// Compiles `source`. Must run on `queue`.
+    ///
+    /// - Throws: `QueryError` when compiling fails.
+    private func compile(_ source: String, bundleID: String?) throws -> NSAppleScript {
+        dispatchPrecondition(condition: .onQueue(queue))
+
+        let startTime = CFAbsoluteTimeGetCurrent()
+        guard let script = NSAppleScript(source: source) else {
+            throw QueryError(type: .appleScript, message: "Failed to create AppleScript instance", errorDataMessage: source)
+        }
+        var errorInfo: NSDictionary?
+        guard script.compileAndReturnError(&errorInfo) else {
+            let message = errorInfo?[NSAppleScript.errorMessage] as? String ?? "Compile AppleScript error"
+            throw QueryError(type: .appleScript, message: message, errorDataMessage: source)
+        }
+        registry.observe(
+            Self.compileDuration,
+            labels: Self.labels(bundleID: bundleID),
+            value: CFAbsoluteTimeGetCurrent() - startTime
+        )
+        return script
+    }
+
+    /// Adds `script` as the most recently used one, evicting the least recently used. Must run on `queue`.
+    private func insert(_ script: NSAppleScript, for key: Key) {
+        dispatchPrecondition(condition: .onQueue(queue))
+
+        guard !scripts.contains(where: { $0.key == key }) else { return }
+        scripts.append((key, script))
+        if scripts.count > capacity {
+            scripts.removeFirst()
+        }
+    }
+}
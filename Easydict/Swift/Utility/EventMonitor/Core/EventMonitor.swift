@@ -242,6 +242,8 @@ final class EventMonitor: NSObject {
         popButtonController.dismissHandler = { [weak self] in
             self?.dismissPopButton()
         }
+
+        AppleScriptTask.startPrewarmingBrowserScripts()
     }
 
     private func handleMonitorEvent(_ event: NSEvent) {
@@ -521,6 +523,7 @@ final class EventMonitor: NSObject {
             selectedText = trimmed
             cancelDismissPopButton()
             selectedTextBlock?(trimmed)
+            SelectionPrefetcher.shared.prefetch(trimmed)
         }
 
         if Thread.isMainThread {
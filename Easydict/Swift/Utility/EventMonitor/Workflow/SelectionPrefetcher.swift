@@ -0,0 +1,248 @@
+//
+//  SelectionPrefetcher.swift
+//  Easydict
+//
+//  Created by tisfeng on 2026/10/19.
+//  Copyright © 2026 izual. All rights reserved.
+//
+
+import Defaults
+import Foundation
+
+// MARK: - SelectionPrefetcher
+
+/// Speculatively detects and looks up auto-selected text before the pop button is clicked.
+///
+/// When enabled, a captured selection is language-detected and run through the cheap local
+/// services of the pop button's window (see `QueryService.supportsSpeculativePrefetch()`).
+/// A query for the same text and languages within `reuseWindow` adopts those results
+/// instead of detecting and looking up again; anything else is discarded.
+///
+/// Budget: selections are debounced, only the latest one is kept, long text is skipped and
+/// a token bucket caps how often detection (which may reach Google or Baidu) runs.
+@objc(EZSelectionPrefetcher)
+@objcMembers
+final class SelectionPrefetcher: NSObject, @unchecked Sendable {
+    // MARK: Lifecycle
+
+    /// - Parameters:
+    ///   - debounceDelay: Selections replaced within this delay never start any work.
+    ///   - isEnabled: Whether prefetching is turned on.
+    ///   - detect: Detects the language of a query model.
+    ///   - makeServices: Creates the enabled services of a window type, used as probes.
+    init(
+        debounceDelay: Duration = .milliseconds(250),
+        isEnabled: @escaping () -> Bool = { Defaults[.enableSpeculativePrefetch] },
+        detect: @escaping (QueryModel) async throws -> QueryModel = { queryModel in
+            try await DetectManager(model: queryModel).detectText(queryModel.queryText)
+        },
+        makeServices: @escaping (EZWindowType) -> [QueryService] = { windowType in
+            LocalStorage.shared().enabledServices(windowType)
+        }
+    ) {
+        self.debounceDelay = debounceDelay
+        self.isEnabled = isEnabled
+        self.detect = detect
+        self.makeServices = makeServices
+        super.init()
+    }
+
+    // MARK: Internal
+
+    static let shared = SelectionPrefetcher()
+
+    /// Starts prefetching `text`, replacing any earlier speculative work.
+    ///
+    /// Selecting the text that is already being prefetched, or whose results are still
+    /// reusable, keeps that work and its results instead of starting over.
+    func prefetch(
+        _ text: String,
+        windowType: EZWindowType = MyConfiguration.shared.mouseSelectTranslateWindowType
+    ) {
+        guard isEnabled() else { return }
+
+        let queryModel = QueryModel()
+        queryModel.inputText = text
+        let queryText = queryModel.queryText
+        guard !queryText.isEmpty, queryText.count <= Self.maxTextLength else { return }
+
+        let target = Target(queryText: queryText, windowType: windowType)
+        let debounceDelay = debounceDelay
+        let previousTask = lock.withLock { () -> Task<(), Never>? in
+            // The same selection again: keep the work in progress or its results.
+            if let entry, entry.target == target, !isExpired(entry) {
+                return nil
+            }
+
+            // The entry exists from now on, so a repeated selection during the debounce matches too.
+            entry = Entry(target: target, createdAt: Self.now())
+            let previousTask = task
+            task = Task { [weak self] in
+                try? await Task.sleep(for: debounceDelay)
+                guard let self, !Task.isCancelled else { return }
+                await run(queryModel, target: target)
+            }
+            return previousTask
+        }
+        previousTask?.cancel()
+    }
+
+    /// Language detected for `queryText` by a recent prefetch, or nil.
+    @objc(detectedLanguageForQueryText:)
+    func detectedLanguage(for queryText: String) -> Language? {
+        lock.withLock {
+            guard let entry, entry.target.queryText == queryText, !isExpired(entry) else { return nil }
+            return entry.detectedLanguage
+        }
+    }
+
+    /// Hands out the prefetched outcome of `service` for this query once; nil when there is none.
+    @nonobjc
+    func takeLookup(
+        for service: QueryService,
+        text: String,
+        from: Language,
+        to: Language
+    )
+        -> Lookup? {
+        lock.withLock {
+            guard let entry, !isExpired(entry),
+                  entry.target == Target(queryText: text, windowType: service.windowType),
+                  entry.from == from, entry.to == to
+            else { return nil }
+
+            let lookup = self.entry?.lookups.removeValue(forKey: service.serviceTypeWithUniqueIdentifier())
+            if service.supportsSpeculativePrefetch() {
+                QueryMetrics.recordCacheLookup("selection_prefetch", hit: lookup != nil)
+            }
+            if lookup != nil {
+                logInfo("reuse prefetched \(service.serviceTypeWithUniqueIdentifier()) result")
+            }
+            return lookup
+        }
+    }
+
+    /// Result of a speculative lookup, with the service instance that produced it.
+    struct Lookup {
+        let outcome: Result<QueryResult, Error>
+        let probe: QueryService
+    }
+
+    // MARK: Private
+
+    /// What a prefetch is for.
+    private struct Target: Equatable {
+        let queryText: String
+        let windowType: EZWindowType
+    }
+
+    private struct Entry {
+        let target: Target
+        let createdAt: TimeInterval
+        var detectedLanguage: Language?
+        var from: Language = .auto
+        var to: Language = .auto
+        var lookups: [String: Lookup] = [:]
+    }
+
+    /// Time a prefetched result stays usable.
+    private static let reuseWindow: TimeInterval = 15
+    /// Dictionary lookups only make sense for words and short phrases.
+    private static let maxTextLength = 100
+
+    private let debounceDelay: Duration
+    private let isEnabled: () -> Bool
+    private let detect: (QueryModel) async throws -> QueryModel
+    private let makeServices: (EZWindowType) -> [QueryService]
+
+    private let lock = NSLock()
+    private var entry: Entry?
+    private var task: Task<(), Never>?
+    /// At most 10 prefetches in a burst, refilling one every 6 seconds.
+    private var budget = TokenBucket(capacity: 10, refillInterval: 6)
+
+    private func run(_ queryModel: QueryModel, target: Target) async {
+        let queryText = target.queryText
+        let hasBudget = lock.withLock { budget.consume() }
+        guard hasBudget else {
+            logInfo("skip prefetch, budget exhausted")
+            lock.withLock {
+                if entry?.target == target {
+                    entry = nil
+                }
+            }
+            return
+        }
+
+        guard let detectedModel = try? await detect(queryModel),
+              !Task.isCancelled
+        else { return }
+
+        let from = Defaults[.queryFromLanguage] != .auto
+            ? Defaults[.queryFromLanguage]
+            : detectedModel.detectedLanguage
+        let to = Defaults[.queryToLanguage] != .auto
+            ? Defaults[.queryToLanguage]
+            : EZLanguageManager.shared().userTargetLanguage(withSourceLanguage: from)
+
+        guard update(queryText, { entry in
+            entry.detectedLanguage = detectedModel.detectedLanguage
+            entry.from = from
+            entry.to = to
+        }) else { return }
+
+        // Probes are separate instances, so the window's results are never touched.
+        var services: [QueryService] = []
+        for service in makeServices(target.windowType) where service.supportsSpeculativePrefetch() {
+            service.queryModel = detectedModel
+            guard service.enabledQuery, service.enabledAutoQuery, service.supportedQueryType() != [] else { continue }
+            service.resetServiceResult()
+            services.append(service)
+        }
+        logInfo("prefetch \(queryText.truncated()) (\(from) -> \(to)) with \(services.count) services")
+
+        await withTaskGroup(of: Void.self) { group in
+            for service in services {
+                group.addTask { [weak self] in
+                    let outcome: Result<QueryResult, Error>
+                    do {
+                        outcome = try .success(await service.translate(queryText, from: from, to: to))
+                    } catch {
+                        outcome = .failure(error)
+                    }
+                    guard !Task.isCancelled else { return }
+
+                    _ = self?.update(queryText) { entry in
+                        let id = service.serviceTypeWithUniqueIdentifier()
+                        entry.lookups[id] = Lookup(outcome: outcome, probe: service)
+                    }
+                }
+            }
+        }
+
+        // Drop unused results once they can no longer be reused.
+        try? await Task.sleep(for: .seconds(Self.reuseWindow))
+        lock.withLock {
+            if let entry, isExpired(entry) {
+                self.entry = nil
+            }
+        }
+    }
+
+    /// Mutates the entry if it still belongs to `queryText`.
+    private func update(_ queryText: String, _ body: (inout Entry) -> ()) -> Bool {
+        lock.withLock {
+            guard entry?.target.queryText == queryText else { return false }
+            body(&entry!)
+            return true
+        }
+    }
+
+    private func isExpired(_ entry: Entry) -> Bool {
+        Self.now() - entry.createdAt > Self.reuseWindow
+    }
+
+    private static func now() -> TimeInterval {
+        ProcessInfo.processInfo.systemUptime
+    }
+}
@@ -0,0 +1,222 @@
+//
+//  MetricsPanel.swift
+//  Easydict
+//
+//  Created by tisfeng on 2026/10/19.
+//  Copyright © 2026 izual. All rights reserved.
+//
+
+import AppKit
+import Combine
+import SwiftUI
+
+// MARK: - MetricsPanelController
+
+/// Manages the floating panel that shows live query metrics from `MetricsRegistry`.
+///
+/// Open via the "Query Metrics" button in the Advanced settings tab.
+final class MetricsPanelController: NSWindowController {
+    // MARK: Lifecycle
+
+    private init() {
+        let panel = NSPanel(
+            contentRect: NSRect(x: 0, y: 0, width: 760, height: 460),
+            styleMask: [.titled, .closable, .resizable, .utilityWindow],
+            backing: .buffered,
+            defer: false
+        )
+        panel.title = String(localized: "metrics_panel.title")
+        panel.level = .floating
+        panel.isReleasedWhenClosed = false
+        panel.center()
+        panel.contentView = NSHostingView(rootView: MetricsPanelView())
+        super.init(window: panel)
+    }
+
+    @available(*, unavailable)
+    required init?(coder: NSCoder) {
+        fatalError("init(coder:) has not been implemented")
+    }
+
+    // MARK: Internal
+
+    static let shared = MetricsPanelController()
+
+    func toggle() {
+        guard let window else { return }
+        if window.isVisible {
+            window.orderOut(nil)
+        } else {
+            window.makeKeyAndOrderFront(nil)
+        }
+    }
+}
+
+// MARK: - ServiceMetricsRow
+
+/// Aggregated metrics of one service, latencies in milliseconds.
+struct ServiceMetricsRow: Identifiable {
+    let service: String
+    let queryCount: Int
+    let errorCount: Int
+    let medianDuration: Double
+    let p90Duration: Double
+    let medianTimeToFirstByte: Double?
+    let medianTimeToFirstToken: Double?
+    let medianTokensPerSecond: Double?
+
+    var id: String { service }
+}
+
+// MARK: - CacheMetricsRow
+
+struct CacheMetricsRow: Identifiable {
+    let cache: String
+    let hitCount: Int
+    let missCount: Int
+
+    var id: String { cache }
+
+    var hitRate: Double {
+        let total = hitCount + missCount
+        return total == 0 ? 0 : Double(hitCount) / Double(total)
+    }
+}
+
+// MARK: - MetricsRegistry + Panel Rows
+
+extension MetricsRegistry {
+    /// Per-service rows for the metrics panel, sorted by service.
+    func serviceRows() -> [ServiceMetricsRow] {
+        let queries = counters(QueryMetrics.queries)
+        let durations = histograms(QueryMetrics.duration)
+        let firstBytes = histograms(QueryMetrics.timeToFirstByte)
+        let firstTokens = histograms(QueryMetrics.timeToFirstToken)
+        let tokenRates = histograms(QueryMetrics.tokensPerSecond)
+
+        let services = Set(queries.keys.compactMap { $0["service"] })
+        return services.sorted().map { service in
+            let labels = ["service": service]
+            let counts = queries.filter { $0.key["service"] == service }
+            let errorCount = counts.filter { $0.key["outcome"] == "error" }.values.reduce(0, +)
+            return ServiceMetricsRow(
+                service: service,
+                queryCount: Int(counts.values.reduce(0, +)),
+                errorCount: Int(errorCount),
+                medianDuration: (durations[labels]?.quantile(0.5) ?? 0) * 1000,
+                p90Duration: (durations[labels]?.quantile(0.9) ?? 0) * 1000,
+                medianTimeToFirstByte: firstBytes[labels].map { $0.quantile(0.5) * 1000 },
+                medianTimeToFirstToken: firstTokens[labels].map { $0.quantile(0.5) * 1000 },
+                medianTokensPerSecond: tokenRates[labels].map { $0.quantile(0.5) }
+            )
+        }
+    }
+
+    /// Per-cache hit and miss counts for the metrics panel, sorted by cache.
+    func cacheRows() -> [CacheMetricsRow] {
+        let lookups = counters(QueryMetrics.cacheLookups)
+        let caches = Set(lookups.keys.compactMap { $0["cache"] })
+        return caches.sorted().map { cache in
+            CacheMetricsRow(
+                cache: cache,
+                hitCount: Int(lookups[["cache": cache, "result": "hit"]] ?? 0),
+                missCount: Int(lookups[["cache": cache, "result": "miss"]] ?? 0)
+            )
+        }
+    }
+}
+
+// MARK: - MetricsPanelViewModel
+
+@MainActor
+private final class MetricsPanelViewModel: ObservableObject {
+    // MARK: Lifecycle
+
+    init() {
+        refresh()
+        Timer.publish(every: 1, on: .main, in: .common)
+            .autoconnect()
+            .sink { [weak self] _ in
+                self?.refresh()
+            }
+            .store(in: &cancellables)
+    }
+
+    // MARK: Internal
+
+    @Published var serviceRows: [ServiceMetricsRow] = []
+    @Published var cacheRows: [CacheMetricsRow] = []
+
+    func refresh() {
+        serviceRows = MetricsRegistry.shared.serviceRows()
+        cacheRows = MetricsRegistry.shared.cacheRows()
+    }
+
+    func copyPrometheusText() {
+        NSPasteboard.general.clearContents()
+        NSPasteboard.general.setString(MetricsRegistry.shared.prometheusText(), forType: .string)
+    }
+
+    func reset() {
+        MetricsRegistry.shared.reset()
+        refresh()
+    }
+
+    // MARK: Private
+
+    private var cancellables = Set<AnyCancellable>()
+}
+
+// MARK: - MetricsPanelView
+
+private struct MetricsPanelView: View {
+    // MARK: Internal
+
+    var body: some View {
+        VStack(spacing: 0) {
+            HStack {
+                Button("metrics_panel.copy_prometheus_text") { viewModel.copyPrometheusText() }
+                Button("metrics_panel.reset") { viewModel.reset() }
+                Spacer()
+            }
+            .padding(8)
+
+            Divider()
+
+            Table(viewModel.serviceRows) {
+                TableColumn("metrics_panel.column.service", value: \.service)
+                TableColumn("metrics_panel.column.queries") { Text(verbatim: "\($0.queryCount)") }
+                TableColumn("metrics_panel.column.errors") { Text(verbatim: "\($0.errorCount)") }
+                TableColumn("metrics_panel.column.p50") { Text(verbatim: milliseconds($0.medianDuration)) }
+                TableColumn("metrics_panel.column.p90") { Text(verbatim: milliseconds($0.p90Duration)) }
+                TableColumn("metrics_panel.column.ttfb") { Text(verbatim: milliseconds($0.medianTimeToFirstByte)) }
+                TableColumn("metrics_panel.column.ttft") { Text(verbatim: milliseconds($0.medianTimeToFirstToken)) }
+                TableColumn("metrics_panel.column.tokens_per_second") { Text(verbatim: decimal($0.medianTokensPerSecond)) }
+            }
+
+            Table(viewModel.cacheRows) {
+                TableColumn("metrics_panel.column.cache", value: \.cache)
+                TableColumn("metrics_panel.column.lookups") { Text(verbatim: "\($0.hitCount + $0.missCount)") }
+                TableColumn("metrics_panel.column.hit_rate") {
+                    Text(verbatim: String(format: "%.0f%%", $0.hitRate * 100))
+                }
+            }
+            .frame(height: 150)
+        }
+        .monospacedDigit()
+    }
+
+    // MARK: Private
+
+    @StateObject private var viewModel = MetricsPanelViewModel()
+
+    private func milliseconds(_ value: Double?) -> String {
+        guard let value else { return "-" }
+        return String(format: "%.0f ms", value)
+    }
+
+    private func decimal(_ value: Double?) -> String {
+        guard let value else { return "-" }
+        return String(format: "%.1f", value)
+    }
+}
@@ -0,0 +1,234 @@
+//
+//  MetricsRegistry.swift
+//  Easydict
+//
+//  Created by tisfeng on 2026/10/19.
+//  Copyright © 2026 izual. All rights reserved.
+//
+
+import Foundation
+
+// MARK: - MetricDescriptor
+
+/// Name, help text and kind of a metric family, rendered as Prometheus `# HELP` / `# TYPE`.
+struct MetricDescriptor: Hashable, Sendable {
+    enum Kind: String, Sendable {
+        case counter
+        /// A value that goes up and down, like a queue depth.
+        case gauge
+        /// Rendered as a Prometheus summary with quantiles computed from a `Histogram`.
+        case summary
+    }
+
+    let name: String
+    let help: String
+    let kind: Kind
+}
+
+// MARK: - Histogram
+
+/// A compact HDR-style histogram for non-negative values.
+///
+/// Values are grouped into power-of-two ranges, each split into `subBucketCount` linear
+/// buckets, so quantiles keep a relative error below `1 / subBucketCount` whatever the
+/// magnitude, in memory proportional to the number of distinct buckets seen.
+struct Histogram: Sendable {
+    // MARK: Lifecycle
+
+    init(subBucketCount: Int = 64) {
+        self.subBucketCount = subBucketCount
+    }
+
+    // MARK: Internal
+
+    let subBucketCount: Int
+
+    private(set) var count = 0
+    private(set) var sum = 0.0
+    private(set) var min = Double.infinity
+    private(set) var max = 0.0
+
+    mutating func record(_ value: Double) {
+        guard value.isFinite else { return }
+
+        let value = Swift.max(value, 0)
+        count += 1
+        sum += value
+        min = Swift.min(min, value)
+        max = Swift.max(max, value)
+
+        if value == 0 {
+            zeroCount += 1
+        } else {
+            buckets[bucketIndex(of: value), default: 0] += 1
+        }
+    }
+
+    /// Value at quantile `q` (0...1), or 0 when empty.
+    func quantile(_ q: Double) -> Double {
+        guard count > 0 else { return 0 }
+
+        let rank = Swift.max(1, Int((q * Double(count)).rounded(.up)))
+        var seen = zeroCount
+        if seen >= rank {
+            return 0
+        }
+        for index in buckets.keys.sorted() {
+            seen += buckets[index] ?? 0
+            if seen >= rank {
+                return Swift.min(Swift.max(midpoint(of: index), min), max)
+            }
+        }
+        return max
+    }
+
+    // MARK: Private
+
+    private var zeroCount = 0
+    private var buckets: [Int: Int] = [:]
+
+    private func bucketIndex(of value: Double) -> Int {
+        // `significand` is in 1..<2 for normal values, subnormals share the first bucket.
+        let scaled = Int((value.significand - 1) * Double(subBucketCount))
+        let subBucket = Swift.min(Swift.max(scaled, 0), subBucketCount - 1)
+        return Int(value.exponent) * subBucketCount + subBucket
+    }
+
+    private func midpoint(of index: Int) -> Double {
+        let exponent = index >= 0 ? index / subBucketCount : (index - subBucketCount + 1) / subBucketCount
+        let subBucket = index - exponent * subBucketCount
+        let significand = 1 + (Double(subBucket) + 0.5) / Double(subBucketCount)
+        return Double(sign: .plus, exponent: exponent, significand: significand)
+    }
+}
+
+// MARK: - MetricsRegistry
+
+/// In-process registry of counters and histograms, keyed by descriptor and labels.
+///
+/// Recording only takes a lock and updates a dictionary entry, so it is cheap enough for
+/// every query. `prometheusText()` renders the Prometheus text exposition format served
+/// at `/metrics`; the metrics panel reads the same data.
+final class MetricsRegistry: @unchecked Sendable {
+    // MARK: Internal
+
+    typealias Labels = [String: String]
+
+    static let shared = MetricsRegistry()
+
+    /// Quantiles rendered for every summary.
+    static let quantiles = [0.5, 0.9, 0.99]
+
+    func increment(_ descriptor: MetricDescriptor, labels: Labels = [:], by amount: Double = 1) {
+        lock.withLock {
+            families[descriptor.name, default: Family(descriptor: descriptor)].counters[labels, default: 0] += amount
+        }
+    }
+
+    /// Sets a gauge to `value`.
+    func set(_ descriptor: MetricDescriptor, labels: Labels = [:], value: Double) {
+        lock.withLock {
+            families[descriptor.name, default: Family(descriptor: descriptor)].counters[labels] = value
+        }
+    }
+
+    func observe(_ descriptor: MetricDescriptor, labels: Labels = [:], value: Double) {
+        lock.withLock {
+            families[descriptor.name, default: Family(descriptor: descriptor)]
+                .histograms[labels, default: Histogram()].record(value)
+        }
+    }
+
+    func counter(_ descriptor: MetricDescriptor, labels: Labels = [:]) -> Double {
+        lock.withLock { families[descriptor.name]?.counters[labels] ?? 0 }
+    }
+
+    func histogram(_ descriptor: MetricDescriptor, labels: Labels = [:]) -> Histogram? {
+        lock.withLock { families[descriptor.name]?.histograms[labels] }
+    }
+
+    /// All label sets recorded for `descriptor`, with their counter values.
+    func counters(_ descriptor: MetricDescriptor) -> [Labels: Double] {
+        lock.withLock { families[descriptor.name]?.counters ?? [:] }
+    }
+
+    /// All label sets recorded for `descriptor`, with their histograms.
+    func histograms(_ descriptor: MetricDescriptor) -> [Labels: Histogram] {
+        lock.withLock { families[descriptor.name]?.histograms ?? [:] }
+    }
+
+    func reset() {
+        lock.withLock {
+            families.removeAll()
+        }
+    }
+
+    /// Renders every metric in the Prometheus text exposition format, version 0.0.4.
+    func prometheusText() -> String {
+        let families = lock.withLock { self.families }
+
+        var lines: [String] = []
+        for family in families.values.sorted(by: { $0.descriptor.name < $1.descriptor.name }) {
+            let descriptor = family.descriptor
+            lines.append("# HELP \(descriptor.name) \(Self.escapeHelp(descriptor.help))")
+            lines.append("# TYPE \(descriptor.name) \(descriptor.kind.rawValue)")
+
+            switch descriptor.kind {
+            case .counter, .gauge:
+                for (labels, value) in family.counters.sorted(by: { Self.labelText($0.key) < Self.labelText($1.key) }) {
+                    lines.append("\(descriptor.name)\(Self.labelText(labels)) \(Self.format(value))")
+                }
+            case .summary:
+                for (labels, histogram) in family.histograms.sorted(by: { Self.labelText($0.key) < Self.labelText($1.key) }) {
+                    for quantile in Self.quantiles {
+                        var quantileLabels = labels
+                        quantileLabels["quantile"] = Self.format(quantile)
+                        let value = histogram.quantile(quantile)
+                        lines.append("\(descriptor.name)\(Self.labelText(quantileLabels)) \(Self.format(value))")
+                    }
+                    lines.append("\(descriptor.name)_sum\(Self.labelText(labels)) \(Self.format(histogram.sum))")
+                    lines.append("\(descriptor.name)_count\(Self.labelText(labels)) \(histogram.count)")
+                }
+            }
+        }
+        return lines.isEmpty ? "" : lines.joined(separator: "\n") + "\n"
+    }
+
+    // MARK: Private
+
+    private struct Family {
+        let descriptor: MetricDescriptor
+        /// Values of counters and gauges.
+        var counters: [Labels: Double] = [:]
+        var histograms: [Labels: Histogram] = [:]
+    }
+
+    private let lock = NSLock()
+    private var families: [String: Family] = [:]
+
+    private static func labelText(_ labels: Labels) -> String {
+        guard !labels.isEmpty else { return "" }
+        let pairs = labels.sorted { $0.key < $1.key }.map { "\($0.key)=\"\(escapeLabelValue($0.value))\"" }
+        return "{\(pairs.joined(separator: ","))}"
+    }
+
+    private static func escapeLabelValue(_ value: String) -> String {
+        value
+            .replacingOccurrences(of: "\\", with: "\\\\")
+            .replacingOccurrences(of: "\"", with: "\\\"")
+            .replacingOccurrences(of: "\n", with: "\\n")
+    }
+
+    private static func escapeHelp(_ help: String) -> String {
+        help
+            .replacingOccurrences(of: "\\", with: "\\\\")
+            .replacingOccurrences(of: "\n", with: "\\n")
+    }
+
+    private static func format(_ value: Double) -> String {
+        if value == value.rounded(), abs(value) < 1e15 {
+            return String(Int64(value))
+        }
+        return String(value)
+    }
+}
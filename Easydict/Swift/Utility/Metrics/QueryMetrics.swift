@@ -0,0 +1,232 @@
+//
+//  QueryMetrics.swift
+//  Easydict
+//
+//  Created by tisfeng on 2026/10/19.
+//  Copyright © 2026 izual. All rights reserved.
+//
+
+import Foundation
+
+// MARK: - QueryMetrics
+
+/// Query performance metrics recorded into `MetricsRegistry.shared`.
+///
+/// A `QueryMetricsSpan` follows one service query and is bound to `QueryMetrics.current`
+/// while the query runs, so transports and stream consumers deep in the call stack can
+/// mark the first byte and each token without any parameter threading.
+enum QueryMetrics {
+    // MARK: Internal
+
+    /// Span of the query the current task works for, if any.
+    @TaskLocal static var current: QueryMetricsSpan?
+
+    static let queries = MetricDescriptor(
+        name: "easydict_query_total",
+        help: "Finished queries by service and outcome (success, error, cancelled).",
+        kind: .counter
+    )
+    static let errors = MetricDescriptor(
+        name: "easydict_query_errors_total",
+        help: "Failed queries by service and QueryError type.",
+        kind: .counter
+    )
+    static let duration = MetricDescriptor(
+        name: "easydict_query_duration_seconds",
+        help: "Total query latency, from start until the final result.",
+        kind: .summary
+    )
+    static let timeToFirstByte = MetricDescriptor(
+        name: "easydict_query_time_to_first_byte_seconds",
+        help: "Time until the provider's response headers arrived, for requests on the shared LLM transport.",
+        kind: .summary
+    )
+    static let timeToFirstToken = MetricDescriptor(
+        name: "easydict_query_time_to_first_token_seconds",
+        help: "Time until the first streamed token, or the first result of non-stream services.",
+        kind: .summary
+    )
+    static let tokensPerSecond = MetricDescriptor(
+        name: "easydict_query_tokens_per_second",
+        help: "Streamed content deltas per second after the first token.",
+        kind: .summary
+    )
+    static let cacheLookups = MetricDescriptor(
+        name: "easydict_cache_lookups_total",
+        help: "Cache lookups by cache and result (hit, miss).",
+        kind: .counter
+    )
+
+    /// Runs `operation` with a span for `service` bound to `current`, and records it.
+    static func measure<T>(
+        service: String,
+        operation: () async throws -> T
+    ) async throws
+        -> T {
+        let span = QueryMetricsSpan(service: service)
+        do {
+            let value = try await $current.withValue(span) {
+                try await operation()
+            }
+            span.markFirstToken()
+            span.finish(error: nil)
+            return value
+        } catch {
+            span.finish(error: error)
+            throw error
+        }
+    }
+
+    static func recordCacheLookup(_ cache: String, hit: Bool) {
+        MetricsRegistry.shared.increment(cacheLookups, labels: ["cache": cache, "result": hit ? "hit" : "miss"])
+    }
+
+    /// Label for an error: `cancelled`, `network` for transport failures, or the `QueryError` type.
+    static func errorClass(of error: Error) -> String {
+        if error is CancellationError {
+            return "cancelled"
+        }
+        if let urlError = error as? URLError {
+            switch urlError.code {
+            case .cancelled: return "cancelled"
+            case .timedOut: return QueryError.ErrorType.timeout.metricsLabel
+            default: return "network"
+            }
+        }
+        return (QueryError.queryError(from: error)?.type ?? .unknown).metricsLabel
+    }
+}
+
+// MARK: - QueryMetricsSpan
+
+/// Timing of one service query. Every mark is recorded once; later calls are ignored.
+final class QueryMetricsSpan: @unchecked Sendable {
+    // MARK: Lifecycle
+
+    init(
+        service: String,
+        registry: MetricsRegistry = .shared,
+        now: @escaping () -> TimeInterval = { ProcessInfo.processInfo.systemUptime }
+    ) {
+        self.service = service
+        self.registry = registry
+        self.now = now
+        self.startTime = now()
+    }
+
+    // MARK: Internal
+
+    let service: String
+
+    /// Marks the arrival of the provider's response headers.
+    func markFirstByte() {
+        let elapsed = now() - startTime
+        let isFirst = lock.withLock { () -> Bool in
+            guard !didMarkFirstByte, !isFinished else { return false }
+            didMarkFirstByte = true
+            return true
+        }
+        if isFirst {
+            registry.observe(QueryMetrics.timeToFirstByte, labels: labels, value: elapsed)
+        }
+    }
+
+    /// Marks one streamed content delta.
+    func markToken() {
+        let time = now()
+        lock.withLock {
+            guard !isFinished else { return }
+            tokenCount += 1
+            if firstTokenTime == nil {
+                firstTokenTime = time
+            }
+        }
+        markFirstToken(at: time)
+    }
+
+    /// Marks the first visible result, which is the first token of non-stream services.
+    func markFirstToken() {
+        markFirstToken(at: now())
+    }
+
+    /// Records the total latency and outcome. A `CancellationError` counts as cancelled.
+    func finish(error: Error?) {
+        let endTime = now()
+        let tokens = lock.withLock { () -> (count: Int, firstTime: TimeInterval?)? in
+            guard !isFinished else { return nil }
+            isFinished = true
+            return (tokenCount, firstTokenTime)
+        }
+        guard let tokens else { return }
+
+        let outcome: String
+        if let error {
+            let errorClass = QueryMetrics.errorClass(of: error)
+            outcome = errorClass == "cancelled" ? "cancelled" : "error"
+            if outcome == "error" {
+                registry.increment(QueryMetrics.errors, labels: ["service": service, "type": errorClass])
+            }
+        } else {
+            outcome = "success"
+        }
+        registry.increment(QueryMetrics.queries, labels: ["service": service, "outcome": outcome])
+
+        // Cancelled queries say nothing about the provider's latency.
+        guard outcome != "cancelled" else { return }
+        registry.observe(QueryMetrics.duration, labels: labels, value: endTime - startTime)
+
+        if let firstTokenTime = tokens.firstTime, tokens.count > 1, endTime > firstTokenTime {
+            let rate = Double(tokens.count - 1) / (endTime - firstTokenTime)
+            registry.observe(QueryMetrics.tokensPerSecond, labels: labels, value: rate)
+        }
+    }
+
+    // MARK: Private
+
+    private let now: () -> TimeInterval
+    private let startTime: TimeInterval
+    private let registry: MetricsRegistry
+    private let lock = NSLock()
+
+    private var didMarkFirstByte = false
+    private var didMarkFirstToken = false
+    private var isFinished = false
+    private var tokenCount = 0
+    private var firstTokenTime: TimeInterval?
+
+    private var labels: MetricsRegistry.Labels {
+        ["service": service]
+    }
+
+    private func markFirstToken(at time: TimeInterval) {
+        let isFirst = lock.withLock { () -> Bool in
+            guard !didMarkFirstToken, !isFinished else { return false }
+            didMarkFirstToken = true
+            return true
+        }
+        if isFirst {
+            registry.observe(QueryMetrics.timeToFirstToken, labels: labels, value: time - startTime)
+        }
+    }
+}
+
+// MARK: - QueryError.ErrorType + metricsLabel
+
+extension QueryError.ErrorType {
+    /// Stable, non-localized name used as a metrics label.
+    var metricsLabel: String {
+        switch self {
+        case .unknown: "unknown"
+        case .api: "api"
+        case .parameter: "parameter"
+        case .appleScript: "apple_script"
+        case .unsupportedLanguage: "unsupported_language"
+        case .missingSecretKey: "missing_secret_key"
+        case .noResult: "no_result"
+        case .timeout: "timeout"
+        case .unsupportedQueryType: "unsupported_query_type"
+        case .unsupportedServiceType: "unsupported_service_type"
+        case .contentTypeMismatch: "content_type_mismatch"
+        }
+    }
+}
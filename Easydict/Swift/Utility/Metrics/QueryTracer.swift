@@ -0,0 +1,303 @@
+//
+//  QueryTracer.swift
+//  Easydict
+//
+//  Created by tisfeng on 2026/10/19.
+//  Copyright © 2026 izual. All rights reserved.
+//
+
+import Combine
+import Defaults
+import Foundation
+
+// MARK: - QueryTracer
+
+/// Records spans of the detect → query → render pipeline and keeps the most recent traces.
+///
+/// A query window starts a trace with `beginTrace(_:)` and stores the root span ID in
+/// `QueryModel.traceSpanID`. Every later stage opens a child span of it, and Swift code
+/// running inside a service query finds its parent in the task-local `currentSpanID`.
+/// Span IDs are plain integers, so they cross into Objective-C; `0` means "not traced".
+///
+/// When tracing is disabled every call returns after reading one Bool under the lock, and
+/// `chromeTraceJSON()` exports the kept traces in the Chrome trace-event format, which
+/// chrome://tracing and Perfetto open.
+@objc(EZQueryTracer)
+@objcMembers
+final class QueryTracer: NSObject, @unchecked Sendable {
+    // MARK: Lifecycle
+
+    init(capacity: Int = 32, now: @escaping () -> TimeInterval = { ProcessInfo.processInfo.systemUptime }) {
+        self.capacity = capacity
+        self.now = now
+        super.init()
+    }
+
+    // MARK: Internal
+
+    static let shared: QueryTracer = {
+        let tracer = QueryTracer()
+        tracer.observeDefaults()
+        return tracer
+    }()
+
+    /// Span the current task works for, `0` when none.
+    @nonobjc @TaskLocal static var currentSpanID: UInt64 = 0
+
+    /// Whether spans are recorded, cached from `Defaults[.enableQueryTracing]`.
+    var isEnabled: Bool {
+        lock.withLock { storedIsEnabled }
+    }
+
+    /// Number of traces kept, older traces are dropped first.
+    let capacity: Int
+
+    func setEnabled(_ enabled: Bool) {
+        lock.withLock {
+            storedIsEnabled = enabled
+            if !enabled {
+                openSpans.removeAll()
+            }
+        }
+    }
+
+    /// Starts a new trace and returns its root span, which ends with its last child.
+    @objc(beginTrace:)
+    func beginTrace(_ name: String) -> UInt64 {
+        guard isEnabled else { return 0 }
+
+        let startTime = now()
+        return lock.withLock {
+            let spanID = makeSpanID()
+            let trace = Trace(id: spanID, name: name, startTime: startTime)
+            traces.append(trace)
+            if traces.count > capacity {
+                let evicted = traces.removeFirst()
+                openSpans = openSpans.filter { $0.value.trace !== evicted }
+            }
+            openSpans[spanID] = OpenSpan(trace: trace, name: name, lane: trace.lane(named: "query"), startTime: startTime)
+            return spanID
+        }
+    }
+
+    /// Opens a child span of `parent`. Spans without a `lane` share their parent's lane.
+    @objc(beginSpan:parent:lane:)
+    func beginSpan(_ name: String, parent: UInt64, lane: String?) -> UInt64 {
+        guard isEnabled, parent != 0 else { return 0 }
+
+        let startTime = now()
+        return lock.withLock {
+            guard let parentSpan = openSpans[parent] else { return 0 }
+            let trace = parentSpan.trace
+            let spanID = makeSpanID()
+            openSpans[spanID] = OpenSpan(
+                trace: trace,
+                name: name,
+                lane: lane.map { trace.lane(named: $0) } ?? parentSpan.lane,
+                startTime: startTime
+            )
+            return spanID
+        }
+    }
+
+    /// Closes a span and records it in its trace.
+    @objc(endSpan:)
+    func endSpan(_ spanID: UInt64) {
+        guard isEnabled, spanID != 0 else { return }
+
+        let endTime = now()
+        lock.withLock {
+            guard let span = openSpans[spanID] else { return }
+            // Root spans stay open, so later stages of the query can still attach to them.
+            guard span.trace.id != spanID else { return }
+            openSpans[spanID] = nil
+            span.trace.events.append(
+                Event(name: span.name, lane: span.lane, startTime: span.startTime, duration: endTime - span.startTime)
+            )
+            span.trace.endTime = max(span.trace.endTime, endTime)
+        }
+    }
+
+    /// Records a point in time, such as the arrival of response headers, under `parent`.
+    @objc(markEvent:parent:)
+    func mark(_ name: String, parent: UInt64) {
+        guard isEnabled, parent != 0 else { return }
+
+        let time = now()
+        lock.withLock {
+            guard let parentSpan = openSpans[parent] else { return }
+            parentSpan.trace.events.append(Event(name: name, lane: parentSpan.lane, startTime: time, duration: nil))
+            parentSpan.trace.endTime = max(parentSpan.trace.endTime, time)
+        }
+    }
+
+    /// Opens a child span of `currentSpanID`; the task-local is not read while disabled.
+    @nonobjc
+    func beginSpan(_ name: String) -> UInt64 {
+        guard isEnabled else { return 0 }
+        return beginSpan(name, parent: Self.currentSpanID, lane: nil)
+    }
+
+    /// Records a point in time under `currentSpanID`.
+    @nonobjc
+    func mark(_ name: String) {
+        guard isEnabled else { return }
+        mark(name, parent: Self.currentSpanID)
+    }
+
+    /// Runs `operation` inside a child span of `parent`, bound to `currentSpanID`.
+    func withSpan<T>(
+        _ name: String,
+        parent: UInt64 = QueryTracer.currentSpanID,
+        lane: String? = nil,
+        operation: () async throws -> T
+    ) async rethrows
+        -> T {
+        let spanID = beginSpan(name, parent: parent, lane: lane)
+        defer { endSpan(spanID) }
+        return try await Self.$currentSpanID.withValue(spanID, operation: operation)
+    }
+
+    func removeAllTraces() {
+        lock.withLock {
+            traces.removeAll()
+            openSpans.removeAll()
+        }
+    }
+
+    /// Kept traces in the Chrome trace-event JSON format.
+    ///
+    /// Each trace becomes a process and each lane a thread. Spans are complete (`X`) events
+    /// and marks are instant (`i`) events, with timestamps in microseconds.
+    func chromeTraceJSON() -> Data {
+        let traces = lock.withLock { self.traces.map { $0.snapshot() } }
+
+        var events: [[String: Any]] = []
+        for (index, trace) in traces.enumerated() {
+            let pid = index + 1
+            events.append(["name": "process_name", "ph": "M", "pid": pid, "args": ["name": trace.name]])
+            for (lane, tid) in trace.lanes {
+                events.append(["name": "thread_name", "ph": "M", "pid": pid, "tid": tid, "args": ["name": lane]])
+            }
+
+            let rootEnd = max(trace.endTime, trace.startTime)
+            events.append(chromeEvent(name: trace.name, pid: pid, tid: 0, start: trace.startTime, duration: rootEnd - trace.startTime))
+            for event in trace.events {
+                events.append(chromeEvent(name: event.name, pid: pid, tid: event.lane, start: event.startTime, duration: event.duration))
+            }
+        }
+
+        let json: [String: Any] = ["traceEvents": events, "displayTimeUnit": "ms"]
+        return (try? JSONSerialization.data(withJSONObject: json, options: [.sortedKeys])) ?? Data()
+    }
+
+    /// Writes `chromeTraceJSON()` to `url`.
+    @objc(exportChromeTraceToURL:error:)
+    func exportChromeTrace(to url: URL) throws {
+        try chromeTraceJSON().write(to: url, options: .atomic)
+    }
+
+    // MARK: Private
+
+    private struct Event {
+        let name: String
+        let lane: Int
+        let startTime: TimeInterval
+        /// nil for instant events.
+        let duration: TimeInterval?
+    }
+
+    private struct OpenSpan {
+        let trace: Trace
+        let name: String
+        let lane: Int
+        let startTime: TimeInterval
+    }
+
+    private struct TraceSnapshot {
+        let name: String
+        let startTime: TimeInterval
+        let endTime: TimeInterval
+        let lanes: [String: Int]
+        let events: [Event]
+    }
+
+    /// Mutated only under the tracer's lock.
+    private final class Trace {
+        // MARK: Lifecycle
+
+        init(id: UInt64, name: String, startTime: TimeInterval) {
+            self.id = id
+            self.name = name
+            self.startTime = startTime
+            self.endTime = startTime
+        }
+
+        // MARK: Internal
+
+        let id: UInt64
+        let name: String
+        let startTime: TimeInterval
+        var endTime: TimeInterval
+        var lanes: [String: Int] = [:]
+        var events: [Event] = []
+
+        func lane(named name: String) -> Int {
+            if let lane = lanes[name] {
+                return lane
+            }
+            let lane = lanes.count
+            lanes[name] = lane
+            return lane
+        }
+
+        func snapshot() -> TraceSnapshot {
+            TraceSnapshot(name: name, startTime: startTime, endTime: endTime, lanes: lanes, events: events)
+        }
+    }
+
+    private let now: () -> TimeInterval
+    private let lock = NSLock()
+    private var traces: [Trace] = []
+    private var openSpans: [UInt64: OpenSpan] = [:]
+    private var nextSpanID: UInt64 = 1
+    private var storedIsEnabled = false
+    private var enabledCancellable: AnyCancellable?
+
+    private func makeSpanID() -> UInt64 {
+        defer { nextSpanID += 1 }
+        return nextSpanID
+    }
+
+    private func observeDefaults() {
+        enabledCancellable = Defaults.publisher(.enableQueryTracing)
+            .sink { [weak self] change in
+                self?.setEnabled(change.newValue)
+            }
+    }
+
+    private func chromeEvent(
+        name: String,
+        pid: Int,
+        tid: Int,
+        start: TimeInterval,
+        duration: TimeInterval?
+    )
+        -> [String: Any] {
+        var event: [String: Any] = [
+            "name": name,
+            "cat": "query",
+            "pid": pid,
+            "tid": tid,
+            "ts": Int64((start * 1_000_000).rounded()),
+        ]
+        if let duration {
+            event["ph"] = "X"
+            event["dur"] = Int64((max(duration, 0) * 1_000_000).rounded())
+        } else {
+            event["ph"] = "i"
+            event["s"] = "t"
+        }
+        return event
+    }
+}
@@ -0,0 +1,57 @@
+//
+//  TokenBucket.swift
+//  Easydict
+//
+//  Created by tisfeng on 2026/10/19.
+//  Copyright © 2026 izual. All rights reserved.
+//
+
+import Foundation
+
+// MARK: - TokenBucket
+
+/// A synchronous token bucket that allows short bursts while bounding the average rate.
+/// Use `ThrottleGate` when only a minimum interval between calls is needed.
+struct TokenBucket {
+    // MARK: Lifecycle
+
+    init(
+        capacity: Int,
+        refillInterval: TimeInterval,
+        now: @escaping () -> TimeInterval = { ProcessInfo.processInfo.systemUptime }
+    ) {
+        self.capacity = capacity
+        self.refillInterval = refillInterval
+        self.now = now
+        self.tokens = Double(capacity)
+        self.lastRefillTime = now()
+    }
+
+    // MARK: Internal
+
+    /// Maximum number of tokens, i.e. the largest burst.
+    let capacity: Int
+    /// Time needed to regain one token.
+    let refillInterval: TimeInterval
+
+    /// Takes one token, returning `false` when the bucket is empty.
+    mutating func consume() -> Bool {
+        refill()
+        guard tokens >= 1 else { return false }
+        tokens -= 1
+        return true
+    }
+
+    // MARK: Private
+
+    private let now: () -> TimeInterval
+    private var tokens: Double
+    private var lastRefillTime: TimeInterval
+
+    private mutating func refill() {
+        let currentTime = now()
+        let elapsed = max(currentTime - lastRefillTime, 0)
+        tokens = min(Double(capacity), tokens + elapsed / refillInterval)
+        lastRefillTime = currentTime
+    }
+}
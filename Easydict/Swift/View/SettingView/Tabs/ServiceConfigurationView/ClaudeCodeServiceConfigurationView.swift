@@ -31,6 +31,13 @@ struct ClaudeCodeServiceConfigurationView: View {
         Section {
             CLIStatusRow()
         }
+        Section {
+            ToggleCell(
+                titleKey: "service.configuration.agent_cli.worker_pool.title",
+                key: .enableClaudeCodeWorkerPool,
+                footnote: "service.configuration.agent_cli.worker_pool.footnote"
+            )
+        }
         #if AGENT_CLI_DEBUG
         Section {
             Button("service.claude_code.debug_log.show_window") {
@@ -44,6 +44,13 @@ struct CodexCLIServiceConfigurationView: View {
                 values: CodexReasoningEffort.allCases
             )
         }
+        Section {
+            ToggleCell(
+                titleKey: "service.configuration.agent_cli.worker_pool.title",
+                key: .enableCodexCLIWorkerPool,
+                footnote: "service.configuration.agent_cli.worker_pool.footnote"
+            )
+        }
         #if AGENT_CLI_DEBUG
         Section {
             Button("service.codex_cli.debug_log.show_window") {
@@ -9,6 +9,7 @@
 import Defaults
 import SFSafeSymbols
 import SwiftUI
+import UniformTypeIdentifiers
 
 struct AdvancedTab: View {
     // MARK: Internal
@@ -17,6 +18,7 @@ struct AdvancedTab: View {
     @Default(.replaceNewlineWithSpace) var replaceNewlineWithSpace: Bool
     @Default(.automaticallyRemoveCodeCommentSymbols) var automaticallyRemoveCodeCommentSymbols: Bool
     @Default(.automaticWordSegmentation) var automaticWordSegmentation: Bool
+    @Default(.enableLongTextChunkedTranslation) var enableLongTextChunkedTranslation: Bool
 
     var body: some View {
         Form {
@@ -62,6 +64,22 @@ struct AdvancedTab: View {
                         labelText: "setting.advance.disable_tips_view"
                     )
                 }
+                Toggle(isOn: $enableHedgedRequests) {
+                    AdvancedTabItemView(
+                        color: .cyan,
+                        icon: .bolt,
+                        labelText: "setting.advance.enable_hedged_requests",
+                        subtitleText: "setting.advance.enable_hedged_requests_desc"
+                    )
+                }
+                Toggle(isOn: $enableSpeculativePrefetch) {
+                    AdvancedTabItemView(
+                        color: .mint,
+                        icon: .sparkles,
+                        labelText: "setting.advance.enable_speculative_prefetch",
+                        subtitleText: "setting.advance.enable_speculative_prefetch_desc"
+                    )
+                }
 
                 // Require macOS 15+
                 if #available(macOS 15.0, *) {
@@ -245,6 +263,14 @@ struct AdvancedTab: View {
                         labelText: "setting.advance.automatically_split_words"
                     )
                 }
+                Toggle(isOn: $enableLongTextChunkedTranslation) {
+                    AdvancedTabItemView(
+                        color: .indigo,
+                        icon: .docPlaintext,
+                        labelText: "setting.advance.enable_long_text_chunked_translation",
+                        subtitleText: "setting.advance.enable_long_text_chunked_translation_desc"
+                    )
+                }
             } header: {
                 Text("setting.advance.header.query_text_processing")
             } footer: {
@@ -276,6 +302,14 @@ struct AdvancedTab: View {
                         subtitleText: "setting.advance.enable_ocr_text_normalization_desc"
                     )
                 }
+                Toggle(isOn: $enableTiledOCR) {
+                    AdvancedTabItemView(
+                        color: .teal,
+                        icon: .squareSplit1x2,
+                        labelText: "setting.advance.enable_tiled_ocr",
+                        subtitleText: "setting.advance.enable_tiled_ocr_desc"
+                    )
+                }
 
                 Toggle(isOn: $showOCRMenuItems) {
                     AdvancedTabItemView(
@@ -422,9 +456,109 @@ struct AdvancedTab: View {
                         subtitleText: "setting.advance.http_port_desc"
                     )
                 }
+
+                Picker(
+                    selection: $httpStreamFlushPolicy,
+                    label: AdvancedTabItemView(
+                        color: getHttpIconColor(),
+                        icon: .waveformPath,
+                        labelText: "setting.advance.http_stream_flush_policy",
+                        subtitleText: "setting.advance.http_stream_flush_policy_desc"
+                    )
+                ) {
+                    ForEach(ServerSentEventFlushPolicy.allCases, id: \.rawValue) { option in
+                        Text(option.title)
+                            .tag(option)
+                    }
+                }
+
+                Picker(
+                    selection: $httpServerRouteConcurrencyLimit,
+                    label: AdvancedTabItemView(
+                        color: getHttpIconColor(),
+                        icon: .arrowTriangleBranch,
+                        labelText: "setting.advance.http_route_concurrency_limit",
+                        subtitleText: "setting.advance.http_route_concurrency_limit_desc"
+                    )
+                ) {
+                    ForEach([2, 4, 8, 16, 32], id: \.self) { limit in
+                        Text(verbatim: "\(limit)")
+                            .tag(limit)
+                    }
+                }
+
+                Picker(
+                    selection: $httpServerServiceConcurrencyLimit,
+                    label: AdvancedTabItemView(
+                        color: getHttpIconColor(),
+                        icon: .squareStack3dUp,
+                        labelText: "setting.advance.http_service_concurrency_limit",
+                        subtitleText: "setting.advance.http_service_concurrency_limit_desc"
+                    )
+                ) {
+                    ForEach([1, 2, 4, 8], id: \.self) { limit in
+                        Text(verbatim: "\(limit)")
+                            .tag(limit)
+                    }
+                }
+
+                Picker(
+                    selection: $httpServerEventLoopThreads,
+                    label: AdvancedTabItemView(
+                        color: getHttpIconColor(),
+                        icon: .cpu,
+                        labelText: "setting.advance.http_event_loop_threads",
+                        subtitleText: "setting.advance.http_event_loop_threads_desc"
+                    )
+                ) {
+                    Text("setting.advance.http_event_loop_threads.automatic")
+                        .tag(0)
+                    ForEach([1, 2, 4, 8], id: \.self) { count in
+                        Text(verbatim: "\(count)")
+                            .tag(count)
+                    }
+                }
             } header: {
                 Text("setting.advance.header.http_server")
             }
+
+            // Diagnostics
+            Section {
+                LabeledContent {
+                    Button("setting.advance.show_metrics_panel.button") {
+                        MetricsPanelController.shared.toggle()
+                    }
+                } label: {
+                    AdvancedTabItemView(
+                        color: .blue,
+                        icon: .chartBarXaxis,
+                        labelText: "setting.advance.show_metrics_panel",
+                        subtitleText: "setting.advance.show_metrics_panel_desc"
+                    )
+                }
+                Toggle(isOn: $enableQueryTracing) {
+                    AdvancedTabItemView(
+                        color: .green,
+                        icon: .stopwatch,
+                        labelText: "setting.advance.enable_query_tracing",
+                        subtitleText: "setting.advance.enable_query_tracing_desc"
+                    )
+                }
+                LabeledContent {
+                    Button("setting.advance.export_query_traces.button") {
+                        exportQueryTraces()
+                    }
+                } label: {
+                    AdvancedTabItemView(
+                        color: .orange,
+                        icon: .squareAndArrowUp,
+                        labelText: "setting.advance.export_query_traces"
+                    )
+                }
+                .disabled(!enableQueryTracing)
+            } header: {
+                Text("setting.advance.header.diagnostics")
+            }
         }
         .formStyle(.grouped)
     }
@@ -436,11 +570,15 @@ struct AdvancedTab: View {
     @Default(.defaultTTSServiceType) private var defaultTTSServiceType
     @Default(.preferYoudaoTTSForEnglishWord) private var preferYoudaoTTSForEnglishWord
     @Default(.disableTipsView) private var disableTipsView
+    @Default(.enableHedgedRequests) private var enableHedgedRequests
+    @Default(.enableSpeculativePrefetch) private var enableSpeculativePrefetch
+    @Default(.enableQueryTracing) private var enableQueryTracing
     @Default(.enableYoudaoOCR) private var enableYoudaoOCR
     @Default(.enableCompatibilityReplace) private var enableCompatibilityReplace
     @Default(.enableAppleOfflineTranslation) private var enableLocalAppleTranslation
     @Default(.minClassicalChineseTextDetectLength) private var minClassicalChineseTextDetectLength
     @Default(.enableOCRTextNormalization) private var enableOCRTextNormalization
+    @Default(.enableTiledOCR) private var enableTiledOCR
     @Default(.showOCRMenuItems) private var showOCRMenuItems
     @Default(.isScreenshotTipLayerHidden) private var isScreenshotTipLayerHidden
     @Default(.autoSelectAllTextFieldText) private var autoSelectAllTextFieldText
@@ -469,6 +607,10 @@ struct AdvancedTab: View {
 
     @Default(.enableHTTPServer) private var enableHTTPServer
     @Default(.httpPort) private var httpPort
+    @Default(.httpStreamFlushPolicy) private var httpStreamFlushPolicy
+    @Default(.httpServerRouteConcurrencyLimit) private var httpServerRouteConcurrencyLimit
+    @Default(.httpServerServiceConcurrencyLimit) private var httpServerServiceConcurrencyLimit
+    @Default(.httpServerEventLoopThreads) private var httpServerEventLoopThreads
 
     @Default(.maxWindowHeightPercentage) private var maxWindowHeightPercentageValue
 
@@ -476,6 +618,20 @@ struct AdvancedTab: View {
     private func getHttpIconColor() -> Color {
         enableHTTPServer ? .green : .red
     }
+
+    /// Saves the recent query traces as Chrome trace-event JSON.
+    private func exportQueryTraces() {
+        let panel = NSSavePanel()
+        panel.nameFieldStringValue = "easydict-query-traces.json"
+        panel.allowedContentTypes = [.json]
+        guard panel.runModal() == .OK, let url = panel.url else { return }
+
+        do {
+            try QueryTracer.shared.exportChromeTrace(to: url)
+        } catch {
+            logError("Export query traces failed: \(error)")
+        }
+    }
 }
 
 #Preview {
@@ -88,6 +88,9 @@ typedef NS_ENUM(NSUInteger, TTTDictionarySearchType) {
 
 + (NSSet<TTTDictionary *> *)availableDictionaries;
 
+/// Re-reads the installed dictionaries, so `dictionaryNamed:` and `availableDictionaries` pick up changes made in Dictionary.app.
++ (void)reloadAvailableDictionaries;
+
 + (NSArray<TTTDictionary *> *)activeDictionaries;
 
 /// Dictionary directory URL, path is ~/Library/Dictionaries/
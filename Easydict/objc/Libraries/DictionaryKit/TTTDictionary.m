@@ -195,34 +195,47 @@ extern CFArrayRef DCSCopyRecordsForSearchString(DCSDictionaryRef, CFStringRef, u
 
 @implementation TTTDictionary
 
+static NSSet *_availableDictionaries = nil;
+static NSDictionary *_availableDictionariesKeyedByName = nil;
+
 + (instancetype)dictionaryNamed:(NSString *)name {
-    static NSDictionary *_availableDictionariesKeyedByName = nil;
-    
-    static dispatch_once_t onceToken;
-    dispatch_once(&onceToken, ^{
-        NSMutableDictionary *mutableAvailableDictionariesKeyedByName = [NSMutableDictionary dictionaryWithCapacity:[[self availableDictionaries] count]];
-        for (TTTDictionary *dictionary in [self availableDictionaries]) {
-            mutableAvailableDictionariesKeyedByName[dictionary.name] = dictionary;
-        }
-        
-        _availableDictionariesKeyedByName = [NSDictionary dictionaryWithDictionary:mutableAvailableDictionariesKeyedByName];
-    });
-    
-    return _availableDictionariesKeyedByName[name];
+    @synchronized(self) {
+        [self loadAvailableDictionariesIfNeeded];
+        return _availableDictionariesKeyedByName[name];
+    }
 }
 
 + (NSSet<TTTDictionary *> *)availableDictionaries {
+    @synchronized(self) {
+        [self loadAvailableDictionariesIfNeeded];
+        return _availableDictionaries;
+    }
+}
+
++ (void)reloadAvailableDictionaries {
+    @synchronized(self) {
+        _availableDictionaries = nil;
+        _availableDictionariesKeyedByName = nil;
+        [self loadAvailableDictionariesIfNeeded];
+    }
+}
+
+/// Must be called while synchronized on the class.
++ (void)loadAvailableDictionariesIfNeeded {
+    if (_availableDictionaries) {
+        return;
+    }
+    
     // Cost < 0.1s
-    static NSSet *_availableDictionaries = nil;
-    static dispatch_once_t onceToken;
-    dispatch_once(&onceToken, ^{
-        NSMutableSet *mutableDictionaries = [NSMutableSet set];
-        for (id dictionary in (__bridge_transfer NSArray *)DCSCopyAvailableDictionaries()) {
-            [mutableDictionaries addObject:[[TTTDictionary alloc] initWithDictionaryRef:(__bridge DCSDictionaryRef)dictionary]];
-        }
-        _availableDictionaries = [NSSet setWithSet:mutableDictionaries];
-    });
-    return _availableDictionaries;
+    NSMutableSet *mutableDictionaries = [NSMutableSet set];
+    NSMutableDictionary *mutableAvailableDictionariesKeyedByName = [NSMutableDictionary dictionary];
+    for (id dictionaryRef in (__bridge_transfer NSArray *)DCSCopyAvailableDictionaries()) {
+        TTTDictionary *dictionary = [[TTTDictionary alloc] initWithDictionaryRef:(__bridge DCSDictionaryRef)dictionaryRef];
+        [mutableDictionaries addObject:dictionary];
+        mutableAvailableDictionariesKeyedByName[dictionary.name] = dictionary;
+    }
+    _availableDictionaries = [NSSet setWithSet:mutableDictionaries];
+    _availableDictionariesKeyedByName = [NSDictionary dictionaryWithDictionary:mutableAvailableDictionariesKeyedByName];
 }
 
 /// Active dictionaries are dictionaries that are currently enabled in Dictionary.app
@@ -8,6 +8,7 @@
 
 #import "EZWebViewManager.h"
 #import "EZConst.h"
+#import "Easydict-Swift.h"
 #import <math.h>
 
 static NSString *kObjcHandler = @"objcHandler";
@@ -35,6 +36,8 @@ static NSString *kMethod = @"method";
     if (!_webView) {
         WKWebViewConfiguration *configuration = [[WKWebViewConfiguration alloc] init];
         [configuration.userContentController addScriptMessageHandler:self name:kObjcHandler];
+        [configuration setURLSchemeHandler:EZDictionaryURLSchemeHandler.shared
+                              forURLScheme:EZDictionaryURLSchemeHandler.scheme];
         _webView = [[WKWebView alloc] initWithFrame:CGRectZero configuration:configuration];
     }
     return _webView;
@@ -132,6 +132,9 @@ static BOOL ez_frame_equal_with_tolerance(CGRect lhs, CGRect rhs, CGFloat tolera
     [super viewWillAppear];
 
     [EZAnalyticsService logWindowAppear:self.windowType];
+
+    // Warm pooled LLM connections while the user is still typing or selecting text.
+    [EZLLMTransport.shared preconnectServices:self.services];
 }
 
 
@@ -292,9 +295,6 @@ static BOOL ez_frame_equal_with_tolerance(CGRect lhs, CGRect rhs, CGFloat tolera
     self.serviceTypeIds = serviceTypeIds;
 
     self.audioPlayer = [[EZAudioPlayer alloc] init];
-    if (!self.youdaoService) {
-        self.youdaoService = [self serviceWithType:EZServiceTypeYoudao];
-    }
 }
 
 - (void)dealloc {
@@ -441,6 +441,16 @@ static BOOL ez_frame_equal_with_tolerance(CGRect lhs, CGRect rhs, CGFloat tolera
     return queryText;
 }
 
+/// Youdao TTS is used even when the Youdao service is disabled, so it is created on demand.
+/// Only playing the query text reads it, and that path is meant to allocate: it runs when
+/// the user asks for audio, not on window setup or queries.
+- (EZQueryService *)youdaoService {
+    if (!_youdaoService) {
+        _youdaoService = [QueryServiceFactory.shared serviceWithTypeId:EZServiceTypeYoudao];
+    }
+    return _youdaoService;
+}
+
 - (EZQueryService *)defaultTTSService {
     EZServiceType defaultTTSServiceType = self.config.defaultTTSServiceType;
     if (![_defaultTTSService.serviceType isEqualToString:defaultTTSServiceType]) {
@@ -841,8 +851,16 @@ static BOOL ez_frame_equal_with_tolerance(CGRect lhs, CGRect rhs, CGFloat tolera
     // !!!: Reset all result before new query.
     [self resetAllResults];
 
+    // Root span of this query's trace, every stage below attaches to it.
+    NSString *traceName = [NSString stringWithFormat:@"query (%@)", [EZEnumTypes windowName:self.windowType]];
+    self.queryModel.traceSpanID = [EZQueryTracer.shared beginTrace:traceName];
+
+    [self applyPrefetchedDetectedLanguageIfNeeded];
+
     if (self.queryModel.needDetectLanguage) {
+        uint64_t detectSpanID = [EZQueryTracer.shared beginSpan:@"detect" parent:self.queryModel.traceSpanID lane:@"detect"];
         [self detectQueryText:^(NSString *_Nonnull language) {
+            [EZQueryTracer.shared endSpan:detectSpanID];
             [self queryAllSerives:self.queryModel];
         }];
     } else {
@@ -900,7 +918,10 @@ static BOOL ez_frame_equal_with_tolerance(CGRect lhs, CGRect rhs, CGFloat tolera
         }
 
         //        MMLogInfo(@"update service: %@, %@", service.serviceType, result);
+        // Table view reload and window height update run synchronously on the main thread.
+        uint64_t renderSpanID = [EZQueryTracer.shared beginSpan:@"render" parent:queryModel.traceSpanID lane:@"render"];
         [self updateCellWithResult:result reloadData:YES];
+        [EZQueryTracer.shared endSpan:renderSpanID];
 
         if (service.autoCopyTranslatedTextBlock) {
             BOOL shouldAutoCopy = !service.isStream || result.isStreamFinished;
@@ -1301,9 +1322,9 @@ static BOOL ez_frame_equal_with_tolerance(CGRect lhs, CGRect rhs, CGFloat tolera
     [self reloadTableViewData:completion];
 }
 
-/// Get latest services from local storage.
+/// Get latest enabled services from local storage, disabled services are not created.
 - (NSArray<EZQueryService *> *)latestServices {
-    return [EZLocalStorage.shared allServices:self.windowType];
+    return [EZLocalStorage.shared enabledServices:self.windowType];
 }
 
 
@@ -1383,6 +1404,24 @@ static BOOL ez_frame_equal_with_tolerance(CGRect lhs, CGRect rhs, CGFloat tolera
     }];
 }
 
+/// Reuse the language detected when the selection was prefetched, see `EZSelectionPrefetcher`.
+- (void)applyPrefetchedDetectedLanguageIfNeeded {
+    if (!self.queryModel.needDetectLanguage) {
+        return;
+    }
+
+    EZLanguage language = [EZSelectionPrefetcher.shared detectedLanguageForQueryText:self.queryText];
+    if (!language) {
+        return;
+    }
+
+    MMLogInfo(@"reuse prefetched detected language: %@", language);
+    self.queryModel.detectedLanguage = language;
+    self.queryModel.needDetectLanguage = NO;
+    self.queryModel.showAutoLanguage = YES;
+    [self updateQueryViewModelAndDetectedLanguage:self.queryModel];
+}
+
 - (void)updateQueryViewModelAndDetectedLanguage:(EZQueryModel *)queryModel {
     self.queryView.clearButtonHidden = (queryModel.inputText.length == 0) && ([self allShowingResults].count == 0);
 
@@ -1552,13 +1591,13 @@ static BOOL ez_frame_equal_with_tolerance(CGRect lhs, CGRect rhs, CGFloat tolera
         webView = webViewManager.webView;
         resultCell.wordResultView.webView = webView;
 
-        BOOL needLoadHTML = result.isShowing && result.htmlString.length && !webViewManager.isLoaded;
+        NSURL *htmlURL = appleDictService.htmlURL;
+        BOOL needLoadHTML = result.isShowing && result.htmlString.length && htmlURL && !webViewManager.isLoaded;
         if (needLoadHTML) {
             webViewManager.isLoaded = YES;
 
-            NSURL *htmlFileURL = [NSURL fileURLWithPath:appleDictService.htmlFilePath];
             webView.navigationDelegate = resultCell.wordResultView;
-            [webView loadFileURL:htmlFileURL allowingReadAccessToURL:TTTDictionary.userDictionaryDirectoryURL];
+            [webView loadRequest:[NSURLRequest requestWithURL:htmlURL]];
         } else if (webViewManager.needUpdateIframeHeight && webViewManager.isLoaded) {
             [webViewManager updateAllIframe];
         }
@@ -0,0 +1,196 @@
+//
+//  HTTPAdmissionControlTests.swift
+//  EasydictTests
+//
+//  Created by tisfeng on 2026/10/19.
+//  Copyright © 2026 izual. All rights reserved.
+//
+
+import Foundation
+import Testing
+import Vapor
+
+@testable import Easydict
+
+// MARK: - HTTPAdmissionControlTests
+
+@Suite("HTTP Admission Control", .tags(.unit))
+struct HTTPAdmissionControlTests {
+    // MARK: Internal
+
+    @Test("Waiters are admitted in arrival order within the limit", .tags(.unit))
+    func admitsWaitersInOrder() async throws {
+        let registry = MetricsRegistry()
+        let limiter = AdmissionLimiter(name: "route:test", maxConcurrent: 2, maxQueued: 8, maxWait: 10, registry: registry)
+        let labels = ["limiter": "route:test"]
+
+        let first = try await limiter.acquire()
+        let second = try await limiter.acquire()
+        #expect(registry.counter(AdmissionLimiter.inFlight, labels: labels) == 2)
+
+        let order = OrderRecorder()
+        var waiters: [Task<(), Error>] = []
+        for index in 0 ..< 3 {
+            waiters.append(Task {
+                let permit = try await limiter.acquire()
+                order.append(index)
+                permit.release()
+            })
+            // Lets each waiter queue before the next one starts.
+            try await waitUntil { registry.counter(AdmissionLimiter.queueDepth, labels: labels) == Double(index + 1) }
+        }
+
+        first.release()
+        second.release()
+        for waiter in waiters {
+            try await waiter.value
+        }
+
+        #expect(order.values == [0, 1, 2])
+        #expect(registry.counter(AdmissionLimiter.queueDepth, labels: labels) == 0)
+        #expect(registry.counter(AdmissionLimiter.inFlight, labels: labels) == 0)
+        #expect(registry.histogram(AdmissionLimiter.queueWait, labels: labels)?.count == 5)
+    }
+
+    @Test("A full queue is rejected with 429 and Retry-After", .tags(.unit))
+    func rejectsWhenQueueIsFull() async throws {
+        let registry = MetricsRegistry()
+        let limiter = AdmissionLimiter(name: "service:cli", maxConcurrent: 1, maxQueued: 1, maxWait: 10, registry: registry)
+        let labels = ["limiter": "service:cli"]
+
+        let permit = try await limiter.acquire()
+        let waiter = Task { try await limiter.acquire() }
+        try await waitUntil { registry.counter(AdmissionLimiter.queueDepth, labels: labels) == 1 }
+
+        do {
+            _ = try await limiter.acquire()
+            Issue.record("Expected a rejection")
+        } catch let rejection as AdmissionRejection {
+            #expect(rejection.status == .tooManyRequests)
+            #expect(rejection.rejectionReason == .queueFull)
+            let retryAfter = try #require(rejection.headers.first(name: "Retry-After").flatMap(Int.init))
+            #expect((1 ... 60).contains(retryAfter))
+        }
+        #expect(registry.counter(AdmissionLimiter.rejections, labels: labels.merging(["reason": "queue_full"]) { $1 }) == 1)
+
+        permit.release()
+        try await waiter.value.release()
+    }
+
+    @Test("Waiting past maxWait is rejected", .tags(.unit))
+    func rejectsAfterTimeout() async throws {
+        let registry = MetricsRegistry()
+        let limiter = AdmissionLimiter(name: "route:ocr", maxConcurrent: 1, maxQueued: 4, maxWait: 0.05, registry: registry)
+        let labels = ["limiter": "route:ocr"]
+
+        let permit = try await limiter.acquire()
+        await #expect(throws: AdmissionRejection.self) {
+            try await limiter.acquire()
+        }
+        #expect(registry.counter(AdmissionLimiter.queueDepth, labels: labels) == 0)
+        #expect(registry.counter(AdmissionLimiter.rejections, labels: labels.merging(["reason": "timeout"]) { $1 }) == 1)
+
+        permit.release()
+        try await limiter.acquire().release()
+    }
+
+    @Test("Cancelling a waiter frees its place in the queue", .tags(.unit))
+    func cancellationRemovesWaiter() async throws {
+        let registry = MetricsRegistry()
+        let limiter = AdmissionLimiter(name: "route:translate", maxConcurrent: 1, maxQueued: 1, maxWait: 10, registry: registry)
+        let labels = ["limiter": "route:translate"]
+
+        let permit = try await limiter.acquire()
+        let waiter = Task { try await limiter.acquire() }
+        try await waitUntil { registry.counter(AdmissionLimiter.queueDepth, labels: labels) == 1 }
+
+        waiter.cancel()
+        await #expect(throws: CancellationError.self) {
+            try await waiter.value
+        }
+        #expect(registry.counter(AdmissionLimiter.queueDepth, labels: labels) == 0)
+
+        permit.release()
+        #expect(registry.counter(AdmissionLimiter.inFlight, labels: labels) == 0)
+    }
+
+    @Test("Route and service permits are released together", .tags(.unit))
+    func releasesRouteAndServicePermits() async throws {
+        let registry = MetricsRegistry()
+        let admissionControl = HTTPAdmissionControl(
+            configuration: .init(routeConcurrencyLimit: 4, serviceConcurrencyLimit: 1, queueLimit: 0, maxQueueWait: 1),
+            registry: registry
+        )
+
+        let permit = try await admissionControl.admit(route: "translate", service: "Google")
+        // The service is busy and its queue holds nothing, so no route slot may be held.
+        await #expect(throws: AdmissionRejection.self) {
+            try await admissionControl.admit(route: "translate", service: "Google")
+        }
+        #expect(registry.counter(AdmissionLimiter.inFlight, labels: ["limiter": "route:translate"]) == 1)
+
+        let otherService = try await admissionControl.admit(route: "translate", service: "DeepL")
+        #expect(registry.counter(AdmissionLimiter.inFlight, labels: ["limiter": "route:translate"]) == 2)
+
+        permit.release()
+        otherService.release()
+        #expect(registry.counter(AdmissionLimiter.inFlight, labels: ["limiter": "route:translate"]) == 0)
+        #expect(registry.counter(AdmissionLimiter.inFlight, labels: ["limiter": "service:Google"]) == 0)
+    }
+
+    @Test("Requests waiting for a busy service do not hold route slots", .tags(.unit))
+    func busyServiceDoesNotBlockRoute() async throws {
+        let registry = MetricsRegistry()
+        let admissionControl = HTTPAdmissionControl(
+            configuration: .init(routeConcurrencyLimit: 2, serviceConcurrencyLimit: 1, queueLimit: 4, maxQueueWait: 5),
+            registry: registry
+        )
+
+        let slowPermit = try await admissionControl.admit(route: "translate", service: "Slow")
+        let waiters = (0 ..< 3).map { _ in
+            Task { try await admissionControl.admit(route: "translate", service: "Slow") }
+        }
+        try await waitUntil {
+            registry.counter(AdmissionLimiter.queueDepth, labels: ["limiter": "service:Slow"]) == 3
+        }
+        #expect(registry.counter(AdmissionLimiter.inFlight, labels: ["limiter": "route:translate"]) == 1)
+
+        // A request for an idle service gets the remaining route slot right away.
+        let idlePermit = try await admissionControl.admit(route: "translate", service: "Idle")
+        #expect(registry.counter(AdmissionLimiter.inFlight, labels: ["limiter": "route:translate"]) == 2)
+
+        idlePermit.release()
+        slowPermit.release()
+        for waiter in waiters {
+            try await waiter.value.release()
+        }
+        #expect(registry.counter(AdmissionLimiter.inFlight, labels: ["limiter": "route:translate"]) == 0)
+    }
+
+    // MARK: Private
+
+    private final class OrderRecorder: @unchecked Sendable {
+        // MARK: Internal
+
+        var values: [Int] {
+            lock.withLock { recorded }
+        }
+
+        func append(_ value: Int) {
+            lock.withLock { recorded.append(value) }
+        }
+
+        // MARK: Private
+
+        private let lock = NSLock()
+        private var recorded: [Int] = []
+    }
+
+    private func waitUntil(timeout: TimeInterval = 2, _ condition: () -> Bool) async throws {
+        let deadline = Date().addingTimeInterval(timeout)
+        while !condition() {
+            try #require(Date() < deadline, "Condition not met in time")
+            await Task.sleep(seconds: 0.001)
+        }
+    }
+}
@@ -0,0 +1,142 @@
+//
+//  OCRUploadTests.swift
+//  EasydictTests
+//
+//  Created by tisfeng on 2026/10/19.
+//  Copyright © 2026 izual. All rights reserved.
+//
+
+import Foundation
+import Testing
+import Vapor
+
+@testable import Easydict
+
+// MARK: - OCRUploadTests
+
+@Suite("OCR Upload", .tags(.unit))
+struct OCRUploadTests {
+    // MARK: Internal
+
+    @Test("Parses multipart uploads streamed in small chunks", .tags(.unit))
+    func parsesMultipartChunks() async throws {
+        let firstImage = Data([0x89, 0x50, 0x4E, 0x47, 0x0D, 0x0A, 0x1A, 0x0A, 0x00, 0xFF])
+        let secondImage = Data((0 ..< 300).map { UInt8($0 % 256) })
+        let body = multipartBody([
+            (#"name="sourceLanguage""#, nil, Data("zh-Hans".utf8)),
+            (#"name="images"; filename="a.png""#, "image/png", firstImage),
+            (#"name="images"; filename="b.jpg""#, "image/jpeg", secondImage),
+            (#"name="note""#, nil, Data("ignored".utf8)),
+        ])
+
+        let upload = try await OCRUpload.read(
+            chunks(of: body, size: 7),
+            contentType: HTTPMediaType(type: "multipart", subType: "form-data", parameters: ["boundary": boundary]),
+            maxSize: 1024 * 1024
+        )
+
+        #expect(upload.images == [firstImage, secondImage])
+        #expect(upload.sourceLanguage == "zh-Hans")
+    }
+
+    @Test("Reads raw image and JSON bodies", .tags(.unit))
+    func readsRawAndJSONBodies() async throws {
+        let image = Data([1, 2, 3, 4, 5])
+
+        let raw = try await OCRUpload.read(
+            chunks(of: image, size: 2),
+            contentType: .png,
+            contentLength: image.count,
+            sourceLanguage: "en",
+            maxSize: 1024
+        )
+        #expect(raw.images == [image])
+        #expect(raw.sourceLanguage == "en")
+
+        let json = try JSONEncoder().encode(OCRBatchRequest(images: [image, image], sourceLanguage: "ja"))
+        let batch = try await OCRUpload.read(chunks(of: json, size: 16), contentType: .json, maxSize: 1024)
+        #expect(batch.images == [image, image])
+        #expect(batch.sourceLanguage == "ja")
+    }
+
+    @Test("Rejects bodies over the size limit while streaming", .tags(.unit))
+    func rejectsOversizedBodies() async throws {
+        let image = Data(repeating: 0xAB, count: 100)
+
+        await #expect(throws: Abort.self) {
+            try await OCRUpload.read(self.chunks(of: image, size: 10), contentType: .png, maxSize: 64)
+        }
+        await #expect(throws: Abort.self) {
+            try await OCRUpload.read(self.chunks(of: image, size: 10), contentType: .png, contentLength: 100, maxSize: 64)
+        }
+    }
+
+    @Test("Bounded map keeps order and the concurrency limit", .tags(.unit))
+    func boundedMapRespectsLimit() async {
+        let counter = ConcurrencyCounter()
+
+        let results = await OCRUpload.boundedMap(Array(0 ..< 12), concurrencyLimit: 3) { value in
+            counter.enter()
+            await Task.sleep(seconds: 0.01 * Double(12 - value) / 12)
+            counter.leave()
+            return value * value
+        }
+
+        #expect(results == (0 ..< 12).map { $0 * $0 })
+        #expect(counter.maxConcurrent <= 3)
+        #expect(counter.maxConcurrent > 1)
+    }
+
+    // MARK: Private
+
+    private final class ConcurrencyCounter: @unchecked Sendable {
+        // MARK: Internal
+
+        var maxConcurrent: Int {
+            lock.withLock { peak }
+        }
+
+        func enter() {
+            lock.withLock {
+                current += 1
+                peak = max(peak, current)
+            }
+        }
+
+        func leave() {
+            lock.withLock { current -= 1 }
+        }
+
+        // MARK: Private
+
+        private let lock = NSLock()
+        private var current = 0
+        private var peak = 0
+    }
+
+    private let boundary = "----EasydictBoundary7MA4YWxk"
+
+    private func multipartBody(_ parts: [(disposition: String, contentType: String?, body: Data)]) -> Data {
+        var data = Data()
+        for part in parts {
+            data.append(Data("--\(boundary)\r\nContent-Disposition: form-data; \(part.disposition)\r\n".utf8))
+            if let contentType = part.contentType {
+                data.append(Data("Content-Type: \(contentType)\r\n".utf8))
+            }
+            data.append(Data("\r\n".utf8))
+            data.append(part.body)
+            data.append(Data("\r\n".utf8))
+        }
+        data.append(Data("--\(boundary)--\r\n".utf8))
+        return data
+    }
+
+    private func chunks(of data: Data, size: Int) -> AsyncStream<ByteBuffer> {
+        AsyncStream { continuation in
+            for start in stride(from: 0, to: data.count, by: size) {
+                continuation.yield(ByteBuffer(bytes: data[start ..< min(start + size, data.count)]))
+            }
+            continuation.finish()
+        }
+    }
+}
@@ -0,0 +1,220 @@
+//
+//  ServerSentEventWriterTests.swift
+//  EasydictTests
+//
+//  Created by tisfeng on 2026/10/19.
+//  Copyright © 2026 izual. All rights reserved.
+//
+
+import Foundation
+import Testing
+import Vapor
+
+@testable import Easydict
+
+// MARK: - ServerSentEventWriterTests
+
+@Suite("Server-Sent Event Writer")
+struct ServerSentEventWriterTests {
+    // MARK: Internal
+
+    @Test("Latency policy writes every event", .tags(.unit))
+    func latencyPolicyWritesEveryEvent() async throws {
+        let recorder = RecordingBodyStreamWriter()
+        let writer = ServerSentEventWriter(writer: recorder, allocator: ByteBufferAllocator(), flushPolicy: .latency)
+
+        try await writer.send(TokenChunk(content: "敏捷的"))
+        try await writer.send(TokenChunk(content: "狐狸"))
+        try await writer.send(json: #"{"error":"boom"}"#)
+        try await writer.finish()
+
+        #expect(
+            recorder.writes == [
+                #"data: {"content":"敏捷的"}\#n\#n"#,
+                #"data: {"content":"狐狸"}\#n\#n"#,
+                #"data: {"error":"boom"}\#n\#n"#,
+            ]
+        )
+        #expect(recorder.didEnd)
+    }
+
+    @Test("Coalesces events produced within the delay", .tags(.unit))
+    func coalescesEvents() async throws {
+        let recorder = RecordingBodyStreamWriter()
+        let writer = ServerSentEventWriter(writer: recorder, allocator: ByteBufferAllocator(), flushPolicy: .throughput)
+
+        let tokens = (0 ..< 200).map { "token \($0) " }
+        for token in tokens {
+            try await writer.send(TokenChunk(content: token))
+        }
+        try await writer.finish()
+
+        let expected = tokens.map { #"data: {"content":"\#($0)"}\#n\#n"# }.joined()
+        #expect(recorder.writes.joined() == expected)
+        // The first event goes out alone, the rest share a few writes.
+        #expect(recorder.writes.first == #"data: {"content":"token 0 "}\#n\#n"#)
+        #expect(recorder.writes.count < 10)
+        #expect(recorder.didEnd)
+    }
+
+    @Test("Writes keep-alive comments while idle", .tags(.unit))
+    func writesKeepAliveComments() async throws {
+        let recorder = RecordingBodyStreamWriter()
+        let writer = ServerSentEventWriter(
+            writer: recorder,
+            allocator: ByteBufferAllocator(),
+            flushPolicy: .balanced,
+            keepAliveInterval: 0.02
+        )
+
+        await writer.startKeepAlive()
+        await Task.sleep(seconds: 0.15)
+        try await writer.send(TokenChunk(content: "late"))
+        try await writer.finish()
+
+        #expect(recorder.writes.first == ": keep-alive\n\n")
+        #expect(recorder.writes.last == #"data: {"content":"late"}\#n\#n"#)
+    }
+
+    @Test("The first event after keep-alives is not held for the delay", .tags(.unit))
+    func firstEventAfterKeepAliveIsWrittenRightAway() async throws {
+        let recorder = RecordingBodyStreamWriter()
+        let writer = ServerSentEventWriter(
+            writer: recorder,
+            allocator: ByteBufferAllocator(),
+            flushPolicy: .throughput,
+            keepAliveInterval: 0.02
+        )
+
+        await writer.startKeepAlive()
+        await Task.sleep(seconds: 0.1)
+        try #require(recorder.writes.first == ": keep-alive\n\n")
+
+        let firstEvent = #"data: {"content":"first"}\#n\#n"#
+        try await writer.send(TokenChunk(content: "first"))
+        // Well within the throughput policy's coalescing delay; a keep-alive write that was
+        // in progress may still be handing the event over.
+        let deadline = Date().addingTimeInterval(ServerSentEventFlushPolicy.throughput.coalescingDelay / 2)
+        while recorder.writes.last != firstEvent, Date() < deadline {
+            await Task.sleep(seconds: 0.001)
+        }
+        #expect(recorder.writes.last == firstEvent)
+
+        try await writer.finish()
+    }
+
+    /// Load generator: concurrent streams emit tokens in bursts, the way providers deliver
+    /// them, through the previous per-token string path and through each flush policy.
+    @Test("Benchmark concurrent streams per flush policy", .tags(.performance))
+    func benchmarkConcurrentStreams() async throws {
+        let streamCount = 64
+        let tokensPerStream = 400
+
+        let legacy = try await runLoad(streamCount: streamCount, tokensPerStream: tokensPerStream, flushPolicy: nil)
+        print("SSE legacy: \(legacy)")
+
+        for policy in ServerSentEventFlushPolicy.allCases {
+            let result = try await runLoad(streamCount: streamCount, tokensPerStream: tokensPerStream, flushPolicy: policy)
+            print("SSE \(policy.rawValue): \(result)")
+
+            #expect(result.bytes == legacy.bytes)
+            #expect(result.writes <= legacy.writes)
+        }
+    }
+
+    // MARK: Private
+
+    private struct TokenChunk: Encodable {
+        let content: String
+    }
+
+    private struct LoadResult: CustomStringConvertible {
+        let writes: Int
+        let bytes: Int
+        let duration: TimeInterval
+
+        var description: String {
+            "\(writes) writes, \(bytes) bytes, \(String(format: "%.1f", duration * 1000)) ms"
+        }
+    }
+
+    /// Records what a response body receives, like the channel would.
+    private final class RecordingBodyStreamWriter: AsyncBodyStreamWriter, @unchecked Sendable {
+        // MARK: Internal
+
+        var writes: [String] {
+            lock.withLock { recordedWrites }
+        }
+
+        var didEnd: Bool {
+            lock.withLock { recordedEnd }
+        }
+
+        func write(_ result: BodyStreamResult) async throws {
+            lock.withLock {
+                switch result {
+                case let .buffer(buffer):
+                    recordedWrites.append(String(buffer: buffer))
+                case .end:
+                    recordedEnd = true
+                case .error:
+                    break
+                }
+            }
+        }
+
+        // MARK: Private
+
+        private let lock = NSLock()
+        private var recordedWrites: [String] = []
+        private var recordedEnd = false
+    }
+
+    /// Runs `streamCount` concurrent streams; a `nil` policy replays the route's previous
+    /// path, which encoded to `String`, formatted, and copied each token into a new buffer.
+    private func runLoad(
+        streamCount: Int,
+        tokensPerStream: Int,
+        flushPolicy: ServerSentEventFlushPolicy?
+    ) async throws
+        -> LoadResult {
+        let recorders = (0 ..< streamCount).map { _ in RecordingBodyStreamWriter() }
+        let start = Date()
+
+        try await withThrowingTaskGroup(of: Void.self) { group in
+            for recorder in recorders {
+                group.addTask {
+                    let eventWriter = flushPolicy.map {
+                        ServerSentEventWriter(writer: recorder, allocator: ByteBufferAllocator(), flushPolicy: $0)
+                    }
+                    for index in 0 ..< tokensPerStream {
+                        let chunk = TokenChunk(content: "词\(index) ")
+                        if let eventWriter {
+                            try await eventWriter.send(chunk)
+                        } else {
+                            let data = "data: \(chunk.jsonString ?? "")\n\n"
+                            try await recorder.write(.buffer(.init(string: data)))
+                        }
+                        // Providers deliver tokens in bursts of a network chunk.
+                        if index % 8 == 7 {
+                            await Task.sleep(seconds: 0.001)
+                        }
+                    }
+                    if let eventWriter {
+                        try await eventWriter.finish()
+                    } else {
+                        try await recorder.write(.end)
+                    }
+                }
+            }
+            try await group.waitForAll()
+        }
+
+        let writes = recorders.map(\.writes)
+        return LoadResult(
+            writes: writes.map(\.count).reduce(0, +),
+            bytes: writes.flatMap { $0 }.map(\.utf8.count).reduce(0, +),
+            duration: Date().timeIntervalSince(start)
+        )
+    }
+}
@@ -0,0 +1,163 @@
+//
+//  OCRImageTilerTests.swift
+//  EasydictTests
+//
+//  Created by tisfeng on 2026/10/19.
+//  Copyright © 2026 izual. All rights reserved.
+//
+
+import AppKit
+import Foundation
+import Testing
+
+@testable import Easydict
+
+// MARK: - OCRImageTilerTests
+
+/// Tests for splitting tall images into OCR tiles and merging the tile observations.
+@Suite("OCR Image Tiler", .tags(.ocr))
+struct OCRImageTilerTests {
+    // MARK: Internal
+
+    @Test("Short images are recognized in one piece", .tags(.unit))
+    func shortImagesAreNotTiled() {
+        let tiler = OCRImageTiler()
+
+        #expect(tiler.tileRects(width: 3024, height: 1600) == [CGRect(x: 0, y: 0, width: 3024, height: 1600)])
+        #expect(tiler.tileRects(width: 800, height: 300).count == 1)
+    }
+
+    @Test("Tiles cover tall images with overlapping bands", .tags(.unit))
+    func tilesCoverTallImages() {
+        let tiler = OCRImageTiler()
+
+        for height in [1601, 2000, 2880, 5000] {
+            let rects = tiler.tileRects(width: 5120, height: height)
+
+            #expect(rects.count > 1)
+            #expect(rects.first?.minY == 0)
+            #expect(rects.last?.maxY == CGFloat(height))
+            for rect in rects {
+                #expect(rect.width == 5120)
+                #expect(rect.height <= CGFloat(tiler.tileHeight))
+            }
+            for (upper, lower) in zip(rects, rects.dropFirst()) {
+                // Rounding to whole pixels may cost one pixel of overlap.
+                #expect(upper.maxY - lower.minY >= CGFloat(tiler.overlap - 1))
+            }
+        }
+    }
+
+    @Test("Merge keeps each line once, from the tile owning its center", .tags(.unit))
+    func mergeDropsOverlapDuplicates() throws {
+        let tiler = OCRImageTiler()
+        let imageHeight = 2000
+        let rects = tiler.tileRects(width: 1000, height: imageHeight)
+        // Tiles span 0-800, 600-1400 and 1200-2000; ownership switches at 700 and 1300.
+        try #require(rects.map(\.minY) == [0, 600, 1200])
+
+        let tileObservations = [
+            [
+                observation("top", from: 100, to: 140, in: rects[0]),
+                observation("first overlap", from: 650, to: 690, in: rects[0]),
+                observation("boundary", from: 678, to: 718, in: rects[0]),
+                observation("cut at tile edge", from: 780, to: 800, in: rects[0]),
+            ],
+            [
+                observation("first overlap", from: 650, to: 690, in: rects[1]),
+                // Vision places the same line a few pixels lower in this tile.
+                observation("boundary", from: 682, to: 722, in: rects[1]),
+                observation("middle", from: 1000, to: 1040, in: rects[1]),
+                observation("second overlap", from: 1350, to: 1390, in: rects[1]),
+            ],
+            [
+                observation("second overlap", from: 1350, to: 1390, in: rects[2]),
+                observation("bottom", from: 1900, to: 1940, in: rects[2]),
+            ],
+        ]
+
+        let merged = tiler.merge(tileObservations, tileRects: rects, imageHeight: imageHeight)
+
+        #expect(merged.recognizedTexts == ["top", "first overlap", "boundary", "middle", "second overlap", "bottom"])
+
+        let secondOverlap = try #require(merged.first { $0.firstText == "second overlap" })
+        #expect(abs(secondOverlap.boundingBox.minY - (1 - 1390 / 2000)) < 0.0001)
+        #expect(abs(secondOverlap.boundingBox.maxY - (1 - 1350 / 2000)) < 0.0001)
+    }
+
+    /// Recognizes the corpus with and without tiling, and reports latency and how many lines
+    /// of the single-pass result the tiled result reproduces.
+    ///
+    /// The corpus images are small, so they are tiled with bands far shorter than the default.
+    @Test(
+        "Benchmark tiled OCR on the image corpus",
+        .tags(.integration, .performance),
+        .disabled("Runs the whole OCR corpus twice, which takes a long time. Run it on demand.")
+    )
+    func benchmarkTiledOCR() async throws {
+        let tiler = OCRImageTiler(minTiledHeight: 600, tileHeight: 500, overlap: 120)
+        var singleTotal: TimeInterval = 0
+        var tiledTotal: TimeInterval = 0
+        var singleLineCount = 0
+        var matchedLineCount = 0
+
+        for sample in OCRTestSample.allCases {
+            let image = try NSImage.loadTestImage(named: sample.imageName)
+            let cgImage = try #require(image.toCGImage())
+            let tileCount = tiler.tileRects(width: cgImage.width, height: cgImage.height).count
+            guard tileCount > 1 else { continue }
+
+            let singleStart = CFAbsoluteTimeGetCurrent()
+            let single = try await ocrEngine.recognizeObservations(in: cgImage)
+            let singleTime = CFAbsoluteTimeGetCurrent() - singleStart
+
+            let tiledStart = CFAbsoluteTimeGetCurrent()
+            let tiled = try await ocrEngine.recognizeObservations(in: cgImage, tiler: tiler)
+            let tiledTime = CFAbsoluteTimeGetCurrent() - tiledStart
+
+            let tiledLines = Set(tiled.recognizedTexts)
+            let matched = single.recognizedTexts.filter { tiledLines.contains($0) }.count
+
+            singleTotal += singleTime
+            tiledTotal += tiledTime
+            singleLineCount += single.count
+            matchedLineCount += matched
+
+            print(
+                "\(sample.imageName) (\(cgImage.width)x\(cgImage.height), \(tileCount) tiles): "
+                    + "single \(singleTime.string3f)s, tiled \(tiledTime.string3f)s, "
+                    + "lines \(matched)/\(single.count) matched, \(tiled.count) tiled"
+            )
+        }
+
+        let parity = Double(matchedLineCount) / Double(max(singleLineCount, 1))
+        print("Tiled OCR total: single \(singleTotal.string3f)s, tiled \(tiledTotal.string3f)s, parity \(parity.string2f)")
+
+        #expect(parity > 0.95)
+    }
+
+    // MARK: Private
+
+    private let ocrEngine = AppleOCREngine()
+
+    /// Makes an observation normalized to `tileRect`, from pixel rows of the whole image.
+    private func observation(
+        _ text: String,
+        from top: CGFloat,
+        to bottom: CGFloat,
+        in tileRect: CGRect
+    )
+        -> EZRecognizedTextObservation {
+        let maxY = (tileRect.maxY - top) / tileRect.height
+        let minY = (tileRect.maxY - bottom) / tileRect.height
+        return EZRecognizedTextObservation(
+            topLeft: CGPoint(x: 0.1, y: maxY),
+            topRight: CGPoint(x: 0.9, y: maxY),
+            bottomRight: CGPoint(x: 0.9, y: minY),
+            bottomLeft: CGPoint(x: 0.1, y: minY),
+            uuid: UUID(),
+            confidence: 1,
+            topCandidates: [EZRecognizedText(string: text, confidence: 1)]
+        )
+    }
+}
@@ -0,0 +1,172 @@
+//
+//  AgentCLILineFramerTests.swift
+//  EasydictTests
+//
+//  Created by tisfeng on 2026/10/19.
+//  Copyright © 2026 izual. All rights reserved.
+//
+
+@testable import Easydict
+import Foundation
+import Testing
+
+// MARK: - AgentCLILineFramerTests
+
+@Suite("Agent CLI Line Framer")
+struct AgentCLILineFramerTests {
+    // MARK: Internal
+
+    @Test("Lines split across reads are reassembled", .tags(.unit))
+    func linesSplitAcrossReads() {
+        let framer = AgentCLILineFramer(initialCapacity: 8)
+        var lines: [String] = []
+
+        for chunk in ["{\"a\":", "1}\n{\"b\"", ":2}\n\n{\"c\":3"] {
+            framer.append(Data(chunk.utf8))
+            framer.drainLines { lines.append(String(decoding: $0, as: UTF8.self)) }
+        }
+        #expect(lines == ["{\"a\":1}", "{\"b\":2}"])
+        #expect(framer.pendingByteCount == 6)
+
+        framer.drainLines(includeRemainder: true) { lines.append(String(decoding: $0, as: UTF8.self)) }
+        #expect(lines == ["{\"a\":1}", "{\"b\":2}", "{\"c\":3"])
+        #expect(framer.pendingByteCount == 0)
+    }
+
+    @Test("Multi-byte UTF-8 split between reads is preserved", .tags(.unit))
+    func multiByteCharactersSplitBetweenReads() {
+        let framer = AgentCLILineFramer(initialCapacity: 4)
+        let bytes = Array("狐狸\n跳过\n".utf8)
+        var lines: [String] = []
+
+        // One byte per read splits every character.
+        for byte in bytes {
+            framer.append(Data([byte]))
+            framer.drainLines { lines.append(String(decoding: $0, as: UTF8.self)) }
+        }
+        #expect(lines == ["狐狸", "跳过"])
+    }
+
+    @Test("Tail buffer keeps only the most recent bytes", .tags(.unit))
+    func tailBufferKeepsMostRecentBytes() {
+        let buffer = AgentCLITailBuffer(capacity: 8)
+        buffer.append(Data("abcdef".utf8))
+        #expect(buffer.data == Data("abcdef".utf8))
+
+        buffer.append(Data("ghij".utf8))
+        #expect(buffer.count == 8)
+        #expect(buffer.data == Data("cdefghij".utf8))
+
+        buffer.append(Data("0123456789".utf8))
+        #expect(buffer.data == Data("23456789".utf8))
+    }
+
+    @Test("Byte-level delta extraction matches the String path", .tags(.unit))
+    func byteLevelExtractionMatchesStringPath() throws {
+        let decoder = AgentCLIJSONEventDecoder()
+        for line in try recordedClaudeLines() {
+            #expect(
+                extractTextDelta(from: Data(line.utf8), decoder: decoder)
+                    == extractTextDelta(from: line)
+            )
+        }
+
+        let codexLine = #"{"type":"item.completed","item":{"id":"i0","type":"agent_message","text":"你好"}}"#
+        #expect(extractCodexText(from: Data(codexLine.utf8), decoder: decoder) == "你好")
+        #expect(extractCodexText(from: Data(#"{"type":"turn.started"}"#.utf8), decoder: decoder) == nil)
+    }
+
+    /// Benchmark: replays recorded `stream-json` output through the legacy `Data` buffer
+    /// and through `AgentCLILineFramer`, using pipe-sized reads that split lines and
+    /// multi-byte characters.
+    @Test("Benchmark recorded stream replay throughput", .tags(.performance))
+    func benchmarkRecordedStreamReplay() throws {
+        let recordedLines = try recordedClaudeLines()
+        let deltaLines = recordedLines.filter { $0.contains("\"text_delta\"") }
+        let controlLines = recordedLines.filter { !$0.contains("\"text_delta\"") }
+
+        // A long translation: thousands of deltas framed by the recorded control events.
+        var replayedLines = Array(controlLines.prefix(3))
+        for _ in 0 ..< 5000 {
+            replayedLines += deltaLines
+        }
+        replayedLines += controlLines.dropFirst(3)
+
+        var stream = Data()
+        for line in replayedLines {
+            stream.append(contentsOf: line.utf8)
+            stream.append(0x0A)
+        }
+        let chunks = stride(from: 0, to: stream.count, by: 4093).map {
+            stream.subdata(in: $0 ..< min($0 + 4093, stream.count))
+        }
+
+        var legacyOutput: [String] = []
+        let legacyStart = Date()
+        replayLegacy(chunks, into: &legacyOutput)
+        let legacyDuration = Date().timeIntervalSince(legacyStart)
+
+        var framedOutput: [String] = []
+        let framedStart = Date()
+        replayFramed(chunks, into: &framedOutput)
+        let framedDuration = Date().timeIntervalSince(framedStart)
+
+        let megabytes = Double(stream.count) / 1_048_576
+        print(
+            "CLI stdout replay (\(String(format: "%.1f", megabytes)) MB, \(chunks.count) reads): "
+                + "legacy \(String(format: "%.1f", megabytes / legacyDuration)) MB/s, "
+                + "framer \(String(format: "%.1f", megabytes / framedDuration)) MB/s"
+        )
+
+        #expect(framedOutput == legacyOutput)
+        #expect(framedOutput.count == deltaLines.count * 5000)
+    }
+
+    // MARK: Private
+
+    private func recordedClaudeLines() throws -> [String] {
+        let url = URL(fileURLWithPath: #filePath)
+            .deletingLastPathComponent()
+            .appendingPathComponent("claude-stream-json-sample.jsonl")
+        return try String(contentsOf: url, encoding: .utf8)
+            .split(separator: "\n")
+            .map(String.init)
+    }
+
+    /// The runner's previous framing: rescan from the read head, decode each line to
+    /// `String`, and copy the unconsumed tail into a new `Data` on every flush.
+    private func replayLegacy(_ chunks: [Data], into output: inout [String]) {
+        let decoder = JSONDecoder()
+        var buffer = Data()
+        for chunk in chunks {
+            buffer.append(chunk)
+            var readHead = buffer.startIndex
+            while let newlineIdx = buffer[readHead...].firstIndex(of: 0x0A) {
+                if let line = String(data: buffer[readHead ..< newlineIdx], encoding: .utf8),
+                   let delta = extractTextDelta(from: line, decoder: decoder) {
+                    output.append(delta)
+                }
+                readHead = buffer.index(after: newlineIdx)
+            }
+            buffer = readHead < buffer.endIndex ? Data(buffer[readHead...]) : Data()
+        }
+    }
+
+    private func replayFramed(_ chunks: [Data], into output: inout [String]) {
+        let decoder = AgentCLIJSONEventDecoder()
+        let framer = AgentCLILineFramer()
+        for chunk in chunks {
+            framer.append(chunk)
+            framer.drainLines { line in
+                if let delta = extractTextDelta(from: line, decoder: decoder) {
+                    output.append(delta)
+                }
+            }
+        }
+        framer.drainLines(includeRemainder: true) { line in
+            if let delta = extractTextDelta(from: line, decoder: decoder) {
+                output.append(delta)
+            }
+        }
+    }
+}
@@ -0,0 +1,189 @@
+//
+//  AgentCLIWorkerPoolTests.swift
+//  EasydictTests
+//
+//  Created by tisfeng on 2026/10/19.
+//  Copyright © 2026 izual. All rights reserved.
+//
+
+import Defaults
+@testable import Easydict
+import Foundation
+import Testing
+
+// MARK: - AgentCLIWorkerPoolTests
+
+/// Exercises `AgentCLIWorkerPool` with `fake-agent-cli.sh`, which simulates CLI
+/// startup latency before reading its prompt from stdin.
+@Suite("Agent CLI Worker Pool", .serialized)
+struct AgentCLIWorkerPoolTests {
+    // MARK: Internal
+
+    @Test("Claude stream-input arguments keep the prompt out of argv", .tags(.unit))
+    func claudeStreamInputArguments() {
+        let arguments = ClaudeCodeRunner.buildStreamInputArguments(systemPrompt: "system")
+
+        #expect(arguments.contains("--input-format"))
+        #expect(arguments.contains("--output-format"))
+        #expect(arguments.filter { $0 == "stream-json" }.count == 2)
+        #expect(arguments.last == "system")
+        #expect(!arguments.contains("Translate this"))
+    }
+
+    @Test("Claude stream-input message is one JSON line", .tags(.unit))
+    func claudeStreamInputMessage() throws {
+        let data = ClaudeCodeRunner.streamInputMessage(prompt: "Translate \"this\"\nplease")
+
+        #expect(data.last == 0x0A)
+        #expect(data.dropLast().firstIndex(of: 0x0A) == nil)
+
+        let object = try JSONSerialization.jsonObject(with: data.dropLast()) as? [String: Any]
+        let message = object?["message"] as? [String: Any]
+        #expect(object?["type"] as? String == "user")
+        #expect(message?["content"] as? String == "Translate \"this\"\nplease")
+    }
+
+    @Test("Prewarmed worker is checked out warm", .tags(.unit))
+    func prewarmedWorkerIsCheckedOutWarm() async throws {
+        try await withWorkerPoolEnabled {
+            let pool = makePool()
+            defer { pool.drain() }
+
+            let configuration = fakeConfiguration(startupDelay: 0.2)
+            pool.prewarm(configuration)
+            try await Task.sleep(for: .milliseconds(500))
+
+            let worker = pool.checkout(configuration)
+            #expect(worker.isAvailable)
+            #expect(pool.statistics.warmCheckouts == 1)
+
+            let output = try await runToCompletion(worker, prompt: "hello")
+            #expect(output.contains("fake translation of 5 characters"))
+        }
+    }
+
+    @Test("Recycle terminates idle workers", .tags(.unit))
+    func recycleTerminatesIdleWorkers() async throws {
+        try await withWorkerPoolEnabled {
+            let pool = makePool()
+            defer { pool.drain() }
+
+            let configuration = fakeConfiguration(startupDelay: 0.2)
+            pool.prewarm(configuration)
+            try await Task.sleep(for: .milliseconds(300))
+            pool.recycle(configuration)
+
+            let worker = pool.checkout(configuration)
+            #expect(!worker.isAvailable)
+            #expect(pool.statistics.coldCheckouts == 1)
+            #expect(pool.statistics.recycledWorkers == 1)
+        }
+    }
+
+    @Test("Workers are not shared across environments", .tags(.unit))
+    func workersAreKeyedByEnvironment() async throws {
+        try await withWorkerPoolEnabled {
+            let pool = makePool()
+            defer { pool.drain() }
+
+            pool.prewarm(fakeConfiguration(startupDelay: 0.1))
+            try await Task.sleep(for: .milliseconds(300))
+
+            // Same executable and arguments, but e.g. a changed API key in the environment.
+            let worker = pool.checkout(fakeConfiguration(startupDelay: 0.2))
+            #expect(!worker.isAvailable)
+            #expect(worker.configuration.environment["FAKE_AGENT_CLI_STARTUP_DELAY"] == "0.2")
+            #expect(pool.statistics.coldCheckouts == 1)
+        }
+    }
+
+    /// Benchmark: latency of sequential requests with and without warm workers.
+    ///
+    /// The fake CLI sleeps for `startupDelay` before reading stdin, so cold requests
+    /// pay the delay on every run while warm requests only pay it in the background.
+    @Test("Benchmark cold vs. warm request latency", .tags(.performance))
+    func benchmarkColdVersusWarmLatency() async throws {
+        try await withWorkerPoolEnabled {
+            let startupDelay = 0.8
+            let requestCount = 5
+            let pool = makePool()
+            defer { pool.drain() }
+
+            let configuration = fakeConfiguration(startupDelay: startupDelay)
+            var coldDurations: [TimeInterval] = []
+            for _ in 0 ..< requestCount {
+                let worker = AgentCLIWorker(configuration: configuration)
+                let start = Date()
+                _ = try await runToCompletion(worker, prompt: "cold")
+                coldDurations.append(Date().timeIntervalSince(start))
+            }
+
+            pool.prewarm(configuration)
+            var warmDurations: [TimeInterval] = []
+            for _ in 0 ..< requestCount {
+                // Simulate user think time between queries, long enough for a refill.
+                try await Task.sleep(for: .seconds(startupDelay + 0.3))
+                let worker = pool.checkout(configuration)
+                let start = Date()
+                _ = try await runToCompletion(worker, prompt: "warm")
+                warmDurations.append(Date().timeIntervalSince(start))
+            }
+
+            let coldAverage = coldDurations.reduce(0, +) / Double(requestCount)
+            let warmAverage = warmDurations.reduce(0, +) / Double(requestCount)
+            print(
+                "Agent CLI pool benchmark: cold \(String(format: "%.0f", coldAverage * 1000)) ms, "
+                    + "warm \(String(format: "%.0f", warmAverage * 1000)) ms, "
+                    + "stats \(pool.statistics)"
+            )
+
+            #expect(warmAverage < coldAverage)
+            #expect(pool.statistics.warmCheckouts == requestCount)
+        }
+    }
+
+    // MARK: Private
+
+    private func fakeConfiguration(startupDelay: TimeInterval) -> AgentCLIWorkerConfiguration {
+        var environment = ProcessInfo.processInfo.environment
+        environment["FAKE_AGENT_CLI_STARTUP_DELAY"] = String(startupDelay)
+
+        let scriptPath = URL(fileURLWithPath: #filePath)
+            .deletingLastPathComponent()
+            .appendingPathComponent("fake-agent-cli.sh")
+            .path
+        return AgentCLIWorkerConfiguration(
+            executablePath: "/bin/sh",
+            arguments: [scriptPath],
+            workingDirectory: FileManager.default.temporaryDirectory.path,
+            environment: environment
+        )
+    }
+
+    private func makePool() -> AgentCLIWorkerPool {
+        AgentCLIWorkerPool(name: "fake-agent-cli", enabledKey: .enableCodexCLIWorkerPool)
+    }
+
+    private func withWorkerPoolEnabled(_ body: () async throws -> ()) async throws {
+        let previousValue = Defaults[.enableCodexCLIWorkerPool]
+        Defaults[.enableCodexCLIWorkerPool] = true
+        defer { Defaults[.enableCodexCLIWorkerPool] = previousValue }
+        try await body()
+    }
+
+    /// Launches the worker if needed, writes the prompt, and waits for the process to exit.
+    private func runToCompletion(_ worker: AgentCLIWorker, prompt: String) async throws -> String {
+        try await withCheckedThrowingContinuation { continuation in
+            worker.setTerminationHandler { _ in
+                let output = worker.stdoutPipe.fileHandleForReading.readDataToEndOfFile()
+                continuation.resume(returning: String(data: output, encoding: .utf8) ?? "")
+            }
+            do {
+                try worker.launchIfNeeded()
+                CodexCLIRunner.writePromptToStandardInput(prompt, pipe: worker.stdinPipe)
+            } catch {
+                continuation.resume(throwing: error)
+            }
+        }
+    }
+}
@@ -0,0 +1,23 @@
+#!/bin/sh
+#
+# fake-agent-cli.sh
+#
+# Stand-in for `codex exec --json ... -- -` used to benchmark AgentCLIWorkerPool.
+# It sleeps to simulate CLI startup (runtime boot, config and auth checks), then
+# reads the prompt from stdin and prints Codex-style JSONL events.
+#
+# Usage:
+#   FAKE_AGENT_CLI_STARTUP_DELAY=1.5 ./fake-agent-cli.sh <<< "prompt"
+#   FAKE_AGENT_CLI_EXIT_CODE=1 ./fake-agent-cli.sh <<< "prompt"
+
+sleep "${FAKE_AGENT_CLI_STARTUP_DELAY:-1.5}"
+
+prompt=$(cat)
+prompt_length=${#prompt}
+
+printf '{"type":"thread.started","thread_id":"fake-thread"}\n'
+printf '{"type":"turn.started"}\n'
+printf '{"type":"item.completed","item":{"id":"item_0","type":"agent_message","text":"fake translation of %d characters"}}\n' "$prompt_length"
+printf '{"type":"turn.completed","usage":{"input_tokens":%d,"cached_input_tokens":0,"output_tokens":6}}\n' "$prompt_length"
+
+exit "${FAKE_AGENT_CLI_EXIT_CODE:-0}"
@@ -113,6 +113,39 @@ struct BingServiceTests {
         #expect(completionResult?.translatedText == "你好")
     }
 
+    /// Verifies the token refresh date is half of the token lifetime after its creation time.
+    @Test("Token refresh date is halfway through the token lifetime", .tags(.unit))
+    func tokenRefreshDateIsHalfwayThroughLifetime() throws {
+        let config = BingConfig()
+        #expect(config.tokenRefreshDate == nil)
+        #expect(config.isBingTokenExpired())
+
+        let createdAt = Date().addingTimeInterval(-10 * 60)
+        config.key = String(Int64(createdAt.timeIntervalSince1970 * 1000))
+        config.expirationInterval = "3600000"
+
+        let refreshDate = try #require(config.tokenRefreshDate)
+        #expect(abs(refreshDate.timeIntervalSince(createdAt) - 30 * 60) < 1)
+        #expect(!config.isBingTokenExpired())
+
+        config.key = String(Int64(Date().addingTimeInterval(-31 * 60).timeIntervalSince1970 * 1000))
+        #expect(config.isBingTokenExpired())
+    }
+
+    /// Verifies callers get a copy of the shared config, so only the manager changes it.
+    @Test("Token manager hands out config copies", .tags(.unit))
+    func tokenManagerHandsOutConfigCopies() {
+        let manager = BingTokenManager.shared
+        let originalHost = manager.config.host
+
+        let copy = manager.config
+        copy.host = "copy.bing.test"
+        copy.resetToken()
+
+        #expect(manager.config.host == originalHost)
+        #expect(manager.config !== copy)
+    }
+
     // MARK: Private
 
     /// Creates a Bing service with a stubbed request dependency and initialized result state.
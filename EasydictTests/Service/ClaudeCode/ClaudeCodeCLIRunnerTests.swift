@@ -189,6 +189,41 @@ struct ClaudeCodeCLIRunnerTests {
         #expect(usage == nil)
     }
 
+    // MARK: - ClaudeCodeEventParser tests
+
+    @Test("ClaudeCodeEventParser yields deltas and tracks usage as lines arrive")
+    func eventParserTracksDeltasAndUsageIncrementally() {
+        let parser = ClaudeCodeEventParser()
+        let deltaLine =
+            #"{"type":"stream_event","event":{"type":"content_block_delta","index":0,"#
+                + #""delta":{"type":"text_delta","text":"你好"}}}"#
+        let resultLine =
+            #"{"type":"result","subtype":"success","is_error":false,"result":"你好","#
+                + #""duration_ms":800,"total_cost_usd":0.001,"#
+                + #""usage":{"input_tokens":3,"output_tokens":2}}"#
+
+        #expect(parser.consume(#"{"type":"stream_event","event":{"type":"message_start"}}"#) == nil)
+        #expect(parser.consume(deltaLine) == "你好")
+        #expect(parser.tokenUsage == nil)
+
+        #expect(parser.consume(resultLine) == nil)
+        #expect(parser.tokenUsage?.inputTokens == 3)
+        #expect(parser.tokenUsage?.outputTokens == 2)
+        #expect(parser.tokenUsage?.durationMs == 800)
+    }
+
+    @Test("ClaudeCodeEventParser classifies errors from consumed events without stdout")
+    func eventParserClassifiesErrorsFromConsumedEvents() {
+        let parser = ClaudeCodeEventParser()
+        parser.consume(#"{"type":"rate_limit_event","rate_limit_info":{"status":"rejected"}}"#)
+        parser.consume(
+            #"{"type":"result","is_error":true,"result":"You've hit your limit","usage":{}}"#
+        )
+
+        #expect(parser.tokenUsage == nil)
+        #expect(parser.error(stderr: "") == .quotaExceeded(message: "You've hit your limit"))
+    }
+
     @Test("resolveLoginShellPath accepts executable non-zsh login shells")
     func resolveLoginShellPathAcceptsExecutableNonZshShell() {
         let shell = ClaudeCodeRunner.resolveLoginShellPath(environmentShell: "/bin/sh")
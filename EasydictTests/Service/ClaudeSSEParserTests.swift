@@ -11,31 +11,27 @@ import Testing
 
 @testable import Easydict
 
-/// Unit tests for Claude SSE event normalization and parsing.
+/// Unit tests for Claude SSE event framing and parsing.
 @Suite("Claude SSE Parser", .tags(.unit))
 struct ClaudeSSEParserTests {
     // MARK: Internal
 
     /// Verifies that a single LF-delimited SSE event is extracted successfully.
     @Test("Extracts a single LF-delimited event")
-    func extractsSingleLFEvent() {
-        let buffer = contentDeltaEvent(text: "Hello", lineSeparator: "\n")
+    func extractsSingleLFEvent() throws {
+        let events = frameEvents([contentDeltaEvent(text: "Hello", lineSeparator: "\n")])
 
-        let extracted = ClaudeSSEParser.extractCompleteEvents(from: buffer)
-
-        #expect(extracted.events == [normalizedContentDeltaEvent(text: "Hello")])
-        #expect(extracted.remainingBuffer.isEmpty)
+        #expect(events == [contentDeltaServerSentEvent(text: "Hello")])
+        #expect(try events.compactMap(ClaudeSSEParser().content) == ["Hello"])
     }
 
     /// Verifies that a single CRLF-delimited SSE event is normalized and extracted successfully.
     @Test("Extracts a single CRLF-delimited event")
-    func extractsSingleCRLFEvent() {
-        let buffer = contentDeltaEvent(text: "Hello", lineSeparator: "\r\n")
-
-        let extracted = ClaudeSSEParser.extractCompleteEvents(from: buffer)
+    func extractsSingleCRLFEvent() throws {
+        let events = frameEvents([contentDeltaEvent(text: "Hello", lineSeparator: "\r\n")])
 
-        #expect(extracted.events == [normalizedContentDeltaEvent(text: "Hello")])
-        #expect(extracted.remainingBuffer.isEmpty)
+        #expect(events == [contentDeltaServerSentEvent(text: "Hello")])
+        #expect(try events.compactMap(ClaudeSSEParser().content) == ["Hello"])
     }
 
     /// Verifies that a chunk boundary between `\\r` and `\\n` does not split one event into two.
@@ -44,44 +40,45 @@ struct ClaudeSSEParserTests {
         let firstChunk = "event: content_block_delta\r"
         let secondChunk = "\ndata: \(contentDeltaPayload(text: "Hello"))\r\n\r\n"
 
-        let firstPass = ClaudeSSEParser.extractCompleteEvents(from: firstChunk)
-        #expect(firstPass.events.isEmpty)
-        #expect(firstPass.remainingBuffer == firstChunk)
+        let framer = ServerSentEventFramer()
+        var events: [ServerSentEvent] = []
+        framer.append(Data(firstChunk.utf8))
+        framer.drainEvents { events.append($0) }
+        #expect(events.isEmpty)
 
-        let secondPass = ClaudeSSEParser.extractCompleteEvents(from: firstPass.remainingBuffer + secondChunk)
+        framer.append(Data(secondChunk.utf8))
+        framer.drainEvents { events.append($0) }
 
-        #expect(secondPass.events == [normalizedContentDeltaEvent(text: "Hello")])
-        #expect(secondPass.remainingBuffer.isEmpty)
+        #expect(events == [contentDeltaServerSentEvent(text: "Hello")])
+        #expect(framer.pendingByteCount == 0)
     }
 
     /// Verifies that multiple CRLF-delimited events in one buffer are all extracted.
     @Test("Extracts multiple CRLF-delimited events from one buffer")
-    func extractsMultipleCRLFEvents() {
-        let buffer = contentDeltaEvent(text: "Hello", lineSeparator: "\r\n")
-            + contentDeltaEvent(text: "World", lineSeparator: "\r\n")
-
-        let extracted = ClaudeSSEParser.extractCompleteEvents(from: buffer)
+    func extractsMultipleCRLFEvents() throws {
+        let events = frameEvents([
+            contentDeltaEvent(text: "Hello", lineSeparator: "\r\n")
+                + contentDeltaEvent(text: "World", lineSeparator: "\r\n"),
+        ])
 
         #expect(
-            extracted.events == [
-                normalizedContentDeltaEvent(text: "Hello"),
-                normalizedContentDeltaEvent(text: "World"),
+            events == [
+                contentDeltaServerSentEvent(text: "Hello"),
+                contentDeltaServerSentEvent(text: "World"),
             ]
         )
-        #expect(extracted.remainingBuffer.isEmpty)
+        #expect(try events.compactMap(ClaudeSSEParser().content) == ["Hello", "World"])
     }
 
     /// Verifies that an error event still throws a `QueryError` after CRLF normalization.
     @Test("Recognizes error events after CRLF normalization")
     func recognizesErrorEventsAfterNormalization() {
-        let buffer = errorEvent(message: "Claude request failed", lineSeparator: "\r\n")
-        let extracted = ClaudeSSEParser.extractCompleteEvents(from: buffer)
+        let events = frameEvents([errorEvent(message: "Claude request failed", lineSeparator: "\r\n")])
 
-        #expect(extracted.events.count == 1)
-        #expect(extracted.remainingBuffer.isEmpty)
+        #expect(events.count == 1)
 
         do {
-            _ = try ClaudeSSEParser.parseEvent(extracted.events[0])
+            _ = try ClaudeSSEParser().content(of: events[0])
             Issue.record("Expected Claude SSE error event to throw QueryError.")
         } catch let error as QueryError {
             #expect(error.type == .api)
@@ -111,11 +108,24 @@ struct ClaudeSSEParserTests {
         "event: content_block_delta\(lineSeparator)data: \(contentDeltaPayload(text: text))\(lineSeparator)\(lineSeparator)"
     }
 
-    /// Builds the normalized event string expected after CRLF conversion.
+    /// Builds the framed event expected for a content delta.
     /// - Parameter text: The incremental text content.
-    /// - Returns: A normalized LF-delimited SSE event string.
-    private func normalizedContentDeltaEvent(text: String) -> String {
-        "event: content_block_delta\ndata: \(contentDeltaPayload(text: text))"
+    /// - Returns: The `content_block_delta` event with its JSON payload.
+    private func contentDeltaServerSentEvent(text: String) -> ServerSentEvent {
+        ServerSentEvent(type: "content_block_delta", data: Data(contentDeltaPayload(text: text).utf8))
+    }
+
+    /// Frames the given chunks, in order, with one `ServerSentEventFramer`.
+    /// - Parameter chunks: Response body chunks.
+    /// - Returns: Every event completed by the chunks.
+    private func frameEvents(_ chunks: [String]) -> [ServerSentEvent] {
+        let framer = ServerSentEventFramer()
+        var events: [ServerSentEvent] = []
+        for chunk in chunks {
+            framer.append(Data(chunk.utf8))
+            framer.drainEvents { events.append($0) }
+        }
+        return events
     }
 
     /// Builds a Claude SSE error event with the requested line separator.
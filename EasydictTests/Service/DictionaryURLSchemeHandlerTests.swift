@@ -0,0 +1,131 @@
+//
+//  DictionaryURLSchemeHandlerTests.swift
+//  EasydictTests
+//
+//  Created by tisfeng on 2026/10/19.
+//  Copyright © 2026 izual. All rights reserved.
+//
+
+import Foundation
+import Testing
+import WebKit
+
+@testable import Easydict
+
+// MARK: - DictionaryURLSchemeHandlerTests
+
+/// Tests for serving rendered dictionary documents and their audio through `easydict-dict://`.
+@Suite("Dictionary URL Scheme Handler", .tags(.unit))
+@MainActor
+struct DictionaryURLSchemeHandlerTests {
+    // MARK: Internal
+
+    @Test("Audio of a rendered entry is served through the handler")
+    func servesAudioOfRenderedEntry() throws {
+        let contentsURL = try makeDictionaryContents()
+        defer { try? FileManager.default.removeItem(at: contentsURL.deletingLastPathComponent()) }
+
+        let entryHTML = #"<a href="javascript:new Audio(&quot;uk/apple__gb_1.mp3&quot;).play();">UK</a>"#
+        let html = AppleDictionary().replacedAudioPath(ofHTML: entryHTML, withBasePath: contentsURL.path)
+        let rendered = try #require(DictionaryHTMLRenderer.render(
+            word: "apple",
+            sections: [DictionaryHTMLSection(title: "Test", html: html)],
+            baseHTML: nil
+        ))
+        let documentURL = handler.registerDocument(
+            html: rendered.htmlString,
+            resourceRoots: [contentsURL.deletingLastPathComponent()]
+        )
+
+        let document = load(documentURL)
+        #expect(document.response?.mimeType == "text/html")
+        #expect(String(data: document.data, encoding: .utf8) == rendered.htmlString)
+
+        let audioPattern = #"easydict-dict://resource/[^'&"]+"#
+        let audioRange = try #require(rendered.htmlString.range(of: audioPattern, options: .regularExpression))
+        let audioURL = try #require(URL(string: String(rendered.htmlString[audioRange])))
+
+        let audio = load(audioURL)
+        #expect(audio.error == nil)
+        #expect(audio.data == audioData)
+        #expect(audio.response?.mimeType == "audio/mpeg")
+    }
+
+    @Test("Non-document paths under the document host are served as resources")
+    func servesResourcesResolvedAgainstDocument() throws {
+        let contentsURL = try makeDictionaryContents()
+        defer { try? FileManager.default.removeItem(at: contentsURL.deletingLastPathComponent()) }
+
+        let documentURL = handler.registerDocument(
+            html: "<html></html>",
+            resourceRoots: [contentsURL.deletingLastPathComponent()]
+        )
+        // What WebKit resolves a bare `new Audio('/Users/...')` path in the document to.
+        let audioPath = contentsURL.appendingPathComponent("uk/apple__gb_1.mp3").path
+        let encodedPath = try #require(audioPath.addingPercentEncoding(withAllowedCharacters: .urlPathAllowed))
+        let resolvedURL = try #require(URL(string: encodedPath, relativeTo: documentURL))
+
+        let audio = load(resolvedURL.absoluteURL)
+        #expect(audio.data == audioData)
+    }
+
+    @Test("Files outside registered roots are not served")
+    func rejectsUnregisteredFiles() {
+        let task = load(handler.resourceURL(forFilePath: "/etc/hosts"))
+        #expect(task.error != nil)
+        #expect(task.data.isEmpty)
+    }
+
+    // MARK: Private
+
+    /// Records what the handler delivers, like WebKit would.
+    private final class RecordingSchemeTask: NSObject, WKURLSchemeTask {
+        // MARK: Lifecycle
+
+        init(url: URL) {
+            self.request = URLRequest(url: url)
+        }
+
+        // MARK: Internal
+
+        let request: URLRequest
+        var response: URLResponse?
+        var data = Data()
+        var error: Error?
+
+        func didReceive(_ response: URLResponse) {
+            self.response = response
+        }
+
+        func didReceive(_ data: Data) {
+            self.data.append(data)
+        }
+
+        func didFinish() {}
+
+        func didFailWithError(_ error: any Error) {
+            self.error = error
+        }
+    }
+
+    private let handler = DictionaryURLSchemeHandler.shared
+    private let webView = WKWebView()
+    private let audioData = Data([0x49, 0x44, 0x33, 0x04, 0x00])
+
+    /// Creates `<tmp>/Test Dict.dictionary/Contents/uk/apple__gb_1.mp3` and returns `Contents`.
+    private func makeDictionaryContents() throws -> URL {
+        let dictionaryURL = FileManager.default.temporaryDirectory
+            .appendingPathComponent(UUID().uuidString)
+            .appendingPathComponent("Test Dict.dictionary")
+        let audioDirectory = dictionaryURL.appendingPathComponent("Contents/uk")
+        try FileManager.default.createDirectory(at: audioDirectory, withIntermediateDirectories: true)
+        try audioData.write(to: audioDirectory.appendingPathComponent("apple__gb_1.mp3"))
+        return dictionaryURL.appendingPathComponent("Contents")
+    }
+
+    private func load(_ url: URL) -> RecordingSchemeTask {
+        let task = RecordingSchemeTask(url: url)
+        handler.webView(webView, start: task)
+        return task
+    }
+}
@@ -0,0 +1,131 @@
+//
+//  GoogleTranslateTokenTests.swift
+//  EasydictTests
+//
+//  Created by tisfeng on 2026/10/19.
+//  Copyright © 2026 izual. All rights reserved.
+//
+
+import Foundation
+import JavaScriptCore
+import Testing
+
+@testable import Easydict
+
+/// Verifies the native Google `tk` sign against the web app script it replaced.
+///
+/// `google-translate-sign.js` is only kept as a test fixture; the app no longer ships a
+/// JavaScript engine for Google.
+@Suite("Google Translate Token", .tags(.unit))
+struct GoogleTranslateTokenTests {
+    // MARK: Internal
+
+    /// Verifies a known token for the default TKK.
+    @Test("Signs with the default TKK")
+    func signsWithDefaultTKK() throws {
+        let text = "Hello, world"
+        #expect(GoogleTranslateToken.sign(text) == (try jsSign(text, tkk: GoogleTranslateToken.defaultTKK)))
+    }
+
+    /// Verifies native and JS signs agree bit for bit on a randomized corpus.
+    @Test("Matches the JavaScript sign on a randomized corpus")
+    func matchesJavaScriptOnRandomCorpus() throws {
+        let context = try makeJSContext()
+        let sign = try #require(context.objectForKeyedSubscript("sign"))
+        let tkks = [
+            GoogleTranslateToken.defaultTKK,
+            "437961.2280157552",
+            "0.0",
+            "474582.0",
+            "4294967295.4294967295",
+            "123456789.987654321",
+        ]
+
+        var generator = SplitMix64(seed: 0x5EED_600D)
+        for index in 0 ..< 5000 {
+            let text = randomText(using: &generator)
+            let tkk = tkks[index % tkks.count]
+
+            // `sign` caches TKK on first use, so reset it for every case.
+            context.evaluateScript("window.TKK = '\(tkk)'; yr = null;")
+            let expected = sign.call(withArguments: [text])?.toString()
+            #expect(GoogleTranslateToken.sign(text, tkk: tkk) == expected, "text: \(text.debugDescription), tkk: \(tkk)")
+        }
+    }
+
+    /// Verifies TKK is scraped from the web app page and malformed values are skipped.
+    @Test("Scrapes TKK from the web page")
+    func scrapesTKK() {
+        let service = GoogleService()
+        #expect(service.scrapeTKK(from: "a,tkk:'437961.2280157552',b") == "437961.2280157552")
+        #expect(service.scrapeTKK(from: "TKK:'x.1',tkk:'1.2',") == "1.2")
+        #expect(service.scrapeTKK(from: "no token here") == nil)
+    }
+
+    /// Verifies the TKK cache only asks for a refresh once the interval has passed.
+    @Test("TKK cache honours the refresh interval")
+    func tkkCacheRefreshInterval() {
+        let cache = GoogleTKKCache()
+        #expect(cache.needsRefresh)
+        #expect(cache.tkk == GoogleTranslateToken.defaultTKK)
+
+        cache.update("437961.2280157552")
+        #expect(!cache.needsRefresh)
+        #expect(cache.tkk == "437961.2280157552")
+
+        // A page without TKK keeps the value but still counts as a refresh.
+        cache.update(nil, at: Date(timeIntervalSinceNow: -GoogleTKKCache.refreshInterval))
+        #expect(cache.needsRefresh)
+        #expect(cache.tkk == "437961.2280157552")
+    }
+
+    // MARK: Private
+
+    /// Deterministic generator so a failing case can be reproduced.
+    private struct SplitMix64: RandomNumberGenerator {
+        var seed: UInt64
+
+        mutating func next() -> UInt64 {
+            seed &+= 0x9E37_79B9_7F4A_7C15
+            var z = seed
+            z = (z ^ (z >> 30)) &* 0xBF58_476D_1CE4_E5B9
+            z = (z ^ (z >> 27)) &* 0x94D0_49BB_1331_11EB
+            return z ^ (z >> 31)
+        }
+    }
+
+    private func makeJSContext() throws -> JSContext {
+        let scriptURL = URL(fileURLWithPath: #filePath)
+            .deletingLastPathComponent()
+            .appendingPathComponent("google-translate-sign.js")
+        let script = try String(contentsOf: scriptURL, encoding: .utf8)
+        let context = try #require(JSContext())
+        context.evaluateScript(script)
+        return context
+    }
+
+    private func jsSign(_ text: String, tkk: String) throws -> String? {
+        let context = try makeJSContext()
+        context.evaluateScript("window.TKK = '\(tkk)'; yr = null;")
+        return context.objectForKeyedSubscript("sign").call(withArguments: [text])?.toString()
+    }
+
+    /// Mixes ASCII, 2- and 3-byte UTF-8 characters and astral scalars such as emoji.
+    private func randomText(using generator: inout SplitMix64) -> String {
+        let length = Int.random(in: 0 ... 60, using: &generator)
+        var scalars = String.UnicodeScalarView()
+        for _ in 0 ..< length {
+            let range: ClosedRange<UInt32> = switch Int.random(in: 0 ..< 10, using: &generator) {
+            case 0 ..< 4: 0x20 ... 0x7E
+            case 4 ..< 6: 0x80 ... 0x7FF
+            case 6 ..< 8: 0x800 ... 0xD7FF
+            case 8: 0xE000 ... 0xFFFF
+            default: 0x10000 ... 0x10FFFF
+            }
+            if let scalar = Unicode.Scalar(UInt32.random(in: range, using: &generator)) {
+                scalars.append(scalar)
+            }
+        }
+        return String(scalars)
+    }
+}
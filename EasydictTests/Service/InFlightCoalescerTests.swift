@@ -0,0 +1,159 @@
+//
+//  InFlightCoalescerTests.swift
+//  EasydictTests
+//
+//  Created by tisfeng on 2026/10/19.
+//  Copyright © 2026 izual. All rights reserved.
+//
+
+import Foundation
+import Testing
+
+@testable import Easydict
+
+/// Unit tests for sharing identical in-flight queries between callers.
+@Suite("In-Flight Coalescer", .tags(.unit))
+struct InFlightCoalescerTests {
+    // MARK: Internal
+
+    /// Verifies concurrent identical calls run the operation once and share its result.
+    @Test("Identical calls share one operation")
+    func identicalCallsShareOperation() async throws {
+        let coalescer = InFlightCoalescer()
+        let counter = Counter()
+        let operation: @Sendable () async throws -> String = {
+            await counter.increment()
+            try await Task.sleep(for: .milliseconds(200))
+            return "result"
+        }
+
+        async let first = coalescer.value(for: "key", operation: operation)
+        async let second = coalescer.value(for: "key", operation: operation)
+        let results = try await [first, second]
+
+        #expect(results == ["result", "result"])
+        #expect(await counter.value == 1)
+        #expect(coalescer.inFlightCount == 0)
+    }
+
+    /// Verifies different keys never share an operation.
+    @Test("Different keys run separately")
+    func differentKeysRunSeparately() async throws {
+        let coalescer = InFlightCoalescer()
+        let counter = Counter()
+
+        async let first = coalescer.value(for: "a") { await counter.increment(); return 1 }
+        async let second = coalescer.value(for: "b") { await counter.increment(); return 2 }
+        let results = try await [first, second]
+
+        #expect(results == [1, 2])
+        #expect(await counter.value == 2)
+    }
+
+    /// Verifies a late subscriber replays earlier elements and the upstream starts once.
+    @Test("Late subscriber replays the stream")
+    func lateSubscriberReplays() async throws {
+        let coalescer = InFlightCoalescer()
+        let (upstream, upstreamContinuation) = AsyncThrowingStream<String, Error>.makeStream()
+        var startCount = 0
+        let makeStream = {
+            startCount += 1
+            return upstream
+        }
+
+        let owner = NSObject()
+        var firstIterator = coalescer.stream(for: "key", owner: owner, makeStream: makeStream).makeAsyncIterator()
+        upstreamContinuation.yield("a")
+        #expect(try await firstIterator.next() == "a")
+
+        let second = coalescer.stream(for: "key", owner: NSObject(), makeStream: makeStream)
+        upstreamContinuation.yield("b")
+        upstreamContinuation.finish()
+
+        #expect(try await collect(second) == ["a", "b"])
+        #expect(try await firstIterator.next() == "b")
+        #expect(try await firstIterator.next() == nil)
+        #expect(startCount == 1)
+    }
+
+    /// Verifies the upstream stream is cancelled once its only subscriber is gone.
+    @Test("Last unsubscribe cancels the upstream")
+    func lastUnsubscribeCancelsUpstream() async throws {
+        let coalescer = InFlightCoalescer()
+        let (upstream, upstreamContinuation) = AsyncThrowingStream<String, Error>.makeStream()
+        let terminated = Flag()
+        upstreamContinuation.onTermination = { _ in terminated.set() }
+
+        let owner = NSObject()
+        let consumer = Task {
+            try await collect(coalescer.stream(for: "key", owner: owner) { upstream })
+        }
+        upstreamContinuation.yield("a")
+        try await Task.sleep(for: .milliseconds(100))
+        consumer.cancel()
+
+        #expect(await waitUntil { terminated.isSet })
+        #expect(coalescer.inFlightCount == 0)
+    }
+
+    /// Verifies cancelling one owner's subscriptions leaves other subscribers streaming.
+    @Test("Cancelling an owner keeps other subscribers")
+    func cancelOwnerKeepsOthers() async throws {
+        let coalescer = InFlightCoalescer()
+        let (upstream, upstreamContinuation) = AsyncThrowingStream<String, Error>.makeStream()
+        let cancelledOwner = NSObject()
+        let keptOwner = NSObject()
+
+        let cancelled = coalescer.stream(for: "key", owner: cancelledOwner) { upstream }
+        let kept = coalescer.stream(for: "key", owner: keptOwner) { upstream }
+        coalescer.cancelSubscriptions(of: cancelledOwner)
+
+        await #expect(throws: CancellationError.self) {
+            _ = try await collect(cancelled)
+        }
+
+        upstreamContinuation.yield("a")
+        upstreamContinuation.finish()
+        #expect(try await collect(kept) == ["a"])
+    }
+
+    // MARK: Private
+
+    private actor Counter {
+        var value = 0
+
+        func increment() {
+            value += 1
+        }
+    }
+
+    private final class Flag: @unchecked Sendable {
+        var isSet: Bool {
+            lock.withLock { value }
+        }
+
+        func set() {
+            lock.withLock { value = true }
+        }
+
+        private let lock = NSLock()
+        private var value = false
+    }
+
+    private func collect(_ stream: AsyncThrowingStream<String, Error>) async throws -> [String] {
+        var elements: [String] = []
+        for try await element in stream {
+            elements.append(element)
+        }
+        return elements
+    }
+
+    /// Polls `condition` for up to one second.
+    private func waitUntil(_ condition: () -> Bool) async -> Bool {
+        for _ in 0 ..< 100 {
+            if condition() { return true }
+            try? await Task.sleep(for: .milliseconds(10))
+        }
+        return condition()
+    }
+}
@@ -0,0 +1,375 @@
+//
+//  JSONDeltaExtractorTests.swift
+//  EasydictTests
+//
+//  Created by tisfeng on 2026/10/19.
+//  Copyright © 2026 izual. All rights reserved.
+//
+
+import Foundation
+import Testing
+
+@testable import Easydict
+
+// MARK: - JSONDeltaExtractorTests
+
+@Suite("JSON Delta Extractor", .tags(.unit))
+struct JSONDeltaExtractorTests {
+    // MARK: Internal
+
+    @Test("Decodes escapes and surrogate pairs", .tags(.unit))
+    func decodesEscapes() {
+        let payload = #"{"delta":"a\"b\\c\/d\n\t\u00E9\ud83d\ude00雪👍🏽"}"#
+        #expect(DoubaoSSEParser.deltaExtractor.extract(from: Data(payload.utf8)) == .delta("a\"b\\c/d\n\té😀雪👍🏽"))
+    }
+
+    @Test("Null, missing and mismatched deltas yield no content", .tags(.unit))
+    func yieldsNoContent() {
+        #expect(DoubaoSSEParser.deltaExtractor.extract(from: Data(#"{"delta":null}"#.utf8)) == .delta(nil))
+        #expect(DoubaoSSEParser.deltaExtractor.extract(from: Data(#"{"type":"x"}"#.utf8)) == .delta(nil))
+
+        let thinking = #"{"type":"stream_event","event":{"type":"content_block_delta","delta":{"type":"thinking_delta","text":"hm"}}}"#
+        #expect(cliTextDeltaExtractor.extract(from: Data(thinking.utf8)) == .delta(nil))
+        #expect(DeepSeekSSEParser.deltaExtractor.extract(from: Data(#"{"choices":[]}"#.utf8)) == .delta(nil))
+    }
+
+    @Test("Falls back on payloads it cannot vouch for", .tags(.unit))
+    func fallsBack() {
+        let claudePayloads = [
+            // Missing required `type`.
+            #"{"index":0,"delta":{"type":"text_delta","text":"a"}}"#,
+            // Duplicate schema key.
+            #"{"type":"content_block_delta","delta":{"type":"text_delta","text":"a"},"delta":null}"#,
+            // Escaped key.
+            #"{"\u0074ype":"content_block_delta","delta":{"type":"text_delta","text":"a"}}"#,
+            // Exponent in an integer.
+            #"{"type":"content_block_delta","index":1e0,"delta":{"type":"text_delta","text":"a"}}"#,
+            // Lone surrogate.
+            #"{"type":"content_block_delta","delta":{"type":"text_delta","text":"\ud83d"}}"#,
+            // Truncated and trailing bytes.
+            #"{"type":"content_block_delta","delta":{"type":"text_delta","text":"a"}"#,
+            #"{"type":"content_block_delta","delta":{"type":"text_delta","text":"a"}}x"#,
+        ]
+        for payload in claudePayloads {
+            #expect(ClaudeSSEParser.deltaExtractor.extract(from: Data(payload.utf8)) == .unsupported, "\(payload)")
+        }
+
+        // DeepSeek's final usage chunk omits `delta`, which the model requires.
+        let usageChunk = #"{"choices":[{"index":0,"finish_reason":"stop"}],"usage":{"total_tokens":9}}"#
+        #expect(DeepSeekSSEParser.deltaExtractor.extract(from: Data(usageChunk.utf8)) == .unsupported)
+    }
+
+    /// Fuzzes schema-valid payloads and byte-level mutations of them: whenever the fast
+    /// path answers, it must agree with `Codable`, and it must answer for every valid payload.
+    @Test("Fast path agrees with Codable on fuzzed payloads", .tags(.unit))
+    func fastPathMatchesCodable() {
+        var generator = SplitMix64(seed: 0x5EED_D317)
+        let claude = ClaudeSSEParser()
+        let doubao = DoubaoSSEParser()
+        let deepSeek = DeepSeekSSEParser()
+        let cliDecoder = AgentCLIJSONEventDecoder()
+
+        let providers: [Provider] = [
+            Provider(
+                name: "Claude",
+                makePayload: { self.claudePayload(using: &$0) },
+                extractor: ClaudeSSEParser.deltaExtractor,
+                fastPath: { try? claude.content(of: ServerSentEvent(type: "content_block_delta", data: $0)) },
+                codable: { claude.decodeDelta(from: $0) }
+            ),
+            Provider(
+                name: "Doubao",
+                makePayload: { self.doubaoPayload(using: &$0) },
+                extractor: DoubaoSSEParser.deltaExtractor,
+                fastPath: { doubao.content(of: ServerSentEvent(type: "response.output_text.delta", data: $0)) },
+                codable: { doubao.decodeDelta(from: $0) }
+            ),
+            Provider(
+                name: "DeepSeek",
+                makePayload: { self.deepSeekPayload(using: &$0) },
+                extractor: DeepSeekSSEParser.deltaExtractor,
+                fastPath: { deepSeek.content(of: ServerSentEvent(type: nil, data: $0)) },
+                codable: { deepSeek.decodeContent(from: $0) }
+            ),
+            Provider(
+                name: "CLI",
+                makePayload: { self.cliPayload(using: &$0) },
+                extractor: cliTextDeltaExtractor,
+                fastPath: { extractTextDelta(from: $0, decoder: cliDecoder) },
+                codable: { extractTextDelta(from: String(decoding: $0, as: UTF8.self)) }
+            ),
+        ]
+
+        for provider in providers {
+            var fastPathCount = 0
+            for index in 0 ..< 1500 {
+                let payload = Data(provider.makePayload(&generator).utf8)
+                if provider.extractor.extract(from: payload) != .unsupported {
+                    fastPathCount += 1
+                }
+                #expect(provider.fastPath(payload) == provider.codable(payload), "\(provider.name): \(String(decoding: payload, as: UTF8.self))")
+
+                // Every few payloads, check a mutation too; most of them are malformed.
+                guard index % 5 == 0 else { continue }
+                let mutated = mutate(payload, using: &generator)
+                if case let .delta(delta) = provider.extractor.extract(from: mutated) {
+                    #expect(delta == provider.codable(mutated), "\(provider.name): \(String(decoding: mutated, as: UTF8.self))")
+                }
+            }
+            #expect(fastPathCount == 1500, "\(provider.name) fast path handled \(fastPathCount) of 1500 payloads")
+        }
+    }
+
+    // MARK: Private
+
+    private struct Provider {
+        let name: String
+        let makePayload: (inout SplitMix64) -> String
+        let extractor: JSONDeltaExtractor
+        let fastPath: (Data) -> String?
+        let codable: (Data) -> String?
+    }
+
+    private struct SplitMix64: RandomNumberGenerator {
+        var seed: UInt64
+
+        mutating func next() -> UInt64 {
+            seed &+= 0x9E37_79B9_7F4A_7C15
+            var z = seed
+            z = (z ^ (z >> 30)) &* 0xBF58_476D_1CE4_E5B9
+            z = (z ^ (z >> 27)) &* 0x94D0_49BB_1331_11EB
+            return z ^ (z >> 31)
+        }
+    }
+
+    private let textPieces = [
+        "a", "Z", "0", " ", "the fox", "\"", "\\", "/", "\n", "\r", "\t", "\u{1}", "\u{1F}",
+        "é", "雪", "山", "ß", "😀", "👍🏽", "e\u{301}", "\u{FEFF}", "\u{10FFFF}", "{", "}", "[", "]", ":", ",",
+    ]
+
+    // MARK: Payloads
+
+    private func claudePayload(using generator: inout SplitMix64) -> String {
+        let deltaType = Bool.random(using: &generator) ? "text_delta" : "input_json_delta"
+        var delta = [("type", jsonString(deltaType, using: &generator))]
+        if let text = optionalDelta(using: &generator) {
+            delta.append(("text", text))
+        }
+        if deltaType == "input_json_delta" {
+            delta.append(("partial_json", randomString(using: &generator)))
+        }
+
+        var fields = [("type", jsonString("content_block_delta", using: &generator))]
+        if Bool.random(using: &generator) {
+            fields.append(("index", randomInteger(using: &generator)))
+        }
+        if Int.random(in: 0 ..< 8, using: &generator) != 0 {
+            fields.append(("delta", object(delta, using: &generator)))
+        }
+        return object(fields + extraFields(using: &generator), using: &generator)
+    }
+
+    private func doubaoPayload(using generator: inout SplitMix64) -> String {
+        var fields = [
+            ("type", jsonString("response.output_text.delta", using: &generator)),
+            ("item_id", randomString(using: &generator)),
+            ("output_index", randomInteger(using: &generator)),
+            ("sequence_number", randomInteger(using: &generator)),
+        ]
+        if let delta = optionalDelta(using: &generator) {
+            fields.append(("delta", delta))
+        }
+        return object(fields + extraFields(using: &generator), using: &generator)
+    }
+
+    private func deepSeekPayload(using generator: inout SplitMix64) -> String {
+        var choices: [String] = []
+        for index in 0 ..< Int.random(in: 0 ... 2, using: &generator) {
+            var delta: [(String, String)] = []
+            if let content = optionalDelta(using: &generator) {
+                delta.append(("content", content))
+            }
+            if Bool.random(using: &generator) {
+                delta.append(("role", jsonString("assistant", using: &generator)))
+            }
+            if Bool.random(using: &generator) {
+                delta.append(("reasoning_content", randomString(using: &generator)))
+            }
+            let choice = [
+                ("index", "\(index)"),
+                ("delta", object(delta, using: &generator)),
+                ("logprobs", "null"),
+                ("finish_reason", Bool.random(using: &generator) ? "null" : jsonString("stop", using: &generator)),
+            ]
+            choices.append(object(choice, using: &generator))
+        }
+
+        let fields = [
+            ("id", randomString(using: &generator)),
+            ("object", jsonString("chat.completion.chunk", using: &generator)),
+            ("created", randomInteger(using: &generator)),
+            ("model", jsonString("deepseek-v4-flash", using: &generator)),
+            ("choices", array(choices, using: &generator)),
+        ]
+        return object(fields + extraFields(using: &generator), using: &generator)
+    }
+
+    private func cliPayload(using generator: inout SplitMix64) -> String {
+        // The runner's marker check expects CLIs to write event types unescaped.
+        let type = ["stream_event", "stream_event", "stream_event", "assistant", "result"]
+            .randomElement(using: &generator)!
+        var fields = [
+            ("type", "\"\(type)\""),
+            ("session_id", randomString(using: &generator)),
+            ("parent_tool_use_id", "null"),
+        ]
+
+        switch type {
+        case "stream_event":
+            let eventType = Int.random(in: 0 ..< 5, using: &generator) == 0 ? "message_start" : "content_block_delta"
+            let deltaType = Int.random(in: 0 ..< 5, using: &generator) == 0 ? "thinking_delta" : "text_delta"
+            var delta = [("type", "\"\(deltaType)\"")]
+            if let text = optionalDelta(using: &generator) {
+                delta.append(("text", text))
+            }
+            let event = [
+                ("type", "\"\(eventType)\""),
+                ("index", randomInteger(using: &generator)),
+                ("delta", object(delta, using: &generator)),
+            ]
+            fields.append(("event", object(event, using: &generator)))
+
+        case "assistant":
+            let content = object([
+                ("type", jsonString("text", using: &generator)),
+                ("text", randomString(using: &generator)),
+            ], using: &generator)
+            fields.append(("message", object([("content", array([content], using: &generator))], using: &generator)))
+
+        default:
+            let usage = [
+                ("input_tokens", randomInteger(using: &generator)),
+                ("cache_read_input_tokens", randomInteger(using: &generator)),
+                ("output_tokens", randomInteger(using: &generator)),
+            ]
+            fields += [
+                ("result", randomString(using: &generator)),
+                ("is_error", Bool.random(using: &generator) ? "true" : "false"),
+                ("usage", object(usage, using: &generator)),
+                ("total_cost_usd", randomDecimal(using: &generator)),
+                ("duration_ms", randomInteger(using: &generator)),
+            ]
+        }
+        return object(fields + extraFields(using: &generator), using: &generator)
+    }
+
+    // MARK: JSON Generation
+
+    /// A delta string, an explicit `null`, or `nil` to omit the field.
+    private func optionalDelta(using generator: inout SplitMix64) -> String? {
+        switch Int.random(in: 0 ..< 10, using: &generator) {
+        case 0: nil
+        case 1: "null"
+        default: randomString(using: &generator)
+        }
+    }
+
+    /// Fields no schema mentions, with arbitrary nested values.
+    private func extraFields(using generator: inout SplitMix64) -> [(String, String)] {
+        (0 ..< Int.random(in: 0 ... 3, using: &generator)).map { index in
+            ("extra_\(index)", randomValue(depth: 0, using: &generator))
+        }
+    }
+
+    private func randomValue(depth: Int, using generator: inout SplitMix64) -> String {
+        switch Int.random(in: 0 ..< (depth < 2 ? 8 : 6), using: &generator) {
+        case 0: return randomString(using: &generator)
+        case 1: return randomInteger(using: &generator)
+        case 2: return randomDecimal(using: &generator)
+        case 3: return Bool.random(using: &generator) ? "true" : "false"
+        case 4: return "null"
+        case 5: return Bool.random(using: &generator) ? "1.5e3" : "-2E-2"
+        case 6:
+            let elements = (0 ..< Int.random(in: 0 ... 3, using: &generator)).map { _ in
+                randomValue(depth: depth + 1, using: &generator)
+            }
+            return array(elements, using: &generator)
+        default:
+            let fields = (0 ..< Int.random(in: 0 ... 3, using: &generator)).map { index in
+                ("k\(index)", randomValue(depth: depth + 1, using: &generator))
+            }
+            return object(fields, using: &generator)
+        }
+    }
+
+    private func randomString(using generator: inout SplitMix64) -> String {
+        let text = (0 ..< Int.random(in: 0 ... 12, using: &generator))
+            .map { _ in textPieces.randomElement(using: &generator)! }
+            .joined()
+        return jsonString(text, using: &generator)
+    }
+
+    private func randomInteger(using generator: inout SplitMix64) -> String {
+        "\(Int.random(in: -1_000_000 ... 1_000_000_000, using: &generator))"
+    }
+
+    private func randomDecimal(using generator: inout SplitMix64) -> String {
+        "\(Int.random(in: -1000 ... 1000, using: &generator)).\(Int.random(in: 0 ... 99999, using: &generator))"
+    }
+
+    /// Encodes `text` as a JSON string, escaping characters in randomly chosen ways.
+    private func jsonString(_ text: String, using generator: inout SplitMix64) -> String {
+        var encoded = "\""
+        for scalar in text.unicodeScalars {
+            let escapesAsUnicode = Int.random(in: 0 ..< 6, using: &generator) == 0
+            let escapesSolidus = Bool.random(using: &generator)
+            switch scalar {
+            case "\"": encoded += #"\""#
+            case "\\": encoded += #"\\"#
+            case "/" where escapesSolidus: encoded += #"\/"#
+            case "\n" where !escapesAsUnicode: encoded += #"\n"#
+            case "\t" where !escapesAsUnicode: encoded += #"\t"#
+            default:
+                guard escapesAsUnicode || scalar.value < 0x20 else {
+                    encoded.unicodeScalars.append(scalar)
+                    continue
+                }
+                let uppercase = Bool.random(using: &generator)
+                for codeUnit in String(scalar).utf16 {
+                    encoded += #"\u"# + String(format: uppercase ? "%04X" : "%04x", UInt32(codeUnit))
+                }
+            }
+        }
+        return encoded + "\""
+    }
+
+    /// Builds an object in random key order. Keys stay unescaped, as providers send them.
+    private func object(_ fields: [(String, String)], using generator: inout SplitMix64) -> String {
+        let members = fields.shuffled(using: &generator).map { key, value in
+            "\"\(key)\"\(whitespace(using: &generator)):\(whitespace(using: &generator))\(value)"
+        }
+        return "{" + whitespace(using: &generator) + members.joined(separator: ",\(whitespace(using: &generator))")
+            + whitespace(using: &generator) + "}"
+    }
+
+    private func array(_ elements: [String], using generator: inout SplitMix64) -> String {
+        "[" + elements.joined(separator: ",\(whitespace(using: &generator))") + whitespace(using: &generator) + "]"
+    }
+
+    private func whitespace(using generator: inout SplitMix64) -> String {
+        guard Int.random(in: 0 ..< 4, using: &generator) == 0 else { return "" }
+        return ["", " ", "\n", "\t", "\r\n  "].randomElement(using: &generator)!
+    }
+
+    /// Truncates the payload or overwrites one ASCII byte, keeping the bytes valid UTF-8.
+    private func mutate(_ payload: Data, using generator: inout SplitMix64) -> Data {
+        var bytes = [UInt8](payload)
+        if Bool.random(using: &generator) {
+            return Data(bytes.prefix(Int.random(in: 0 ..< bytes.count, using: &generator)))
+        }
+        let asciiIndices = bytes.indices.filter { bytes[$0] < 0x80 }
+        let replacements = Array(#"{}[]":,\ /0159-.eEnultrfabxuD"#.utf8)
+        bytes[asciiIndices.randomElement(using: &generator)!] = replacements.randomElement(using: &generator)!
+        return Data(bytes)
+    }
+}
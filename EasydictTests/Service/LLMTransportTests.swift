@@ -0,0 +1,53 @@
+//
+//  LLMTransportTests.swift
+//  EasydictTests
+//
+//  Created by tisfeng on 2026/10/19.
+//  Copyright © 2026 izual. All rights reserved.
+//
+
+import Foundation
+import Testing
+
+@testable import Easydict
+
+/// Unit tests for per-host session pooling in `LLMTransport`.
+@Suite("LLM Transport", .tags(.unit))
+struct LLMTransportTests {
+    /// Verifies that endpoints on the same host share one pooled session.
+    @Test("Endpoints on the same host share a session")
+    func sameHostSharesSession() throws {
+        let transport = LLMTransport.shared
+        let chatURL = try #require(URL(string: "https://api.deepseek.com/chat/completions"))
+        let modelsURL = try #require(URL(string: "https://API.deepseek.com/models"))
+
+        #expect(transport.session(for: chatURL) === transport.session(for: modelsURL))
+    }
+
+    /// Verifies that different hosts and ports are isolated from each other.
+    @Test("Different hosts and ports use separate sessions")
+    func differentHostsUseSeparateSessions() throws {
+        let transport = LLMTransport.shared
+        let groqURL = try #require(URL(string: "https://api.groq.com/openai/v1/chat/completions"))
+        let zhipuURL = try #require(URL(string: "https://open.bigmodel.cn/api/paas/v4/chat/completions"))
+        let ollamaURL = try #require(URL(string: "http://localhost:11434/v1/chat/completions"))
+        let otherOllamaURL = try #require(URL(string: "http://localhost:11435/v1/chat/completions"))
+
+        #expect(transport.session(for: groqURL) !== transport.session(for: zhipuURL))
+        #expect(transport.session(for: ollamaURL) !== transport.session(for: otherOllamaURL))
+    }
+
+    /// Verifies reuse ratios are derived from reused and new connection counts.
+    @Test("Statistics report reuse ratio and average connect time")
+    func statisticsReportReuseRatio() {
+        var statistics = LLMTransportStatistics()
+        #expect(statistics.reuseRatio == 0)
+
+        statistics.newConnectionCount = 1
+        statistics.totalConnectMilliseconds = 120
+        statistics.reusedConnectionCount = 3
+
+        #expect(statistics.reuseRatio == 0.75)
+        #expect(statistics.averageConnectMilliseconds == 120)
+    }
+}
@@ -0,0 +1,266 @@
+//
+//  LongTextSegmenterTests.swift
+//  EasydictTests
+//
+//  Created by tisfeng on 2026/10/19.
+//  Copyright © 2026 izual. All rights reserved.
+//
+
+import Defaults
+import Foundation
+import Testing
+
+@testable import Easydict
+
+/// Unit tests for long-text chunking, ordered reassembly and chunk retries.
+@Suite("Long Text Segmenter", .tags(.unit), .serialized)
+struct LongTextSegmenterTests {
+    // MARK: Internal
+
+    /// Verifies paragraphs are grouped up to the chunk limit without splitting them.
+    @Test("Paragraphs are grouped within the chunk limit")
+    func paragraphsAreGrouped() {
+        let paragraph = String(repeating: "a", count: 40)
+        let text = Array(repeating: paragraph, count: 5).joined(separator: "\n")
+        let segmenter = LongTextSegmenter(maxChunkLength: 100, minChunkLength: 10)
+
+        let chunks = segmenter.chunks(for: text)
+
+        #expect(chunks.map(\.text) == [
+            "\(paragraph)\n\(paragraph)",
+            "\(paragraph)\n\(paragraph)",
+            paragraph,
+        ])
+        #expect(chunks.map(\.separator) == ["", "\n", "\n"])
+    }
+
+    /// Verifies overlong paragraphs are split between sentences.
+    @Test("Overlong paragraphs are split at sentence boundaries")
+    func longParagraphIsSplitBySentence() {
+        let sentence = "This sentence is exactly forty chars ok."
+        let text = Array(repeating: sentence, count: 4).joined(separator: " ")
+        let segmenter = LongTextSegmenter(maxChunkLength: 90, minChunkLength: 10)
+
+        let chunks = segmenter.chunks(for: text)
+
+        #expect(chunks.count == 2)
+        #expect(chunks.allSatisfy { $0.text.count <= 90 })
+        #expect(chunks.last?.separator == " ")
+        #expect(chunks.map(\.text).joined(separator: " ") == text)
+    }
+
+    /// Verifies a short trailing chunk is folded into the previous one.
+    @Test("Short trailing chunk is merged")
+    func shortTrailingChunkIsMerged() {
+        let paragraph = String(repeating: "b", count: 90)
+        let text = "\(paragraph)\n\nend"
+        let segmenter = LongTextSegmenter(maxChunkLength: 90, minChunkLength: 10)
+
+        let chunks = segmenter.chunks(for: text)
+
+        #expect(chunks == [LongTextChunk(text: text, separator: "")])
+    }
+
+    /// Verifies a short heading is not sent alone when the paragraph after it fills a chunk.
+    @Test("Short heading is merged with the long paragraph after it")
+    func shortHeadingIsMerged() {
+        let heading = "# Title"
+        let paragraph = String(repeating: "c", count: 90)
+        let text = "\(heading)\n\(paragraph)\n\(paragraph)"
+        let segmenter = LongTextSegmenter(maxChunkLength: 90, minChunkLength: 10)
+
+        let chunks = segmenter.chunks(for: text)
+
+        #expect(chunks == [
+            LongTextChunk(text: "\(heading)\n\(paragraph)", separator: ""),
+            LongTextChunk(text: paragraph, separator: "\n"),
+        ])
+    }
+
+    /// Verifies out-of-order completion is revealed only in source order.
+    @Test("Assembler reveals chunks in source order")
+    func assemblerKeepsSourceOrder() {
+        let chunks = [
+            LongTextChunk(text: "one", separator: ""),
+            LongTextChunk(text: "two", separator: "\n"),
+            LongTextChunk(text: "three", separator: "\n"),
+        ]
+        var assembler = LongTextAssembler(chunks: chunks)
+
+        assembler.append("二", toChunk: 1)
+        assembler.finishChunk(1)
+        assembler.append("一", toChunk: 0)
+        #expect(assembler.visibleText == "一")
+
+        assembler.finishChunk(0)
+        #expect(assembler.visibleText == "一\n二")
+
+        assembler.append("错", toChunk: 2)
+        assembler.resetChunk(2)
+        assembler.append("三", toChunk: 2)
+        #expect(assembler.visibleText == "一\n二\n三")
+        #expect(!assembler.isComplete)
+
+        assembler.finishChunk(2)
+        #expect(assembler.isComplete)
+        #expect(assembler.committedText == "一\n二\n三")
+    }
+
+    /// Verifies partial output of the head chunk is trimmed like committed output.
+    @Test("Assembler trims partial output")
+    func assemblerTrimsPartialOutput() {
+        let chunks = [
+            LongTextChunk(text: "one", separator: ""),
+            LongTextChunk(text: "two", separator: "\n"),
+        ]
+        var assembler = LongTextAssembler(chunks: chunks)
+
+        assembler.append("\n 一 ", toChunk: 0)
+        #expect(assembler.visibleText == "一")
+
+        assembler.finishChunk(0)
+        assembler.append("  二", toChunk: 1)
+        #expect(assembler.visibleText == "一\n二")
+    }
+
+    /// Verifies only transient errors are retried.
+    @Test("Only transient chunk errors are retried")
+    func retryableChunkErrors() {
+        #expect(StreamService.isRetryableChunkError(URLError(.timedOut)))
+        #expect(StreamService.isRetryableChunkError(URLError(.networkConnectionLost)))
+        #expect(StreamService.isRetryableChunkError(QueryError.timeoutError))
+        #expect(StreamService.isRetryableChunkError(QueryError.httpError(statusCode: 429)))
+        #expect(StreamService.isRetryableChunkError(QueryError.httpError(statusCode: 503)))
+
+        #expect(!StreamService.isRetryableChunkError(URLError(.cancelled)))
+        #expect(!StreamService.isRetryableChunkError(QueryError.httpError(statusCode: 401)))
+        #expect(!StreamService.isRetryableChunkError(QueryError(type: .missingSecretKey)))
+    }
+
+    /// Verifies a chunk that fails once is retried alone while the others run concurrently.
+    @Test("Concurrent chunks recover from a transient failure")
+    func transientChunkFailureIsRetried() async throws {
+        try await withChunkedTranslationEnabled {
+            let service = ScriptedChunkService()
+            service.failures = ["beta": [QueryError.httpError(statusCode: 503)]]
+
+            let texts = try await translate(longText, with: service)
+
+            #expect(texts.last == "ALPHA done\nBETA done\nGAMMA done")
+            #expect(service.attemptCounts == ["alpha": 1, "beta": 2, "gamma": 1])
+            #expect(!service.queryTypes.isEmpty && service.queryTypes.allSatisfy { $0 == .translation })
+            #expect(texts.allSatisfy { !$0.hasPrefix(" ") && !$0.contains("\n ") })
+        }
+    }
+
+    /// Verifies a permanent error fails the translation without retrying the chunk.
+    @Test("Permanent chunk errors are not retried")
+    func permanentChunkFailureIsNotRetried() async throws {
+        try await withChunkedTranslationEnabled {
+            let service = ScriptedChunkService()
+            service.failures = ["beta": [QueryError.httpError(statusCode: 401)]]
+
+            await #expect(throws: QueryError.self) {
+                _ = try await translate(longText, with: service)
+            }
+            #expect(service.attemptCounts["beta"] == 1)
+        }
+    }
+
+    // MARK: Private
+
+    /// Streams canned translations, failing a chunk's first attempts with scripted errors.
+    private final class ScriptedChunkService: StreamService {
+        // MARK: Internal
+
+        /// Errors thrown by the next attempts of a chunk, keyed by the chunk's first word.
+        var failures: [String: [Error]] {
+            get { lock.withLock { scriptedFailures } }
+            set { lock.withLock { scriptedFailures = newValue } }
+        }
+
+        /// Attempts per chunk, keyed by the chunk's first word.
+        var attemptCounts: [String: Int] {
+            lock.withLock { attempts }
+        }
+
+        /// Query types the chunks were sent as.
+        var queryTypes: [EZQueryTextType] {
+            lock.withLock { sentQueryTypes }
+        }
+
+        override var longTextConcurrencyLimit: Int {
+            3
+        }
+
+        override func serviceType() -> ServiceType {
+            .openAI
+        }
+
+        override func coalescingKey(
+            text: String,
+            from: Language,
+            to: Language,
+            queryType: EZQueryTextType
+        )
+            -> String? {
+            nil
+        }
+
+        override func contentStreamTranslate(
+            _ text: String,
+            from: Language,
+            to: Language,
+            queryType: EZQueryTextType
+        )
+            -> AsyncThrowingStream<String, Error> {
+            let word = String(text.prefix { $0 != " " })
+            let failure = lock.withLock { () -> Error? in
+                attempts[word, default: 0] += 1
+                sentQueryTypes.append(queryType)
+                guard scriptedFailures[word]?.isEmpty == false else { return nil }
+                return scriptedFailures[word]?.removeFirst()
+            }
+
+            return AsyncThrowingStream { continuation in
+                continuation.yield("  \(word.uppercased())")
+                if let failure {
+                    continuation.finish(throwing: failure)
+                } else {
+                    continuation.yield(" done\n")
+                    continuation.finish()
+                }
+            }
+        }
+
+        // MARK: Private
+
+        private let lock = NSLock()
+        private var scriptedFailures: [String: [Error]] = [:]
+        private var attempts: [String: Int] = [:]
+        private var sentQueryTypes: [EZQueryTextType] = []
+    }
+
+    /// Three paragraphs that become one chunk each.
+    private var longText: String {
+        ["alpha", "beta", "gamma"]
+            .map { String(repeating: "\($0) ", count: 250).trimmingCharacters(in: .whitespaces) }
+            .joined(separator: "\n")
+    }
+
+    private func translate(_ text: String, with service: StreamService) async throws -> [String] {
+        var texts: [String] = []
+        let stream = service.translatedTextStream(text, from: .english, to: .simplifiedChinese, queryType: .translation)
+        for try await text in stream {
+            texts.append(text)
+        }
+        return texts
+    }
+
+    private func withChunkedTranslationEnabled(_ body: () async throws -> ()) async throws {
+        let previousValue = Defaults[.enableLongTextChunkedTranslation]
+        Defaults[.enableLongTextChunkedTranslation] = true
+        defer { Defaults[.enableLongTextChunkedTranslation] = previousValue }
+        try await body()
+    }
+}
@@ -0,0 +1,75 @@
+//
+//  PromptPrefixCacheTests.swift
+//  EasydictTests
+//
+//  Created by tisfeng on 2026/10/19.
+//  Copyright © 2026 izual. All rights reserved.
+//
+
+import Foundation
+import Testing
+
+@testable import Easydict
+
+/// Unit tests for the memoized, cacheable prompt prefix of built-in LLM prompts.
+@Suite("Prompt Prefix Cache", .tags(.unit))
+struct PromptPrefixCacheTests {
+    /// Verifies that queries of the same language pair share a byte-identical prefix.
+    @Test("Translation prefix is identical across queries")
+    func translationPrefixIsStable() {
+        let service = OpenAIService()
+        let first = service.translationMessages(chatQuery(text: "Hello world"))
+        let second = service.translationMessages(chatQuery(text: "A completely different sentence"))
+
+        #expect(first.count == second.count)
+        #expect(Array(first.dropLast()) == Array(second.dropLast()))
+        #expect(first.last?.role == .user)
+        #expect(first.last != second.last)
+    }
+
+    /// Verifies that only the final prefix message is marked for provider caching.
+    @Test("Last prefix message is the cache breakpoint")
+    func lastPrefixMessageIsBreakpoint() {
+        let service = OpenAIService()
+        let messages = service.translationMessages(chatQuery(text: "cache"))
+
+        #expect(messages.filter(\.isCacheBreakpoint).count == 1)
+        #expect(messages.dropLast().last?.isCacheBreakpoint == true)
+        #expect(messages.last?.isCacheBreakpoint == false)
+    }
+
+    /// Verifies a prefix is rendered once per key.
+    @Test("Prefix is rendered once per key")
+    func prefixIsRenderedOnce() {
+        let cache = PromptPrefixCache.shared
+        let key = PromptPrefixKey(
+            queryType: .translation,
+            sourceLanguage: .japanese,
+            targetLanguage: .korean,
+            answerLanguage: .english,
+            enableSystemPrompt: false
+        )
+        var renderCount = 0
+        let render = {
+            renderCount += 1
+            return [ChatMessage(role: .user, content: "prefix")]
+        }
+
+        _ = cache.messages(for: key, render: render)
+        _ = cache.messages(for: key, render: render)
+
+        #expect(renderCount == 1)
+    }
+
+    // MARK: Private
+
+    private func chatQuery(text: String) -> ChatQueryParam {
+        ChatQueryParam(
+            text: text,
+            sourceLanguage: .english,
+            targetLanguage: .simplifiedChinese,
+            queryType: .translation,
+            enableSystemPrompt: true
+        )
+    }
+}
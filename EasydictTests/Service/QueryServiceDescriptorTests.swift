@@ -0,0 +1,76 @@
+//
+//  QueryServiceDescriptorTests.swift
+//  EasydictTests
+//
+//  Created by tisfeng on 2026/10/19.
+//  Copyright © 2026 izual. All rights reserved.
+//
+
+import Foundation
+import Testing
+
+@testable import Easydict
+
+// MARK: - QueryServiceDescriptorTests
+
+@Suite("Query Service Descriptor", .tags(.unit))
+struct QueryServiceDescriptorTests {
+    @Test("Descriptors match the stored services without creating them", .tags(.unit))
+    func descriptorsMatchServices() {
+        let storage = LocalStorage.shared()
+        let descriptors = storage.allServiceDescriptors(.mini)
+        let services = storage.allServices(.mini)
+
+        #expect(descriptors.map(\.serviceTypeId) == services.map { $0.serviceTypeWithUniqueIdentifier() })
+        #expect(descriptors.map(\.enabled) == services.map(\.enabled))
+        #expect(descriptors.map(\.enabledQuery) == services.map(\.enabledQuery))
+        #expect(descriptors.allSatisfy { !$0.isInstantiated })
+    }
+
+    @Test("The service is created once with the stored state", .tags(.unit))
+    func serviceIsCreatedOnce() throws {
+        let descriptor = QueryServiceDescriptor(
+            serviceTypeId: "\(ServiceType.deepL.rawValue)#1234",
+            serviceType: .deepL,
+            uuid: "1234",
+            windowType: .fixed,
+            enabled: true,
+            enabledQuery: false
+        )
+
+        let service = descriptor.service
+        #expect(descriptor.isInstantiated)
+        #expect(descriptor.service === service)
+        #expect(service is DeepLService)
+        #expect(service.uuid == "1234")
+        #expect(service.windowType == .fixed)
+        #expect(!service.enabledQuery)
+    }
+
+    /// Compares the services a query window used to create on open with the enabled ones it
+    /// creates now. The configuration snapshot is warmed first, so only creation is timed.
+    @Test("Benchmark window service setup", .tags(.performance))
+    func benchmarkWindowServiceSetup() {
+        let storage = LocalStorage.shared()
+        let iterations = 20
+        _ = storage.allServiceDescriptors(.mini)
+
+        let allStart = Date()
+        for _ in 0 ..< iterations {
+            _ = storage.allServices(.mini)
+        }
+        let allDuration = Date().timeIntervalSince(allStart) / Double(iterations)
+
+        let enabledStart = Date()
+        var enabledCount = 0
+        for _ in 0 ..< iterations {
+            enabledCount = storage.enabledServices(.mini).count
+        }
+        let enabledDuration = Date().timeIntervalSince(enabledStart) / Double(iterations)
+
+        print(
+            "Window services: all \(storage.allServiceTypes(.mini).count) in \(String(format: "%.2f", allDuration * 1000)) ms, "
+                + "enabled \(enabledCount) in \(String(format: "%.2f", enabledDuration * 1000)) ms"
+        )
+    }
+}
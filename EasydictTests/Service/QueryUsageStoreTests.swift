@@ -0,0 +1,76 @@
+//
+//  QueryUsageStoreTests.swift
+//  EasydictTests
+//
+//  Created by tisfeng on 2026/10/19.
+//  Copyright © 2026 izual. All rights reserved.
+//
+
+import Foundation
+import Testing
+
+@testable import Easydict
+
+// MARK: - QueryUsageStoreTests
+
+@Suite("Query Usage Store", .tags(.unit))
+struct QueryUsageStoreTests {
+    // MARK: Internal
+
+    @Test("Counts queries in memory and writes them on flush", .tags(.unit))
+    func writesOnFlush() throws {
+        let userDefaults = try makeUserDefaults()
+        let store = QueryUsageStore(userDefaults: userDefaults, flushInterval: 60)
+
+        for _ in 0 ..< 10 {
+            store.recordQuery(characterCount: 5)
+            store.recordQuery(of: .deepL, characterCount: 5)
+            store.recordQuery(of: .google, characterCount: 5)
+        }
+
+        #expect(store.totalUsage == .init(queryCount: 10, queryCharacterCount: 50))
+        #expect(store.usage(of: .deepL) == .init(queryCount: 10, queryCharacterCount: 50))
+        #expect(store.usage(of: .bing) == .init())
+        #expect(userDefaults.object(forKey: "kQueryCountKey") == nil)
+
+        store.flush()
+        #expect(userDefaults.integer(forKey: "kQueryCountKey") == 10)
+        #expect(userDefaults.integer(forKey: "kQueryCharacterCountKey") == 50)
+
+        let reloaded = QueryUsageStore(userDefaults: userDefaults)
+        #expect(reloaded.totalUsage == store.totalUsage)
+        #expect(reloaded.usage(of: .google) == .init(queryCount: 10, queryCharacterCount: 50))
+    }
+
+    @Test("Reports the count before and after a query", .tags(.unit))
+    func reportsQueryCounts() throws {
+        let store = try QueryUsageStore(userDefaults: makeUserDefaults(), flushInterval: 60)
+        store.totalUsage.queryCount = 99
+
+        let counts = store.recordQuery(characterCount: 1)
+        #expect(counts.previousCount == 99)
+        #expect(counts.newCount == 100)
+    }
+
+    @Test("Discarding drops unwritten changes", .tags(.unit))
+    func discardsPendingWrites() throws {
+        let userDefaults = try makeUserDefaults()
+        let store = QueryUsageStore(userDefaults: userDefaults, flushInterval: 60)
+
+        store.recordQuery(of: .deepL, characterCount: 5)
+        store.discardPendingWrites()
+        store.flush()
+
+        #expect(store.usage(of: .deepL) == .init())
+        #expect(userDefaults.dictionary(forKey: "kQueryServiceRecordKey") == nil)
+    }
+
+    // MARK: Private
+
+    private func makeUserDefaults() throws -> UserDefaults {
+        let suiteName = "QueryUsageStoreTests-\(UUID().uuidString)"
+        let userDefaults = try #require(UserDefaults(suiteName: suiteName))
+        userDefaults.removePersistentDomain(forName: suiteName)
+        return userDefaults
+    }
+}
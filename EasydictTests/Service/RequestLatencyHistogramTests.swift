@@ -0,0 +1,61 @@
+//
+//  RequestLatencyHistogramTests.swift
+//  EasydictTests
+//
+//  Created by tisfeng on 2026/10/19.
+//  Copyright © 2026 izual. All rights reserved.
+//
+
+import Foundation
+import Testing
+
+@testable import Easydict
+
+/// Unit tests for per-service latency histograms used by hedged requests.
+@Suite("Request Latency Histogram", .tags(.unit))
+struct RequestLatencyHistogramTests {
+    /// Verifies percentiles fall inside the bucket that holds them.
+    @Test("Percentiles are interpolated within buckets")
+    func percentilesAreInterpolated() {
+        var histogram = RequestLatencyHistogram()
+        for _ in 0 ..< 90 {
+            histogram.record(milliseconds: 150)
+        }
+        for _ in 0 ..< 10 {
+            histogram.record(milliseconds: 2500, hedged: true, hedgeWon: true)
+        }
+
+        #expect((100 ... 200).contains(histogram.percentile(0.5)))
+        #expect((2000 ... 2500).contains(histogram.percentile(0.95)))
+        #expect(histogram.percentile(1) == 2500)
+        #expect(histogram.hedgedCount == 10)
+        #expect(histogram.hedgeWinCount == 10)
+    }
+
+    /// Verifies the overflow bucket reports the largest observed latency.
+    @Test("Overflow bucket reports the maximum")
+    func overflowBucketReportsMaximum() {
+        var histogram = RequestLatencyHistogram()
+        histogram.record(milliseconds: 30000)
+
+        #expect(histogram.percentile(0.95) == 30000)
+    }
+
+    /// Verifies hedge delays use a default until enough samples exist, then follow p95.
+    @Test("Hedge delay follows p95 within bounds")
+    func hedgeDelayFollowsP95() {
+        let recorder = RequestLatencyRecorder.shared
+        let label = "test-\(UUID().uuidString)"
+        #expect(recorder.hedgeDelay(for: label) == 1.0)
+
+        for _ in 0 ..< 40 {
+            recorder.record(label, milliseconds: 40)
+        }
+        #expect(recorder.hedgeDelay(for: label) == 0.3)
+
+        for _ in 0 ..< 400 {
+            recorder.record(label, milliseconds: 20000)
+        }
+        #expect(recorder.hedgeDelay(for: label) == 3.0)
+    }
+}
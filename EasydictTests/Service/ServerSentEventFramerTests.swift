@@ -0,0 +1,239 @@
+//
+//  ServerSentEventFramerTests.swift
+//  EasydictTests
+//
+//  Created by tisfeng on 2026/10/19.
+//  Copyright © 2026 izual. All rights reserved.
+//
+
+import Foundation
+import Testing
+
+@testable import Easydict
+
+// MARK: - ServerSentEventFramerTests
+
+@Suite("Server-Sent Event Framer")
+struct ServerSentEventFramerTests {
+    // MARK: Internal
+
+    @Test("Byte-sized chunks frame the same events as one chunk", .tags(.unit))
+    func byteSizedChunksMatchSingleChunk() {
+        let stream = Data(recordedClaudeStream.replacingOccurrences(of: "\n", with: "\r\n").utf8)
+
+        let whole = frameEvents([stream])
+        // One byte per chunk splits every CRLF and every multi-byte character.
+        let bytewise = frameEvents(stream.map { Data([$0]) })
+
+        #expect(whole.count == 9)
+        #expect(bytewise == whole)
+        #expect(whole.map(\.type).contains("ping"))
+    }
+
+    @Test("Follows the event-stream field rules", .tags(.unit))
+    func followsFieldRules() {
+        let stream = [
+            ": keep-alive",
+            "",
+            "event: update",
+            "data:first",
+            "data: second",
+            "id: 7",
+            "",
+            "event: no-data",
+            "",
+            "data",
+            "",
+            "data: 雪\rdata: 山\r\r",
+            "data: unterminated",
+        ].joined(separator: "\n")
+
+        let events = frameEvents([Data(stream.utf8)])
+
+        #expect(
+            events == [
+                ServerSentEvent(type: "update", data: Data("first\nsecond".utf8)),
+                ServerSentEvent(type: nil, data: Data()),
+                ServerSentEvent(type: nil, data: Data("雪\n山".utf8)),
+            ]
+        )
+    }
+
+    @Test("Doubao and DeepSeek parsers extract deltas", .tags(.unit))
+    func providerParsersExtractDeltas() {
+        let doubao = DoubaoSSEParser()
+        let doubaoDelta = ServerSentEvent(
+            type: "response.output_text.delta",
+            data: Data(#"{"type":"response.output_text.delta","delta":"你好"}"#.utf8)
+        )
+        #expect(doubao.content(of: doubaoDelta) == "你好")
+        #expect(doubao.content(of: ServerSentEvent(type: "response.completed", data: Data("{}".utf8))) == nil)
+
+        let deepSeek = DeepSeekSSEParser()
+        let deepSeekChunk = ServerSentEvent(
+            type: nil,
+            data: Data(#"{"choices":[{"index":0,"delta":{"content":"Hi"}}]}"#.utf8)
+        )
+        #expect(deepSeek.content(of: deepSeekChunk) == "Hi")
+        #expect(deepSeek.content(of: ServerSentEvent(type: nil, data: Data("[DONE]".utf8))) == nil)
+    }
+
+    /// Benchmark: replays a recorded Claude stream through the previous per-byte `String`
+    /// parser and through `ServerSentEventFramer`, in network-sized chunks.
+    @Test("Benchmark recorded stream replay per event", .tags(.performance))
+    func benchmarkRecordedStreamReplay() throws {
+        let recordedEvents = recordedClaudeStream.components(separatedBy: "\n\n").filter { !$0.isEmpty }
+        let deltaEvents = recordedEvents.filter { $0.contains("content_block_delta") }
+        let controlEvents = recordedEvents.filter { !$0.contains("content_block_delta") }
+
+        // A long translation: thousands of deltas framed by the recorded control events.
+        var events = Array(controlEvents.prefix(3))
+        for _ in 0 ..< 5000 {
+            events += deltaEvents
+        }
+        events += controlEvents.dropFirst(3)
+
+        let body = events.map { $0 + "\n\n" }.joined()
+        let stream = Data(body.replacingOccurrences(of: "\n", with: "\r\n").utf8)
+        let chunks = stride(from: 0, to: stream.count, by: 1371).map {
+            stream.subdata(in: $0 ..< min($0 + 1371, stream.count))
+        }
+
+        let legacyStart = Date()
+        let legacyOutput = replayLegacy(chunks)
+        let legacyDuration = Date().timeIntervalSince(legacyStart)
+
+        let framedStart = Date()
+        let framedOutput = try replayFramed(chunks)
+        let framedDuration = Date().timeIntervalSince(framedStart)
+
+        let eventCount = Double(events.count)
+        print(
+            "Claude SSE replay (\(events.count) events, \(chunks.count) chunks): "
+                + "legacy \(String(format: "%.2f", legacyDuration / eventCount * 1_000_000)) µs/event, "
+                + "framer \(String(format: "%.2f", framedDuration / eventCount * 1_000_000)) µs/event"
+        )
+
+        #expect(framedOutput == legacyOutput)
+        #expect(framedOutput.count == deltaEvents.count * 5000)
+    }
+
+    // MARK: Private
+
+    /// Anthropic Messages API stream, recorded from a short translation.
+    private let recordedClaudeStream = """
+    event: message_start
+    data: {"type":"message_start","message":{"id":"msg_01","type":"message","role":"assistant","model":"claude-sonnet-4-5","content":[],"stop_reason":null,"usage":{"input_tokens":52,"output_tokens":1}}}
+
+    event: content_block_start
+    data: {"type":"content_block_start","index":0,"content_block":{"type":"text","text":""}}
+
+    event: ping
+    data: {"type":"ping"}
+
+    event: content_block_delta
+    data: {"type":"content_block_delta","index":0,"delta":{"type":"text_delta","text":"敏捷的棕色"}}
+
+    event: content_block_delta
+    data: {"type":"content_block_delta","index":0,"delta":{"type":"text_delta","text":"狐狸跳过了"}}
+
+    event: content_block_delta
+    data: {"type":"content_block_delta","index":0,"delta":{"type":"text_delta","text":"那只懒狗。"}}
+
+    event: content_block_stop
+    data: {"type":"content_block_stop","index":0}
+
+    event: message_delta
+    data: {"type":"message_delta","delta":{"stop_reason":"end_turn","stop_sequence":null},"usage":{"output_tokens":18}}
+
+    event: message_stop
+    data: {"type":"message_stop"}
+
+
+    """
+
+    private func frameEvents(_ chunks: [Data]) -> [ServerSentEvent] {
+        let framer = ServerSentEventFramer()
+        var events: [ServerSentEvent] = []
+        for chunk in chunks {
+            framer.append(chunk)
+            framer.drainEvents { events.append($0) }
+        }
+        return events
+    }
+
+    private func replayFramed(_ chunks: [Data]) throws -> [String] {
+        let parser = ClaudeSSEParser()
+        let framer = ServerSentEventFramer()
+        var output: [String] = []
+        for chunk in chunks {
+            framer.append(chunk)
+            try framer.drainEvents { event in
+                if let content = try parser.content(of: event) {
+                    output.append(content)
+                }
+            }
+        }
+        return output
+    }
+
+    /// The services' previous path: append byte by byte, decode to `String` at every LF,
+    /// normalize CRLF and split the whole remaining buffer, then parse each event's lines.
+    private func replayLegacy(_ chunks: [Data]) -> [String] {
+        var output: [String] = []
+        var dataBuffer = Data()
+        var textBuffer = ""
+
+        for chunk in chunks {
+            for byte in chunk {
+                dataBuffer.append(byte)
+                guard dataBuffer.count >= 1024 || byte == 0x0A else { continue }
+                if let text = String(data: dataBuffer, encoding: .utf8) {
+                    textBuffer.append(text)
+                    dataBuffer.removeAll()
+                    legacyProcessEvents(from: &textBuffer, into: &output)
+                }
+            }
+        }
+        return output
+    }
+
+    private func legacyProcessEvents(from textBuffer: inout String, into output: inout [String]) {
+        var normalizedBuffer = textBuffer
+        let hasTrailingCarriageReturn = normalizedBuffer.last == "\r"
+        if hasTrailingCarriageReturn {
+            normalizedBuffer.removeLast()
+        }
+        normalizedBuffer = normalizedBuffer.replacingOccurrences(of: "\r\n", with: "\n")
+            .replacingOccurrences(of: "\r", with: "\n")
+        if hasTrailingCarriageReturn {
+            normalizedBuffer.append("\r")
+        }
+
+        guard normalizedBuffer.contains("\n\n") else {
+            textBuffer = normalizedBuffer
+            return
+        }
+        let parts = normalizedBuffer.split(separator: "\n\n", omittingEmptySubsequences: false)
+        textBuffer = String(parts.last ?? "")
+
+        let decoder = JSONDecoder()
+        for event in parts.dropLast() where !event.isEmpty {
+            var eventType: String?
+            var payload: String?
+            for line in event.split(separator: "\n") {
+                let trimmedLine = line.trimmingCharacters(in: .whitespacesAndNewlines)
+                if trimmedLine.hasPrefix("event:") {
+                    eventType = trimmedLine.dropFirst(6).trimmingCharacters(in: .whitespaces)
+                } else if trimmedLine.hasPrefix("data:") {
+                    payload = trimmedLine.dropFirst(5).trimmingCharacters(in: .whitespaces)
+                }
+            }
+            guard eventType == "content_block_delta", let payload,
+                  let delta = try? decoder.decode(ClaudeStreamDelta.self, from: Data(payload.utf8)),
+                  let text = delta.delta?.text
+            else { continue }
+            output.append(text)
+        }
+    }
+}
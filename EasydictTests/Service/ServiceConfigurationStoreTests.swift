@@ -0,0 +1,91 @@
+//
+//  ServiceConfigurationStoreTests.swift
+//  EasydictTests
+//
+//  Created by tisfeng on 2026/10/19.
+//  Copyright © 2026 izual. All rights reserved.
+//
+
+import Foundation
+import Testing
+
+@testable import Easydict
+
+// MARK: - ServiceConfigurationStoreTests
+
+@Suite("Service Configuration Store", .tags(.unit))
+struct ServiceConfigurationStoreTests {
+    // MARK: Internal
+
+    @Test("Stored data is decoded once per key", .tags(.unit))
+    func decodesOncePerKey() throws {
+        let userDefaults = try makeUserDefaults()
+        let store = ServiceConfigurationStore(userDefaults: userDefaults)
+        userDefaults.set(try JSONEncoder().encode(deepL.configuration), forKey: "deepL")
+
+        var decodeCount = 0
+        let decode = { (data: Data) -> ServiceConfigurationStore.Entry? in
+            decodeCount += 1
+            return (try? JSONDecoder().decode(QueryServiceConfiguration.self, from: data))
+                .map(ServiceConfigurationStore.Entry.init)
+        }
+
+        for _ in 0 ..< 100 {
+            #expect(store.entry(forKey: "deepL", decode: decode) == deepL)
+            #expect(store.entry(forKey: "missing", decode: decode) == nil)
+        }
+        #expect(decodeCount == 1)
+    }
+
+    @Test("Writes are coalesced and flushed to UserDefaults", .tags(.unit))
+    func coalescesWrites() throws {
+        let userDefaults = try makeUserDefaults()
+        let store = ServiceConfigurationStore(userDefaults: userDefaults, flushDelay: 60)
+
+        var entry = deepL
+        for index in 0 ..< 10 {
+            entry.enabledQuery = index.isMultiple(of: 2)
+            store.set(entry, forKey: "deepL")
+        }
+
+        #expect(userDefaults.data(forKey: "deepL") == nil)
+        #expect(store.entry(forKey: "deepL") { _ in nil } == entry)
+
+        store.flush()
+        let data = try #require(userDefaults.data(forKey: "deepL"))
+        let stored = try JSONDecoder().decode(QueryServiceConfiguration.self, from: data)
+        #expect(ServiceConfigurationStore.Entry(stored) == entry)
+    }
+
+    @Test("Changes made outside the store are picked up", .tags(.unit))
+    func revalidatesExternalChanges() throws {
+        let userDefaults = try makeUserDefaults()
+        let store = ServiceConfigurationStore(userDefaults: userDefaults)
+        let decode = { (data: Data) -> ServiceConfigurationStore.Entry? in
+            (try? JSONDecoder().decode(QueryServiceConfiguration.self, from: data))
+                .map(ServiceConfigurationStore.Entry.init)
+        }
+
+        #expect(store.entry(forKey: "deepL", decode: decode) == nil)
+
+        // Posts `UserDefaults.didChangeNotification`.
+        userDefaults.set(try JSONEncoder().encode(deepL.configuration), forKey: "deepL")
+        #expect(store.entry(forKey: "deepL", decode: decode) == deepL)
+
+        userDefaults.removeObject(forKey: "deepL")
+        #expect(store.entry(forKey: "deepL", decode: decode) == nil)
+    }
+
+    // MARK: Private
+
+    private let deepL = ServiceConfigurationStore.Entry(
+        QueryServiceConfiguration(uuid: "", type: .deepL, enabled: true, enabledQuery: false, windowType: .mini)
+    )
+
+    private func makeUserDefaults() throws -> UserDefaults {
+        let suiteName = "ServiceConfigurationStoreTests-\(UUID().uuidString)"
+        let userDefaults = try #require(UserDefaults(suiteName: suiteName))
+        userDefaults.removePersistentDomain(forName: suiteName)
+        return userDefaults
+    }
+}
@@ -0,0 +1,145 @@
+//
+//  CompiledAppleScriptCacheTests.swift
+//  EasydictTests
+//
+//  Created by tisfeng on 2026/10/19.
+//  Copyright © 2026 izual. All rights reserved.
+//
+
+import Foundation
+import Testing
+
+@testable import Easydict
+
+// MARK: - CompiledAppleScriptCacheTests
+
+/// Validates reuse and eviction of compiled scripts with permission-free scripts, and prints
+/// how long a cold run takes compared to a cached one.
+@Suite("Compiled AppleScript Cache", .tags(.utilities, .unit))
+struct CompiledAppleScriptCacheTests {
+    /// Verifies that repeated runs compile the script once.
+    @Test("Compiles a script once and reuses it", .tags(.utilities, .unit))
+    func compilesOnce() async throws {
+        let registry = MetricsRegistry()
+        let cache = CompiledAppleScriptCache(registry: registry)
+        let executor = AppleScriptExecutor(compiledScriptCache: cache)
+
+        for _ in 0 ..< 3 {
+            let result = try await executor.run("return \"hello\"", bundleID: "com.apple.Safari")
+            #expect(result == "hello")
+        }
+
+        let labels = ["bundle_id": "com.apple.Safari"]
+        #expect(cache.count == 1)
+        #expect(registry.histogram(CompiledAppleScriptCache.compileDuration, labels: labels)?.count == 1)
+        #expect(registry.histogram(CompiledAppleScriptCache.executeDuration, labels: labels)?.count == 3)
+    }
+
+    /// Verifies that the least recently used script is evicted and that the bundle ID is part
+    /// of the key.
+    @Test("Evicts the least recently used script", .tags(.utilities, .unit))
+    func evictsLeastRecentlyUsed() throws {
+        let cache = CompiledAppleScriptCache(capacity: 2, registry: MetricsRegistry())
+
+        func reuse(_ source: String, bundleID: String? = nil) throws -> NSAppleScript {
+            let script = try cache.checkOut(source, bundleID: bundleID)
+            cache.checkIn(script, source: source, bundleID: bundleID)
+            return script
+        }
+
+        let first = try reuse("return 1")
+        let second = try reuse("return 2")
+        #expect(try reuse("return 1") === first)
+
+        _ = try reuse("return 1", bundleID: "com.google.Chrome")
+        #expect(try reuse("return 1") === first)
+        #expect(try reuse("return 2") !== second)
+        #expect(cache.count == 2)
+    }
+
+    /// Verifies that a checked out script is not handed to a second caller.
+    @Test("Checked out scripts are exclusive", .tags(.utilities, .unit))
+    func checkedOutScriptsAreExclusive() throws {
+        let cache = CompiledAppleScriptCache(registry: MetricsRegistry())
+
+        let running = try cache.checkOut("return 1", bundleID: nil)
+        cache.checkIn(running, source: "return 1", bundleID: nil)
+        let first = try cache.checkOut("return 1", bundleID: nil)
+        let second = try cache.checkOut("return 1", bundleID: nil)
+        #expect(first !== second)
+        #expect(cache.count == 0)
+
+        cache.checkIn(first, source: "return 1", bundleID: nil)
+        cache.checkIn(second, source: "return 1", bundleID: nil)
+        #expect(cache.count == 1)
+    }
+
+    /// Verifies that a slow script does not hold up scripts for another browser.
+    @Test("A slow script does not block other scripts", .tags(.utilities, .unit))
+    func slowScriptDoesNotBlockOthers() async throws {
+        let executor = AppleScriptExecutor(compiledScriptCache: CompiledAppleScriptCache(registry: MetricsRegistry()))
+
+        let slowRun = Task {
+            try await executor.run("delay 2\nreturn \"slow\"", bundleID: "com.apple.Safari")
+        }
+        await Task.sleep(seconds: 0.2)
+
+        let startTime = CFAbsoluteTimeGetCurrent()
+        let result = try await executor.run("return \"fast\"", bundleID: "com.google.Chrome")
+        #expect(result == "fast")
+        #expect(CFAbsoluteTimeGetCurrent() - startTime < 1)
+
+        #expect(try await slowRun.value == "slow")
+    }
+
+    /// Verifies that scripts failing to compile map to `QueryError` and are not cached.
+    @Test("Does not cache scripts that fail to compile", .tags(.utilities, .unit))
+    func doesNotCacheInvalidScripts() async {
+        let cache = CompiledAppleScriptCache(registry: MetricsRegistry())
+        let executor = AppleScriptExecutor(compiledScriptCache: cache)
+        let script = "this is not valid AppleScript"
+
+        do {
+            _ = try await executor.run(script)
+            Issue.record("Expected compiling to fail")
+        } catch let error as QueryError {
+            #expect(error.type == .appleScript)
+            #expect(error.errorDataMessage == script)
+        } catch {
+            Issue.record("Unexpected error type: \(error)")
+        }
+        #expect(cache.count == 0)
+    }
+
+    @Test("Benchmark cold and cached runs", .tags(.performance))
+    func benchmarkColdAndCachedRuns() async throws {
+        let script = """
+        set total to 0
+        repeat with index from 1 to 10
+            set total to total + index
+        end repeat
+        return total as text
+        """
+        let iterations = 20
+
+        let uncached = AppleScriptExecutor()
+        let uncachedStart = Date()
+        for _ in 0 ..< iterations {
+            _ = try await uncached.run(script)
+        }
+        let uncachedDuration = Date().timeIntervalSince(uncachedStart) / Double(iterations)
+
+        let cached = AppleScriptExecutor(compiledScriptCache: CompiledAppleScriptCache(registry: MetricsRegistry()))
+        _ = try await cached.run(script)
+        let cachedStart = Date()
+        for _ in 0 ..< iterations {
+            _ = try await cached.run(script)
+        }
+        let cachedDuration = Date().timeIntervalSince(cachedStart) / Double(iterations)
+
+        print(
+            "AppleScript run: compiled each time \(String(format: "%.2f", uncachedDuration * 1000)) ms, "
+                + "cached \(String(format: "%.2f", cachedDuration * 1000)) ms"
+        )
+    }
+}
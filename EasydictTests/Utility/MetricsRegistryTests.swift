@@ -0,0 +1,127 @@
+//
+//  MetricsRegistryTests.swift
+//  EasydictTests
+//
+//  Created by tisfeng on 2026/10/19.
+//  Copyright © 2026 izual. All rights reserved.
+//
+
+import Foundation
+import Testing
+
+@testable import Easydict
+
+// MARK: - MetricsRegistryTests
+
+@Suite("Metrics Registry", .tags(.utilities, .unit))
+struct MetricsRegistryTests {
+    // MARK: Internal
+
+    @Test("Histogram quantiles stay within the bucket precision", .tags(.utilities, .unit))
+    func testHistogramQuantilePrecision() {
+        var histogram = Histogram()
+        for value in 1 ... 10000 {
+            histogram.record(Double(value) / 1000)
+        }
+
+        #expect(histogram.count == 10000)
+        #expect(abs(histogram.sum - 50005) < 0.001)
+        for (quantile, expected) in [(0.5, 5.0), (0.9, 9.0), (0.99, 9.9)] {
+            let relativeError = abs(histogram.quantile(quantile) - expected) / expected
+            #expect(relativeError < 1.0 / Double(histogram.subBucketCount), "q\(quantile)")
+        }
+    }
+
+    @Test("Histogram handles zero, tiny and empty input", .tags(.utilities, .unit))
+    func testHistogramEdgeValues() {
+        var histogram = Histogram()
+        #expect(histogram.quantile(0.5) == 0)
+
+        histogram.record(0)
+        histogram.record(0)
+        histogram.record(1e-9)
+        histogram.record(-1)
+        histogram.record(.nan)
+
+        #expect(histogram.count == 4)
+        #expect(histogram.quantile(0.5) == 0)
+        #expect(histogram.quantile(1) <= 1e-9)
+    }
+
+    @Test("Renders the Prometheus text format", .tags(.utilities, .unit))
+    func testPrometheusText() {
+        let registry = MetricsRegistry()
+        let counter = MetricDescriptor(name: "test_total", help: "Test counter.", kind: .counter)
+        let summary = MetricDescriptor(name: "test_seconds", help: "Test summary.", kind: .summary)
+
+        registry.increment(counter, labels: ["service": "a\"b"])
+        registry.increment(counter, labels: ["service": "a\"b"], by: 2)
+        registry.observe(summary, labels: ["service": "x"], value: 2)
+
+        let text = registry.prometheusText()
+        #expect(text.contains("# TYPE test_total counter\n"))
+        #expect(text.contains("test_total{service=\"a\\\"b\"} 3\n"))
+        #expect(text.contains("# TYPE test_seconds summary\n"))
+        #expect(text.contains("test_seconds{quantile=\"0.5\",service=\"x\"} 2\n"))
+        #expect(text.contains("test_seconds_sum{service=\"x\"} 2\n"))
+        #expect(text.contains("test_seconds_count{service=\"x\"} 1\n"))
+
+        registry.reset()
+        #expect(registry.prometheusText().isEmpty)
+    }
+
+    @Test("Span records latency, first token and token rate", .tags(.utilities, .unit))
+    func testSpanRecordsStreamTimings() {
+        let registry = MetricsRegistry()
+        let clock = TestClock()
+        let span = QueryMetricsSpan(service: "OpenAI", registry: registry, now: { clock.now() })
+        let labels = ["service": "OpenAI"]
+
+        clock.currentTime = 0.2
+        span.markFirstByte()
+        clock.currentTime = 0.5
+        span.markToken()
+        clock.currentTime = 1.5
+        for _ in 0 ..< 10 {
+            span.markToken()
+        }
+        clock.currentTime = 2.5
+        span.finish(error: nil)
+        // Later marks and finishes are ignored.
+        span.markFirstByte()
+        span.finish(error: QueryError(type: .api))
+
+        #expect(registry.histogram(QueryMetrics.timeToFirstByte, labels: labels)?.sum == 0.2)
+        #expect(registry.histogram(QueryMetrics.timeToFirstToken, labels: labels)?.sum == 0.5)
+        #expect(registry.histogram(QueryMetrics.duration, labels: labels)?.sum == 2.5)
+        #expect(registry.histogram(QueryMetrics.tokensPerSecond, labels: labels)?.sum == 5)
+        #expect(registry.counter(QueryMetrics.queries, labels: ["service": "OpenAI", "outcome": "success"]) == 1)
+        #expect(registry.counters(QueryMetrics.errors).isEmpty)
+    }
+
+    @Test("Span classifies errors and cancellation", .tags(.utilities, .unit))
+    func testSpanClassifiesErrors() {
+        let registry = MetricsRegistry()
+
+        QueryMetricsSpan(service: "Google", registry: registry).finish(error: QueryError(type: .timeout))
+        QueryMetricsSpan(service: "Google", registry: registry).finish(error: URLError(.notConnectedToInternet))
+        QueryMetricsSpan(service: "Google", registry: registry).finish(error: CancellationError())
+
+        #expect(registry.counter(QueryMetrics.errors, labels: ["service": "Google", "type": "timeout"]) == 1)
+        #expect(registry.counter(QueryMetrics.errors, labels: ["service": "Google", "type": "network"]) == 1)
+        #expect(registry.counter(QueryMetrics.queries, labels: ["service": "Google", "outcome": "error"]) == 2)
+        #expect(registry.counter(QueryMetrics.queries, labels: ["service": "Google", "outcome": "cancelled"]) == 1)
+        // Cancelled queries are not part of the latency distribution.
+        #expect(registry.histogram(QueryMetrics.duration, labels: ["service": "Google"])?.count == 2)
+    }
+
+    // MARK: Private
+
+    private final class TestClock {
+        var currentTime: TimeInterval = 0
+
+        func now() -> TimeInterval {
+            currentTime
+        }
+    }
+}
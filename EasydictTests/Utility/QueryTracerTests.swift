@@ -0,0 +1,118 @@
+//
+//  QueryTracerTests.swift
+//  EasydictTests
+//
+//  Created by tisfeng on 2026/10/19.
+//  Copyright © 2026 izual. All rights reserved.
+//
+
+import Foundation
+import Testing
+
+@testable import Easydict
+
+// MARK: - QueryTracerTests
+
+@Suite("Query Tracer", .tags(.utilities, .unit))
+struct QueryTracerTests {
+    // MARK: Internal
+
+    @Test("Disabled tracer records nothing", .tags(.utilities, .unit))
+    func testDisabledTracerIsNoOp() throws {
+        let tracer = QueryTracer()
+
+        let rootID = tracer.beginTrace("query")
+        #expect(rootID == 0)
+        #expect(tracer.beginSpan("detect", parent: rootID, lane: nil) == 0)
+        tracer.endSpan(rootID)
+
+        #expect(try traceEvents(tracer).isEmpty)
+    }
+
+    @Test("Spans are exported as Chrome trace events", .tags(.utilities, .unit))
+    func testChromeTraceExport() throws {
+        let clock = TestClock()
+        let tracer = QueryTracer(now: { clock.now() })
+        tracer.setEnabled(true)
+
+        let rootID = tracer.beginTrace("query (mini)")
+        clock.currentTime = 0.001
+        let detectID = tracer.beginSpan("detect", parent: rootID, lane: "detect")
+        clock.currentTime = 0.004
+        tracer.endSpan(detectID)
+        let serviceID = tracer.beginSpan("OpenAI", parent: rootID, lane: "OpenAI")
+        clock.currentTime = 0.010
+        tracer.mark("response headers", parent: serviceID)
+        clock.currentTime = 0.020
+        tracer.endSpan(serviceID)
+
+        let events = try traceEvents(tracer)
+        let spans = events.filter { $0["ph"] as? String == "X" }
+        let byName = Dictionary(uniqueKeysWithValues: spans.map { ($0["name"] as? String ?? "", $0) })
+
+        #expect(byName["query (mini)"]?["dur"] as? Int == 20000)
+        #expect(byName["detect"]?["ts"] as? Int == 1000)
+        #expect(byName["detect"]?["dur"] as? Int == 3000)
+        #expect(byName["OpenAI"]?["dur"] as? Int == 16000)
+        #expect(byName["OpenAI"]?["tid"] as? Int != byName["detect"]?["tid"] as? Int)
+
+        let mark = try #require(events.first { $0["ph"] as? String == "i" })
+        #expect(mark["name"] as? String == "response headers")
+        #expect(mark["tid"] as? Int == byName["OpenAI"]?["tid"] as? Int)
+
+        let laneNames = events
+            .filter { $0["name"] as? String == "thread_name" }
+            .compactMap { ($0["args"] as? [String: Any])?["name"] as? String }
+        #expect(Set(laneNames) == ["query", "detect", "OpenAI"])
+    }
+
+    @Test("Swift spans nest through the task-local parent", .tags(.utilities, .unit))
+    func testWithSpanBindsParent() async throws {
+        let tracer = QueryTracer()
+        tracer.setEnabled(true)
+
+        let rootID = tracer.beginTrace("query")
+        await tracer.withSpan("service", parent: rootID, lane: "service") {
+            let childID = tracer.beginSpan("updateResultText")
+            #expect(childID != 0)
+            tracer.endSpan(childID)
+        }
+
+        let names = try traceEvents(tracer).filter { $0["ph"] as? String == "X" }.compactMap { $0["name"] as? String }
+        #expect(Set(names) == ["query", "service", "updateResultText"])
+    }
+
+    @Test("Only the most recent traces are kept", .tags(.utilities, .unit))
+    func testRingBufferEvictsOldestTrace() throws {
+        let tracer = QueryTracer(capacity: 2)
+        tracer.setEnabled(true)
+
+        let firstRootID = tracer.beginTrace("first")
+        _ = tracer.beginTrace("second")
+        _ = tracer.beginTrace("third")
+
+        // Spans of an evicted trace are dropped.
+        #expect(tracer.beginSpan("late", parent: firstRootID, lane: nil) == 0)
+
+        let processNames = try traceEvents(tracer)
+            .filter { $0["name"] as? String == "process_name" }
+            .compactMap { ($0["args"] as? [String: Any])?["name"] as? String }
+        #expect(processNames == ["second", "third"])
+    }
+
+    // MARK: Private
+
+    private final class TestClock {
+        var currentTime: TimeInterval = 0
+
+        func now() -> TimeInterval {
+            currentTime
+        }
+    }
+
+    private func traceEvents(_ tracer: QueryTracer) throws -> [[String: Any]] {
+        let object = try JSONSerialization.jsonObject(with: tracer.chromeTraceJSON())
+        let json = try #require(object as? [String: Any])
+        return try #require(json["traceEvents"] as? [[String: Any]])
+    }
+}
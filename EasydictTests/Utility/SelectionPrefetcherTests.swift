@@ -0,0 +1,192 @@
+//
+//  SelectionPrefetcherTests.swift
+//  EasydictTests
+//
+//  Created by tisfeng on 2026/10/19.
+//  Copyright © 2026 izual. All rights reserved.
+//
+
+import Foundation
+import Testing
+
+@testable import Easydict
+
+// MARK: - SelectionPrefetcherTests
+
+/// Tests for speculative prefetching of selected text, with stubbed detection and probe services.
+@Suite("Selection Prefetcher", .tags(.utilities, .unit))
+struct SelectionPrefetcherTests {
+    // MARK: Internal
+
+    @Test("A query adopts the prefetched lookup once", .tags(.utilities, .unit))
+    func reusesPrefetchedLookup() async throws {
+        let recorder = Recorder()
+        let prefetcher = makePrefetcher(recorder: recorder)
+
+        prefetcher.prefetch("apple", windowType: .mini)
+        try await waitUntil { recorder.lookups.count == 1 }
+        let lookup = try #require(recorder.lookups.first)
+        #expect(prefetcher.detectedLanguage(for: "apple") == .english)
+
+        let service = makeProbe(recorder: recorder)
+        let prefetched = try await waitForLookup(prefetcher, service: service, lookup: lookup)
+        #expect(prefetched.probe !== service)
+        #expect(prefetcher.takeLookup(for: service, text: "apple", from: lookup.from, to: lookup.to) == nil)
+    }
+
+    @Test("Selecting the same text again keeps the work in progress and its results", .tags(.utilities, .unit))
+    func repeatedSelectionKeepsEntry() async throws {
+        let recorder = Recorder()
+        let prefetcher = makePrefetcher(recorder: recorder, debounceDelay: .milliseconds(50))
+
+        // Repeated while debouncing, while looking up, and after the lookup finished.
+        prefetcher.prefetch("apple", windowType: .mini)
+        prefetcher.prefetch("apple", windowType: .mini)
+        try await waitUntil { recorder.lookups.count == 1 }
+        prefetcher.prefetch("apple", windowType: .mini)
+        await Task.sleep(seconds: 0.2)
+        prefetcher.prefetch("apple", windowType: .mini)
+        await Task.sleep(seconds: 0.2)
+
+        #expect(recorder.detectedTexts == ["apple"])
+        #expect(recorder.lookups.count == 1)
+
+        let lookup = try #require(recorder.lookups.first)
+        _ = try await waitForLookup(prefetcher, service: makeProbe(recorder: recorder), lookup: lookup)
+    }
+
+    @Test("A new selection cancels the pending prefetch", .tags(.utilities, .unit))
+    func newSelectionCancelsPendingPrefetch() async throws {
+        let recorder = Recorder()
+        let prefetcher = makePrefetcher(recorder: recorder, debounceDelay: .milliseconds(100))
+
+        prefetcher.prefetch("apple", windowType: .mini)
+        prefetcher.prefetch("banana", windowType: .mini)
+        try await waitUntil { recorder.lookups.count == 1 }
+        await Task.sleep(seconds: 0.2)
+
+        #expect(recorder.detectedTexts == ["banana"])
+        #expect(recorder.lookups.map(\.text) == ["banana"])
+        #expect(prefetcher.detectedLanguage(for: "apple") == nil)
+    }
+
+    // MARK: Private
+
+    private struct RecordedLookup {
+        let text: String
+        let from: Language
+        let to: Language
+    }
+
+    private final class Recorder: @unchecked Sendable {
+        // MARK: Internal
+
+        var detectedTexts: [String] {
+            lock.withLock { detected }
+        }
+
+        var lookups: [RecordedLookup] {
+            lock.withLock { recordedLookups }
+        }
+
+        func recordDetection(_ text: String) {
+            lock.withLock { detected.append(text) }
+        }
+
+        func recordLookup(_ lookup: RecordedLookup) {
+            lock.withLock { recordedLookups.append(lookup) }
+        }
+
+        // MARK: Private
+
+        private let lock = NSLock()
+        private var detected: [String] = []
+        private var recordedLookups: [RecordedLookup] = []
+    }
+
+    /// A local service that records its lookups instead of querying anything.
+    private final class ProbeService: QueryService {
+        var recorder: Recorder?
+
+        override var enabledQuery: Bool {
+            get { true }
+            set {}
+        }
+
+        override var enabledAutoQuery: Bool {
+            get { true }
+            set {}
+        }
+
+        override func serviceType() -> ServiceType {
+            .appleDictionary
+        }
+
+        override func name() -> String {
+            "Probe"
+        }
+
+        override func supportLanguagesDictionary() -> MMOrderedDictionary {
+            MMOrderedDictionary()
+        }
+
+        override func supportsSpeculativePrefetch() -> Bool {
+            true
+        }
+
+        @nonobjc
+        override func translate(_ text: String, from: Language, to: Language) async throws -> QueryResult {
+            recorder?.recordLookup(RecordedLookup(text: text, from: from, to: to))
+            return QueryResult()
+        }
+    }
+
+    private func makePrefetcher(
+        recorder: Recorder,
+        debounceDelay: Duration = .zero
+    )
+        -> SelectionPrefetcher {
+        SelectionPrefetcher(
+            debounceDelay: debounceDelay,
+            isEnabled: { true },
+            detect: { queryModel in
+                recorder.recordDetection(queryModel.queryText)
+                queryModel.detectedLanguage = .english
+                return queryModel
+            },
+            makeServices: { windowType in
+                [makeProbe(recorder: recorder, windowType: windowType)]
+            }
+        )
+    }
+
+    private func makeProbe(recorder: Recorder, windowType: EZWindowType = .mini) -> ProbeService {
+        let service = ProbeService()
+        service.recorder = recorder
+        service.windowType = windowType
+        return service
+    }
+
+    /// The lookup is stored right after the probe returns, so poll for it briefly.
+    private func waitForLookup(
+        _ prefetcher: SelectionPrefetcher,
+        service: QueryService,
+        lookup: RecordedLookup
+    ) async throws
+        -> SelectionPrefetcher.Lookup {
+        var prefetched: SelectionPrefetcher.Lookup?
+        try await waitUntil {
+            prefetched = prefetcher.takeLookup(for: service, text: lookup.text, from: lookup.from, to: lookup.to)
+            return prefetched != nil
+        }
+        return try #require(prefetched)
+    }
+
+    private func waitUntil(timeout: TimeInterval = 2, _ condition: () -> Bool) async throws {
+        let deadline = Date().addingTimeInterval(timeout)
+        while !condition() {
+            try #require(Date() < deadline, "Condition not met in time")
+            await Task.sleep(seconds: 0.005)
+        }
+    }
+}
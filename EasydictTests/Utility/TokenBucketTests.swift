@@ -0,0 +1,67 @@
+//
+//  TokenBucketTests.swift
+//  EasydictTests
+//
+//  Created by tisfeng on 2026/10/19.
+//  Copyright © 2026 izual. All rights reserved.
+//
+
+import Foundation
+import Testing
+
+@testable import Easydict
+
+// MARK: - TokenBucketTests
+
+@Suite("Token Bucket", .tags(.utilities, .unit))
+struct TokenBucketTests {
+    // MARK: Internal
+
+    @Test("Burst up to capacity is allowed", .tags(.utilities, .unit))
+    func testBurstUpToCapacityIsAllowed() {
+        let clock = TestClock()
+        var bucket = TokenBucket(capacity: 3, refillInterval: 1, now: { clock.now() })
+
+        #expect(bucket.consume() == true)
+        #expect(bucket.consume() == true)
+        #expect(bucket.consume() == true)
+        #expect(bucket.consume() == false)
+    }
+
+    @Test("Tokens refill over time", .tags(.utilities, .unit))
+    func testTokensRefillOverTime() {
+        let clock = TestClock()
+        var bucket = TokenBucket(capacity: 2, refillInterval: 1, now: { clock.now() })
+
+        #expect(bucket.consume() == true)
+        #expect(bucket.consume() == true)
+
+        clock.currentTime = 0.5
+        #expect(bucket.consume() == false)
+
+        clock.currentTime = 1
+        #expect(bucket.consume() == true)
+        #expect(bucket.consume() == false)
+    }
+
+    @Test("Refill never exceeds capacity", .tags(.utilities, .unit))
+    func testRefillNeverExceedsCapacity() {
+        let clock = TestClock()
+        var bucket = TokenBucket(capacity: 2, refillInterval: 1, now: { clock.now() })
+
+        clock.currentTime = 100
+        #expect(bucket.consume() == true)
+        #expect(bucket.consume() == true)
+        #expect(bucket.consume() == false)
+    }
+
+    // MARK: Private
+
+    private final class TestClock {
+        var currentTime: TimeInterval = 0
+
+        func now() -> TimeInterval {
+            currentTime
+        }
+    }
+}